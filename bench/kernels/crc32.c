@@ -0,0 +1,26 @@
+// テーブル方式の CRC32 (unsigned のシフトと xor)
+int printf(char *fmt, ...);
+
+unsigned table[256];
+char data[65536];
+
+int main() {
+    for (unsigned i = 0; i < 256; i++) {
+        unsigned c = i;
+        for (int k = 0; k < 8; k++)
+            c = c & 1 ? 0xedb88320 ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    for (int i = 0; i < 65536; i++)
+        data[i] = i * 31 + (i >> 8);
+
+    unsigned crc = 0;
+    for (int round = 0; round < 256; round++) {
+        crc = ~crc;
+        for (int i = 0; i < 65536; i++)
+            crc = table[(crc ^ data[i]) & 255] ^ (crc >> 8);
+        crc = ~crc;
+    }
+    printf("%u\n", crc);
+    return 0;
+}
@@ -0,0 +1,13 @@
+// 再帰呼び出し (関数呼び出しのオーバーヘッド)
+int printf(char *fmt, ...);
+
+int fib(int n) {
+    if (n < 2)
+        return n;
+    return fib(n - 1) + fib(n - 2);
+}
+
+int main() {
+    printf("%d\n", fib(35));
+    return 0;
+}
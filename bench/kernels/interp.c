@@ -0,0 +1,57 @@
+// switch で命令を振り分けるスタックマシン
+int printf(char *fmt, ...);
+
+enum { PUSH, LOAD, STORE, ADD, SUB, MUL, LESS, JUMP_IF_ZERO, JUMP, HALT };
+
+int code[64];
+int length;
+
+void emit(int op, int operand) {
+    code[length++] = op;
+    code[length++] = operand;
+}
+
+// i = 0; sum = 0; while (i < n) { sum = sum + i * 3; i = i + 1; }
+void assemble(int n) {
+    emit(PUSH, 0); emit(STORE, 0);
+    emit(PUSH, 0); emit(STORE, 1);
+    int loop = length;
+    emit(LOAD, 0); emit(PUSH, n); emit(LESS, 0);
+    int exit = length;
+    emit(JUMP_IF_ZERO, 0);
+    emit(LOAD, 1); emit(LOAD, 0); emit(PUSH, 3); emit(MUL, 0); emit(ADD, 0); emit(STORE, 1);
+    emit(LOAD, 0); emit(PUSH, 1); emit(ADD, 0); emit(STORE, 0);
+    emit(JUMP, loop);
+    code[exit + 1] = length;
+    emit(HALT, 0);
+}
+
+int run() {
+    int stack[16];
+    int variables[4];
+    int sp = 0;
+    int pc = 0;
+    for (;;) {
+        int op = code[pc];
+        int operand = code[pc + 1];
+        pc += 2;
+        switch (op) {
+        case PUSH: stack[sp++] = operand; break;
+        case LOAD: stack[sp++] = variables[operand]; break;
+        case STORE: variables[operand] = stack[--sp]; break;
+        case ADD: sp--; stack[sp - 1] = stack[sp - 1] + stack[sp]; break;
+        case SUB: sp--; stack[sp - 1] = stack[sp - 1] - stack[sp]; break;
+        case MUL: sp--; stack[sp - 1] = stack[sp - 1] * stack[sp]; break;
+        case LESS: sp--; stack[sp - 1] = stack[sp - 1] < stack[sp]; break;
+        case JUMP_IF_ZERO: if (!stack[--sp]) pc = operand; break;
+        case JUMP: pc = operand; break;
+        case HALT: return variables[1];
+        }
+    }
+}
+
+int main() {
+    assemble(1000000);
+    printf("%d\n", run());
+    return 0;
+}
@@ -0,0 +1,37 @@
+// 構造体の連結リストを何度もたどる (ポインタの追跡とメンバアクセス)
+int printf(char *fmt, ...);
+void *calloc(long count, long size);
+
+struct node {
+    struct node *next;
+    int key;
+    int value;
+    long weight;
+};
+
+int main() {
+    int n = 20000;
+    struct node *nodes = calloc(n, sizeof(struct node));
+    // 隣り合わない順につなぐ
+    for (int i = 0; i < n; i++) {
+        nodes[i].key = i;
+        nodes[i].value = i % 97;
+        nodes[i].weight = i * 3;
+        nodes[i].next = &nodes[(i + 7919) % n];
+    }
+
+    long total = 0;
+    for (int round = 0; round < 1000; round++) {
+        struct node *p = &nodes[round];
+        for (int i = 0; i < n; i++) {
+            if (p->key & 1)
+                total += p->value;
+            else
+                total += p->weight >> 4;
+            p->value = (p->value + round) % 97;
+            p = p->next;
+        }
+    }
+    printf("%ld\n", total);
+    return 0;
+}
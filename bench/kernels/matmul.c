@@ -0,0 +1,32 @@
+// 行列積 (int, 行優先の 2 次元配列)
+int printf(char *fmt, ...);
+
+int a[128][128];
+int b[128][128];
+int c[128][128];
+
+int main() {
+    int n = 128;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a[i][j] = (i * 7 + j * 3) % 17 - 8;
+            b[i][j] = (i * 5 + j * 11) % 13 - 6;
+        }
+    }
+
+    long checksum = 0;
+    for (int round = 0; round < 8; round++) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                int sum = 0;
+                for (int k = 0; k < n; k++)
+                    sum += a[i][k] * b[k][j];
+                c[i][j] = sum + round;
+            }
+        }
+        for (int i = 0; i < n; i++)
+            checksum += c[i][(i * 31 + round) % n];
+    }
+    printf("%ld\n", checksum);
+    return 0;
+}
@@ -0,0 +1,85 @@
+// n 体問題 (double の構造体配列)
+int printf(char *fmt, ...);
+double sqrt(double x);
+
+struct body {
+    double x, y, z;
+    double vx, vy, vz;
+    double mass;
+};
+
+struct body bodies[5];
+
+void init() {
+    double solarMass = 39.47841760435743;
+    double daysPerYear = 365.24;
+    double values[5][7] = {
+        {0, 0, 0, 0, 0, 0, 1},
+        {4.84143144246472090, -1.16032004402742839, -0.103622044471123109, 0.00166007664274403694,
+         0.00769901118419740425, -0.0000690460016972063023, 0.000954791938424326609},
+        {8.34336671824457987, 4.12479856412430479, -0.403523417114321381, -0.00276742510726862411,
+         0.00499852801234917238, 0.0000230417297573763929, 0.000285885980666130812},
+        {12.8943695621391310, -15.1111514016986312, -0.223307578892655734, 0.00296460137564761618,
+         0.00237847173959480950, -0.0000296589568540237556, 0.0000436624404335156298},
+        {15.3796971148509165, -25.9193146099879641, 0.179258772950371181, 0.00268067772490389322,
+         0.00162824170038242295, -0.0000951592254519715870, 0.0000515138902046611451},
+    };
+    for (int i = 0; i < 5; i++) {
+        bodies[i].x = values[i][0];
+        bodies[i].y = values[i][1];
+        bodies[i].z = values[i][2];
+        bodies[i].vx = values[i][3] * daysPerYear;
+        bodies[i].vy = values[i][4] * daysPerYear;
+        bodies[i].vz = values[i][5] * daysPerYear;
+        bodies[i].mass = values[i][6] * solarMass;
+    }
+}
+
+void advance(double dt) {
+    for (int i = 0; i < 5; i++) {
+        struct body *b = &bodies[i];
+        for (int j = i + 1; j < 5; j++) {
+            struct body *o = &bodies[j];
+            double dx = b->x - o->x;
+            double dy = b->y - o->y;
+            double dz = b->z - o->z;
+            double d2 = dx * dx + dy * dy + dz * dz;
+            double magnitude = dt / (d2 * sqrt(d2));
+            b->vx -= dx * o->mass * magnitude;
+            b->vy -= dy * o->mass * magnitude;
+            b->vz -= dz * o->mass * magnitude;
+            o->vx += dx * b->mass * magnitude;
+            o->vy += dy * b->mass * magnitude;
+            o->vz += dz * b->mass * magnitude;
+        }
+    }
+    for (int i = 0; i < 5; i++) {
+        bodies[i].x += dt * bodies[i].vx;
+        bodies[i].y += dt * bodies[i].vy;
+        bodies[i].z += dt * bodies[i].vz;
+    }
+}
+
+double energy() {
+    double e = 0;
+    for (int i = 0; i < 5; i++) {
+        struct body *b = &bodies[i];
+        e += 0.5 * b->mass * (b->vx * b->vx + b->vy * b->vy + b->vz * b->vz);
+        for (int j = i + 1; j < 5; j++) {
+            struct body *o = &bodies[j];
+            double dx = b->x - o->x;
+            double dy = b->y - o->y;
+            double dz = b->z - o->z;
+            e -= b->mass * o->mass / sqrt(dx * dx + dy * dy + dz * dz);
+        }
+    }
+    return e;
+}
+
+int main() {
+    init();
+    for (int i = 0; i < 500000; i++)
+        advance(0.01);
+    printf("%.9f\n", energy());
+    return 0;
+}
@@ -0,0 +1,49 @@
+// 配列のクイックソート (再帰と添字アクセス)
+int printf(char *fmt, ...);
+
+int values[1000000];
+
+void sort(int *a, int lo, int hi) {
+    while (lo < hi) {
+        int pivot = a[(lo + hi) / 2];
+        int i = lo;
+        int j = hi;
+        while (i <= j) {
+            while (a[i] < pivot) i++;
+            while (a[j] > pivot) j--;
+            if (i <= j) {
+                int t = a[i];
+                a[i] = a[j];
+                a[j] = t;
+                i++;
+                j--;
+            }
+        }
+        if (j - lo < hi - i) {
+            sort(a, lo, j);
+            lo = i;
+        } else {
+            sort(a, i, hi);
+            hi = j;
+        }
+    }
+}
+
+int main() {
+    int n = 1000000;
+    unsigned seed = 12345;
+    for (int i = 0; i < n; i++) {
+        seed = seed * 1103515245 + 12345;
+        values[i] = (seed >> 8) % 1000000;
+    }
+    sort(values, 0, n - 1);
+
+    long checksum = 0;
+    for (int i = 0; i < n; i += 1000)
+        checksum += values[i];
+    for (int i = 1; i < n; i++)
+        if (values[i - 1] > values[i])
+            return 1;
+    printf("%ld\n", checksum);
+    return 0;
+}
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""
+Runtime benchmark for the code yoctocc generates.
+
+Compiles each kernel in bench/kernels with yoctocc and with gcc -O0 / -O1,
+checks that every build prints the same result, and reports cycles and
+instructions (`perf stat`) or wall time (when perf is unavailable) together
+with the ratio against gcc.
+
+Usage:
+    python3 bench/kernels/run_kernels.py                 # All kernels
+    python3 bench/kernels/run_kernels.py matmul sieve    # Kernels matching filters (OR)
+
+Environment:
+    KERNEL_CC=gcc        Reference compiler (also used to assemble and link)
+    KERNEL_FLAGS=        Extra yoctocc options for the yoctocc build (recorded in kernels.json)
+    KERNEL_REPEAT=3      Runs per binary (the minimum is used)
+    KERNEL_PERF=auto     auto | 0 (force wall time)
+"""
+
+import json
+import math
+import os
+import shutil
+import subprocess
+import sys
+import time
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, List, Optional
+
+# --- Configuration ---
+
+REFERENCE_CC = os.environ.get("KERNEL_CC", "gcc")
+YOCTOCC_FLAGS = os.environ.get("KERNEL_FLAGS", "").split()
+REPEAT = int(os.environ.get("KERNEL_REPEAT", "3"))
+USE_PERF = os.environ.get("KERNEL_PERF", "auto") != "0" and shutil.which("perf") is not None
+FILTERS = sys.argv[1:]
+
+SCRIPT_DIR = Path(__file__).resolve().parent
+PROJECT_ROOT = SCRIPT_DIR.parent.parent
+COMPILER = PROJECT_ROOT / "build" / "yoctocc"
+OUTPUT_DIR = PROJECT_ROOT / "build" / "bench" / "kernels"
+RESULT_JSON = PROJECT_ROOT / "build" / "bench" / "kernels.json"
+
+# yoctocc のビルドと、比較に使う gcc のビルド
+VARIANTS = ["yoctocc", "gcc-O0", "gcc-O1"]
+
+
+class C:
+    GREEN, RED, NC = "\033[0;32m", "\033[0;31m", "\033[0m"
+
+
+@dataclass
+class Sample:
+    seconds: float = math.inf
+    cycles: Optional[int] = None
+    instructions: Optional[int] = None
+    output: str = ""
+
+
+@dataclass
+class KernelResult:
+    name: str
+    samples: Dict[str, Sample] = field(default_factory=dict)
+    error: str = ""
+
+
+def run(command: List[str], **kwargs) -> subprocess.CompletedProcess:
+    return subprocess.run(command, capture_output=True, text=True, **kwargs)
+
+
+def build(kernel: Path) -> Dict[str, Path]:
+    """Builds the kernel with every variant. Raises RuntimeError on failure."""
+    binaries = {}
+    asm = OUTPUT_DIR / f"{kernel.stem}.s"
+    result = run([str(COMPILER), *YOCTOCC_FLAGS, str(kernel), str(asm)])
+    if result.returncode != 0:
+        raise RuntimeError(f"yoctocc failed:\n{result.stderr}")
+    binaries["yoctocc"] = OUTPUT_DIR / f"{kernel.stem}.yoctocc"
+    result = run([REFERENCE_CC, "-no-pie", "-o", str(binaries["yoctocc"]), str(asm), "-lm"])
+    if result.returncode != 0:
+        raise RuntimeError(f"link failed:\n{result.stderr}")
+
+    for level in ["O0", "O1"]:
+        binary = OUTPUT_DIR / f"{kernel.stem}.gcc-{level}"
+        # カーネルは stdio.h を使わずに自前で宣言しているので警告は抑える
+        result = run([REFERENCE_CC, f"-{level}", "-w", "-o", str(binary), str(kernel), "-lm"])
+        if result.returncode != 0:
+            raise RuntimeError(f"{REFERENCE_CC} -{level} failed:\n{result.stderr}")
+        binaries[f"gcc-{level}"] = binary
+    return binaries
+
+
+def measure(binary: Path) -> Sample:
+    best = Sample()
+    for _ in range(REPEAT):
+        sample = Sample()
+        if USE_PERF:
+            start = time.perf_counter()
+            result = run(["perf", "stat", "-x,", "-e", "cycles,instructions", "--", str(binary)])
+            sample.seconds = time.perf_counter() - start
+            for line in result.stderr.splitlines():
+                fields = line.split(",")
+                if len(fields) > 2 and fields[0].isdigit():
+                    if fields[2].startswith("cycles"):
+                        sample.cycles = int(fields[0])
+                    elif fields[2].startswith("instructions"):
+                        sample.instructions = int(fields[0])
+        else:
+            start = time.perf_counter()
+            result = run([str(binary)])
+            sample.seconds = time.perf_counter() - start
+        if result.returncode != 0:
+            raise RuntimeError(f"{binary.name} exited with {result.returncode}")
+        sample.output = result.stdout
+
+        # サイクル数が取れればそれで、取れなければ時間で最良の回を選ぶ
+        if (sample.cycles or sample.seconds) < (best.cycles or best.seconds):
+            best = sample
+    return best
+
+
+def ratio(value: Optional[float], reference: Optional[float]) -> str:
+    return f"{value / reference:6.2f}x" if value and reference else "     -"
+
+
+def print_table(results: List[KernelResult]) -> None:
+    metric = "cycles" if USE_PERF else "time (ms)"
+    print(f"{'kernel':<12} {'yoctocc ' + metric:>22} {'instructions':>14} "
+          f"{'gcc-O0 ' + metric:>22} {'gcc-O1 ' + metric:>22} {'vs O0':>8} {'vs O1':>8}")
+    for r in results:
+        if r.error:
+            print(f"{r.name:<12} {C.RED}{r.error.splitlines()[0]}{C.NC}")
+            continue
+
+        def value(variant: str) -> Optional[float]:
+            sample = r.samples[variant]
+            return sample.cycles if USE_PERF else sample.seconds * 1000
+
+        instructions = r.samples["yoctocc"].instructions
+        instructions_text = f"{instructions:,}" if instructions else "-"
+        print(f"{r.name:<12} {value('yoctocc') or 0:>22,.1f} {instructions_text:>14} "
+              f"{value('gcc-O0') or 0:>22,.1f} {value('gcc-O1') or 0:>22,.1f} "
+              f"{ratio(value('yoctocc'), value('gcc-O0')):>8} {ratio(value('yoctocc'), value('gcc-O1')):>8}")
+
+
+def write_json(results: List[KernelResult]) -> None:
+    data = {"metric": "cycles" if USE_PERF else "seconds", "yoctocc_flags": YOCTOCC_FLAGS, "kernels": []}
+    for r in results:
+        entry = {"name": r.name, "error": r.error}
+        for variant, sample in r.samples.items():
+            entry[variant] = {"seconds": sample.seconds, "cycles": sample.cycles, "instructions": sample.instructions}
+        data["kernels"].append(entry)
+    RESULT_JSON.write_text(json.dumps(data, indent=2) + "\n")
+
+
+def main() -> int:
+    if not COMPILER.exists():
+        print(f"{C.RED}Error: {COMPILER} not found. Run `make` first.{C.NC}")
+        return 1
+    OUTPUT_DIR.mkdir(parents=True, exist_ok=True)
+
+    kernels = sorted(SCRIPT_DIR.glob("*.c"))
+    kernels = [k for k in kernels if not FILTERS or any(f in k.stem for f in FILTERS)]
+    if not USE_PERF:
+        print("perf is not available; reporting wall time instead of cycles")
+    if YOCTOCC_FLAGS:
+        print(f"yoctocc flags: {' '.join(YOCTOCC_FLAGS)}")
+
+    results = []
+    for kernel in kernels:
+        result = KernelResult(kernel.stem)
+        try:
+            binaries = build(kernel)
+            for variant in VARIANTS:
+                result.samples[variant] = measure(binaries[variant])
+            outputs = {variant: sample.output for variant, sample in result.samples.items()}
+            if len(set(outputs.values())) != 1:
+                result.error = "output mismatch: " + ", ".join(f"{v}={o.strip()!r}" for v, o in outputs.items())
+        except RuntimeError as error:
+            result.error = str(error)
+        results.append(result)
+
+    print_table(results)
+    write_json(results)
+    print(f"Results saved to {RESULT_JSON.relative_to(PROJECT_ROOT)}")
+
+    failed = [r.name for r in results if r.error]
+    if failed:
+        print(f"{C.RED}Failed: {', '.join(failed)}{C.NC}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
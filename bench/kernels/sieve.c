@@ -0,0 +1,25 @@
+// エラトステネスのふるい (char 配列)
+int printf(char *fmt, ...);
+
+char composite[1000000];
+
+int main() {
+    int n = 1000000;
+    int count = 0;
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < n; i++)
+            composite[i] = 0;
+        count = 0;
+        for (int i = 2; i < n; i++) {
+            if (composite[i])
+                continue;
+            count++;
+            if (i > n / i)
+                continue;
+            for (int j = i * i; j < n; j += i)
+                composite[j] = 1;
+        }
+    }
+    printf("%d\n", count);
+    return 0;
+}
@@ -0,0 +1,449 @@
+// コンパイラの各フェーズ (tokenize / parse / addType / Generator / AssemblyWriter) を
+// 固定のコーパスで個別に計測するマイクロベンチマーク。
+//
+// 使用例: build/bench/microbench --corpus test/cases --output build/bench/micro.json
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <print>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Assembly/AssemblyWriter.hpp"
+#include "Generator.hpp"
+#include "Logger.hpp"
+#include "Node/Node.hpp"
+#include "Parser/Parser.hpp"
+#include "Token.hpp"
+#include "Tokenizer.hpp"
+#include "Type.hpp"
+
+using namespace yoctocc;
+using namespace std::string_view_literals;
+
+namespace {
+
+struct Settings {
+    std::string corpusDirectory = "test/cases";
+    std::string output;
+    std::string baseline;
+    std::string filter;
+    // 結果に記録する名前 (make bench ではコミットハッシュ)
+    std::string label;
+    int repetitions = 10;
+    // 合成コーパスの関数の数
+    int syntheticFunctions = 400;
+};
+
+struct Corpus {
+    std::string name;
+    std::string source;
+};
+
+struct Result {
+    std::string name;
+    std::string unit;
+    uint64_t units = 0;
+    double medianNs = 0;
+    double minNs = 0;
+    double meanNs = 0;
+    double stddevNs = 0;
+
+    [[nodiscard]] double throughput() const {
+        return medianNs > 0 ? units / (medianNs / 1e9) : 0;
+    }
+};
+
+// 1 回分の計測。prepare は計測に含めない
+struct Measurement {
+    std::function<void()> prepare = nullptr;
+    std::function<uint64_t()> run = nullptr;
+};
+
+Result measure(std::string name, std::string unit, int repetitions, const Measurement& measurement) {
+    Result result{.name = std::move(name), .unit = std::move(unit)};
+    std::vector<double> samples;
+
+    // 1 回目はウォームアップとして捨てる
+    for (int i = 0; i <= repetitions; i++) {
+        if (measurement.prepare) {
+            measurement.prepare();
+        }
+        auto start = std::chrono::steady_clock::now();
+        uint64_t units = measurement.run();
+        auto end = std::chrono::steady_clock::now();
+        if (i == 0) {
+            continue;
+        }
+        result.units = units;
+        samples.emplace_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+
+    std::ranges::sort(samples);
+    const size_t n = samples.size();
+    result.minNs = samples.front();
+    result.medianNs = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    for (double sample : samples) {
+        result.meanNs += sample / n;
+    }
+    for (double sample : samples) {
+        result.stddevNs += (sample - result.meanNs) * (sample - result.meanNs) / n;
+    }
+    result.stddevNs = std::sqrt(result.stddevNs);
+    return result;
+}
+
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream ifs(path);
+    if (!ifs) {
+        Log::error(std::format("Failed to open {}", path.string()));
+    }
+    return {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+}
+
+// test/cases/*.c を名前順に連結する
+Corpus loadTestCases(const std::string& directory) {
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path().extension() == ".c") {
+            files.emplace_back(entry.path());
+        }
+    }
+    if (files.empty()) {
+        Log::error(std::format("No .c files in {}", directory));
+    }
+    std::ranges::sort(files);
+
+    Corpus corpus{.name = "test-cases", .source = {}};
+    for (const auto& file : files) {
+        corpus.source += readFile(file);
+        corpus.source += '\n';
+    }
+    return corpus;
+}
+
+// 算術・制御構文・配列・構造体を含む関数を count 個並べる
+Corpus generateSynthetic(int count) {
+    Corpus corpus{.name = "synthetic", .source = {}};
+    auto& out = corpus.source;
+    out += "struct point { int x; int y; long weight; };\n";
+    out += "int table[64];\n";
+    for (int i = 0; i < count; i++) {
+        out += std::format(R"(
+int synthetic{}(int n, struct point *p) {{
+    int sum = {};
+    long acc = 0;
+    int values[16];
+    for (int i = 0; i < 16; i++)
+        values[i] = (i * {} + n) % 7;
+    while (n > 0) {{
+        if (n % 3 == 0)
+            sum += values[n & 15] * 2 - table[n & 63];
+        else if (n % 5 == 1)
+            sum ^= (sum << 2) | (n >> 1);
+        else
+            sum = sum ? sum - 1 : {};
+        acc += p->x * p->y + p->weight;
+        n--;
+    }}
+    switch (sum & 3) {{
+    case 0: return sum + (int)acc;
+    case 1: return sum - {};
+    default: break;
+    }}
+    return sum * 3 + (acc > 100 ? 1 : 0);
+}}
+)",
+                           i, i, i % 11 + 1, i % 11 + 1, i);
+    }
+    return corpus;
+}
+
+uint64_t countTokens(const Token* token) {
+    uint64_t count = 0;
+    for (; token && token->kind != TokenKind::TERMINATOR; token = token->next.get()) {
+        count++;
+    }
+    return count;
+}
+
+uint64_t countNodes(const Node* node) {
+    uint64_t count = 0;
+    for (; node; node = node->next.get()) {
+        count++;
+        count += countNodes(node->left.get());
+        count += countNodes(node->right.get());
+        count += countNodes(node->condition.get());
+        count += countNodes(node->then.get());
+        count += countNodes(node->els.get());
+        count += countNodes(node->init.get());
+        count += countNodes(node->inc.get());
+        count += countNodes(node->body.get());
+        count += countNodes(node->arguments.get());
+    }
+    return count;
+}
+
+uint64_t countProgramNodes(const Object* program) {
+    uint64_t count = 0;
+    for (const Object* fn = program; fn; fn = fn->next.get()) {
+        if (fn->isFunction && fn->body) {
+            count += countNodes(fn->body.get());
+        }
+    }
+    return count;
+}
+
+// 型のついていない式木を作る。構文解析中に型がつくので addType だけを計測するために使う
+std::unique_ptr<Node> buildExpression(Object* variables, int variableCount, int depth, int& seed) {
+    const Token* token = nullptr;
+    if (depth == 0) {
+        seed = seed * 1103515245 + 12345;
+        int pick = (seed >> 16) & 0x7fff;
+        if (pick % 3 == 0) {
+            return createNumberNode(token, static_cast<int64_t>(pick));
+        }
+        Object* variable = variables;
+        for (int i = pick % variableCount; i > 0; i--) {
+            variable = variable->next.get();
+        }
+        return createVariableNode(token, variable);
+    }
+
+    static constexpr NodeType OPERATORS[] = {
+        NodeType::ADD, NodeType::SUB, NodeType::MUL, NodeType::BIT_AND, NodeType::BIT_XOR, NodeType::LESS,
+    };
+    seed = seed * 1103515245 + 12345;
+    auto op = OPERATORS[((seed >> 16) & 0x7fff) % std::size(OPERATORS)];
+    auto left = buildExpression(variables, variableCount, depth - 1, seed);
+    auto right = buildExpression(variables, variableCount, depth - 1, seed);
+    return createBinaryNode(op, token, std::move(left), std::move(right));
+}
+
+std::vector<Result> runBenchmarks(const Corpus& corpus, const Settings& settings) {
+    std::vector<Result> results;
+    auto name = [&corpus](std::string_view component) {
+        return std::format("{}/{}", component, corpus.name);
+    };
+    auto selected = [&settings](const std::string& benchmark) {
+        return settings.filter.empty() || benchmark.find(settings.filter) != std::string::npos;
+    };
+
+    if (selected(name("tokenize"))) {
+        results.emplace_back(measure(name("tokenize"), "tokens", settings.repetitions, {
+            .run = [&corpus] {
+                auto tokens = tokenize(corpus.source);
+                return countTokens(tokens.get());
+            },
+        }));
+    }
+
+    if (selected(name("parse"))) {
+        std::unique_ptr<Token> tokens;
+        results.emplace_back(measure(name("parse"), "nodes", settings.repetitions, {
+            .prepare = [&] { tokens = tokenize(corpus.source); },
+            .run = [&tokens] {
+                Parser parser{};
+                auto program = parser.parse(tokens.get());
+                return countProgramNodes(program.get());
+            },
+        }));
+    }
+
+    auto tokens = tokenize(corpus.source);
+    Parser parser{};
+    auto program = parser.parse(tokens.get());
+
+    if (selected(name("codegen"))) {
+        results.emplace_back(measure(name("codegen"), "lines", settings.repetitions, {
+            .run = [&program] {
+                Generator generator{};
+                return static_cast<uint64_t>(generator.run(program.get()).size());
+            },
+        }));
+    }
+
+    if (selected(name("assembly-writer"))) {
+        Generator generator{};
+        auto code = generator.run(program.get());
+        results.emplace_back(measure(name("assembly-writer"), "lines", settings.repetitions, {
+            .run = [&code] {
+                AssemblyWriter writer{};
+                writer.compile(code);
+                std::ostringstream oss;
+                for (const auto& line : writer.getCode()) {
+                    oss << line;
+                }
+                return static_cast<uint64_t>(writer.getCode().size());
+            },
+        }));
+    }
+    return results;
+}
+
+// 型付けは構文解析と同時に行われるので、コーパスとは別に型のない式木で計測する
+Result runAddTypeBenchmark(const Settings& settings) {
+    constexpr int VARIABLE_COUNT = 4;
+    constexpr int DEPTH = 12;
+    constexpr int TREES = 16;
+
+    std::unique_ptr<Object> variables;
+    std::shared_ptr<Type> types[VARIABLE_COUNT] = {type::intType(), type::longType(), type::charType(),
+                                                    type::uintType()};
+    for (int i = 0; i < VARIABLE_COUNT; i++) {
+        auto variable = std::make_unique<Object>();
+        variable->name = std::format("v{}", i);
+        variable->type = types[i];
+        variable->next = std::move(variables);
+        variables = std::move(variable);
+    }
+
+    std::vector<std::unique_ptr<Node>> trees;
+    return measure("addType/expression-trees", "nodes", settings.repetitions, {
+        .prepare = [&] {
+            trees.clear();
+            int seed = 1;
+            for (int i = 0; i < TREES; i++) {
+                trees.emplace_back(buildExpression(variables.get(), VARIABLE_COUNT, DEPTH, seed));
+            }
+        },
+        .run = [&trees] {
+            uint64_t count = 0;
+            for (auto& tree : trees) {
+                type::addType(tree.get());
+                count += countNodes(tree.get());
+            }
+            return count;
+        },
+    });
+}
+
+struct Baseline {
+    std::string label;
+    std::map<std::string, double> medianNs;
+};
+
+// writeJson が書いた形式だけを読む
+Baseline readBaseline(const std::string& path) {
+    Baseline baseline;
+    std::ifstream ifs(path);
+    if (!ifs) {
+        return baseline;
+    }
+    static const std::regex labelPattern{R"re("label": "([^"]*)")re"};
+    static const std::regex benchmarkPattern{R"re("name": "([^"]+)".*"median_ns": ([0-9.eE+-]+))re"};
+    std::string line;
+    while (std::getline(ifs, line)) {
+        std::smatch match;
+        if (std::regex_search(line, match, benchmarkPattern)) {
+            baseline.medianNs[match[1]] = std::stod(match[2]);
+        } else if (std::regex_search(line, match, labelPattern)) {
+            baseline.label = match[1];
+        }
+    }
+    return baseline;
+}
+
+void writeJson(const std::string& path, const std::vector<Result>& results, const Settings& settings) {
+    std::filesystem::path output{path};
+    if (output.has_parent_path()) {
+        std::filesystem::create_directories(output.parent_path());
+    }
+    std::ofstream ofs(path);
+    if (!ofs) {
+        Log::error(std::format("Failed to open {}", path));
+    }
+    ofs << std::format("{{\n  \"label\": \"{}\",\n  \"repetitions\": {},\n  \"benchmarks\": [\n", settings.label,
+                       settings.repetitions);
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        ofs << std::format(
+            "    {{\"name\": \"{}\", \"unit\": \"{}\", \"units\": {}, \"median_ns\": {:.0f}, \"min_ns\": {:.0f}, "
+            "\"stddev_ns\": {:.0f}, \"throughput\": {:.0f}}}{}\n",
+            r.name, r.unit, r.units, r.medianNs, r.minNs, r.stddevNs, r.throughput(),
+            i + 1 < results.size() ? "," : "");
+    }
+    ofs << "  ]\n}\n";
+}
+
+void printResults(const std::vector<Result>& results, const Baseline& baseline) {
+    if (!baseline.medianNs.empty()) {
+        std::println("baseline: {}", baseline.label.empty() ? "(unlabeled)" : baseline.label);
+    }
+    std::println("{:<34} {:>10} {:>12} {:>8} {:>16} {:>9}", "benchmark", "units", "median (ms)", "stddev",
+                 "throughput", "vs base");
+    for (const auto& r : results) {
+        std::string delta = "-";
+        if (auto it = baseline.medianNs.find(r.name); it != baseline.medianNs.end() && it->second > 0) {
+            // 正なら遅くなった
+            delta = std::format("{:+.1f}%", (r.medianNs / it->second - 1) * 100);
+        }
+        std::println("{:<34} {:>10} {:>12.3f} {:>7.1f}% {:>12.0f} {:<3} {:>9}", r.name, r.units, r.medianNs / 1e6,
+                     r.medianNs > 0 ? r.stddevNs / r.medianNs * 100 : 0.0, r.throughput(),
+                     std::format("{}/s", r.unit.substr(0, 1)), delta);
+    }
+}
+
+Settings parseSettings(int argc, char* argv[]) {
+    Settings settings{};
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                Log::error(std::format("{} requires a value", arg));
+            }
+            return argv[++i];
+        };
+        if (arg == "--corpus"sv) {
+            settings.corpusDirectory = value();
+        } else if (arg == "--output"sv) {
+            settings.output = value();
+        } else if (arg == "--baseline"sv) {
+            settings.baseline = value();
+        } else if (arg == "--label"sv) {
+            settings.label = value();
+        } else if (arg == "--filter"sv) {
+            settings.filter = value();
+        } else if (arg == "--repetitions"sv) {
+            settings.repetitions = std::max(1, std::stoi(value()));
+        } else if (arg == "--synthetic-functions"sv) {
+            settings.syntheticFunctions = std::max(1, std::stoi(value()));
+        } else {
+            Log::error(std::format("Unknown option: {}", arg));
+        }
+    }
+    return settings;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Settings settings = parseSettings(argc, argv);
+
+    std::vector<Result> results;
+    for (const auto& corpus : {loadTestCases(settings.corpusDirectory), generateSynthetic(settings.syntheticFunctions)}) {
+        Log::sourceFileName = corpus.name;
+        auto corpusResults = runBenchmarks(corpus, settings);
+        results.insert(results.end(), corpusResults.begin(), corpusResults.end());
+    }
+    if (settings.filter.empty() || std::string{"addType/expression-trees"}.find(settings.filter) != std::string::npos) {
+        results.emplace_back(runAddTypeBenchmark(settings));
+    }
+
+    auto baseline = settings.baseline.empty() ? Baseline{} : readBaseline(settings.baseline);
+    printResults(results, baseline);
+
+    if (!settings.output.empty()) {
+        writeJson(settings.output, results, settings);
+    }
+    return 0;
+}
@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+"""
+Scaling / complexity regression suite for YoctoCC.
+
+Generates synthetic sources that grow along one dimension at a time, compiles
+each size with `yoctocc -ftime-report`, fits log(time) = k * log(size) + c and
+fails when the measured exponent k exceeds the limit for that dimension.
+
+Usage:
+    python3 bench/scaling/run_scaling.py                # All dimensions
+    python3 bench/scaling/run_scaling.py goto globals   # Dimensions matching filters (OR)
+
+Environment:
+    SCALING_REPEAT=3     Runs per size (the minimum is used)
+    SCALING_SCALE=1      Multiplier for all input sizes
+"""
+
+import math
+import os
+import re
+import subprocess
+import sys
+import tempfile
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Callable, List
+
+# --- Configuration ---
+
+REPEAT = int(os.environ.get("SCALING_REPEAT", "3"))
+SCALE = float(os.environ.get("SCALING_SCALE", "1"))
+FILTERS = sys.argv[1:]
+
+SCRIPT_DIR = Path(__file__).resolve().parent
+PROJECT_ROOT = SCRIPT_DIR.parent.parent
+COMPILER = PROJECT_ROOT / "build" / "yoctocc"
+
+
+class C:
+    GREEN, RED, YELLOW, NC = "\033[0;32m", "\033[0;31m", "\033[1;33m", "\033[0m"
+
+
+# --- Synthetic sources (one growing dimension each) ---
+
+
+def globals_source(n: int) -> str:
+    """n global variables, each referenced once."""
+    lines = [f"int g{i} = {i % 100};" for i in range(n)]
+    lines.append("int main() {")
+    lines.append("    int sum = 0;")
+    lines += [f"    sum += g{i};" for i in range(n)]
+    lines.append("    return sum;")
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+def locals_source(n: int) -> str:
+    """One function with n local variables, each referenced once."""
+    lines = ["int main() {"]
+    lines += [f"    int v{i} = {i % 100};" for i in range(n)]
+    lines.append("    int sum = 0;")
+    lines += [f"    sum += v{i};" for i in range(n)]
+    lines.append("    return sum;")
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+def goto_source(n: int) -> str:
+    """One function with n labels and n gotos."""
+    lines = ["int main() {", "    int x = 0;"]
+    for i in range(n):
+        lines.append(f"    if (x == {i}) goto L{i};")
+    for i in range(n):
+        lines.append(f"L{i}:")
+        lines.append("    x++;")
+    lines.append("    return x;")
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+def nesting_source(n: int) -> str:
+    """Blocks nested n deep."""
+    lines = ["int main() {", "    int x = 0;"]
+    lines += ["    if (x < 1000) {"] * n
+    lines.append("    x++;")
+    lines += ["    }"] * n
+    lines.append("    return x;")
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+def functions_source(n: int) -> str:
+    """n small functions, each called from main."""
+    lines = [f"int f{i}(int x) {{ return x + {i % 100}; }}" for i in range(n)]
+    lines.append("int main() {")
+    lines.append("    int sum = 0;")
+    lines += [f"    sum = f{i}(sum);" for i in range(n)]
+    lines.append("    return sum;")
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+def expression_source(n: int) -> str:
+    """A single expression with n operands."""
+    operands = " + ".join(f"x * {i % 100}" for i in range(n))
+    return f"int main() {{\n    int x = 1;\n    return {operands};\n}}\n"
+
+
+def initializer_source(n: int) -> str:
+    """A global array initialized with n elements."""
+    values = ", ".join(str(i % 100) for i in range(n))
+    return f"int table[{n}] = {{{values}}};\nint main() {{\n    return table[{n - 1}];\n}}\n"
+
+
+@dataclass
+class Dimension:
+    name: str
+    generate: Callable[[int], str]
+    sizes: List[int]
+    # 許容する指数 (時間 ∝ size^max_exponent まで)
+    max_exponent: float
+    note: str = ""
+
+
+# 上限は次元ごとに、いま測った指数 (デバッグビルド) に計測のばらつきの分だけ足したもの。
+# 線形から二乗への悪化なら指数が 1 近く増えるので必ず超える。改善したら上限も下げること。
+LINEAR = 1.3
+
+DIMENSIONS = [
+    # 実測 1.4
+    Dimension("globals", globals_source, [1000, 2000, 4000, 8000], 1.6,
+              "ParseScope::findVariable walks the scope chain linearly"),
+    # 実測 1.4
+    Dimension("locals", locals_source, [1000, 2000, 4000, 8000], 1.6,
+              "ParseScope::findVariable walks the scope chain linearly"),
+    # 実測 1.1
+    Dimension("goto", goto_source, [500, 1000, 2000, 4000], 1.3,
+              "resolveGotoLabels compares every goto with every label"),
+    # 実測 1.6
+    Dimension("nesting", nesting_source, [250, 500, 1000, 2000], 1.8,
+              "every nested scope is searched on lookup"),
+    # 実測 1.3
+    Dimension("functions", functions_source, [500, 1000, 2000, 4000], 1.5,
+              "Parser::isFunction re-parses declarators"),
+    # 式は再帰下降とコード生成の再帰が深くなるので、デバッグビルドでもスタックに収まる大きさにする
+    Dimension("expression", expression_source, [100, 200, 400, 800], LINEAR),
+    Dimension("initializer", initializer_source, [2500, 5000, 10000, 20000], LINEAR),
+]
+
+
+# --- Measurement ---
+
+TOTAL_PATTERN = re.compile(r"^total\s+([0-9.]+)", re.MULTILINE)
+
+
+def compile_time(source: Path, output: Path) -> float:
+    """Returns the compiler's own total wall time (ms) from -ftime-report, excluding process startup."""
+    best = math.inf
+    for _ in range(REPEAT):
+        result = subprocess.run(
+            [str(COMPILER), "-ftime-report", str(source), str(output)],
+            capture_output=True,
+            text=True,
+        )
+        if result.returncode < 0:
+            raise RuntimeError(f"yoctocc crashed on {source.name} (signal {-result.returncode}, stack overflow?)")
+        if result.returncode != 0:
+            raise RuntimeError(f"yoctocc failed on {source.name}:\n{result.stderr}")
+        match = TOTAL_PATTERN.search(result.stderr)
+        if not match:
+            raise RuntimeError(f"no time report for {source.name}")
+        best = min(best, float(match.group(1)))
+    return best
+
+
+def fit_exponent(sizes: List[int], times: List[float]) -> float:
+    """Least-squares slope of log(time) against log(size)."""
+    xs = [math.log(s) for s in sizes]
+    ys = [math.log(max(t, 1e-3)) for t in times]
+    mx = sum(xs) / len(xs)
+    my = sum(ys) / len(ys)
+    numerator = sum((x - mx) * (y - my) for x, y in zip(xs, ys))
+    denominator = sum((x - mx) ** 2 for x in xs)
+    return numerator / denominator
+
+
+def main() -> int:
+    if not COMPILER.exists():
+        print(f"{C.RED}Error: {COMPILER} not found. Run `make` first.{C.NC}")
+        return 1
+
+    dimensions = [d for d in DIMENSIONS if not FILTERS or any(f in d.name for f in FILTERS)]
+    failures = []
+
+    with tempfile.TemporaryDirectory(prefix="yoctocc-scaling-") as tmp:
+        tmpdir = Path(tmp)
+        output = tmpdir / "out.s"
+        for dimension in dimensions:
+            sizes = [max(1, int(size * SCALE)) for size in dimension.sizes]
+            times = []
+            try:
+                for size in sizes:
+                    source = tmpdir / f"{dimension.name}_{size}.c"
+                    source.write_text(dimension.generate(size))
+                    times.append(compile_time(source, output))
+            except RuntimeError as error:
+                print(f"{dimension.name:<12} {C.RED}FAIL{C.NC}  {error}")
+                failures.append(dimension)
+                continue
+
+            exponent = fit_exponent(sizes, times)
+            ok = exponent <= dimension.max_exponent
+            status = f"{C.GREEN}OK{C.NC}" if ok else f"{C.RED}FAIL{C.NC}"
+            samples = "  ".join(f"{s}:{t:.1f}ms" for s, t in zip(sizes, times))
+            print(f"{dimension.name:<12} exponent {exponent:5.2f} (limit {dimension.max_exponent:.2f}) {status}  {samples}")
+            if not ok:
+                failures.append(dimension)
+                if dimension.note:
+                    print(f"{C.YELLOW}    hint: {dimension.note}{C.NC}")
+
+    if failures:
+        print(f"{C.RED}Superlinear growth in: {', '.join(d.name for d in failures)}{C.NC}")
+        return 1
+    print(f"{C.GREEN}All dimensions scale within limits{C.NC}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
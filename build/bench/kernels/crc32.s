@@ -0,0 +1,467 @@
+.file 1 "/root/repo/bench/kernels/crc32.c"
+.intel_syntax  noprefix
+.text
+
+# ===== Generated Code Start =====
+
+.local .L..10
+.align 1
+.data
+.L..10:
+.byte 37
+.byte 117
+.byte 10
+.byte 0
+.globl data
+.align 1
+.bss
+data:
+.zero 65536
+.globl table
+.align 4
+.bss
+table:
+.zero 1024
+.globl main
+.text
+main:
+push rbp
+mov rbp, rsp
+sub rsp, 224
+mov DWORD PTR [rbp - 212], 0
+mov DWORD PTR [rbp - 208], 48
+movq [rbp - 196], rbp
+addq [rbp - 196], -188
+movq [rbp - 188], rdi
+movq [rbp - 180], rsi
+movq [rbp - 172], rdx
+movq [rbp - 164], rcx
+movq [rbp - 156], r8
+movq [rbp - 148], r9
+movsd [rbp - 140], xmm0
+movsd [rbp - 132], xmm1
+movsd [rbp - 124], xmm2
+movsd [rbp - 116], xmm3
+movsd [rbp - 108], xmm4
+movsd [rbp - 100], xmm5
+movsd [rbp - 92], xmm6
+movsd [rbp - 84], xmm7
+.loc 1 8 
+mov rcx, 4
+lea rdi, [rbp - 76]
+mov al, 0
+rep stosb
+lea rax, [rbp - 76]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.0:
+mov rax, 256
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setb al
+movzx rax, al
+cmp eax, 0
+je .L..0
+.loc 1 9 
+mov rcx, 4
+lea rdi, [rbp - 64]
+mov al, 0
+rep stosb
+lea rax, [rbp - 64]
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 10 
+mov rcx, 4
+lea rdi, [rbp - 60]
+mov al, 0
+rep stosb
+lea rax, [rbp - 60]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.1:
+mov rax, 8
+push rax
+lea rax, [rbp - 60]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..2
+.loc 1 11 
+lea rax, [rbp - 64]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 64]
+movsxd rax, [rax]
+pop rdi
+and eax, edi
+cmp eax, 0
+je .L.else.2
+mov rax, 1
+push rax
+lea rax, [rbp - 64]
+movsxd rax, [rax]
+pop rdi
+mov rcx, rdi
+shr eax, cl
+push rax
+mov rax, 3988292384
+pop rdi
+xor eax, edi
+jmp .L.end.2
+.L.else.2:
+mov rax, 1
+push rax
+lea rax, [rbp - 64]
+movsxd rax, [rax]
+pop rdi
+mov rcx, rdi
+shr eax, cl
+.L.end.2:
+pop rdi
+mov [rdi], eax
+.L..3:
+.loc 1 10 
+mov rax, -1
+push rax
+lea rax, [rbp - 56]
+push rax
+lea rax, [rbp - 60]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 56]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 56]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.1
+.L..2:
+.loc 1 12 
+mov rax, 4
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+mov eax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + table]
+pop rdi
+add rax, rdi
+push rax
+lea rax, [rbp - 64]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.L..1:
+.loc 1 8 
+mov rax, -1
+push rax
+lea rax, [rbp - 72]
+push rax
+lea rax, [rbp - 76]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 72]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 72]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.0
+.L..0:
+.loc 1 14 
+mov rcx, 4
+lea rdi, [rbp - 44]
+mov al, 0
+rep stosb
+lea rax, [rbp - 44]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.3:
+mov rax, 65536
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..4
+.loc 1 15 
+mov rax, 1
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + data]
+pop rdi
+add rax, rdi
+push rax
+mov rax, 8
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+pop rdi
+mov rcx, rdi
+sar eax, cl
+push rax
+mov rax, 31
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+pop rdi
+imul eax, edi
+pop rdi
+add eax, edi
+movsx eax, al
+pop rdi
+mov [rdi], al
+.L..5:
+.loc 1 14 
+mov rax, -1
+push rax
+lea rax, [rbp - 40]
+push rax
+lea rax, [rbp - 44]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.3
+.L..4:
+.loc 1 17 
+mov rcx, 4
+lea rdi, [rbp - 32]
+mov al, 0
+rep stosb
+lea rax, [rbp - 32]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.loc 1 18 
+mov rcx, 4
+lea rdi, [rbp - 28]
+mov al, 0
+rep stosb
+lea rax, [rbp - 28]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.4:
+mov rax, 256
+push rax
+lea rax, [rbp - 28]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..6
+.loc 1 19 
+lea rax, [rbp - 32]
+push rax
+lea rax, [rbp - 32]
+movsxd rax, [rax]
+not rax
+pop rdi
+mov [rdi], eax
+.loc 1 20 
+mov rcx, 4
+lea rdi, [rbp - 12]
+mov al, 0
+rep stosb
+lea rax, [rbp - 12]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.5:
+mov rax, 65536
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..8
+.loc 1 21 
+lea rax, [rbp - 32]
+push rax
+mov rax, 8
+push rax
+lea rax, [rbp - 32]
+movsxd rax, [rax]
+pop rdi
+mov rcx, rdi
+shr eax, cl
+push rax
+mov rax, 4
+push rax
+mov rax, 255
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + data]
+pop rdi
+add rax, rdi
+movsx eax, BYTE PTR [rax]
+push rax
+lea rax, [rbp - 32]
+movsxd rax, [rax]
+pop rdi
+xor eax, edi
+pop rdi
+and eax, edi
+mov eax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + table]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+xor eax, edi
+pop rdi
+mov [rdi], eax
+.L..9:
+.loc 1 20 
+mov rax, -1
+push rax
+lea rax, [rbp - 8]
+push rax
+lea rax, [rbp - 12]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.5
+.L..8:
+.loc 1 22 
+lea rax, [rbp - 32]
+push rax
+lea rax, [rbp - 32]
+movsxd rax, [rax]
+not rax
+pop rdi
+mov [rdi], eax
+.L..7:
+.loc 1 18 
+mov rax, -1
+push rax
+lea rax, [rbp - 24]
+push rax
+lea rax, [rbp - 28]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 24]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 24]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.4
+.L..6:
+.loc 1 24 
+lea rax, [rbp - 32]
+movsxd rax, [rax]
+push rax
+lea rax, [rip + .L..10]
+push rax
+pop rdi
+pop rsi
+call printf
+.loc 1 25 
+mov rax, 0
+jmp .L.return.main
+.L.return.main:
+mov rsp, rbp
+pop rbp
+ret
+
+# ===== Generated Code End =====
+
+return:    mov rdi, rax
+    mov rax, 60
+    syscall
+.section .note.GNU-stack,"",@progbits
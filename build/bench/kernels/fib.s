@@ -0,0 +1,66 @@
+.file 1 "/root/repo/bench/kernels/fib.c"
+.intel_syntax  noprefix
+.text
+
+# ===== Generated Code Start =====
+
+.local .L..0
+.align 1
+.data
+.L..0:
+.byte 37
+.byte 100
+.byte 10
+.byte 0
+.globl main
+.text
+main:
+sub rsp, 8
+.loc 1 11 
+mov edi, 35
+call fib
+mov rsi, rax
+lea rdi, [rip + .L..0]
+mov eax, 0
+call printf
+.loc 1 12 
+xor eax, eax
+add rsp, 8
+ret
+.globl fib
+.text
+fib:
+cmp edi, 2
+jl .L.bb.fib.1
+push rbx
+push r12
+sub rsp, 8
+mov rbx, rdi
+.L.bb.fib.2:
+.loc 1 7 
+mov rsi, rbx
+sub esi, 2
+mov rdi, rsi
+call fib
+mov r12, rax
+mov rsi, rbx
+sub esi, 1
+mov rdi, rsi
+call fib
+mov rsi, rax
+add esi, r12d
+mov rax, rsi
+add rsp, 8
+pop r12
+pop rbx
+ret
+.L.bb.fib.1:
+mov rax, rdi
+ret
+
+# ===== Generated Code End =====
+
+return:    mov rdi, rax
+    mov rax, 60
+    syscall
+.section .note.GNU-stack,"",@progbits
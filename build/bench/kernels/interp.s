@@ -0,0 +1,998 @@
+.file 1 "/root/repo/bench/kernels/interp.c"
+.intel_syntax  noprefix
+.text
+
+# ===== Generated Code Start =====
+
+.local .L..13
+.align 1
+.data
+.L..13:
+.byte 37
+.byte 100
+.byte 10
+.byte 0
+.globl length
+.align 4
+.bss
+length:
+.zero 4
+.globl code
+.align 4
+.bss
+code:
+.zero 256
+.globl main
+.text
+main:
+push rbp
+mov rbp, rsp
+sub rsp, 144
+mov DWORD PTR [rbp - 136], 0
+mov DWORD PTR [rbp - 132], 48
+movq [rbp - 120], rbp
+addq [rbp - 120], -112
+movq [rbp - 112], rdi
+movq [rbp - 104], rsi
+movq [rbp - 96], rdx
+movq [rbp - 88], rcx
+movq [rbp - 80], r8
+movq [rbp - 72], r9
+movsd [rbp - 64], xmm0
+movsd [rbp - 56], xmm1
+movsd [rbp - 48], xmm2
+movsd [rbp - 40], xmm3
+movsd [rbp - 32], xmm4
+movsd [rbp - 24], xmm5
+movsd [rbp - 16], xmm6
+movsd [rbp - 8], xmm7
+.loc 1 54 
+mov rax, 1000000
+push rax
+pop rdi
+call assemble
+.loc 1 55 
+call run
+push rax
+lea rax, [rip + .L..13]
+push rax
+pop rdi
+pop rsi
+call printf
+.loc 1 56 
+mov rax, 0
+jmp .L.return.main
+.L.return.main:
+mov rsp, rbp
+pop rbp
+ret
+.globl run
+.text
+run:
+push rbp
+mov rbp, rsp
+sub rsp, 304
+mov DWORD PTR [rbp - 304], 0
+mov DWORD PTR [rbp - 300], 48
+movq [rbp - 288], rbp
+addq [rbp - 288], -280
+movq [rbp - 280], rdi
+movq [rbp - 272], rsi
+movq [rbp - 264], rdx
+movq [rbp - 256], rcx
+movq [rbp - 248], r8
+movq [rbp - 240], r9
+movsd [rbp - 232], xmm0
+movsd [rbp - 224], xmm1
+movsd [rbp - 216], xmm2
+movsd [rbp - 208], xmm3
+movsd [rbp - 200], xmm4
+movsd [rbp - 192], xmm5
+movsd [rbp - 184], xmm6
+movsd [rbp - 176], xmm7
+.loc 1 30 
+.loc 1 31 
+.loc 1 32 
+mov rcx, 4
+lea rdi, [rbp - 88]
+mov al, 0
+rep stosb
+lea rax, [rbp - 88]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.loc 1 33 
+mov rcx, 4
+lea rdi, [rbp - 84]
+mov al, 0
+rep stosb
+lea rax, [rbp - 84]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.loc 1 34 
+.L.begin.0:
+.loc 1 35 
+mov rcx, 4
+lea rdi, [rbp - 80]
+mov al, 0
+rep stosb
+lea rax, [rbp - 80]
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 84]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + code]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 36 
+mov rcx, 4
+lea rdi, [rbp - 76]
+mov al, 0
+rep stosb
+lea rax, [rbp - 76]
+push rax
+mov rax, 4
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 84]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + code]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 37 
+lea rax, [rbp - 72]
+push rax
+lea rax, [rbp - 84]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 72]
+mov rax, [rax]
+push rax
+mov rax, 2
+push rax
+lea rax, [rbp - 72]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+.loc 1 38 
+lea rax, [rbp - 80]
+movsxd rax, [rax]
+cmp eax, 9
+je .L..12
+cmp eax, 8
+je .L..11
+cmp eax, 7
+je .L..10
+cmp eax, 6
+je .L..9
+cmp eax, 5
+je .L..8
+cmp eax, 4
+je .L..7
+cmp eax, 3
+je .L..6
+cmp eax, 2
+je .L..5
+cmp eax, 1
+je .L..4
+cmp eax, 0
+je .L..3
+jmp .L..2
+.loc 1 39 
+.L..3:
+mov rax, 4
+push rax
+mov rax, -1
+push rax
+lea rax, [rbp - 64]
+push rax
+lea rax, [rbp - 88]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+jmp .L..2
+.loc 1 40 
+.L..4:
+mov rax, 4
+push rax
+mov rax, -1
+push rax
+lea rax, [rbp - 56]
+push rax
+lea rax, [rbp - 88]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 56]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 56]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 104]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+jmp .L..2
+.loc 1 41 
+.L..5:
+mov rax, 4
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 104]
+pop rdi
+add rax, rdi
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 48]
+push rax
+lea rax, [rbp - 88]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 48]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 48]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+pop rdi
+mov [rdi], eax
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+jmp .L..2
+.loc 1 42 
+.L..6:
+mov rax, 1
+push rax
+lea rax, [rbp - 40]
+push rax
+lea rax, [rbp - 88]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+push rax
+mov rax, -1
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+mov rax, 4
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+push rax
+mov rax, 4
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+jmp .L..2
+.loc 1 43 
+.L..7:
+mov rax, 1
+push rax
+lea rax, [rbp - 32]
+push rax
+lea rax, [rbp - 88]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 32]
+mov rax, [rax]
+push rax
+mov rax, -1
+push rax
+lea rax, [rbp - 32]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+mov rax, 4
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+push rax
+mov rax, 4
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+pop rdi
+mov [rdi], eax
+jmp .L..2
+.loc 1 44 
+.L..8:
+mov rax, 1
+push rax
+lea rax, [rbp - 24]
+push rax
+lea rax, [rbp - 88]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 24]
+mov rax, [rax]
+push rax
+mov rax, -1
+push rax
+lea rax, [rbp - 24]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+mov rax, 4
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+push rax
+mov rax, 4
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+imul eax, edi
+pop rdi
+mov [rdi], eax
+jmp .L..2
+.loc 1 45 
+.L..9:
+mov rax, 1
+push rax
+lea rax, [rbp - 16]
+push rax
+lea rax, [rbp - 88]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 16]
+mov rax, [rax]
+push rax
+mov rax, -1
+push rax
+lea rax, [rbp - 16]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+mov rax, 4
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+push rax
+mov rax, 4
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 88]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+pop rdi
+mov [rdi], eax
+jmp .L..2
+.loc 1 46 
+.L..10:
+mov rax, 4
+push rax
+lea rax, [rbp - 8]
+push rax
+lea rax, [rbp - 88]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+pop rdi
+mov [rdi], eax
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 168]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+cmp eax, 0
+sete al
+movzx rax, al
+cmp eax, 0
+je .L.else.1
+lea rax, [rbp - 84]
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+jmp .L.end.1
+.L.else.1:
+.L.end.1:
+jmp .L..2
+.loc 1 47 
+.L..11:
+lea rax, [rbp - 84]
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+jmp .L..2
+.loc 1 48 
+.L..12:
+mov rax, 4
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 104]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+jmp .L.return.run
+.L..2:
+.L..1:
+jmp .L.begin.0
+.L..0:
+.L.return.run:
+mov rsp, rbp
+pop rbp
+ret
+.globl assemble
+.text
+assemble:
+push rbp
+mov rbp, rsp
+sub rsp, 16
+mov [rbp - 12], edi
+.loc 1 16 
+mov rax, 0
+push rax
+mov rax, 0
+push rax
+pop rdi
+pop rsi
+call emit
+mov rax, 0
+push rax
+mov rax, 2
+push rax
+pop rdi
+pop rsi
+call emit
+.loc 1 17 
+mov rax, 0
+push rax
+mov rax, 0
+push rax
+pop rdi
+pop rsi
+call emit
+mov rax, 1
+push rax
+mov rax, 2
+push rax
+pop rdi
+pop rsi
+call emit
+.loc 1 18 
+mov rcx, 4
+lea rdi, [rbp - 8]
+mov al, 0
+rep stosb
+lea rax, [rbp - 8]
+push rax
+lea rax, [rip + length]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 19 
+mov rax, 0
+push rax
+mov rax, 1
+push rax
+pop rdi
+pop rsi
+call emit
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+push rax
+mov rax, 0
+push rax
+pop rdi
+pop rsi
+call emit
+mov rax, 0
+push rax
+mov rax, 6
+push rax
+pop rdi
+pop rsi
+call emit
+.loc 1 20 
+mov rcx, 4
+lea rdi, [rbp - 4]
+mov al, 0
+rep stosb
+lea rax, [rbp - 4]
+push rax
+lea rax, [rip + length]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 21 
+mov rax, 0
+push rax
+mov rax, 7
+push rax
+pop rdi
+pop rsi
+call emit
+.loc 1 22 
+mov rax, 1
+push rax
+mov rax, 1
+push rax
+pop rdi
+pop rsi
+call emit
+mov rax, 0
+push rax
+mov rax, 1
+push rax
+pop rdi
+pop rsi
+call emit
+mov rax, 3
+push rax
+mov rax, 0
+push rax
+pop rdi
+pop rsi
+call emit
+mov rax, 0
+push rax
+mov rax, 5
+push rax
+pop rdi
+pop rsi
+call emit
+mov rax, 0
+push rax
+mov rax, 3
+push rax
+pop rdi
+pop rsi
+call emit
+mov rax, 1
+push rax
+mov rax, 2
+push rax
+pop rdi
+pop rsi
+call emit
+.loc 1 23 
+mov rax, 0
+push rax
+mov rax, 1
+push rax
+pop rdi
+pop rsi
+call emit
+mov rax, 1
+push rax
+mov rax, 0
+push rax
+pop rdi
+pop rsi
+call emit
+mov rax, 0
+push rax
+mov rax, 3
+push rax
+pop rdi
+pop rsi
+call emit
+mov rax, 0
+push rax
+mov rax, 2
+push rax
+pop rdi
+pop rsi
+call emit
+.loc 1 24 
+lea rax, [rbp - 8]
+movsxd rax, [rax]
+push rax
+mov rax, 8
+push rax
+pop rdi
+pop rsi
+call emit
+.loc 1 25 
+mov rax, 4
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 4]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + code]
+pop rdi
+add rax, rdi
+push rax
+lea rax, [rip + length]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 26 
+mov rax, 0
+push rax
+mov rax, 9
+push rax
+pop rdi
+pop rsi
+call emit
+.L.return.assemble:
+mov rsp, rbp
+pop rbp
+ret
+.globl emit
+.text
+emit:
+push rbp
+mov rbp, rsp
+sub rsp, 32
+mov [rbp - 20], edi
+mov [rbp - 24], esi
+.loc 1 10 
+mov rax, 4
+push rax
+mov rax, -1
+push rax
+lea rax, [rbp - 16]
+push rax
+lea rax, [rip + length]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 16]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 16]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + code]
+pop rdi
+add rax, rdi
+push rax
+lea rax, [rbp - 20]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 11 
+mov rax, 4
+push rax
+mov rax, -1
+push rax
+lea rax, [rbp - 8]
+push rax
+lea rax, [rip + length]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + code]
+pop rdi
+add rax, rdi
+push rax
+lea rax, [rbp - 24]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.L.return.emit:
+mov rsp, rbp
+pop rbp
+ret
+
+# ===== Generated Code End =====
+
+return:    mov rdi, rax
+    mov rax, 60
+    syscall
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,465 @@
+.file 1 "/root/repo/bench/kernels/linkedlist.c"
+.intel_syntax  noprefix
+.text
+
+# ===== Generated Code Start =====
+
+.local .L..6
+.align 1
+.data
+.L..6:
+.byte 37
+.byte 108
+.byte 100
+.byte 10
+.byte 0
+.globl main
+.text
+main:
+push rbp
+mov rbp, rsp
+sub rsp, 240
+mov DWORD PTR [rbp - 228], 0
+mov DWORD PTR [rbp - 224], 48
+movq [rbp - 212], rbp
+addq [rbp - 212], -204
+movq [rbp - 204], rdi
+movq [rbp - 196], rsi
+movq [rbp - 188], rdx
+movq [rbp - 180], rcx
+movq [rbp - 172], r8
+movq [rbp - 164], r9
+movsd [rbp - 156], xmm0
+movsd [rbp - 148], xmm1
+movsd [rbp - 140], xmm2
+movsd [rbp - 132], xmm3
+movsd [rbp - 124], xmm4
+movsd [rbp - 116], xmm5
+movsd [rbp - 108], xmm6
+movsd [rbp - 100], xmm7
+.loc 1 13 
+mov rcx, 4
+lea rdi, [rbp - 92]
+mov al, 0
+rep stosb
+lea rax, [rbp - 92]
+push rax
+mov rax, 20000
+pop rdi
+mov [rdi], eax
+.loc 1 14 
+mov rcx, 8
+lea rdi, [rbp - 88]
+mov al, 0
+rep stosb
+lea rax, [rbp - 88]
+push rax
+mov rax, 24
+push rax
+lea rax, [rbp - 92]
+movsxd rax, [rax]
+movsxd rax, eax
+push rax
+pop rdi
+pop rsi
+sub rsp, 8
+call calloc
+add rsp, 8
+pop rdi
+mov [rdi], rax
+.loc 1 16 
+mov rcx, 4
+lea rdi, [rbp - 76]
+mov al, 0
+rep stosb
+lea rax, [rbp - 76]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.0:
+lea rax, [rbp - 92]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..0
+.loc 1 17 
+mov rax, 24
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 88]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+add rax, 8
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 18 
+mov rax, 24
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 88]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+add rax, 12
+push rax
+mov rax, 97
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+pop rdi
+cdq
+idiv edi
+mov rax, rdx
+pop rdi
+mov [rdi], eax
+.loc 1 19 
+mov rax, 24
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 88]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+add rax, 16
+push rax
+mov rax, 3
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+pop rdi
+imul eax, edi
+movsxd rax, eax
+pop rdi
+mov [rdi], rax
+.loc 1 20 
+mov rax, 24
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 88]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+add rax, 0
+push rax
+mov rax, 24
+push rax
+lea rax, [rbp - 92]
+movsxd rax, [rax]
+push rax
+mov rax, 7919
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+cdq
+idiv edi
+mov rax, rdx
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 88]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+pop rdi
+mov [rdi], rax
+.L..1:
+.loc 1 16 
+mov rax, -1
+push rax
+lea rax, [rbp - 72]
+push rax
+lea rax, [rbp - 76]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 72]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 72]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.0
+.L..0:
+.loc 1 23 
+mov rcx, 8
+lea rdi, [rbp - 64]
+mov al, 0
+rep stosb
+lea rax, [rbp - 64]
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+mov [rdi], rax
+.loc 1 24 
+mov rcx, 4
+lea rdi, [rbp - 52]
+mov al, 0
+rep stosb
+lea rax, [rbp - 52]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.1:
+mov rax, 1000
+push rax
+lea rax, [rbp - 52]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..2
+.loc 1 25 
+mov rcx, 8
+lea rdi, [rbp - 40]
+mov al, 0
+rep stosb
+lea rax, [rbp - 40]
+push rax
+mov rax, 24
+push rax
+lea rax, [rbp - 52]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 88]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+pop rdi
+mov [rdi], rax
+.loc 1 26 
+mov rcx, 4
+lea rdi, [rbp - 28]
+mov al, 0
+rep stosb
+lea rax, [rbp - 28]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.2:
+lea rax, [rbp - 92]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 28]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..4
+.loc 1 27 
+mov rax, 1
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+add rax, 8
+movsxd rax, [rax]
+pop rdi
+and eax, edi
+cmp eax, 0
+je .L.else.3
+.loc 1 28 
+lea rax, [rbp - 16]
+push rax
+lea rax, [rbp - 64]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 16]
+mov rax, [rax]
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+add rax, 12
+movsxd rax, [rax]
+movsxd rax, eax
+push rax
+lea rax, [rbp - 16]
+mov rax, [rax]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+pop rdi
+mov [rdi], rax
+jmp .L.end.3
+.L.else.3:
+.loc 1 30 
+lea rax, [rbp - 8]
+push rax
+lea rax, [rbp - 64]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+add rax, 16
+mov rax, [rax]
+pop rdi
+mov rcx, rdi
+sar rax, cl
+push rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+pop rdi
+mov [rdi], rax
+.L.end.3:
+.loc 1 31 
+lea rax, [rbp - 40]
+mov rax, [rax]
+add rax, 12
+push rax
+mov rax, 97
+push rax
+lea rax, [rbp - 52]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+add rax, 12
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+cdq
+idiv edi
+mov rax, rdx
+pop rdi
+mov [rdi], eax
+.loc 1 32 
+lea rax, [rbp - 40]
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+add rax, 0
+mov rax, [rax]
+pop rdi
+mov [rdi], rax
+.L..5:
+.loc 1 26 
+mov rax, -1
+push rax
+lea rax, [rbp - 24]
+push rax
+lea rax, [rbp - 28]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 24]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 24]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.2
+.L..4:
+.L..3:
+.loc 1 24 
+mov rax, -1
+push rax
+lea rax, [rbp - 48]
+push rax
+lea rax, [rbp - 52]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 48]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 48]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.1
+.L..2:
+.loc 1 35 
+lea rax, [rbp - 64]
+mov rax, [rax]
+push rax
+lea rax, [rip + .L..6]
+push rax
+pop rdi
+pop rsi
+call printf
+.loc 1 36 
+mov rax, 0
+jmp .L.return.main
+.L.return.main:
+mov rsp, rbp
+pop rbp
+ret
+
+# ===== Generated Code End =====
+
+return:    mov rdi, rax
+    mov rax, 60
+    syscall
+.section .note.GNU-stack,"",@progbits
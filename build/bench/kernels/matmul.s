@@ -0,0 +1,688 @@
+.file 1 "/root/repo/bench/kernels/matmul.c"
+.intel_syntax  noprefix
+.text
+
+# ===== Generated Code Start =====
+
+.local .L..14
+.align 1
+.data
+.L..14:
+.byte 37
+.byte 108
+.byte 100
+.byte 10
+.byte 0
+.globl c
+.align 4
+.bss
+c:
+.zero 65536
+.globl b
+.align 4
+.bss
+b:
+.zero 65536
+.globl a
+.align 4
+.bss
+a:
+.zero 65536
+.globl main
+.text
+main:
+push rbp
+mov rbp, rsp
+sub rsp, 272
+mov DWORD PTR [rbp - 272], 0
+mov DWORD PTR [rbp - 268], 48
+movq [rbp - 256], rbp
+addq [rbp - 256], -248
+movq [rbp - 248], rdi
+movq [rbp - 240], rsi
+movq [rbp - 232], rdx
+movq [rbp - 224], rcx
+movq [rbp - 216], r8
+movq [rbp - 208], r9
+movsd [rbp - 200], xmm0
+movsd [rbp - 192], xmm1
+movsd [rbp - 184], xmm2
+movsd [rbp - 176], xmm3
+movsd [rbp - 168], xmm4
+movsd [rbp - 160], xmm5
+movsd [rbp - 152], xmm6
+movsd [rbp - 144], xmm7
+.loc 1 9 
+mov rcx, 4
+lea rdi, [rbp - 136]
+mov al, 0
+rep stosb
+lea rax, [rbp - 136]
+push rax
+mov rax, 128
+pop rdi
+mov [rdi], eax
+.loc 1 10 
+mov rcx, 4
+lea rdi, [rbp - 132]
+mov al, 0
+rep stosb
+lea rax, [rbp - 132]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.0:
+lea rax, [rbp - 136]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 132]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..0
+.loc 1 11 
+mov rcx, 4
+lea rdi, [rbp - 116]
+mov al, 0
+rep stosb
+lea rax, [rbp - 116]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.1:
+lea rax, [rbp - 136]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 116]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..2
+.loc 1 12 
+mov rax, 4
+push rax
+lea rax, [rbp - 116]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 512
+push rax
+lea rax, [rbp - 132]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + a]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+mov rax, 8
+push rax
+mov rax, 17
+push rax
+mov rax, 3
+push rax
+lea rax, [rbp - 116]
+movsxd rax, [rax]
+pop rdi
+imul eax, edi
+push rax
+mov rax, 7
+push rax
+lea rax, [rbp - 132]
+movsxd rax, [rax]
+pop rdi
+imul eax, edi
+pop rdi
+add eax, edi
+pop rdi
+cdq
+idiv edi
+mov rax, rdx
+pop rdi
+sub eax, edi
+pop rdi
+mov [rdi], eax
+.loc 1 13 
+mov rax, 4
+push rax
+lea rax, [rbp - 116]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 512
+push rax
+lea rax, [rbp - 132]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + b]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+mov rax, 6
+push rax
+mov rax, 13
+push rax
+mov rax, 11
+push rax
+lea rax, [rbp - 116]
+movsxd rax, [rax]
+pop rdi
+imul eax, edi
+push rax
+mov rax, 5
+push rax
+lea rax, [rbp - 132]
+movsxd rax, [rax]
+pop rdi
+imul eax, edi
+pop rdi
+add eax, edi
+pop rdi
+cdq
+idiv edi
+mov rax, rdx
+pop rdi
+sub eax, edi
+pop rdi
+mov [rdi], eax
+.L..3:
+.loc 1 11 
+mov rax, -1
+push rax
+lea rax, [rbp - 112]
+push rax
+lea rax, [rbp - 116]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 112]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 112]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.1
+.L..2:
+.L..1:
+.loc 1 10 
+mov rax, -1
+push rax
+lea rax, [rbp - 128]
+push rax
+lea rax, [rbp - 132]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 128]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 128]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.0
+.L..0:
+.loc 1 17 
+mov rcx, 8
+lea rdi, [rbp - 104]
+mov al, 0
+rep stosb
+lea rax, [rbp - 104]
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+mov [rdi], rax
+.loc 1 18 
+mov rcx, 4
+lea rdi, [rbp - 92]
+mov al, 0
+rep stosb
+lea rax, [rbp - 92]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.2:
+mov rax, 8
+push rax
+lea rax, [rbp - 92]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..4
+.loc 1 19 
+mov rcx, 4
+lea rdi, [rbp - 76]
+mov al, 0
+rep stosb
+lea rax, [rbp - 76]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.3:
+lea rax, [rbp - 136]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..6
+.loc 1 20 
+mov rcx, 4
+lea rdi, [rbp - 60]
+mov al, 0
+rep stosb
+lea rax, [rbp - 60]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.4:
+lea rax, [rbp - 136]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 60]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..8
+.loc 1 21 
+mov rcx, 4
+lea rdi, [rbp - 48]
+mov al, 0
+rep stosb
+lea rax, [rbp - 48]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.loc 1 22 
+mov rcx, 4
+lea rdi, [rbp - 44]
+mov al, 0
+rep stosb
+lea rax, [rbp - 44]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.5:
+lea rax, [rbp - 136]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..10
+.loc 1 23 
+lea rax, [rbp - 32]
+push rax
+lea rax, [rbp - 48]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 32]
+mov rax, [rax]
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 60]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 512
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + b]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 512
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + a]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+imul eax, edi
+push rax
+lea rax, [rbp - 32]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+.L..11:
+.loc 1 22 
+mov rax, -1
+push rax
+lea rax, [rbp - 40]
+push rax
+lea rax, [rbp - 44]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.5
+.L..10:
+.loc 1 24 
+mov rax, 4
+push rax
+lea rax, [rbp - 60]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 512
+push rax
+lea rax, [rbp - 76]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + c]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+lea rax, [rbp - 92]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 48]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+.L..9:
+.loc 1 20 
+mov rax, -1
+push rax
+lea rax, [rbp - 56]
+push rax
+lea rax, [rbp - 60]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 56]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 56]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.4
+.L..8:
+.L..7:
+.loc 1 19 
+mov rax, -1
+push rax
+lea rax, [rbp - 72]
+push rax
+lea rax, [rbp - 76]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 72]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 72]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.3
+.L..6:
+.loc 1 27 
+mov rcx, 4
+lea rdi, [rbp - 20]
+mov al, 0
+rep stosb
+lea rax, [rbp - 20]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.6:
+lea rax, [rbp - 136]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 20]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..12
+.loc 1 28 
+lea rax, [rbp - 8]
+push rax
+lea rax, [rbp - 104]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 136]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 92]
+movsxd rax, [rax]
+push rax
+mov rax, 31
+push rax
+lea rax, [rbp - 20]
+movsxd rax, [rax]
+pop rdi
+imul eax, edi
+pop rdi
+add eax, edi
+pop rdi
+cdq
+idiv edi
+mov rax, rdx
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 512
+push rax
+lea rax, [rbp - 20]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + c]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+movsxd rax, eax
+push rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+pop rdi
+mov [rdi], rax
+.L..13:
+.loc 1 27 
+mov rax, -1
+push rax
+lea rax, [rbp - 16]
+push rax
+lea rax, [rbp - 20]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 16]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 16]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.6
+.L..12:
+.L..5:
+.loc 1 18 
+mov rax, -1
+push rax
+lea rax, [rbp - 88]
+push rax
+lea rax, [rbp - 92]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 88]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 88]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.2
+.L..4:
+.loc 1 30 
+lea rax, [rbp - 104]
+mov rax, [rax]
+push rax
+lea rax, [rip + .L..14]
+push rax
+pop rdi
+pop rsi
+call printf
+.loc 1 31 
+mov rax, 0
+jmp .L.return.main
+.L.return.main:
+mov rsp, rbp
+pop rbp
+ret
+
+# ===== Generated Code End =====
+
+return:    mov rdi, rax
+    mov rax, 60
+    syscall
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,2606 @@
+.file 1 "/root/repo/bench/kernels/nbody.c"
+.intel_syntax  noprefix
+.text
+
+# ===== Generated Code Start =====
+
+.local .L..14
+.align 1
+.data
+.L..14:
+.byte 37
+.byte 46
+.byte 57
+.byte 102
+.byte 10
+.byte 0
+.globl bodies
+.align 8
+.bss
+bodies:
+.zero 280
+.globl main
+.text
+main:
+push rbp
+mov rbp, rsp
+sub rsp, 160
+mov DWORD PTR [rbp - 148], 0
+mov DWORD PTR [rbp - 144], 48
+movq [rbp - 132], rbp
+addq [rbp - 132], -124
+movq [rbp - 124], rdi
+movq [rbp - 116], rsi
+movq [rbp - 108], rdx
+movq [rbp - 100], rcx
+movq [rbp - 92], r8
+movq [rbp - 84], r9
+movsd [rbp - 76], xmm0
+movsd [rbp - 68], xmm1
+movsd [rbp - 60], xmm2
+movsd [rbp - 52], xmm3
+movsd [rbp - 44], xmm4
+movsd [rbp - 36], xmm5
+movsd [rbp - 28], xmm6
+movsd [rbp - 20], xmm7
+.loc 1 80 
+call init
+.loc 1 81 
+mov rcx, 4
+lea rdi, [rbp - 12]
+mov al, 0
+rep stosb
+lea rax, [rbp - 12]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.0:
+mov rax, 500000
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..12
+.loc 1 82 
+mov rax, 4576918229304087675
+movq xmm0, rax
+sub rsp, 8
+movsd [rsp], xmm0
+movsd xmm0, [rsp]
+add rsp, 8
+call advance
+.L..13:
+.loc 1 81 
+mov rax, -1
+push rax
+lea rax, [rbp - 8]
+push rax
+lea rax, [rbp - 12]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.0
+.L..12:
+.loc 1 83 
+call energy
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rip + .L..14]
+push rax
+pop rdi
+movsd xmm0, [rsp]
+add rsp, 8
+call printf
+.loc 1 84 
+mov rax, 0
+jmp .L.return.main
+.L.return.main:
+mov rsp, rbp
+pop rbp
+ret
+.globl energy
+.text
+energy:
+push rbp
+mov rbp, rsp
+sub rsp, 240
+mov DWORD PTR [rbp - 232], 0
+mov DWORD PTR [rbp - 228], 48
+movq [rbp - 216], rbp
+addq [rbp - 216], -208
+movq [rbp - 208], rdi
+movq [rbp - 200], rsi
+movq [rbp - 192], rdx
+movq [rbp - 184], rcx
+movq [rbp - 176], r8
+movq [rbp - 168], r9
+movsd [rbp - 160], xmm0
+movsd [rbp - 152], xmm1
+movsd [rbp - 144], xmm2
+movsd [rbp - 136], xmm3
+movsd [rbp - 128], xmm4
+movsd [rbp - 120], xmm5
+movsd [rbp - 112], xmm6
+movsd [rbp - 104], xmm7
+.loc 1 64 
+mov rcx, 8
+lea rdi, [rbp - 96]
+mov al, 0
+rep stosb
+lea rax, [rbp - 96]
+push rax
+mov rax, 0
+cvtsi2sd xmm0, eax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 65 
+mov rcx, 4
+lea rdi, [rbp - 84]
+mov al, 0
+rep stosb
+lea rax, [rbp - 84]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.1:
+mov rax, 5
+push rax
+lea rax, [rbp - 84]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..8
+.loc 1 66 
+mov rcx, 8
+lea rdi, [rbp - 72]
+mov al, 0
+rep stosb
+lea rax, [rbp - 72]
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 84]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+pop rdi
+mov [rdi], rax
+.loc 1 67 
+lea rax, [rbp - 64]
+push rax
+lea rax, [rbp - 96]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+push rax
+lea rax, [rbp - 72]
+mov rax, [rax]
+add rax, 40
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 72]
+mov rax, [rax]
+add rax, 40
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 72]
+mov rax, [rax]
+add rax, 32
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 72]
+mov rax, [rax]
+add rax, 32
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 72]
+mov rax, [rax]
+add rax, 24
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 72]
+mov rax, [rax]
+add rax, 24
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 72]
+mov rax, [rax]
+add rax, 48
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+mov rax, 4602678819172646912
+movq xmm0, rax
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 64]
+mov rax, [rax]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 68 
+mov rcx, 4
+lea rdi, [rbp - 52]
+mov al, 0
+rep stosb
+lea rax, [rbp - 52]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 84]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+.L.begin.2:
+mov rax, 5
+push rax
+lea rax, [rbp - 52]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..10
+.loc 1 69 
+mov rcx, 8
+lea rdi, [rbp - 40]
+mov al, 0
+rep stosb
+lea rax, [rbp - 40]
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 52]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+pop rdi
+mov [rdi], rax
+.loc 1 70 
+mov rcx, 8
+lea rdi, [rbp - 32]
+mov al, 0
+rep stosb
+lea rax, [rbp - 32]
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+add rax, 0
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 72]
+mov rax, [rax]
+add rax, 0
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+subsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 71 
+mov rcx, 8
+lea rdi, [rbp - 24]
+mov al, 0
+rep stosb
+lea rax, [rbp - 24]
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+add rax, 8
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 72]
+mov rax, [rax]
+add rax, 8
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+subsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 72 
+mov rcx, 8
+lea rdi, [rbp - 16]
+mov al, 0
+rep stosb
+lea rax, [rbp - 16]
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+add rax, 16
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 72]
+mov rax, [rax]
+add rax, 16
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+subsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 73 
+lea rax, [rbp - 8]
+push rax
+lea rax, [rbp - 96]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+push rax
+lea rax, [rbp - 16]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 16]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 24]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 24]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 32]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 32]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+movsd xmm0, [rsp]
+add rsp, 8
+sub rsp, 8
+call sqrt
+add rsp, 8
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 40]
+mov rax, [rax]
+add rax, 48
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 72]
+mov rax, [rax]
+add rax, 48
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+divsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 8]
+mov rax, [rax]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+subsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.L..11:
+.loc 1 68 
+mov rax, -1
+push rax
+lea rax, [rbp - 48]
+push rax
+lea rax, [rbp - 52]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 48]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 48]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.2
+.L..10:
+.L..9:
+.loc 1 65 
+mov rax, -1
+push rax
+lea rax, [rbp - 80]
+push rax
+lea rax, [rbp - 84]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 80]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 80]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.1
+.L..8:
+.loc 1 76 
+lea rax, [rbp - 96]
+movsd xmm0, [rax]
+jmp .L.return.energy
+.L.return.energy:
+mov rsp, rbp
+pop rbp
+ret
+.globl advance
+.text
+advance:
+push rbp
+mov rbp, rsp
+sub rsp, 192
+movsd [rbp - 184], xmm0
+.loc 1 39 
+mov rcx, 4
+lea rdi, [rbp - 172]
+mov al, 0
+rep stosb
+lea rax, [rbp - 172]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.3:
+mov rax, 5
+push rax
+lea rax, [rbp - 172]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..2
+.loc 1 40 
+mov rcx, 8
+lea rdi, [rbp - 160]
+mov al, 0
+rep stosb
+lea rax, [rbp - 160]
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 172]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+pop rdi
+mov [rdi], rax
+.loc 1 41 
+mov rcx, 4
+lea rdi, [rbp - 148]
+mov al, 0
+rep stosb
+lea rax, [rbp - 148]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 172]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+.L.begin.4:
+mov rax, 5
+push rax
+lea rax, [rbp - 148]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..4
+.loc 1 42 
+mov rcx, 8
+lea rdi, [rbp - 136]
+mov al, 0
+rep stosb
+lea rax, [rbp - 136]
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 148]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+pop rdi
+mov [rdi], rax
+.loc 1 43 
+mov rcx, 8
+lea rdi, [rbp - 128]
+mov al, 0
+rep stosb
+lea rax, [rbp - 128]
+push rax
+lea rax, [rbp - 136]
+mov rax, [rax]
+add rax, 0
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 160]
+mov rax, [rax]
+add rax, 0
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+subsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 44 
+mov rcx, 8
+lea rdi, [rbp - 120]
+mov al, 0
+rep stosb
+lea rax, [rbp - 120]
+push rax
+lea rax, [rbp - 136]
+mov rax, [rax]
+add rax, 8
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 160]
+mov rax, [rax]
+add rax, 8
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+subsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 45 
+mov rcx, 8
+lea rdi, [rbp - 112]
+mov al, 0
+rep stosb
+lea rax, [rbp - 112]
+push rax
+lea rax, [rbp - 136]
+mov rax, [rax]
+add rax, 16
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 160]
+mov rax, [rax]
+add rax, 16
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+subsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 46 
+mov rcx, 8
+lea rdi, [rbp - 104]
+mov al, 0
+rep stosb
+lea rax, [rbp - 104]
+push rax
+lea rax, [rbp - 112]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 112]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 120]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 120]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 128]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 128]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 47 
+mov rcx, 8
+lea rdi, [rbp - 96]
+mov al, 0
+rep stosb
+lea rax, [rbp - 96]
+push rax
+lea rax, [rbp - 104]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+movsd xmm0, [rsp]
+add rsp, 8
+sub rsp, 8
+call sqrt
+add rsp, 8
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 104]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 184]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+divsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 48 
+lea rax, [rbp - 88]
+push rax
+lea rax, [rbp - 160]
+mov rax, [rax]
+add rax, 24
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 88]
+mov rax, [rax]
+push rax
+lea rax, [rbp - 96]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 136]
+mov rax, [rax]
+add rax, 48
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 128]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 88]
+mov rax, [rax]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+subsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 49 
+lea rax, [rbp - 80]
+push rax
+lea rax, [rbp - 160]
+mov rax, [rax]
+add rax, 32
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 80]
+mov rax, [rax]
+push rax
+lea rax, [rbp - 96]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 136]
+mov rax, [rax]
+add rax, 48
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 120]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 80]
+mov rax, [rax]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+subsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 50 
+lea rax, [rbp - 72]
+push rax
+lea rax, [rbp - 160]
+mov rax, [rax]
+add rax, 40
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 72]
+mov rax, [rax]
+push rax
+lea rax, [rbp - 96]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 136]
+mov rax, [rax]
+add rax, 48
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 112]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 72]
+mov rax, [rax]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+subsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 51 
+lea rax, [rbp - 64]
+push rax
+lea rax, [rbp - 136]
+mov rax, [rax]
+add rax, 24
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+push rax
+lea rax, [rbp - 96]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 160]
+mov rax, [rax]
+add rax, 48
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 128]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 64]
+mov rax, [rax]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 52 
+lea rax, [rbp - 56]
+push rax
+lea rax, [rbp - 136]
+mov rax, [rax]
+add rax, 32
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 56]
+mov rax, [rax]
+push rax
+lea rax, [rbp - 96]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 160]
+mov rax, [rax]
+add rax, 48
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 120]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 56]
+mov rax, [rax]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 53 
+lea rax, [rbp - 48]
+push rax
+lea rax, [rbp - 136]
+mov rax, [rax]
+add rax, 40
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 48]
+mov rax, [rax]
+push rax
+lea rax, [rbp - 96]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 160]
+mov rax, [rax]
+add rax, 48
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 112]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 48]
+mov rax, [rax]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.L..5:
+.loc 1 41 
+mov rax, -1
+push rax
+lea rax, [rbp - 144]
+push rax
+lea rax, [rbp - 148]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 144]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 144]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.4
+.L..4:
+.L..3:
+.loc 1 39 
+mov rax, -1
+push rax
+lea rax, [rbp - 168]
+push rax
+lea rax, [rbp - 172]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 168]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 168]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.3
+.L..2:
+.loc 1 56 
+mov rcx, 4
+lea rdi, [rbp - 36]
+mov al, 0
+rep stosb
+lea rax, [rbp - 36]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.5:
+mov rax, 5
+push rax
+lea rax, [rbp - 36]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..6
+.loc 1 57 
+lea rax, [rbp - 24]
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 36]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 0
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 24]
+mov rax, [rax]
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 36]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 24
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 184]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 24]
+mov rax, [rax]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 58 
+lea rax, [rbp - 16]
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 36]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 8
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 16]
+mov rax, [rax]
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 36]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 32
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 184]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 16]
+mov rax, [rax]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 59 
+lea rax, [rbp - 8]
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 36]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 16
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 36]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 40
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 184]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+sub rsp, 8
+movsd [rsp], xmm0
+lea rax, [rbp - 8]
+mov rax, [rax]
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+addsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.L..7:
+.loc 1 56 
+mov rax, -1
+push rax
+lea rax, [rbp - 32]
+push rax
+lea rax, [rbp - 36]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 32]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 32]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.5
+.L..6:
+.L.return.advance:
+mov rsp, rbp
+pop rbp
+ret
+.globl init
+.text
+init:
+push rbp
+mov rbp, rsp
+sub rsp, 448
+mov DWORD PTR [rbp - 448], 0
+mov DWORD PTR [rbp - 444], 48
+movq [rbp - 432], rbp
+addq [rbp - 432], -424
+movq [rbp - 424], rdi
+movq [rbp - 416], rsi
+movq [rbp - 408], rdx
+movq [rbp - 400], rcx
+movq [rbp - 392], r8
+movq [rbp - 384], r9
+movsd [rbp - 376], xmm0
+movsd [rbp - 368], xmm1
+movsd [rbp - 360], xmm2
+movsd [rbp - 352], xmm3
+movsd [rbp - 344], xmm4
+movsd [rbp - 336], xmm5
+movsd [rbp - 328], xmm6
+movsd [rbp - 320], xmm7
+.loc 1 14 
+mov rcx, 8
+lea rdi, [rbp - 312]
+mov al, 0
+rep stosb
+lea rax, [rbp - 312]
+push rax
+mov rax, 4630752910647379422
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 15 
+mov rcx, 8
+lea rdi, [rbp - 304]
+mov al, 0
+rep stosb
+lea rax, [rbp - 304]
+push rax
+mov rax, 4645132986222473380
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 26 
+.loc 1 16 
+mov rcx, 280
+lea rdi, [rbp - 296]
+mov al, 0
+rep stosb
+mov rax, 8
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 17 
+mov rax, 0
+cvtsi2sd xmm0, eax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 17 
+mov rax, 0
+cvtsi2sd xmm0, eax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 17 
+mov rax, 0
+cvtsi2sd xmm0, eax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 17 
+mov rax, 0
+cvtsi2sd xmm0, eax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 17 
+mov rax, 0
+cvtsi2sd xmm0, eax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 5
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 17 
+mov rax, 0
+cvtsi2sd xmm0, eax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 6
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 17 
+mov rax, 1
+cvtsi2sd xmm0, eax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 18 
+mov rax, 4617136985637443884
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 18 
+mov rax, 4607904436090559356
+movq xmm0, rax
+mov rax, 1
+shl rax, 63
+movq xmm1, rax
+xorpd xmm0, xmm1
+neg rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 18 
+mov rax, 4592131175877045232
+movq xmm0, rax
+mov rax, 1
+shl rax, 63
+movq xmm1, rax
+xorpd xmm0, xmm1
+neg rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 18 
+mov rax, 4565298575141802505
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 19 
+mov rax, 4575526377712152758
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 5
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 19 
+mov rax, 4544723120079945088
+movq xmm0, rax
+mov rax, 1
+shl rax, 63
+movq xmm1, rax
+xorpd xmm0, xmm1
+neg rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 6
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 19 
+mov rax, 4561945624537448757
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 20 
+mov rax, 4620886515960171111
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 20 
+mov rax, 4616330128746480048
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 20 
+mov rax, 4600940851561711228
+movq xmm0, rax
+mov rax, 1
+shl rax, 63
+movq xmm1, rax
+xorpd xmm0, xmm1
+neg rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 20 
+mov rax, 4568527670363430262
+movq xmm0, rax
+mov rax, 1
+shl rax, 63
+movq xmm1, rax
+xorpd xmm0, xmm1
+neg rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 21 
+mov rax, 4572412932590500024
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 5
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 21 
+mov rax, 4537421943404317376
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 6
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 21 
+mov rax, 4553909289163810552
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 22 
+mov rax, 4623448502799161807
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 22 
+mov rax, 4624696440032487038
+movq xmm0, rax
+mov rax, 1
+shl rax, 63
+movq xmm1, rax
+xorpd xmm0, xmm1
+neg rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 22 
+mov rax, 4597213523723255200
+movq xmm0, rax
+mov rax, 1
+shl rax, 63
+movq xmm1, rax
+xorpd xmm0, xmm1
+neg rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 22 
+mov rax, 4568982327883454804
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 23 
+mov rax, 4567630804959669473
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 5
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 23 
+mov rax, 4539375004119988896
+movq xmm0, rax
+mov rax, 1
+shl rax, 63
+movq xmm1, rax
+xorpd xmm0, xmm1
+neg rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 6
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 23 
+mov rax, 4541568263676574678
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 24 
+mov rax, 4624847617829197610
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 24 
+mov rax, 4627988856158331424
+movq xmm0, rax
+mov rax, 1
+shl rax, 63
+movq xmm1, rax
+xorpd xmm0, xmm1
+neg rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 24 
+mov rax, 4595626498235032896
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 24 
+mov rax, 4568327644518236960
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 25 
+mov rax, 4565151762383216008
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 5
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 25 
+mov rax, 4546649935902119760
+movq xmm0, rax
+mov rax, 1
+shl rax, 63
+movq xmm1, rax
+xorpd xmm0, xmm1
+neg rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 16 
+mov rax, 8
+push rax
+mov rax, 6
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+push rax
+.loc 1 25 
+mov rax, 4542726933152861932
+movq xmm0, rax
+pop rdi
+movsd [rdi], xmm0
+.loc 1 27 
+mov rcx, 4
+lea rdi, [rbp - 12]
+mov al, 0
+rep stosb
+lea rax, [rbp - 12]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.6:
+mov rax, 5
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..0
+.loc 1 28 
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 0
+push rax
+mov rax, 8
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+movsd xmm0, [rax]
+pop rdi
+movsd [rdi], xmm0
+.loc 1 29 
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 8
+push rax
+mov rax, 8
+push rax
+mov rax, 1
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+movsd xmm0, [rax]
+pop rdi
+movsd [rdi], xmm0
+.loc 1 30 
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 16
+push rax
+mov rax, 8
+push rax
+mov rax, 2
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+movsd xmm0, [rax]
+pop rdi
+movsd [rdi], xmm0
+.loc 1 31 
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 24
+push rax
+lea rax, [rbp - 304]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+mov rax, 8
+push rax
+mov rax, 3
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 32 
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 32
+push rax
+lea rax, [rbp - 304]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+mov rax, 8
+push rax
+mov rax, 4
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 33 
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 40
+push rax
+lea rax, [rbp - 304]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+mov rax, 8
+push rax
+mov rax, 5
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.loc 1 34 
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + bodies]
+pop rdi
+add rax, rdi
+add rax, 48
+push rax
+lea rax, [rbp - 312]
+movsd xmm0, [rax]
+sub rsp, 8
+movsd [rsp], xmm0
+mov rax, 8
+push rax
+mov rax, 6
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+mov rax, 56
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 296]
+pop rdi
+add rax, rdi
+pop rdi
+add rax, rdi
+movsd xmm0, [rax]
+movsd xmm1, [rsp]
+add rsp, 8
+mulsd xmm0, xmm1
+pop rdi
+movsd [rdi], xmm0
+.L..1:
+.loc 1 27 
+mov rax, -1
+push rax
+lea rax, [rbp - 8]
+push rax
+lea rax, [rbp - 12]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.6
+.L..0:
+.L.return.init:
+mov rsp, rbp
+pop rbp
+ret
+
+# ===== Generated Code End =====
+
+return:    mov rdi, rax
+    mov rax, 60
+    syscall
+.section .note.GNU-stack,"",@progbits
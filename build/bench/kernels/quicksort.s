@@ -0,0 +1,756 @@
+.file 1 "/root/repo/bench/kernels/quicksort.c"
+.intel_syntax  noprefix
+.text
+
+# ===== Generated Code Start =====
+
+.local .L..14
+.align 1
+.data
+.L..14:
+.byte 37
+.byte 108
+.byte 100
+.byte 10
+.byte 0
+.globl values
+.align 4
+.bss
+values:
+.zero 4000000
+.globl main
+.text
+main:
+push rbp
+mov rbp, rsp
+sub rsp, 208
+mov DWORD PTR [rbp - 204], 0
+mov DWORD PTR [rbp - 200], 48
+movq [rbp - 188], rbp
+addq [rbp - 188], -180
+movq [rbp - 180], rdi
+movq [rbp - 172], rsi
+movq [rbp - 164], rdx
+movq [rbp - 156], rcx
+movq [rbp - 148], r8
+movq [rbp - 140], r9
+movsd [rbp - 132], xmm0
+movsd [rbp - 124], xmm1
+movsd [rbp - 116], xmm2
+movsd [rbp - 108], xmm3
+movsd [rbp - 100], xmm4
+movsd [rbp - 92], xmm5
+movsd [rbp - 84], xmm6
+movsd [rbp - 76], xmm7
+.loc 1 33 
+mov rcx, 4
+lea rdi, [rbp - 68]
+mov al, 0
+rep stosb
+lea rax, [rbp - 68]
+push rax
+mov rax, 1000000
+pop rdi
+mov [rdi], eax
+.loc 1 34 
+mov rcx, 4
+lea rdi, [rbp - 64]
+mov al, 0
+rep stosb
+lea rax, [rbp - 64]
+push rax
+mov rax, 12345
+pop rdi
+mov [rdi], eax
+.loc 1 35 
+mov rcx, 4
+lea rdi, [rbp - 60]
+mov al, 0
+rep stosb
+lea rax, [rbp - 60]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.0:
+lea rax, [rbp - 68]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 60]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..8
+.loc 1 36 
+lea rax, [rbp - 64]
+push rax
+mov rax, 12345
+push rax
+mov rax, 1103515245
+push rax
+lea rax, [rbp - 64]
+movsxd rax, [rax]
+pop rdi
+imul eax, edi
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+.loc 1 37 
+mov rax, 4
+push rax
+lea rax, [rbp - 60]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + values]
+pop rdi
+add rax, rdi
+push rax
+mov rax, 1000000
+push rax
+mov rax, 8
+push rax
+lea rax, [rbp - 64]
+movsxd rax, [rax]
+pop rdi
+mov rcx, rdi
+shr eax, cl
+pop rdi
+mov edx, 0
+div edi
+mov rax, rdx
+pop rdi
+mov [rdi], eax
+.L..9:
+.loc 1 35 
+mov rax, -1
+push rax
+lea rax, [rbp - 56]
+push rax
+lea rax, [rbp - 60]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 56]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 56]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.0
+.L..8:
+.loc 1 39 
+mov rax, 1
+push rax
+lea rax, [rbp - 68]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+push rax
+mov rax, 0
+push rax
+lea rax, [rip + values]
+push rax
+pop rdi
+pop rsi
+pop rdx
+call sort
+.loc 1 41 
+mov rcx, 8
+lea rdi, [rbp - 48]
+mov al, 0
+rep stosb
+lea rax, [rbp - 48]
+push rax
+mov rax, 0
+movsxd rax, eax
+pop rdi
+mov [rdi], rax
+.loc 1 42 
+mov rcx, 4
+lea rdi, [rbp - 36]
+mov al, 0
+rep stosb
+lea rax, [rbp - 36]
+push rax
+mov rax, 0
+pop rdi
+mov [rdi], eax
+.L.begin.1:
+lea rax, [rbp - 68]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 36]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..10
+.loc 1 43 
+lea rax, [rbp - 24]
+push rax
+lea rax, [rbp - 48]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 24]
+mov rax, [rax]
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 36]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + values]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+movsxd rax, eax
+push rax
+lea rax, [rbp - 24]
+mov rax, [rax]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+pop rdi
+mov [rdi], rax
+.L..11:
+.loc 1 42 
+lea rax, [rbp - 32]
+push rax
+lea rax, [rbp - 36]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 32]
+mov rax, [rax]
+push rax
+mov rax, 1000
+push rax
+lea rax, [rbp - 32]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+jmp .L.begin.1
+.L..10:
+.loc 1 44 
+mov rcx, 4
+lea rdi, [rbp - 12]
+mov al, 0
+rep stosb
+lea rax, [rbp - 12]
+push rax
+mov rax, 1
+pop rdi
+mov [rdi], eax
+.L.begin.2:
+lea rax, [rbp - 68]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..12
+.loc 1 45 
+mov rax, 4
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + values]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 12]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rip + values]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L.else.3
+.loc 1 46 
+mov rax, 1
+jmp .L.return.main
+jmp .L.end.3
+.L.else.3:
+.L.end.3:
+.L..13:
+.loc 1 44 
+mov rax, -1
+push rax
+lea rax, [rbp - 8]
+push rax
+lea rax, [rbp - 12]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.begin.2
+.L..12:
+.loc 1 47 
+lea rax, [rbp - 48]
+mov rax, [rax]
+push rax
+lea rax, [rip + .L..14]
+push rax
+pop rdi
+pop rsi
+call printf
+.loc 1 48 
+mov rax, 0
+jmp .L.return.main
+.L.return.main:
+mov rsp, rbp
+pop rbp
+ret
+.globl sort
+.text
+sort:
+push rbp
+mov rbp, rsp
+sub rsp, 80
+mov [rbp - 64], rdi
+mov [rbp - 68], esi
+mov [rbp - 72], edx
+.loc 1 7 
+.L.begin.4:
+lea rax, [rbp - 72]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 68]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..0
+.loc 1 8 
+mov rcx, 4
+lea rdi, [rbp - 52]
+mov al, 0
+rep stosb
+lea rax, [rbp - 52]
+push rax
+mov rax, 4
+push rax
+mov rax, 2
+push rax
+lea rax, [rbp - 72]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 68]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+cdq
+idiv edi
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 9 
+mov rcx, 4
+lea rdi, [rbp - 48]
+mov al, 0
+rep stosb
+lea rax, [rbp - 48]
+push rax
+lea rax, [rbp - 68]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 10 
+mov rcx, 4
+lea rdi, [rbp - 44]
+mov al, 0
+rep stosb
+lea rax, [rbp - 44]
+push rax
+lea rax, [rbp - 72]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 11 
+.L.begin.5:
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 48]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setle al
+movzx rax, al
+cmp eax, 0
+je .L..2
+.loc 1 12 
+.L.begin.6:
+lea rax, [rbp - 52]
+movsxd rax, [rax]
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 48]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..4
+mov rax, -1
+push rax
+lea rax, [rbp - 40]
+push rax
+lea rax, [rbp - 48]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 40]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+.L..5:
+jmp .L.begin.6
+.L..4:
+.loc 1 13 
+.L.begin.7:
+mov rax, 4
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 52]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L..6
+mov rax, 1
+push rax
+lea rax, [rbp - 32]
+push rax
+lea rax, [rbp - 44]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 32]
+mov rax, [rax]
+push rax
+mov rax, -1
+push rax
+lea rax, [rbp - 32]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+.L..7:
+jmp .L.begin.7
+.L..6:
+.loc 1 14 
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 48]
+movsxd rax, [rax]
+pop rdi
+cmp eax, edi
+setle al
+movzx rax, al
+cmp eax, 0
+je .L.else.8
+.loc 1 15 
+mov rcx, 4
+lea rdi, [rbp - 20]
+mov al, 0
+rep stosb
+lea rax, [rbp - 20]
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 48]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 16 
+mov rax, 4
+push rax
+lea rax, [rbp - 48]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+push rax
+mov rax, 4
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 17 
+mov rax, 4
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+movsxd rax, eax
+pop rdi
+imul rax, rdi
+push rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+pop rdi
+add rax, rdi
+push rax
+lea rax, [rbp - 20]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.loc 1 18 
+mov rax, -1
+push rax
+lea rax, [rbp - 16]
+push rax
+lea rax, [rbp - 48]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 16]
+mov rax, [rax]
+push rax
+mov rax, 1
+push rax
+lea rax, [rbp - 16]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+.loc 1 19 
+mov rax, 1
+push rax
+lea rax, [rbp - 8]
+push rax
+lea rax, [rbp - 44]
+pop rdi
+mov [rdi], rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+push rax
+mov rax, -1
+push rax
+lea rax, [rbp - 8]
+mov rax, [rax]
+movsxd rax, [rax]
+pop rdi
+add eax, edi
+pop rdi
+mov [rdi], eax
+pop rdi
+add eax, edi
+jmp .L.end.8
+.L.else.8:
+.L.end.8:
+.L..3:
+jmp .L.begin.5
+.L..2:
+.loc 1 22 
+lea rax, [rbp - 48]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 72]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+push rax
+lea rax, [rbp - 68]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+pop rdi
+sub eax, edi
+pop rdi
+cmp eax, edi
+setl al
+movzx rax, al
+cmp eax, 0
+je .L.else.9
+.loc 1 23 
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 68]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+push rax
+pop rdi
+pop rsi
+pop rdx
+call sort
+.loc 1 24 
+lea rax, [rbp - 68]
+push rax
+lea rax, [rbp - 48]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+jmp .L.end.9
+.L.else.9:
+.loc 1 26 
+lea rax, [rbp - 72]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 48]
+movsxd rax, [rax]
+push rax
+lea rax, [rbp - 64]
+mov rax, [rax]
+push rax
+pop rdi
+pop rsi
+pop rdx
+call sort
+.loc 1 27 
+lea rax, [rbp - 72]
+push rax
+lea rax, [rbp - 44]
+movsxd rax, [rax]
+pop rdi
+mov [rdi], eax
+.L.end.9:
+.L..1:
+jmp .L.begin.4
+.L..0:
+.L.return.sort:
+mov rsp, rbp
+pop rbp
+ret
+
+# ===== Generated Code End =====
+
+return:    mov rdi, rax
+    mov rax, 60
+    syscall
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,193 @@
+.file 1 "/root/repo/bench/kernels/sieve.c"
+.intel_syntax  noprefix
+.text
+
+# ===== Generated Code Start =====
+
+.local .L..8
+.align 1
+.data
+.L..8:
+.byte 37
+.byte 100
+.byte 10
+.byte 0
+.globl composite
+.align 1
+.bss
+composite:
+.zero 1000000
+.globl main
+.text
+main:
+push rbx
+push r12
+push r13
+push r14
+sub rsp, 8
+.loc 1 9 
+xor esi, esi
+jmp .L.bb.main.4
+.align 16
+.L.bb.main.29:
+mov rsi, rdi
+.L.bb.main.4:
+.loc 1 10 
+mov eax, 1000000
+movsxd r8, eax
+xor eax, eax
+movsxd r9, eax
+add r9, 15
+xor r10d, r10d
+and r10d, 255
+mov r11d, 16843009
+imul r10d, r11d
+movd xmm1, r10d
+pshufd xmm2, xmm1, 0
+cmp r9, r8
+jge .L.bb.main.30
+.L.bb.main.27:
+xor r9d, r9d
+jmp .L.bb.main.25
+.align 16
+.L.bb.main.36:
+mov r9, r10
+.L.bb.main.25:
+.loc 1 11 
+movsxd rbx, r9d
+mov r11, 1
+imul rbx, r11
+lea r11, [rip + composite]
+add rbx, r11
+movdqu XMMWORD PTR [rbx], xmm2
+.loc 1 10 
+mov r10, r9
+add r10d, 16
+movsxd r9, r10d
+add r9, 15
+cmp r9, r8
+jl .L.bb.main.36
+.L.bb.main.26:
+cmp r10d, 1000000
+jge .L.bb.main.5
+.L.bb.main.32:
+mov r8, r10
+jmp .L.bb.main.8
+.L.bb.main.30:
+xor r8d, r8d
+jmp .L.bb.main.8
+.align 16
+.L.bb.main.31:
+mov r8, r9
+.L.bb.main.8:
+.loc 1 11 
+movsxd r10, r8d
+mov r11, 1
+imul r10, r11
+lea r11, [rip + composite]
+add r10, r11
+mov BYTE PTR [r10], 0
+.loc 1 10 
+mov r9, r8
+add r9d, 1
+cmp r9d, 1000000
+jl .L.bb.main.31
+.L.bb.main.5:
+.loc 1 13 
+xor r8d, r8d
+mov r9d, 2
+jmp .L.bb.main.12
+.align 16
+.L.bb.main.34:
+mov r8, rbx
+mov r9, r10
+.L.bb.main.12:
+.loc 1 14 
+movsxd r12, r9d
+mov r11, 1
+imul r12, r11
+lea r11, [rip + composite]
+add r12, r11
+movsx r12d, BYTE PTR [r12]
+cmp r12d, 0
+je .L.bb.main.14
+.L.bb.main.13:
+.loc 1 15 
+mov rbx, r8
+jmp .L.bb.main.10
+.L.bb.main.14:
+.loc 1 16 
+add r8d, 1
+.loc 1 17 
+mov eax, 1000000
+cdq
+idiv r9d
+mov r12, rax
+cmp r12d, r9d
+jge .L.bb.main.16
+.L.bb.main.15:
+.loc 1 18 
+mov rbx, r8
+jmp .L.bb.main.10
+.L.bb.main.16:
+.loc 1 19 
+mov r12, r9
+imul r12d, r9d
+cmp r12d, 1000000
+jge .L.bb.main.17
+.L.bb.main.22:
+jmp .L.bb.main.20
+.align 16
+.L.bb.main.35:
+mov r12, r13
+.L.bb.main.20:
+.loc 1 20 
+movsxd r14, r12d
+mov r11, 1
+imul r14, r11
+lea r11, [rip + composite]
+add r14, r11
+mov BYTE PTR [r14], 1
+.loc 1 19 
+mov r13, r12
+add r13d, r9d
+cmp r13d, 1000000
+jl .L.bb.main.35
+.L.bb.main.17:
+mov rbx, r8
+.L.bb.main.10:
+.loc 1 13 
+mov r10, r9
+add r10d, 1
+cmp r10d, 1000000
+jl .L.bb.main.34
+.L.bb.main.33:
+mov r8, rbx
+.L.bb.main.9:
+.loc 1 9 
+mov rdi, rsi
+add edi, 1
+cmp edi, 3
+jl .L.bb.main.29
+.L.bb.main.28:
+mov rsi, r8
+.L.bb.main.1:
+.loc 1 23 
+lea rdi, [rip + .L..8]
+mov eax, 0
+call printf
+.loc 1 24 
+xor eax, eax
+add rsp, 8
+pop r14
+pop r13
+pop r12
+pop rbx
+ret
+
+# ===== Generated Code End =====
+
+return:    mov rdi, rax
+    mov rax, 60
+    syscall
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yoctocc {
+
+// 翻訳単位の .rodata に置く浮動小数点数の定数 (リテラルと符号を反転するマスク)。
+// 同じ値は 1 つにまとめ、movsd xmm0, [rip + .L.constant.0] のように読み出す
+class ConstantPool final {
+public:
+    // size (4 か 8) バイトのスカラー bits のラベル
+    std::string scalar(uint64_t bits, int size);
+    // 最下位の要素の符号ビットだけが立った 16 バイトのマスクのラベル。
+    // xorps のメモリオペランドにするので 16 バイト境界に揃える
+    std::string signMask(int size);
+
+    // 定数があれば .rodata に出力して .text に戻す
+    [[nodiscard]] std::vector<std::string> emit() const;
+
+private:
+    struct Entry {
+        uint64_t bits = 0;
+        // 16 ならマスクで、上位 8 バイトは 0
+        int size = 0;
+        std::string label;
+    };
+
+    std::string intern(uint64_t bits, int size);
+
+    std::vector<Entry> _entries;
+};
+
+} // namespace yoctocc
@@ -124,6 +124,16 @@ inline constexpr Instruction<RET> ret;
 inline constexpr Instruction<JMP> jmp;
 inline constexpr Instruction<JE> je;
 inline constexpr Instruction<JNE> jne;
+inline constexpr Instruction<JL> jl;
+inline constexpr Instruction<JLE> jle;
+inline constexpr Instruction<JG> jg;
+inline constexpr Instruction<JGE> jge;
+inline constexpr Instruction<JB> jb;
+inline constexpr Instruction<JBE> jbe;
+inline constexpr Instruction<JA> ja;
+inline constexpr Instruction<JAE> jae;
+inline constexpr Instruction<JP> jp;
+inline constexpr Instruction<JNP> jnp;
 inline constexpr Instruction<JS> js;
 inline constexpr Instruction<TEST> test;
 inline constexpr Instruction<CALL> call;
@@ -147,6 +157,68 @@ inline constexpr Instruction<MULSS> mulss;
 inline constexpr Instruction<MULSD> mulsd;
 inline constexpr Instruction<DIVSS> divss;
 inline constexpr Instruction<DIVSD> divsd;
+inline constexpr Instruction<MOVD> movd;
+inline constexpr Instruction<MOVAPS> movaps;
+inline constexpr Instruction<MOVUPS> movups;
+inline constexpr Instruction<MOVUPD> movupd;
+inline constexpr Instruction<MOVDQU> movdqu;
+inline constexpr Instruction<PSHUFD> pshufd;
+inline constexpr Instruction<PADDD> paddd;
+inline constexpr Instruction<PADDQ> paddq;
+inline constexpr Instruction<PSUBD> psubd;
+inline constexpr Instruction<PSUBQ> psubq;
+inline constexpr Instruction<PAND> pand;
+inline constexpr Instruction<POR> por;
+inline constexpr Instruction<ADDPS> addps;
+inline constexpr Instruction<ADDPD> addpd;
+inline constexpr Instruction<SUBPS> subps;
+inline constexpr Instruction<SUBPD> subpd;
+inline constexpr Instruction<MULPS> mulps;
+inline constexpr Instruction<MULPD> mulpd;
+inline constexpr Instruction<DIVPS> divps;
+inline constexpr Instruction<DIVPD> divpd;
+inline constexpr Instruction<VADDSS> vaddss;
+inline constexpr Instruction<VADDSD> vaddsd;
+inline constexpr Instruction<VADDPS> vaddps;
+inline constexpr Instruction<VADDPD> vaddpd;
+inline constexpr Instruction<VSUBSS> vsubss;
+inline constexpr Instruction<VSUBSD> vsubsd;
+inline constexpr Instruction<VSUBPS> vsubps;
+inline constexpr Instruction<VSUBPD> vsubpd;
+inline constexpr Instruction<VMULSS> vmulss;
+inline constexpr Instruction<VMULSD> vmulsd;
+inline constexpr Instruction<VMULPS> vmulps;
+inline constexpr Instruction<VMULPD> vmulpd;
+inline constexpr Instruction<VDIVSS> vdivss;
+inline constexpr Instruction<VDIVSD> vdivsd;
+inline constexpr Instruction<VDIVPS> vdivps;
+inline constexpr Instruction<VDIVPD> vdivpd;
+inline constexpr Instruction<VPADDD> vpaddd;
+inline constexpr Instruction<VPADDQ> vpaddq;
+inline constexpr Instruction<VPSUBD> vpsubd;
+inline constexpr Instruction<VPSUBQ> vpsubq;
+inline constexpr Instruction<VPAND> vpand;
+inline constexpr Instruction<VPOR> vpor;
+inline constexpr Instruction<VPXOR> vpxor;
+inline constexpr Instruction<VFMADD231SS> vfmadd231ss;
+inline constexpr Instruction<VFMADD231SD> vfmadd231sd;
+inline constexpr Instruction<VFMADD231PS> vfmadd231ps;
+inline constexpr Instruction<VFMADD231PD> vfmadd231pd;
+inline constexpr Instruction<VFMSUB231SS> vfmsub231ss;
+inline constexpr Instruction<VFMSUB231SD> vfmsub231sd;
+inline constexpr Instruction<VFMSUB231PS> vfmsub231ps;
+inline constexpr Instruction<VFMSUB231PD> vfmsub231pd;
+inline constexpr Instruction<VFNMADD231SS> vfnmadd231ss;
+inline constexpr Instruction<VFNMADD231SD> vfnmadd231sd;
+inline constexpr Instruction<VFNMADD231PS> vfnmadd231ps;
+inline constexpr Instruction<VFNMADD231PD> vfnmadd231pd;
+inline constexpr Instruction<SHLX> shlx;
+inline constexpr Instruction<SARX> sarx;
+inline constexpr Instruction<SHRX> shrx;
+inline constexpr Instruction<ANDN> andn;
+inline constexpr Instruction<POPCNT> popcnt;
+inline constexpr Instruction<LZCNT> lzcnt;
+inline constexpr Instruction<TZCNT> tzcnt;
 
 static_assert(mov(RAX, 42) == "mov rax, 42");
 static_assert(add(Address{RAX}, 42) == "add [rax], 42");
@@ -61,6 +61,12 @@ enum class OpCode {
     JLE,
     JG,
     JGE,
+    JB,
+    JBE,
+    JA,
+    JAE,
+    JP,
+    JNP,
     JS,
     TEST,
     SYSCALL,
@@ -84,6 +90,68 @@ enum class OpCode {
     MULSD,
     DIVSS,
     DIVSD,
+    MOVD,
+    MOVAPS,
+    MOVUPS,
+    MOVUPD,
+    MOVDQU,
+    PSHUFD,
+    PADDD,
+    PADDQ,
+    PSUBD,
+    PSUBQ,
+    PAND,
+    POR,
+    ADDPS,
+    ADDPD,
+    SUBPS,
+    SUBPD,
+    MULPS,
+    MULPD,
+    DIVPS,
+    DIVPD,
+    VADDSS,
+    VADDSD,
+    VADDPS,
+    VADDPD,
+    VSUBSS,
+    VSUBSD,
+    VSUBPS,
+    VSUBPD,
+    VMULSS,
+    VMULSD,
+    VMULPS,
+    VMULPD,
+    VDIVSS,
+    VDIVSD,
+    VDIVPS,
+    VDIVPD,
+    VPADDD,
+    VPADDQ,
+    VPSUBD,
+    VPSUBQ,
+    VPAND,
+    VPOR,
+    VPXOR,
+    VFMADD231SS,
+    VFMADD231SD,
+    VFMADD231PS,
+    VFMADD231PD,
+    VFMSUB231SS,
+    VFMSUB231SD,
+    VFMSUB231PS,
+    VFMSUB231PD,
+    VFNMADD231SS,
+    VFNMADD231SD,
+    VFNMADD231PS,
+    VFNMADD231PD,
+    SHLX,
+    SARX,
+    SHRX,
+    ANDN,
+    POPCNT,
+    LZCNT,
+    TZCNT,
 };
 
 constexpr std::string to_string(OpCode op) {
@@ -203,6 +271,18 @@ constexpr std::string to_string(OpCode op) {
             return "jg";
         case JGE:
             return "jge";
+        case JB:
+            return "jb";
+        case JBE:
+            return "jbe";
+        case JA:
+            return "ja";
+        case JAE:
+            return "jae";
+        case JP:
+            return "jp";
+        case JNP:
+            return "jnp";
         case JS:
             return "js";
         case TEST:
@@ -249,6 +329,130 @@ constexpr std::string to_string(OpCode op) {
             return "divss";
         case DIVSD:
             return "divsd";
+        case MOVD:
+            return "movd";
+        case MOVAPS:
+            return "movaps";
+        case MOVUPS:
+            return "movups";
+        case MOVUPD:
+            return "movupd";
+        case MOVDQU:
+            return "movdqu";
+        case PSHUFD:
+            return "pshufd";
+        case PADDD:
+            return "paddd";
+        case PADDQ:
+            return "paddq";
+        case PSUBD:
+            return "psubd";
+        case PSUBQ:
+            return "psubq";
+        case PAND:
+            return "pand";
+        case POR:
+            return "por";
+        case ADDPS:
+            return "addps";
+        case ADDPD:
+            return "addpd";
+        case SUBPS:
+            return "subps";
+        case SUBPD:
+            return "subpd";
+        case MULPS:
+            return "mulps";
+        case MULPD:
+            return "mulpd";
+        case DIVPS:
+            return "divps";
+        case DIVPD:
+            return "divpd";
+        case VADDSS:
+            return "vaddss";
+        case VADDSD:
+            return "vaddsd";
+        case VADDPS:
+            return "vaddps";
+        case VADDPD:
+            return "vaddpd";
+        case VSUBSS:
+            return "vsubss";
+        case VSUBSD:
+            return "vsubsd";
+        case VSUBPS:
+            return "vsubps";
+        case VSUBPD:
+            return "vsubpd";
+        case VMULSS:
+            return "vmulss";
+        case VMULSD:
+            return "vmulsd";
+        case VMULPS:
+            return "vmulps";
+        case VMULPD:
+            return "vmulpd";
+        case VDIVSS:
+            return "vdivss";
+        case VDIVSD:
+            return "vdivsd";
+        case VDIVPS:
+            return "vdivps";
+        case VDIVPD:
+            return "vdivpd";
+        case VPADDD:
+            return "vpaddd";
+        case VPADDQ:
+            return "vpaddq";
+        case VPSUBD:
+            return "vpsubd";
+        case VPSUBQ:
+            return "vpsubq";
+        case VPAND:
+            return "vpand";
+        case VPOR:
+            return "vpor";
+        case VPXOR:
+            return "vpxor";
+        case VFMADD231SS:
+            return "vfmadd231ss";
+        case VFMADD231SD:
+            return "vfmadd231sd";
+        case VFMADD231PS:
+            return "vfmadd231ps";
+        case VFMADD231PD:
+            return "vfmadd231pd";
+        case VFMSUB231SS:
+            return "vfmsub231ss";
+        case VFMSUB231SD:
+            return "vfmsub231sd";
+        case VFMSUB231PS:
+            return "vfmsub231ps";
+        case VFMSUB231PD:
+            return "vfmsub231pd";
+        case VFNMADD231SS:
+            return "vfnmadd231ss";
+        case VFNMADD231SD:
+            return "vfnmadd231sd";
+        case VFNMADD231PS:
+            return "vfnmadd231ps";
+        case VFNMADD231PD:
+            return "vfnmadd231pd";
+        case SHLX:
+            return "shlx";
+        case SARX:
+            return "sarx";
+        case SHRX:
+            return "shrx";
+        case ANDN:
+            return "andn";
+        case POPCNT:
+            return "popcnt";
+        case LZCNT:
+            return "lzcnt";
+        case TZCNT:
+            return "tzcnt";
         default:
             return "???";
     }
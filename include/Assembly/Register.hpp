@@ -1,6 +1,7 @@
 #pragma once
 #include <array>
 #include <string>
+#include <utility>
 
 namespace yoctocc {
 
@@ -149,6 +150,21 @@ static constexpr std::array ARG_REGISTERS128 = {
     XMM7,
 };
 
+// 64 ビットの汎用レジスタを size バイトの名前にする
+inline constexpr Register sized(Register reg, int size) {
+    const int index = std::to_underlying(reg) - std::to_underlying(RAX);
+    switch (size) {
+        case 1:
+            return static_cast<Register>(std::to_underlying(AL) + index);
+        case 2:
+            return static_cast<Register>(std::to_underlying(AX) + index);
+        case 4:
+            return static_cast<Register>(std::to_underlying(EAX) + index);
+        default:
+            return reg;
+    }
+}
+
 inline constexpr std::string to_string(Register reg) {
     switch (reg) {
         case XMM0:
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace yoctocc {
+
+struct Type;
+
+// System V ABI (x86-64) の引数の渡し方
+namespace abi {
+
+constexpr int INTEGER_ARGUMENT_REGISTERS = 6;
+constexpr int FLOAT_ARGUMENT_REGISTERS = 8;
+
+// レジスタで渡す 8 バイトの種類
+enum class ArgumentClass {
+    // rdi, rsi, rdx, rcx, r8, r9
+    INTEGER,
+    // xmm0 - xmm7
+    SSE,
+};
+
+// 1 つの引数を渡す場所
+struct ArgumentLocation {
+    // レジスタに入りきらない引数と 16 バイトを超える構造体は、call の時点の rsp + stackOffset に置く
+    bool onStack = false;
+    int stackOffset = 0;
+    // レジスタで渡すときの 8 バイトごとの種類とレジスタの番号 (ARG_REGISTERS64 / ARG_REGISTERS128 の添字)
+    int eightbytes = 0;
+    std::array<ArgumentClass, 2> classes{};
+    std::array<int, 2> registers{};
+};
+
+struct ArgumentLayout {
+    std::vector<ArgumentLocation> arguments;
+    // 使った引数レジスタの数 (可変長引数の関数では al と __va_area__ に使う)
+    int integerRegisters = 0;
+    int floatRegisters = 0;
+    // スタックで渡す引数の領域の大きさ (16 バイトの倍数)
+    int stackSize = 0;
+    // 16 バイトに揃える前の大きさ。可変長引数の関数では、名前のない引数がスタックのこの位置から始まる
+    int stackUsed = 0;
+};
+
+// 引数の型の並びから、それぞれを渡すレジスタとスタック上の位置を決める。
+// 構造体・共用体は 8 バイトごとに分類し、すべてがレジスタに入るときだけレジスタで渡す
+ArgumentLayout layoutArguments(std::span<const Type* const> types);
+
+// type の [begin, end) バイトに浮動小数点数しかないか (その 8 バイトを SSE で渡すか)
+bool isFloatOnly(const Type* type, int begin, int end, int offset = 0);
+
+// レジスタで渡す index 番目の 8 バイトの大きさ (構造体の末尾では 8 より小さい)
+int eightbyteSize(const Type* type, int index);
+
+} // namespace abi
+
+} // namespace yoctocc
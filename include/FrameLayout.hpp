@@ -0,0 +1,34 @@
+#pragma once
+
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace yoctocc {
+
+// スタックフレーム上のローカル変数の配置
+namespace frame {
+
+// 配置する 1 つの領域
+struct FrameObject {
+    int size = 0;
+    int alignment = 1;
+    // 生存範囲 (Object::lifetimeBegin / lifetimeEnd)。重ならない領域は同じ場所を使える
+    int lifetimeBegin = 0;
+    int lifetimeEnd = std::numeric_limits<int>::max();
+};
+
+struct FrameLayout {
+    // objects と同じ順に、フレームの上端 (rbp) からの位置 (負の値)
+    std::vector<int> offsets;
+    // 使う領域の大きさ (STACK_ALIGNMENT には揃えていない)
+    int size = 0;
+};
+
+// 揃える境界の大きいものから順に、生存範囲の重なる領域とぶつからない最も浅い位置に置く。
+// 生存範囲が重ならない領域 (兄弟の複合文の変数など) は同じ場所を共有する
+FrameLayout layoutObjects(std::span<const FrameObject> objects);
+
+} // namespace frame
+
+} // namespace yoctocc
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Assembly/Address.hpp"
+#include "Assembly/ConstantPool.hpp"
+#include "CallingConvention.hpp"
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -11,20 +14,35 @@ struct Node;
 struct Object;
 struct Type;
 
+namespace optimizer {
+class PassManager;
+}
+
 class Generator final {
 public:
+    Generator() = default;
+    // 関数ごとの命令列に passManager の命令レベルのパスを適用する
+    explicit Generator(optimizer::PassManager& passManager) : passManager(&passManager) {
+    }
+
     std::vector<std::string> run(Object* obj);
 
 private:
     void cast(const Node* node);
     void load(const Type* type);
+    void loadFloatConstant(Register reg, const Node* node);
     void store(const Type* type);
     void storeIntegerArgs(int reg, int offset, int size);
     void storeFloatArgs(int reg, int offset, int size);
     void assignLocalVariableOffsets(Object* obj);
     void generateAddress(const Node* node);
     void generateStatement(const Node* node);
-    void pushArgs(const Node* node);
+    void generateArguments(const Node* arguments, const abi::ArgumentLayout& layout);
+    void storeStackArgument(const Type* type, int offset);
+    void loadArgument(const Node* node, const abi::ArgumentLocation& location);
+    void loadAggregateArgument(const Type* type, const abi::ArgumentLocation& location, Address<Register> address);
+    void loadEightbyte(Register reg, Address<Register> address, int size);
+    void copyMemory(Address<Register> to, Address<Register> from, int size);
     void generateExpression(const Node* node);
     void generateFunction(const Object* obj);
     void emitData(const Object* obj);
@@ -56,7 +74,9 @@ private:
     void emitLocation(const Node* node);
 
 private:
+    optimizer::PassManager* passManager = nullptr;
     std::vector<std::string> lines{};
+    ConstantPool constantPool;
     const Object* currentFunction = nullptr;
     uint64_t labelCount = 0UL;
     size_t lastEmittedLine = 0;
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "IR/IR.hpp"
+
+namespace yoctocc::ir {
+
+// 入口から到達できるブロックの逆後順 (reverse post order)
+std::vector<BasicBlock*> reversePostOrder(const Function& function);
+
+// スカラー変数のアドレスを加減算・比較に使う関数は、範囲外のポインタで隣の変数を読み書きしうる。
+// そうした関数では変数をレジスタに昇格せず、フレームの配置をスタックマシンと同じにする
+bool observesFrameLayout(const Function& function);
+
+// アドレスの由来 (FrameSlot / グローバル変数) をたどる保守的な別名解析。
+// ADD / SUB は両辺をたどり、定数・乗算・シフト・拡張は添字とみなす。それ以外の値から来たアドレスは
+// 由来不明で、アドレスが外へ出た (メモリに書かれた・呼び出し先に渡った) FrameSlot かグローバル変数を指しうる
+class AliasAnalysis final {
+public:
+    explicit AliasAnalysis(const Function& function);
+
+    // address から size バイトのメモリを instruction (STORE / CLEAR / COPY_MEMORY / CALL) が書き換えうるか
+    [[nodiscard]] bool mayModify(const Instruction* instruction, const Instruction* address, int64_t size) const;
+    // address から size バイトを読んでも必ず有効なメモリか (FrameSlot の範囲内かグローバル変数の先頭)
+    [[nodiscard]] bool isDereferenceable(const Instruction* address, int64_t size) const;
+    [[nodiscard]] bool escapes(int64_t slot) const {
+        return _escaped[static_cast<size_t>(slot)];
+    }
+
+private:
+    struct Roots {
+        bool unknown = false;
+        // FRAME_ADDRESS / GLOBAL_ADDRESS 命令
+        std::vector<const Instruction*> bases;
+    };
+
+    const Roots& roots(const Instruction* address) const;
+    // 由来不明のアドレスが指しうるもの (グローバル変数か外へ出た FrameSlot) を含むか
+    [[nodiscard]] bool isExposed(const Roots& roots) const;
+    [[nodiscard]] static bool sameBase(const Instruction* a, const Instruction* b);
+    // FRAME_ADDRESS / GLOBAL_ADDRESS に定数を足しただけのアドレスなら、その基底と変位
+    [[nodiscard]] static std::pair<const Instruction*, int64_t> decompose(const Instruction* address);
+
+    const Function& _function;
+    // 範囲外のポインタで隣の変数に届く関数では、FrameSlot 同士も別名になりうる
+    bool _frameLayoutObserved;
+    std::vector<bool> _escaped;
+    mutable std::vector<Roots> _roots;
+    mutable std::vector<bool> _computed;
+};
+
+// 支配木 (Cooper, Harvey, Kennedy "A Simple, Fast Dominance Algorithm")。
+// ブロックを追加・削除したら作り直す
+class DominatorTree final {
+public:
+    explicit DominatorTree(const Function& function);
+
+    // 入口と到達できないブロックは nullptr
+    [[nodiscard]] BasicBlock* idom(const BasicBlock* block) const {
+        return _idom[block->id];
+    }
+    [[nodiscard]] const std::vector<BasicBlock*>& children(const BasicBlock* block) const {
+        return _children[block->id];
+    }
+    [[nodiscard]] bool isReachable(const BasicBlock* block) const {
+        return _rpoIndex[block->id] >= 0;
+    }
+    // a が b を支配するか (a == b も真)
+    [[nodiscard]] bool dominates(const BasicBlock* a, const BasicBlock* b) const;
+    // 命令 a が命令 b より前で実行されることが保証されているか
+    [[nodiscard]] bool dominates(const Instruction* a, const Instruction* b) const;
+    [[nodiscard]] const std::vector<BasicBlock*>& reversePostOrder() const {
+        return _order;
+    }
+    // 支配辺境 (dominance frontier)
+    [[nodiscard]] std::vector<std::vector<BasicBlock*>> frontiers() const;
+
+private:
+    std::vector<BasicBlock*> _order;
+    std::vector<int> _rpoIndex;
+    std::vector<BasicBlock*> _idom;
+    std::vector<std::vector<BasicBlock*>> _children;
+    // 支配木の DFS の入り順と出順 (dominates を O(1) で答える)
+    std::vector<uint32_t> _enter;
+    std::vector<uint32_t> _leave;
+};
+
+} // namespace yoctocc::ir
@@ -0,0 +1,238 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace yoctocc {
+struct Object;
+}
+
+// -O1 以上で使う SSA 形式の中間表現。
+// 関数は基本ブロックの列で、各ブロックは PHI 命令 → 通常の命令 → 終端命令 (BR / CONDBR / RET) の順に並ぶ。
+// 命令そのものが値 (仮想レジスタ) を表し、operands で他の命令の結果を参照する。
+namespace yoctocc::ir {
+
+enum class ValueType {
+    VOID,
+    // char / short / int / bool / enum は 32 ビットに符号拡張またはゼロ拡張した値として扱う
+    I32,
+    // long / ポインタ / 配列や構造体のアドレス
+    I64,
+    F32,
+    F64,
+    // xmm レジスタ 1 本分 (16 バイト) のベクトル。loop-vectorize だけが作る
+    V4I32,
+    V2I64,
+    V4F32,
+    V2F64,
+};
+
+enum class Opcode {
+    // immediate: 値 (浮動小数点数はビット列)
+    CONST,
+    // immediate: 整数 / 浮動小数点数それぞれの引数レジスタの番号
+    // (レジスタの数以上なら、スタックで受け取る引数の (immediate - レジスタの数) 番目の 8 バイト)
+    PARAM,
+    // immediate: Function::slots の番号
+    FRAME_ADDRESS,
+    // symbol: グローバル変数か関数の名前
+    GLOBAL_ADDRESS,
+
+    ADD,
+    SUB,
+    MUL,
+    SDIV,
+    UDIV,
+    SREM,
+    UREM,
+    AND,
+    OR,
+    XOR,
+    SHL,
+    SHR,
+    SAR,
+    NEG,
+    NOT,
+    // 立っているビットの数 (loop-idiom だけが作る)
+    POPCOUNT,
+    // 上位 / 下位から続く 0 のビットの数。0 ならビット幅 (loop-idiom だけが作る)
+    CLZ,
+    CTZ,
+
+    FADD,
+    FSUB,
+    FMUL,
+    FDIV,
+    FNEG,
+    // ベクトルは ADD / SUB / AND / OR / XOR と FADD / FSUB / FMUL / FDIV を要素ごとに計算する
+
+    // operands: {スカラー}, スカラーをすべての要素に並べたベクトル
+    SPLAT,
+    // operands: {整数のベクトル}, immediate: 要素をまとめる演算 (Opcode::ADD / AND / OR / XOR)
+    REDUCE,
+
+    // condition で比較し、I32 の 0 / 1 を返す
+    CMP,
+    FCMP,
+
+    // I32 -> I64
+    SEXT,
+    ZEXT,
+    // I64 -> I32
+    TRUNC,
+    // I32 の下位 immediate ビットを isSigned に従って拡張する (char / short への変換)
+    EXTEND,
+    SITOFP,
+    // 符号なし 64 ビット整数 -> 浮動小数点数
+    UITOFP,
+    FPTOSI,
+    FPEXT,
+    FPTRUNC,
+
+    // operands: {アドレス}, immediate: バイト数, isSigned: 符号拡張するか
+    LOAD,
+    // operands: {アドレス, 値}, immediate: バイト数
+    STORE,
+    // operands: {アドレス}, immediate: バイト数
+    CLEAR,
+    // operands: {コピー先, コピー元}, immediate: バイト数
+    COPY_MEMORY,
+    // symbol: 関数名, operands: 引数 (構造体は 8 バイトごとの値。レジスタに収まらないものはスタックで渡す)
+    CALL,
+
+    // operands[i] は blocks[i] から来たときの値
+    PHI,
+    // SSA を解体した後に使うレジスタ間のコピー
+    COPY,
+
+    // blocks: {分岐先}
+    BR,
+    // operands: {条件}, blocks: {真, 偽}
+    CONDBR,
+    // operands: {} または {戻り値}
+    RET,
+};
+
+// FCMP は NE 以外は順序付きの比較 (NaN なら偽) で、NE だけは NaN なら真
+enum class Condition {
+    EQ,
+    NE,
+    LT,
+    LE,
+    GT,
+    GE,
+    ULT,
+    ULE,
+    UGT,
+    UGE,
+};
+
+struct BasicBlock;
+
+struct Instruction {
+    Opcode opcode;
+    ValueType type = ValueType::VOID;
+    std::vector<Instruction*> operands;
+    std::vector<BasicBlock*> blocks;
+    BasicBlock* parent = nullptr;
+    int64_t immediate = 0;
+    Condition condition = Condition::EQ;
+    bool isSigned = false;
+    // CALL: 可変長引数の関数なら al に使った xmm レジスタの数を入れる
+    bool isVariadic = false;
+    // CALL: 直後の RET がこの値を返すだけなので、フレームを片付けてから jmp で呼ぶ (tail-call が付ける)
+    bool isTail = false;
+    std::string symbol;
+    uint32_t id = 0;
+    // .loc に使うソースの行
+    size_t line = 0;
+
+    [[nodiscard]] bool isTerminator() const noexcept {
+        return opcode == Opcode::BR || opcode == Opcode::CONDBR || opcode == Opcode::RET;
+    }
+    // 結果を使われなくても消してはいけない命令
+    [[nodiscard]] bool hasSideEffects() const noexcept;
+    [[nodiscard]] bool isFloat() const noexcept {
+        return type == ValueType::F32 || type == ValueType::F64;
+    }
+    [[nodiscard]] bool isVector() const noexcept;
+};
+
+struct BasicBlock {
+    uint32_t id = 0;
+    std::vector<std::unique_ptr<Instruction>> instructions;
+    // Function::recomputeControlFlow で更新する
+    std::vector<BasicBlock*> predecessors;
+    std::vector<BasicBlock*> successors;
+
+    Instruction* terminator() const noexcept {
+        return instructions.empty() || !instructions.back()->isTerminator() ? nullptr : instructions.back().get();
+    }
+    Instruction* append(std::unique_ptr<Instruction> instruction);
+    // position の直前に挿入する (nullptr なら終端命令の直前)
+    Instruction* insertBefore(const Instruction* position, std::unique_ptr<Instruction> instruction);
+    // PHI 命令の直後に挿入する
+    Instruction* insertAfterPhis(std::unique_ptr<Instruction> instruction);
+    std::unique_ptr<Instruction> remove(const Instruction* instruction);
+};
+
+// 変数 (アドレスを取られる・配列や構造体などでレジスタに置けないもの) と一時領域のスタック上の場所
+struct FrameSlot {
+    std::string name;
+    int size = 0;
+    int alignment = 1;
+    const Object* variable = nullptr;
+};
+
+struct Function {
+    const Object* object = nullptr;
+    std::string name;
+    ValueType returnType = ValueType::VOID;
+    // blocks[0] が入口
+    std::vector<std::unique_ptr<BasicBlock>> blocks;
+    std::vector<FrameSlot> slots;
+    uint32_t nextValueId = 0;
+    uint32_t nextBlockId = 0;
+
+    BasicBlock* createBlock();
+    std::unique_ptr<Instruction> create(Opcode opcode, ValueType type, std::initializer_list<Instruction*> operands = {});
+
+    void recomputeControlFlow();
+    // 入口から到達できないブロックを削除する (PHI の流入元も取り除く)。削除したブロック数を返す
+    size_t removeUnreachableBlocks();
+    // 置き換え先が連鎖していても最終的な値に置き換える
+    void replaceUses(const std::unordered_map<Instruction*, Instruction*>& replacements);
+    // 命令ごとの使用回数
+    [[nodiscard]] std::unordered_map<const Instruction*, size_t> countUses() const;
+    [[nodiscard]] size_t instructionCount() const;
+};
+
+// ベクトルの要素の型 (スカラーはそのまま)
+[[nodiscard]] ValueType elementType(ValueType type);
+// 要素の型を element とする 16 バイトのベクトルの型
+[[nodiscard]] ValueType vectorType(ValueType element);
+[[nodiscard]] inline bool isVectorType(ValueType type) {
+    return elementType(type) != type;
+}
+
+[[nodiscard]] std::string_view to_string(ValueType type);
+[[nodiscard]] std::string_view to_string(Opcode opcode);
+[[nodiscard]] std::string_view to_string(Condition condition);
+
+[[nodiscard]] inline bool isCommutative(Opcode opcode) {
+    using enum Opcode;
+    return opcode == ADD || opcode == MUL || opcode == AND || opcode == OR || opcode == XOR || opcode == FADD ||
+           opcode == FMUL;
+}
+
+// a op b が b op' a になる条件
+[[nodiscard]] Condition swapCondition(Condition condition);
+// !(a op b) が a op' b になる条件 (整数の比較のみ)
+[[nodiscard]] Condition invertCondition(Condition condition);
+
+} // namespace yoctocc::ir
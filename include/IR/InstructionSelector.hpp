@@ -0,0 +1,19 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "IR/IR.hpp"
+#include "IR/Target.hpp"
+
+namespace yoctocc {
+class ConstantPool;
+}
+
+namespace yoctocc::ir {
+
+// レジスタを割り当て、関数本体 (プロローグからすべての RET のエピローグまで) の命令列を作る。
+// 関数名のラベルと .globl などは呼び出し側 (Generator) が出力する。
+// target で使える拡張命令 (BMI / AVX / FMA など) があれば使う。
+// 浮動小数点数の定数と符号のマスクは翻訳単位で共有する constantPool に置く
+std::vector<std::string> selectInstructions(Function& function, const Target& target, ConstantPool& constantPool);
+
+} // namespace yoctocc::ir
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "IR/Analysis.hpp"
+#include "IR/IR.hpp"
+
+namespace yoctocc::ir {
+
+// 自然ループ (ヘッダが支配するブロックからヘッダへ戻る辺で囲まれた部分)。
+// 同じヘッダへ戻る辺が複数あればひとつのループにまとめる
+struct Loop {
+    BasicBlock* header = nullptr;
+    // header を含む本体 (逆後順)
+    std::vector<BasicBlock*> blocks;
+    // 本体の外へ出る辺を持つブロック
+    std::vector<BasicBlock*> exiting;
+    // ブロックの id ごとに本体に含まれるか
+    std::vector<bool> members;
+
+    [[nodiscard]] bool contains(const BasicBlock* block) const {
+        return block->id < members.size() && members[block->id];
+    }
+};
+
+// 内側のループ (本体の小さいもの) から順に返す。CFG を変えたら作り直す
+std::vector<Loop> findLoops(const Function& function, const DominatorTree& dominators);
+
+// ループの外から header へ入る辺をひとつのブロック (前ヘッダ) にまとめて返す。
+// 既に前ヘッダがあればそれを返し、header が入口ブロックなら nullptr を返す。
+// 新しく作った場合は CFG が変わるので、支配木とループを作り直すこと
+BasicBlock* insertPreheader(Function& function, const Loop& loop);
+
+// header の前ヘッダ (ループの外からの唯一の先行ブロックで、後続が header だけのもの)。なければ nullptr
+BasicBlock* preheaderOf(const Loop& loop);
+
+// 1 ブロックで、末尾の i + step と不変な n の比較で戻るループ (loop-rotate 後の for) の帰納変数
+struct InductionVariable {
+    // 本体の先頭の PHI
+    Instruction* phi;
+    // i + step
+    Instruction* next;
+    int64_t step;
+    Instruction* bound;
+    // 条件が成り立つ間ループを続ける (next condition bound)
+    Condition condition;
+    // 末尾の比較
+    Instruction* compare;
+};
+
+// body が exit へ抜ける 1 ブロックの計数ループなら、その帰納変数。
+// 単調に条件へ近づく組み合わせ (増やしながら < / <=、減らしながら > / >=) だけを認める
+std::optional<InductionVariable> findInductionVariable(BasicBlock* body, const BasicBlock* exit);
+
+// 帰納変数と比べる n を、ループの条件に合わせて 64 ビットに広げる値を block の末尾に置く
+Instruction* widenBound(Function& function, BasicBlock* block, const InductionVariable& induction);
+
+// 帰納変数の値 value からさらに count 回ループを続けられるか (value + (count - 1) * step が条件を満たすか)
+// を調べる比較を block の末尾に置く。bound は widenBound の結果で、64 ビットで比べるので桁あふれしない
+Instruction* appendTripCheck(Function& function, BasicBlock* block, const InductionVariable& induction,
+                             Instruction* bound, Instruction* value, int64_t count);
+
+} // namespace yoctocc::ir
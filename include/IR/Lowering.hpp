@@ -0,0 +1,13 @@
+#pragma once
+#include <memory>
+#include "IR/IR.hpp"
+
+namespace yoctocc::ir {
+
+// 関数定義の構文木を IR に変換する。
+// すべての変数は FrameSlot に置き、読み書きは LOAD / STORE で表す (レジスタへの昇格は mem2reg が行う)。
+// IR で表せない関数 (可変長引数・構造体の戻り値・レジスタに収まらない引数) なら nullptr を返すので、
+// 呼び出し側はスタックマシンの Generator で生成する
+std::unique_ptr<Function> lower(const Object* function);
+
+} // namespace yoctocc::ir
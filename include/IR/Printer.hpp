@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include "IR/IR.hpp"
+
+namespace yoctocc::ir {
+
+// -fdump-ir で出力するテキスト形式
+// 例: "%3 = add i32 %1, %2"
+std::string to_string(const Instruction& instruction);
+void print(const Function& function, std::FILE* out);
+
+} // namespace yoctocc::ir
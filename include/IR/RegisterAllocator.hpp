@@ -0,0 +1,56 @@
+#pragma once
+#include <vector>
+#include "Assembly/Register.hpp"
+#include "IR/IR.hpp"
+#include "IR/Target.hpp"
+
+namespace yoctocc::ir {
+
+// 値の置き場所
+struct Location {
+    enum class Kind {
+        // レジスタを割り当てない (使われない値、または使う場所で作り直す値)
+        NONE,
+        REGISTER,
+        // スピル領域 (8 バイトずつ。ベクトルは spillSlot とその上の 2 つ分)
+        STACK,
+    };
+    Kind kind = Kind::NONE;
+    Register reg = Register::RAX;
+    int spillSlot = 0;
+    // 16 バイトのベクトル (xmm レジスタ全体を転送する)
+    bool isVector = false;
+
+    [[nodiscard]] bool operator==(const Location& other) const noexcept {
+        return kind == other.kind && (kind != Kind::REGISTER || reg == other.reg) &&
+               (kind != Kind::STACK || spillSlot == other.spillSlot);
+    }
+};
+
+struct Allocation {
+    // ブロックの配置順 (逆後順を基本に、ループへ戻る辺のコピーだけのブロックをヘッダの直前へ移したもの)
+    std::vector<BasicBlock*> order;
+    // ブロックの id ごとに、ループの先頭として配置を揃えるか
+    std::vector<bool> loopHeads;
+    // 値の id ごとの置き場所
+    std::vector<Location> locations;
+    // 値の id ごとに、単独では命令を生成せず使う側に埋め込むか
+    // (定数とアドレス、直後の CONDBR で使う比較、LOAD / STORE の変位にできる加算、andn / FMA にまとめる演算)
+    std::vector<bool> inlined;
+    // 使った callee-saved レジスタ (プロローグで退避する)
+    std::vector<Register> calleeSaved;
+    int spillSlots = 0;
+};
+
+// 使う場所で作り直す値 (定数とアドレス)
+[[nodiscard]] inline bool isRematerializable(const Instruction* value) {
+    return value->opcode == Opcode::CONST || value->opcode == Opcode::FRAME_ADDRESS ||
+           value->opcode == Opcode::GLOBAL_ADDRESS;
+}
+
+// 命令選択の前に CFG を整え (臨界辺の分割など)、線形走査法でレジスタを割り当てる。
+// PHI は先行ブロックの末尾での並列コピーとして扱う。
+// rax / rcx / rdx / r11 / xmm0 / xmm1 は命令選択の一時レジスタとして残しておく
+Allocation allocateRegisters(Function& function, const Target& target);
+
+} // namespace yoctocc::ir
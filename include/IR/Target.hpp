@@ -0,0 +1,33 @@
+#pragma once
+
+namespace yoctocc::ir {
+
+// 命令選択で使ってよい拡張命令 (-march のマイクロアーキテクチャレベルと -ffp-contract から決める) とフレームの作り方
+struct Target {
+    // x86-64-v2: popcnt
+    bool hasPopcnt = false;
+    // x86-64-v3: BMI1 / BMI2 (andn, tzcnt, shlx / sarx / shrx) と lzcnt
+    bool hasBmi = false;
+    // x86-64-v3: VEX 形式の 3 オペランドの浮動小数点数・ベクトル演算
+    bool hasAvx = false;
+    // x86-64-v3 かつ -ffp-contract=fast: a * b ± c を FMA 命令にまとめる
+    bool contractsFloat = false;
+    // -fomit-frame-pointer: フレームを rsp から参照し、rbp もレジスタ割り当てに使う
+    bool omitsFramePointer = false;
+    // -fshrink-wrap: 入口で引数を比べるだけで抜ける経路は、プロローグの前で分岐してフレームを作らずに戻る
+    bool shrinkWraps = false;
+    // -fstack-coloring: 生存範囲の重ならない FrameSlot に同じ場所を使い、揃える境界の大きい順に並べる
+    bool colorsStackSlots = false;
+
+    // x86-64-v4 の AVX-512 は使わないので v3 と同じ
+    [[nodiscard]] static Target ofLevel(int isaLevel, bool contractFloat) {
+        return Target{
+            .hasPopcnt = isaLevel >= 2,
+            .hasBmi = isaLevel >= 3,
+            .hasAvx = isaLevel >= 3,
+            .contractsFloat = isaLevel >= 3 && contractFloat,
+        };
+    }
+};
+
+} // namespace yoctocc::ir
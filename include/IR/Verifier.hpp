@@ -0,0 +1,11 @@
+#pragma once
+#include <string_view>
+#include "IR/IR.hpp"
+
+namespace yoctocc::ir {
+
+// 構造 (終端命令・PHI の位置と流入元)、定義が使用を支配していること、型の整合性を調べる。
+// 壊れていれば after (直前に実行したパスの名前) を添えてエラー終了する
+void verify(const Function& function, std::string_view after);
+
+} // namespace yoctocc::ir
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yoctocc {
+
+struct Object;
+struct Type;
+
+namespace interpreter {
+
+// Generator の castTable と同じ分類
+enum class ValueType : uint8_t {
+    I8,
+    I16,
+    I32,
+    I64,
+    U8,
+    U16,
+    U32,
+    U64,
+    F32,
+    F64,
+};
+
+ValueType valueTypeOf(const Type* type);
+
+// スタックマシンのバイトコード。
+// 値はすべて 64 ビットのスロットに入り、整数は型に合わせて符号/ゼロ拡張、
+// float は下位 32 ビット、double は 64 ビットのビット列で持つ。
+enum class Op : uint8_t {
+    PUSH,           // imm をプッシュ
+    LOCAL_ADDRESS,  // フレーム末尾 + imm をプッシュ
+    LOAD,           // アドレスをポップして type で読み込む
+    STORE,          // 値とアドレスをポップして type で書き込み、値をプッシュ
+    STORE_BLOCK,    // 構造体のコピー (imm バイト)
+    MEMORY_CLEAR,   // フレーム末尾 + imm から imm2 バイトをゼロクリア
+    POP,
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MOD,
+    BIT_AND,
+    BIT_OR,
+    BIT_XOR,
+    SHL,
+    SHR,
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    NEGATE,
+    BIT_NOT,
+    NOT,
+    CAST,           // type から type2 へ
+    TO_BOOL,
+    JUMP,           // imm へ
+    JUMP_IF_ZERO,   // 値をポップして 0 なら imm へ
+    JUMP_IF_NOT_ZERO,
+    JUMP_IF_EQUAL,  // 先頭の値が imm と等しければポップして imm2 へ
+    CALL,           // 呼び出し情報 imm
+    RETURN,         // 値をポップして返す
+};
+
+struct Instruction {
+    Op op;
+    ValueType type = ValueType::I64;
+    ValueType type2 = ValueType::I64;
+    int64_t imm = 0;
+    int64_t imm2 = 0;
+};
+
+struct CallSite {
+    std::string name;
+    // 定義済み関数ならその番号、なければ -1 (ホスト関数)
+    int function = -1;
+    void* host = nullptr;
+    std::vector<ValueType> arguments;
+    // 構造体の引数はアドレスを値とし、ホスト関数に渡すときにこの型で分類する
+    std::vector<const Type*> argumentTypes;
+    // void なら nullptr
+    const Type* returnType = nullptr;
+    // 構造体を返す定義済み関数の呼び出しで、戻り値を写す呼び出し元の領域 (フレーム末尾からの位置)
+    int returnSlot = 0;
+};
+
+struct Function {
+    const Object* object = nullptr;
+    std::vector<Instruction> code;
+    int frameSize = 0;
+};
+
+} // namespace interpreter
+} // namespace yoctocc
@@ -0,0 +1,69 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Interpreter/Bytecode.hpp"
+
+namespace yoctocc {
+
+struct Node;
+struct Object;
+
+namespace interpreter {
+
+struct Program {
+    std::vector<Function> functions;
+    std::vector<CallSite> callSites;
+    std::unordered_map<std::string, int> functionIndices;
+};
+
+// Parser が作った Object / Node をスタックマシンのバイトコードに変換する。
+class BytecodeCompiler final {
+public:
+    // globalAddress: グローバル変数の実アドレス, externalFunction: 未定義関数の解決
+    BytecodeCompiler(std::function<void*(const Object*)> globalAddress,
+                     std::function<void*(const std::string&)> externalFunction);
+
+    // プログラム中の定義済み関数をすべて変換する
+    Program compile(Object* program);
+    // fn と、そこから呼ばれる関数だけを変換する (fn は program.functions[0] になる)
+    Program compileReachable(const Object* fn);
+
+private:
+    int registerFunction(const Object* fn);
+    void compilePending();
+    void assignLocalVariableOffsets(Object* fn, Function& function);
+    void compileFunction(const Object* fn, Function& function);
+    void compileStatement(const Node* node);
+    void compileExpression(const Node* node);
+    void compileAddress(const Node* node);
+    void compileCall(const Node* node);
+    // 今の関数のフレームに size バイトの領域を足し、フレーム末尾からの位置を返す
+    int allocateTemporary(int size, int alignment);
+    void compileLoad(const Type* type);
+    void compileStore(const Type* type);
+    void compileCondition(const Node* node, bool jumpIfZero, const std::string& label);
+
+    void emit(Op op, ValueType type = ValueType::I64, ValueType type2 = ValueType::I64, int64_t imm = 0,
+              int64_t imm2 = 0);
+    void emitJump(Op op, ValueType type, const std::string& label);
+    void defineLabel(const std::string& label);
+    std::string newLabel();
+
+    std::function<void*(const Object*)> _globalAddress;
+    std::function<void*(const std::string&)> _externalFunction;
+    Program _program;
+    // 変換待ちの関数番号
+    std::vector<int> _pending;
+    Function* _function = nullptr;
+    // 今の関数のローカル変数と一時領域が使う大きさ (STACK_ALIGNMENT に揃える前)
+    int _frameOffset = 0;
+    std::unordered_map<std::string, size_t> _labels;
+    // ラベル名と、そのラベルを参照する命令の位置
+    std::vector<std::pair<std::string, size_t>> _patches;
+    uint64_t _labelCount = 0;
+};
+
+} // namespace interpreter
+} // namespace yoctocc
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+namespace yoctocc {
+
+struct Node;
+
+namespace interpreter {
+
+// 定数式の中の関数呼び出しをコンパイル時に実行し、戻り値を返す。
+// 整数は型に合わせて符号拡張/ゼロ拡張した値、float/double はビット列のまま返す。
+// 呼び出せるのは定義済みで、グローバル変数や外部関数に触れない関数のみ。
+uint64_t evaluateConstantCall(const Node* node, std::span<const uint64_t> args);
+
+} // namespace interpreter
+} // namespace yoctocc
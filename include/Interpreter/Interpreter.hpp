@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Interpreter/BytecodeCompiler.hpp"
+#include "Runtime/HostLibrary.hpp"
+
+namespace yoctocc {
+
+struct Object;
+
+namespace interpreter {
+
+// 実行ステップ数と呼び出しの深さの上限 (0 なら無制限)
+struct ExecutionLimits {
+    uint64_t maxSteps = 0;
+    int maxDepth = 0;
+    // true なら実行中の関数のフレームの外を読み書きしたときにエラーにする (定数式の評価用)
+    bool checksMemory = false;
+};
+
+// Parser が作ったプログラムをバイトコードに変換して実行する。
+// ローカル変数やグローバル変数は実際のメモリに置くので、ポインタをそのままホスト関数に渡せる。
+class Interpreter final {
+public:
+    Interpreter(Object* program, const runtime::HostLibrary& host);
+    // グローバル変数もホスト関数も使わない、変換済みのプログラムを実行する
+    Interpreter(Program program, ExecutionLimits limits);
+
+    // main(argc, argv) を呼び出して戻り値を返す
+    int run(const std::string& programName);
+    // function 番目の関数を呼び出して戻り値を返す
+    uint64_t call(int function, std::span<const uint64_t> args, std::span<const ValueType> types);
+
+private:
+    void allocateGlobals(Object* program);
+    void* globalAddress(const Object* variable);
+    // returnSlot があれば、構造体の戻り値をそこへ写してそのアドレスを返す
+    uint64_t execute(const Function& function, std::span<const uint64_t> args, std::span<const ValueType> types,
+                     std::byte* returnSlot = nullptr);
+    uint64_t callHost(const CallSite& callSite, std::span<const uint64_t> args);
+    std::byte* allocate(size_t size, size_t alignment);
+    // checksMemory のとき、[address, address + size) が生きているフレームに収まらなければエラーにする
+    void checkAccess(const Object* fn, uint64_t address, size_t size) const;
+
+    const runtime::HostLibrary* _host = nullptr;
+    ExecutionLimits _limits;
+    uint64_t _steps = 0;
+    int _depth = 0;
+    // checksMemory のときに調べる、生きているフレームの [先頭, 末尾)
+    std::vector<std::pair<uintptr_t, uintptr_t>> _frames;
+    std::vector<std::unique_ptr<std::byte[]>> _memory;
+    std::unordered_map<std::string, void*> _globals;
+    Program _program;
+};
+
+} // namespace interpreter
+} // namespace yoctocc
@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace yoctocc::jit {
+
+enum class SectionKind {
+    TEXT,
+    DATA,
+    BSS,
+};
+
+struct Symbol {
+    SectionKind section;
+    size_t offset;
+    bool isFunction = false;
+};
+
+enum class FixupKind {
+    // rel32 (call / jmp / jcc)
+    BRANCH32,
+    // [rip + symbol] の disp32
+    RIP32,
+    // .quad symbol+addend
+    ABSOLUTE64,
+};
+
+struct Fixup {
+    FixupKind kind;
+    SectionKind section;
+    // パッチ位置
+    size_t offset;
+    // RIP 相対の基準となる命令末尾
+    size_t instructionEnd;
+    // lea の opcode 位置 (外部データ参照を GOT 経由の mov に書き換えるため)
+    size_t opcodeOffset;
+    std::string symbol;
+    int64_t addend;
+};
+
+// Generator が出力した Intel 記法のアセンブリを機械語に変換する。
+// 対応しているのは Generator が実際に出力する命令とディレクティブのみ。
+class Encoder final {
+public:
+    void encode(const std::vector<std::string>& lines);
+
+    [[nodiscard]] const std::vector<uint8_t>& text() const noexcept {
+        return _text;
+    }
+    [[nodiscard]] const std::vector<uint8_t>& data() const noexcept {
+        return _data;
+    }
+    [[nodiscard]] size_t bssSize() const noexcept {
+        return _bssSize;
+    }
+    [[nodiscard]] const std::map<std::string, Symbol>& symbols() const noexcept {
+        return _symbols;
+    }
+    [[nodiscard]] const std::vector<Fixup>& fixups() const noexcept {
+        return _fixups;
+    }
+
+private:
+    struct Operand;
+
+    void encodeLine(std::string_view line);
+    void encodeDirective(std::string_view line);
+    void encodeInstruction(std::string_view mnemonic, std::vector<Operand>& operands);
+    void defineLabel(std::string_view name);
+
+    Operand parseOperand(std::string_view text);
+    std::string resolveLabelReference(std::string_view name);
+
+    void emitByte(uint8_t value);
+    void emitImmediate(int64_t value, int size);
+    void emitRex(bool w, int reg, const Operand& rm, bool forceRex);
+    void emitModRM(int reg, const Operand& rm, int immediateSize);
+    void emitOp(uint8_t prefix, bool w, std::initializer_list<uint8_t> opcode, int reg, bool regIsByte,
+                const Operand& rm, int immediateSize = 0);
+    // VEX (L = 0) の命令。vvvv は 2 番目のオペランドのレジスタ番号
+    void emitVex(uint8_t pp, uint8_t map, bool w, uint8_t opcode, int reg, int vvvv, const Operand& rm);
+    void emitBranch(std::initializer_list<uint8_t> opcode, const Operand& target);
+
+    std::vector<uint8_t>& current();
+    size_t currentOffset();
+
+    std::vector<uint8_t> _text;
+    std::vector<uint8_t> _data;
+    size_t _bssSize = 0;
+    SectionKind _section = SectionKind::TEXT;
+    std::map<std::string, Symbol> _symbols;
+    std::map<std::string, int> _numericLabelCounts;
+    std::vector<Fixup> _fixups;
+    size_t _opcodeOffset = 0;
+    std::string_view _currentLine;
+};
+
+} // namespace yoctocc::jit
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Jit/Encoder.hpp"
+#include "Runtime/HostLibrary.hpp"
+
+namespace yoctocc::jit {
+
+// Encoder の出力を実行可能メモリに配置し、プロセス内で main を呼び出す。
+// 外部シンボルは HostLibrary で解決する。
+// perfMap なら perf 用の /tmp/perf-<pid>.map を書き出す (実行後も残る)
+class Jit final {
+public:
+    Jit(const Encoder& encoder, const runtime::HostLibrary& host, bool perfMap = false);
+    ~Jit();
+    Jit(const Jit&) = delete;
+    Jit& operator=(const Jit&) = delete;
+
+    // main(argc, argv) を呼び出して戻り値を返す
+    int run(const std::string& programName);
+
+private:
+    uint8_t* addressOf(const std::string& name);
+    void load();
+    void writePerfMap();
+
+    const Encoder& _encoder;
+    const runtime::HostLibrary& _host;
+    uint8_t* _memory = nullptr;
+    size_t _memorySize = 0;
+    size_t _textSize = 0;
+    size_t _dataOffset = 0;
+    size_t _bssOffset = 0;
+};
+
+} // namespace yoctocc::jit
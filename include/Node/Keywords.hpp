@@ -44,6 +44,8 @@ enum class Keyword {
     __RESTRICT,
     __RESTRICT__,
     NORETURN,
+    INLINE,
+    ATTRIBUTE,
 };
 
 inline constexpr std::string_view to_string_view(Keyword keyword) {
@@ -127,6 +129,10 @@ inline constexpr std::string_view to_string_view(Keyword keyword) {
             return "__restrict__";
         case NORETURN:
             return "_Noreturn";
+        case INLINE:
+            return "inline";
+        case ATTRIBUTE:
+            return "__attribute__";
     }
     return "";
 }
@@ -172,6 +178,8 @@ inline const std::unordered_map<std::string_view, Keyword> KEYWORDS = {
     {to_string_view(Keyword::__RESTRICT), Keyword::__RESTRICT},
     {to_string_view(Keyword::__RESTRICT__), Keyword::__RESTRICT__},
     {to_string_view(Keyword::NORETURN), Keyword::NORETURN},
+    {to_string_view(Keyword::INLINE), Keyword::INLINE},
+    {to_string_view(Keyword::ATTRIBUTE), Keyword::ATTRIBUTE},
 };
 
 } // namespace yoctocc
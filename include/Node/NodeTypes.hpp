@@ -1,9 +1,11 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
+#include "Profiler/AllocationTracker.hpp"
 #include "Type.hpp"
 
 namespace yoctocc {
@@ -68,7 +70,7 @@ enum class NodeType {
     MEMORY_CLEAR,
 };
 
-struct Node {
+struct Node : profiler::Tracked<profiler::AllocationCategory::NODE> {
     NodeType nodeType;
     int64_t integerValue = 0;
     double floatValue = 0.0;
@@ -98,16 +100,16 @@ struct Node {
     // goto or label
     std::string label;
     std::string uniqueLabel;
-    Node* gotoNext;
+    Node* gotoNext = nullptr;
     // switch
-    Node* cases;
-    Node* defaultCase;
+    Node* cases = nullptr;
+    Node* defaultCase = nullptr;
 
     Node(NodeType type, const Token* token) : nodeType(type), token(token) {
     }
 };
 
-struct Object {
+struct Object : profiler::Tracked<profiler::AllocationCategory::OBJECT> {
     // local or global variable/function
     bool isLocal = false;
     int alignment = 0;
@@ -115,11 +117,16 @@ struct Object {
     bool isFunction = false;
     bool isDefinition = false;
     bool isStatic = false;
+    // false なら参照されない static な定義として出力しない
+    bool isLive = true;
     // global variable
     std::vector<char> initialData;
     std::unique_ptr<Relocation> relocations;
     // local variable
     int offset = 0;
+    // 宣言された複合文の生存範囲 (構文解析の順序で数えた時点)。範囲が重ならない変数は同じ場所を使える
+    int lifetimeBegin = 0;
+    int lifetimeEnd = std::numeric_limits<int>::max();
     std::string name;
     std::shared_ptr<Type> type;
 
@@ -129,6 +136,12 @@ struct Object {
     std::unique_ptr<Object> locals;
     Object* vaArea = nullptr;
     int stackSize = 0;
+    // true なら stack-coloring がローカル変数の offset と stackSize を決めた
+    bool hasFrameLayout = false;
+    // inline 指定と __attribute__((always_inline)) / __attribute__((noinline))
+    bool isInline = false;
+    bool isAlwaysInline = false;
+    bool isNoInline = false;
 
     std::unique_ptr<Object> next;
     Token* token;
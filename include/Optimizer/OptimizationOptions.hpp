@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace yoctocc::optimizer {
+
+// -O<level> / -f<pass> / -fno-<pass> で指定する最適化の設定
+struct OptimizationOptions {
+    // -O0 / -O1 / -O2
+    int level = 0;
+    // -f<pass>: 最適化レベルに関係なく有効にするパス
+    std::vector<std::string> enabledPasses;
+    // -fno-<pass>: 無効にするパス
+    std::vector<std::string> disabledPasses;
+    // -fopt-bisect-limit=<n>: 先頭から n 回目までのパス実行だけを行う (負なら無制限)
+    int bisectLimit = -1;
+    // -funroll-factor=<n>: loop-unroll で本体を並べる数 (1 なら展開しない)
+    int unrollFactor = 4;
+    // -march=x86-64 / x86-64-v2 / x86-64-v3 / x86-64-v4: x86-64 psABI のマイクロアーキテクチャレベル (1〜4)。
+    // IR から命令を選ぶときに使ってよい拡張命令を決める
+    int isaLevel = 1;
+    // -ffp-contract=fast: x86-64-v3 以上で a * b ± c を丸めが 1 回の FMA 命令にまとめる (既定の off では丸めを変えない)
+    bool contractFloat = false;
+    // -fdump-ir: IR のパスを実行した後の関数を標準エラー出力に表示する
+    bool dumpIr = false;
+    // -fverify-ir: IR を作った直後と IR のパスごとに検証する
+    bool verifyIr = false;
+};
+
+} // namespace yoctocc::optimizer
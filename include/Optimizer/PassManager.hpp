@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "IR/Target.hpp"
+#include "Optimizer/OptimizationOptions.hpp"
+
+namespace yoctocc {
+struct Object;
+}
+
+namespace yoctocc::ir {
+struct Function;
+}
+
+namespace yoctocc::optimizer {
+
+enum class PassKind {
+    // 構文木 (プログラム全体) に対するパス
+    AST,
+    // 1 関数分の SSA IR に対するパス
+    IR,
+    // Generator が出力した 1 関数分の命令列に対するパス
+    INSTRUCTION,
+};
+
+struct PassInfo {
+    std::string_view name;
+    PassKind kind;
+    // このレベル以上で既定で有効になる
+    int level;
+    std::string_view description;
+};
+
+// 登録されているパスを実行順に返す
+std::span<const PassInfo> registeredPasses();
+const PassInfo* findPass(std::string_view name);
+
+// 最適化レベルと -f<pass> / -fno-<pass> に従ってパスを順に実行し、
+// パスごとの実行回数・変更数・時間を集計する。
+// -fopt-bisect-limit=<n> を指定すると n 回目より後のパス実行を飛ばすので、
+// 誤ったコードを生成するパスを二分探索で特定できる。
+class PassManager final {
+public:
+    PassManager() : PassManager(OptimizationOptions{}) {
+    }
+    explicit PassManager(OptimizationOptions options);
+
+    [[nodiscard]] int level() const noexcept {
+        return _options.level;
+    }
+    [[nodiscard]] bool isEnabled(std::string_view name) const;
+    // -march / -ffp-contract から決まる、命令選択で使ってよい拡張命令と、omit-frame-pointer / shrink-wrap から決まるフレームの作り方
+    [[nodiscard]] ir::Target target() const {
+        auto target = ir::Target::ofLevel(_options.isaLevel, _options.contractFloat);
+        target.omitsFramePointer = isEnabled("omit-frame-pointer");
+        target.shrinkWraps = isEnabled("shrink-wrap");
+        target.colorsStackSlots = isEnabled("stack-coloring");
+        return target;
+    }
+
+    void runAstPasses(Object* program);
+    // "ir" パスが有効なら関数を IR に変換して IR のパスを実行する。
+    // 無効か IR で表せない関数なら nullptr (スタックマシンで生成する)
+    std::unique_ptr<ir::Function> buildIr(const Object* function);
+    void runInstructionPasses(std::string_view function, std::vector<std::string>& lines);
+
+    // -ftime-report で表示するパスごとの統計
+    void printStatistics(std::FILE* out) const;
+
+private:
+    struct Statistics {
+        size_t runs = 0;
+        size_t changes = 0;
+        int64_t microseconds = 0;
+    };
+
+    bool shouldRun(size_t index, std::string_view unit);
+    template <typename Body>
+    void runPass(size_t index, std::string_view unit, Body&& body);
+
+    OptimizationOptions _options;
+    std::vector<bool> _enabled;
+    std::vector<Statistics> _statistics;
+    int _executions = 0;
+};
+
+} // namespace yoctocc::optimizer
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace yoctocc {
+struct Object;
+}
+
+namespace yoctocc::ir {
+struct Function;
+}
+
+// 各パスは変更した箇所の数を返す (PassManager が集計する)
+namespace yoctocc::optimizer {
+
+// constant-fold: 整数の定数式を NUMBER ノードに畳み込む
+size_t foldConstants(Object* program);
+
+// inline: 小さい関数と inline 指定の関数の呼び出しを、本体を複製した文式に置き換える
+// (__attribute__((always_inline)) / __attribute__((noinline)) は大きさに関係なく従う)
+size_t inlineFunctions(Object* program);
+
+// unused-statics: static でない定義から参照をたどり、届かない static な関数と変数を出力しないようにする
+size_t removeUnusedStatics(Object* program);
+
+// stack-coloring: 生存範囲の重ならないローカル変数に同じ場所を使い、揃える境界の大きい順に並べてフレームを小さくする
+// (IR から作る関数のフレームは命令選択が同じ方法で配置する)
+size_t colorStackSlots(Object* program);
+
+// mem2reg: アドレスを取られないスカラー変数の FrameSlot を SSA の値と PHI に置き換える
+size_t promoteMemoryToRegisters(ir::Function& function);
+
+// gvn: 支配する位置で計算済みの式と、書き換えられていない読み出し済みのメモリを使い回す
+size_t numberGlobalValues(ir::Function& function);
+
+// tail-call: 自分自身を末尾で呼ぶ再帰を入口へ戻るループにし、ほかの末尾呼び出しはフレームを片付けてから jmp で呼ぶ
+size_t eliminateTailCalls(ir::Function& function);
+
+// loop-rotate: 先頭で条件を調べるループを、入口で 1 回だけ条件を調べて末尾の条件分岐で戻る形にする
+size_t rotateLoops(ir::Function& function);
+
+// licm: ループ不変の計算と、ループの中で書き換えられないメモリの読み出しを前ヘッダへ移す
+size_t hoistLoopInvariants(ir::Function& function);
+
+// loop-idiom: ビットを 1 つずつ数える 1 ブロックのループを popcnt / lzcnt / tzcnt の 1 命令にする
+// (-march=x86-64-v2 以上。lzcnt / tzcnt は x86-64-v3 以上)
+size_t recognizeLoopIdioms(ir::Function& function, int isaLevel);
+
+// loop-vectorize: 1 ブロックの計数ループの要素ごとの計算を SSE2 のベクトルで 16 バイトずつ行い、残りは元のループで回す
+size_t vectorizeLoops(ir::Function& function);
+
+// loop-unroll: 1 ブロックの計数ループの本体を factor 個並べ、残りの回数は元のループで回す
+size_t unrollLoops(ir::Function& function, int factor);
+
+// dce: 定数の条件分岐を畳み、到達できないブロック・読まれない書き込み・使われない値を取り除く
+size_t eliminateDeadCode(ir::Function& function);
+
+// peephole: スタックマシン由来の冗長な命令の組を置き換える
+size_t optimizePeephole(std::vector<std::string>& lines);
+
+} // namespace yoctocc::optimizer
@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Optimizer/OptimizationOptions.hpp"
+
+namespace yoctocc {
+
+struct Options {
+    std::string sourceFile;
+    std::string outputFile = "build/program.s";
+
+    // --run: アセンブリを出力せずにメモリ上で実行する
+    bool run = false;
+    // --interpret: バイトコードインタプリタで実行する
+    bool interpret = false;
+    // --load <lib>: --run / --interpret 時にシンボル解決に使う共有ライブラリ
+    std::vector<std::string> libraries;
+    // --perf-map: --run 時に perf 用の /tmp/perf-<pid>.map を書き出す
+    bool perfMap = false;
+    // -ftime-report: フェーズごとの時間とメモリ使用量を標準エラー出力に表示する
+    bool timeReport = false;
+    // -ftime-trace=<file>: Chrome の trace_event 形式で時間を書き出す
+    std::string timeTraceFile;
+    // -fmem-report: データ構造ごとのメモリ割り当てを標準エラー出力に表示する
+    bool memoryReport = false;
+    // -O0 / -O1 / -O2, -f<pass> / -fno-<pass>, -fopt-bisect-limit=<n>
+    optimizer::OptimizationOptions optimization;
+};
+
+Options parseOptions(int argc, char* argv[]);
+
+} // namespace yoctocc
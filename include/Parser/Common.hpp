@@ -1,6 +1,7 @@
 #pragma once
 #include <memory>
 #include <vector>
+#include "Profiler/AllocationTracker.hpp"
 
 namespace yoctocc {
 
@@ -15,9 +16,13 @@ struct VariableAttribute {
     bool isStatic = false;
     bool isExtern = false;
     int alignment = 0;
+    // 関数のインライン展開の指定 (inline / __attribute__((always_inline)) / __attribute__((noinline)))
+    bool isInline = false;
+    bool isAlwaysInline = false;
+    bool isNoInline = false;
 };
 
-struct Initializer {
+struct Initializer : profiler::Tracked<profiler::AllocationCategory::INITIALIZER> {
     Initializer* next;
     std::shared_ptr<Type> type;
     Token* token;
@@ -2,6 +2,7 @@
 #include <cassert>
 #include <memory>
 #include <string>
+#include "Profiler/AllocationTracker.hpp"
 
 namespace yoctocc {
 
@@ -9,7 +10,7 @@ struct Object;
 struct Token;
 struct Type;
 
-struct VariableScope {
+struct VariableScope : profiler::Tracked<profiler::AllocationCategory::SCOPE> {
     std::string name;
     std::unique_ptr<VariableScope> next;
     Object* variable = nullptr;
@@ -18,13 +19,13 @@ struct VariableScope {
     int enumValue = 0;
 };
 
-struct TagScope {
+struct TagScope : profiler::Tracked<profiler::AllocationCategory::SCOPE> {
     std::string name;
     std::shared_ptr<Type> type;
     std::unique_ptr<TagScope> next;
 };
 
-struct Scope {
+struct Scope : profiler::Tracked<profiler::AllocationCategory::SCOPE> {
     std::unique_ptr<VariableScope> variables;
     std::unique_ptr<TagScope> tags;
     std::unique_ptr<Scope> next;
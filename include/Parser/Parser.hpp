@@ -2,6 +2,7 @@
 #include "ParseScope.hpp"
 #include <cassert>
 #include <memory>
+#include <vector>
 
 namespace yoctocc {
 
@@ -42,8 +43,12 @@ private:
     //             | struct-decl | union-decl | typedef-name
     //             | enum-specifier
     //             | "const" | "volatile" | "auto" | "register" | "restrict"
-    //             | "__restrict" | "__restrict__" | "_Noreturn")+
+    //             | "__restrict" | "__restrict__" | "_Noreturn" | "inline"
+    //             | attribute)+
     std::shared_ptr<Type> declSpec(Token*& token, VariableAttribute* attr);
+    // attribute = "__attribute__" "(" "(" (ident ("(" balanced-tokens ")")? ("," ident ...)*)? ")" ")"
+    // always_inline / noinline 以外の属性は読み飛ばす
+    void attribute(Token*& token, VariableAttribute* attr);
     // abstract-declarator = pointers ("(" abstract-declarator ")")? type-suffix
     std::shared_ptr<Type> abstractDeclarator(Token*& token, std::shared_ptr<Type>& type);
     // pointers = ("*" ("const" | "volatile" | "restrict")*)*
@@ -66,6 +71,8 @@ private:
     bool isFunction(Token* token);
     Object* createLocalVariable(const std::string& name, const std::shared_ptr<Type>& type);
     Object* createTemporaryLocalVariable(const std::shared_ptr<Type>& type);
+    // 今の複合文で宣言されたローカル変数として生存範囲の開始を記録する
+    void beginLifetime(Object* var);
     Object* createGlobalVariable(const std::string& name, const std::shared_ptr<Type>& type);
     Object* createGlobalAnonymousVariable(const std::shared_ptr<Type>& type);
     int64_t constExpression(Token*& token);
@@ -120,6 +127,14 @@ private:
     std::string _continueLabel;
     Node* _currentSwitch;
     ParseScope _parseScope;
+
+    // 複合文の開始時点とその中で宣言されたローカル変数
+    struct LifetimeScope {
+        int begin = 0;
+        std::vector<Object*> locals;
+    };
+    std::vector<LifetimeScope> _lifetimeScopes;
+    int _lifetimeTick = 0;
 };
 
 } // namespace yoctocc
@@ -0,0 +1,109 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <string_view>
+
+namespace yoctocc::profiler {
+
+enum class AllocationCategory {
+    TOKEN,
+    NODE,
+    TYPE,
+    OBJECT,
+    INITIALIZER,
+    // Generator が出力する命令文字列
+    INSTRUCTION,
+    // ParseScope の変数/タグ/スコープのエントリ
+    SCOPE,
+};
+
+inline constexpr size_t ALLOCATION_CATEGORY_COUNT = 7;
+
+std::string_view to_string_view(AllocationCategory category);
+
+// コンパイラ自身のデータ構造のメモリ割り当てをカテゴリ別に数える (-fmem-report)。
+// 無効なときは何も数えない。
+class AllocationTracker final {
+public:
+    struct Counter {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        // 解放されていないバイト数とその最大値
+        int64_t liveBytes = 0;
+        int64_t peakBytes = 0;
+    };
+
+    static AllocationTracker& instance();
+
+    void enable() noexcept {
+        _enabled = true;
+    }
+    [[nodiscard]] bool enabled() const noexcept {
+        return _enabled;
+    }
+
+    void allocated(AllocationCategory category, size_t bytes, uint64_t count = 1) noexcept;
+    void deallocated(AllocationCategory category, size_t bytes) noexcept;
+
+    [[nodiscard]] const Counter& counter(AllocationCategory category) const noexcept {
+        return _counters[static_cast<size_t>(category)];
+    }
+
+    void print(std::FILE* out) const;
+
+private:
+    bool _enabled = false;
+    std::array<Counter, ALLOCATION_CATEGORY_COUNT> _counters{};
+};
+
+// 継承したクラスの new/delete を Category として数える
+template <AllocationCategory Category>
+struct Tracked {
+    static void* operator new(size_t size) {
+        void* pointer = ::operator new(size);
+        AllocationTracker::instance().allocated(Category, size);
+        return pointer;
+    }
+
+    static void operator delete(void* pointer, size_t size) noexcept {
+        AllocationTracker::instance().deallocated(Category, size);
+        ::operator delete(pointer, size);
+    }
+};
+
+// std::allocate_shared 用 (make_shared はクラスの operator new を使わないため)
+template <typename T, AllocationCategory Category>
+struct TrackingAllocator {
+    using value_type = T;
+
+    TrackingAllocator() noexcept = default;
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U, Category>&) noexcept {
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = TrackingAllocator<U, Category>;
+    };
+
+    T* allocate(size_t n) {
+        auto* pointer = static_cast<T*>(::operator new(n * sizeof(T)));
+        AllocationTracker::instance().allocated(Category, n * sizeof(T));
+        return pointer;
+    }
+
+    void deallocate(T* pointer, size_t n) noexcept {
+        AllocationTracker::instance().deallocated(Category, n * sizeof(T));
+        ::operator delete(pointer, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const TrackingAllocator<U, Category>&) const noexcept {
+        return true;
+    }
+};
+
+} // namespace yoctocc::profiler
@@ -0,0 +1,61 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace yoctocc::profiler {
+
+// フェーズや関数ごとの壁時計時間・CPU 時間・ピーク RSS を記録する (-ftime-report / -ftime-trace)。
+// 無効なときは Scope を作っても何も記録しない。
+class TimeReport final {
+public:
+    static TimeReport& instance();
+
+    void enable() noexcept {
+        _enabled = true;
+    }
+    [[nodiscard]] bool enabled() const noexcept {
+        return _enabled;
+    }
+
+    // 生存期間をひとつのイベントとして記録する
+    class Scope final {
+    public:
+        Scope(std::string_view name, std::string_view category);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        size_t _index = SIZE_MAX;
+    };
+
+    // フェーズごとの表と、codegen に時間がかかった関数を出力する
+    void print(std::FILE* out) const;
+    // Chrome の trace_event 形式 (chrome://tracing / Perfetto で開ける) で書き出す
+    void writeTrace(const std::string& path) const;
+
+private:
+    struct Event {
+        std::string name;
+        std::string category;
+        int depth;
+        int64_t startMicroseconds;
+        int64_t wallMicroseconds;
+        int64_t cpuMicroseconds;
+        long peakRssKilobytes;
+    };
+
+    size_t begin(std::string_view name, std::string_view category);
+    void end(size_t index);
+
+    bool _enabled = false;
+    int _depth = 0;
+    std::chrono::steady_clock::time_point _origin = std::chrono::steady_clock::now();
+    std::vector<Event> _events;
+};
+
+} // namespace yoctocc::profiler
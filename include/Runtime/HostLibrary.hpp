@@ -0,0 +1,25 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace yoctocc::runtime {
+
+// --run / --interpret で外部シンボルを解決する。
+// --load で指定したライブラリ、組み込みのホスト関数表、実行中のプロセスの順に探す。
+class HostLibrary final {
+public:
+    explicit HostLibrary(const std::vector<std::string>& libraries);
+    ~HostLibrary();
+    HostLibrary(const HostLibrary&) = delete;
+    HostLibrary& operator=(const HostLibrary&) = delete;
+
+    // 見つからなければ nullptr
+    [[nodiscard]] void* find(const std::string& name) const;
+    // 見つからなければエラー終了
+    [[nodiscard]] void* resolve(const std::string& name) const;
+
+private:
+    std::vector<void*> _handles;
+};
+
+} // namespace yoctocc::runtime
@@ -1,5 +1,6 @@
 #pragma once
 #include "Node/Keywords.hpp"
+#include "Profiler/AllocationTracker.hpp"
 #include <cassert>
 #include <cstdint>
 #include <format>
@@ -65,7 +66,7 @@ namespace yoctocc {
 
 struct Type;
 
-struct Token {
+struct Token : profiler::Tracked<profiler::AllocationCategory::TOKEN> {
     TokenKind kind;
     std::string originalValue;
     int64_t integerValue;
@@ -77,6 +78,14 @@ struct Token {
 
     Token(TokenKind kind = TokenKind::UNKNOWN) : kind(kind), integerValue(0), location(0), line(0) {
     }
+
+    // 長いトークン列を再帰的に解放するとスタックが溢れるので、後続を順に解放する
+    ~Token() {
+        auto rest = std::move(next);
+        while (rest) {
+            rest = std::move(rest->next);
+        }
+    }
 };
 
 namespace token {
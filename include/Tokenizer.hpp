@@ -1,11 +1,13 @@
 #pragma once
 #include <fstream>
 #include <memory>
+#include <string>
 
 namespace yoctocc {
 
 struct Token;
 
 std::unique_ptr<Token> tokenize(std::ifstream& ifs);
+std::unique_ptr<Token> tokenize(const std::string& content);
 
 } // namespace yoctocc
@@ -1,5 +1,6 @@
 #pragma once
 #include "Node/Keywords.hpp"
+#include "Profiler/AllocationTracker.hpp"
 #include "Token.hpp"
 #include <functional>
 #include <memory>
@@ -67,60 +68,67 @@ namespace type {
 
 using enum TypeKind;
 
+// -fmem-report で数えられるように、Type はすべてここで作る
+template <typename... Args>
+std::shared_ptr<Type> makeType(Args&&... args) {
+    using Allocator = profiler::TrackingAllocator<Type, profiler::AllocationCategory::TYPE>;
+    return std::allocate_shared<Type>(Allocator{}, std::forward<Args>(args)...);
+}
+
 inline std::shared_ptr<Type> voidType() {
-    return std::make_shared<Type>(VOID, 1, 1);
+    return makeType(VOID, 1, 1);
 }
 
 inline std::shared_ptr<Type> boolType() {
-    return std::make_shared<Type>(BOOL, 1, 1);
+    return makeType(BOOL, 1, 1);
 }
 
 inline std::shared_ptr<Type> charType() {
-    return std::make_shared<Type>(CHAR, 1, 1);
+    return makeType(CHAR, 1, 1);
 }
 
 inline std::shared_ptr<Type> ucharType() {
-    return std::make_shared<Type>(CHAR, 1, 1, true);
+    return makeType(CHAR, 1, 1, true);
 }
 
 inline std::shared_ptr<Type> shortType() {
-    return std::make_shared<Type>(SHORT, 2, 2);
+    return makeType(SHORT, 2, 2);
 }
 
 inline std::shared_ptr<Type> ushortType() {
-    return std::make_shared<Type>(SHORT, 2, 2, true);
+    return makeType(SHORT, 2, 2, true);
 }
 
 inline std::shared_ptr<Type> intType() {
-    return std::make_shared<Type>(INT, 4, 4);
+    return makeType(INT, 4, 4);
 }
 
 inline std::shared_ptr<Type> uintType() {
-    return std::make_shared<Type>(INT, 4, 4, true);
+    return makeType(INT, 4, 4, true);
 }
 
 inline std::shared_ptr<Type> longType() {
-    return std::make_shared<Type>(LONG, 8, 8);
+    return makeType(LONG, 8, 8);
 }
 
 inline std::shared_ptr<Type> ulongType() {
-    return std::make_shared<Type>(LONG, 8, 8, true);
+    return makeType(LONG, 8, 8, true);
 }
 
 inline std::shared_ptr<Type> floatType() {
-    return std::make_shared<Type>(FLOAT, 4, 4);
+    return makeType(FLOAT, 4, 4);
 }
 
 inline std::shared_ptr<Type> doubleType() {
-    return std::make_shared<Type>(DOUBLE, 8, 8);
+    return makeType(DOUBLE, 8, 8);
 }
 
 inline std::shared_ptr<Type> enumType() {
-    return std::make_shared<Type>(ENUM, 4, 4);
+    return makeType(ENUM, 4, 4);
 }
 
 inline std::shared_ptr<Type> structType() {
-    return std::make_shared<Type>(STRUCT, 0, 1);
+    return makeType(STRUCT, 0, 1);
 }
 
 template <typename T>
@@ -201,6 +209,8 @@ inline bool isTypeName(const Token* token) {
         to_string_view(__RESTRICT),
         to_string_view(__RESTRICT__),
         to_string_view(NORETURN),
+        to_string_view(INLINE),
+        to_string_view(ATTRIBUTE),
     };
     return TYPE_NAMES.contains(token->originalValue);
 }
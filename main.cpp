@@ -1,14 +1,24 @@
 #include "Assembly/Assembly.hpp"
 #include "Generator.hpp"
+#include "Jit/Encoder.hpp"
+#include "Interpreter/Interpreter.hpp"
+#include "Jit/Jit.hpp"
 #include "Logger.hpp"
 #include "Node/Node.hpp"
+#include "Optimizer/PassManager.hpp"
+#include "Options.hpp"
 #include "Parser/Parser.hpp"
+#include "Profiler/AllocationTracker.hpp"
+#include "Profiler/TimeReport.hpp"
+#include "Runtime/HostLibrary.hpp"
 #include "Token.hpp"
 #include "Tokenizer.hpp"
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <print>
 #include <string>
+#include <vector>
 
 using namespace yoctocc;
 
@@ -20,44 +30,138 @@ void handle_contract_violation(const std::contracts::contract_violation& violati
 }
 #endif
 
+namespace {
+// -ftime-report / -ftime-trace / -fmem-report の結果を出力する
+void finishReports(const Options& options, const optimizer::PassManager& passManager) {
+    const auto& report = profiler::TimeReport::instance();
+    if (options.timeReport) {
+        report.print(stderr);
+        passManager.printStatistics(stderr);
+    }
+    if (!options.timeTraceFile.empty()) {
+        report.writeTrace(options.timeTraceFile);
+    }
+    if (options.memoryReport) {
+        profiler::AllocationTracker::instance().print(stderr);
+    }
+}
+} // namespace
+
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        Log::error("Usage: yoctocc <source_file> [output_file]");
-        return EXIT_FAILURE;
+    Options options = parseOptions(argc, argv);
+    const std::string& sourceFile = options.sourceFile;
+    using Scope = profiler::TimeReport::Scope;
+
+    if (options.timeReport || !options.timeTraceFile.empty()) {
+        profiler::TimeReport::instance().enable();
+    }
+    if (options.memoryReport) {
+        profiler::AllocationTracker::instance().enable();
     }
-    std::string sourceFile = argv[1];
-    std::string outputFile = (argc >= 3) ? argv[2] : "build/program.s";
 
     std::ifstream ifs(sourceFile);
     if (!ifs) {
         Log::error("Failed to open source file");
         return EXIT_FAILURE;
     }
-    std::ofstream ofs(outputFile);
-    if (!ofs) {
-        Log::error("Failed to open output file");
-        return EXIT_FAILURE;
-    }
 
-    std::println("Tokenizing...");
+    // --run / --interpret ではプログラムの標準出力と混ざらないように進捗を出さない
+    const bool quiet = options.run || options.interpret;
+    if (!quiet) {
+        std::println("Tokenizing...");
+    }
     Log::sourceFileName = sourceFile;
-    auto tokenChain = tokenize(ifs);
+    std::unique_ptr<Token> tokenChain;
+    {
+        Scope scope{"tokenize", "phase"};
+        tokenChain = tokenize(ifs);
+    }
 
-    std::println("Parsing...");
+    if (!quiet) {
+        std::println("Parsing...");
+    }
     Parser parser{};
-    auto program = parser.parse(tokenChain.get());
+    std::unique_ptr<Object> program;
+    {
+        // 型の付与は構文解析と同時に行われるので、このフェーズに含まれる
+        Scope scope{"parse", "phase"};
+        program = parser.parse(tokenChain.get());
+    }
+
+    optimizer::PassManager passManager{options.optimization};
+    {
+        Scope scope{"optimize", "phase"};
+        passManager.runAstPasses(program.get());
+    }
+
+    if (options.interpret) {
+        runtime::HostLibrary host{options.libraries};
+        std::optional<interpreter::Interpreter> interpreter;
+        {
+            Scope scope{"bytecode", "phase"};
+            interpreter.emplace(program.get(), host);
+        }
+        int result = 0;
+        {
+            Scope scope{"execute", "phase"};
+            result = interpreter->run(sourceFile);
+        }
+        finishReports(options, passManager);
+        return result;
+    }
+
+    if (options.run) {
+        std::vector<std::string> code;
+        {
+            Scope scope{"codegen", "phase"};
+            Generator generator{passManager};
+            code = generator.run(program.get());
+        }
+        jit::Encoder encoder{};
+        {
+            Scope scope{"encode", "phase"};
+            encoder.encode(code);
+        }
+        runtime::HostLibrary host{options.libraries};
+        int result = 0;
+        {
+            Scope scope{"execute", "phase"};
+            jit::Jit jit{encoder, host, options.perfMap};
+            result = jit.run(sourceFile);
+        }
+        finishReports(options, passManager);
+        return result;
+    }
 
     std::println("Generating...");
-    Generator generator{};
+    std::vector<std::string> code;
+    {
+        Scope scope{"codegen", "phase"};
+        Generator generator{passManager};
+        code = generator.run(program.get());
+    }
     AssemblyWriter writer{};
-    writer.addLine(directive::file(1, sourceFile));
-    writer.compile(generator.run(program.get()));
+    {
+        Scope scope{"assemble", "phase"};
+        writer.addLine(directive::file(1, sourceFile));
+        writer.compile(code);
+    }
+
+    std::ofstream ofs(options.outputFile);
+    if (!ofs) {
+        Log::error("Failed to open output file");
+        return EXIT_FAILURE;
+    }
 
     std::println("Writing...");
-    for (const auto& line : writer.getCode()) {
-        ofs << line;
+    {
+        Scope scope{"emit", "phase"};
+        for (const auto& line : writer.getCode()) {
+            ofs << line;
+        }
+        ofs.close();
     }
-    ofs.close();
 
+    finishReports(options, passManager);
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,49 @@
+# ==================================================
+#  ベンチマーク
+# ==================================================
+
+ifndef _BENCH_MK
+_BENCH_MK := 1
+
+include mk/compiler.mk
+
+BENCH_BUILD_DIR := $(BUILD_DIR)/bench
+
+# --- コンパイラの各フェーズのマイクロベンチマーク ---
+MICRO_BENCH := $(BENCH_BUILD_DIR)/microbench
+MICRO_BENCH_SRCS := $(shell find bench/micro -name "*.cpp" -type f)
+MICRO_BENCH_OBJS := $(MICRO_BENCH_SRCS:%.cpp=$(BUILD_DIR)/%.o)
+# 結果はコミットごとに micro-<rev>.json に残し、BENCH_BASE のコミットの結果と比べる
+BENCH_BASE ?= HEAD~1
+
+# main.o 以外のコンパイラのオブジェクトをリンクする
+$(MICRO_BENCH): $(MICRO_BENCH_OBJS) $(filter-out %/main.o,$(OBJS))
+	@mkdir -p $(dir $@)
+	$(CXX) -o $@ $^ $(LDFLAGS)
+
+-include $(MICRO_BENCH_OBJS:.o=.d)
+
+# 同じコミットで何度実行しても、比較先は BENCH_BASE のコミットの結果のまま変わらない
+# 使用例: make bench MODE=release BENCH_ARGS="--repetitions 20 --filter parse"
+#         make bench MODE=release BENCH_BASE=main
+bench: $(MICRO_BENCH)
+	@rev=$$(git rev-parse --short HEAD 2>/dev/null || echo local); \
+	base=$$(git rev-parse --short "$(BENCH_BASE)" 2>/dev/null || echo none); \
+	if [ ! -f $(BENCH_BUILD_DIR)/micro-$$base.json ]; then \
+		echo "no baseline for $(BENCH_BASE) ($$base); run make bench on that commit to compare against it"; \
+	fi; \
+	./$(MICRO_BENCH) --corpus test/cases --baseline $(BENCH_BUILD_DIR)/micro-$$base.json \
+		--output $(BENCH_BUILD_DIR)/micro-$$rev.json --label "$$rev" $(BENCH_ARGS)
+
+# --- 入力の大きさに対する計算量の回帰テスト ---
+# 使用例: make bench-scaling SCALING_FILTERS="goto globals"
+bench-scaling: $(COMPILER)
+	@python3 bench/scaling/run_scaling.py $(SCALING_FILTERS)
+
+# --- 生成コードの実行速度を gcc -O0 / -O1 と比較する ---
+# KERNEL_FLAGS は yoctocc のビルドだけに渡す
+# 使用例: make bench-kernels KERNEL_FILTERS="matmul sieve"
+bench-kernels: $(COMPILER)
+	@KERNEL_FLAGS="$(KERNEL_FLAGS)" python3 bench/kernels/run_kernels.py $(KERNEL_FILTERS)
+
+endif # _BENCH_MK
@@ -47,6 +47,9 @@ else
     endif
 endif
 
+# --run (JIT) で dlopen / dlsym を使う
+LDFLAGS += -ldl
+
 # プロファイル
 ifeq ($(PROFILE), 1)
     CXXFLAGS += -pg
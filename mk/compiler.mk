@@ -7,8 +7,8 @@ _COMPILER_MK := 1
 
 include mk/common.mk
 
-# C++ ソースファイル（サブディレクトリも含む）
-SRCS := $(shell find $(SRC_DIR) -name "*.cpp" -type f)
+# C++ ソースファイル（サブディレクトリも含む。ベンチマークは別のバイナリにする）
+SRCS := $(shell find $(SRC_DIR) -name "*.cpp" -type f -not -path "./bench/*")
 OBJS := $(SRCS:%.cpp=$(BUILD_DIR)/%.o)
 DEPS := $(OBJS:.o=.d)
 
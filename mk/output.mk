@@ -16,6 +16,7 @@ BIN := $(BUILD_DIR)/program
 # テスト用ヘルパー
 TEST_HELPER_C := test/test_helper.c
 TEST_HELPER_O := $(BUILD_DIR)/test_helper.o
+TEST_HELPER_SO := $(BUILD_DIR)/test_helper.so
 
 # YoctoCC でソースをコンパイル → アセンブリ生成
 $(ASM): $(COMPILER)
@@ -35,6 +36,10 @@ $(OBJ): $(ASM)
 $(TEST_HELPER_O): $(TEST_HELPER_C) | $(BUILD_DIR)
 	$(X86_64_CC) -g -std=c23 -O2 -fno-builtin -fno-stack-protector -c -o $@ $<
 
+# --run (JIT) 用の共有ライブラリ版
+$(TEST_HELPER_SO): $(TEST_HELPER_C) | $(BUILD_DIR)
+	$(X86_64_CC) -g -std=c23 -O2 -fno-builtin -fno-stack-protector -fPIC -shared -o $@ $<
+
 # yoctocc が生成したコード + テストヘルパーをリンク
 $(BIN): $(OBJ) $(TEST_HELPER_O)
 	$(X86_64_CC) -no-pie -o $@ $^
@@ -7,8 +7,27 @@ include mk/output.mk
 
 # FORMAT=simple (default) | md
 FORMAT ?= simple
+# テスト対象のコンパイルに追加するオプション (例: make test YOCTOCC_FLAGS=-O2)
+YOCTOCC_FLAGS ?=
 
 test: $(COMPILER) $(TEST_HELPER_O)
 	@echo "Running parallel test suite..."
-	@FORMAT=$(FORMAT) python3 test/run_tests_parallel.sh $(FILTERS)
+	@FORMAT=$(FORMAT) YOCTOCC_FLAGS="$(YOCTOCC_FLAGS)" python3 test/run_tests_parallel.sh $(FILTERS)
 
+# -O1 / -O2 でテストを実行する (最適化パスの退行は最適化を有効にしないと見つからない)
+test-O1 test-O2: test-O%: $(COMPILER) $(TEST_HELPER_O)
+	@echo "Running parallel test suite (-O$*)..."
+	@FORMAT=$(FORMAT) YOCTOCC_FLAGS="-O$* $(YOCTOCC_FLAGS)" python3 test/run_tests_parallel.sh $(FILTERS)
+
+# -O0 / -O1 / -O2 のすべてでテストを実行する
+test-all: test test-O1 test-O2
+
+# --run (JIT) でテストを実行する
+test-jit: $(COMPILER) $(TEST_HELPER_SO)
+	@echo "Running parallel test suite (JIT)..."
+	@JIT=1 FORMAT=$(FORMAT) YOCTOCC_FLAGS="$(YOCTOCC_FLAGS)" python3 test/run_tests_parallel.sh $(FILTERS)
+
+# --interpret (バイトコードインタプリタ) でテストを実行する
+test-interpret: $(COMPILER) $(TEST_HELPER_SO)
+	@echo "Running parallel test suite (interpreter)..."
+	@INTERPRET=1 FORMAT=$(FORMAT) YOCTOCC_FLAGS="$(YOCTOCC_FLAGS)" python3 test/run_tests_parallel.sh $(FILTERS)
@@ -0,0 +1,55 @@
+#include "Assembly/ConstantPool.hpp"
+
+#include <algorithm>
+#include "Assembly/Assembly.hpp"
+
+namespace yoctocc {
+
+using namespace directive;
+
+std::string ConstantPool::scalar(uint64_t bits, int size) {
+    return intern(size == 4 ? static_cast<uint32_t>(bits) : bits, size);
+}
+
+std::string ConstantPool::signMask(int size) {
+    return intern(size == 4 ? 0x8000'0000ULL : 0x8000'0000'0000'0000ULL, 16);
+}
+
+std::string ConstantPool::intern(uint64_t bits, int size) {
+    auto it = std::ranges::find_if(_entries, [&](const Entry& entry) {
+        return entry.bits == bits && entry.size == size;
+    });
+    if (it != _entries.end()) {
+        return it->label;
+    }
+    auto label = labels::label("constant", _entries.size()).ref();
+    _entries.push_back({bits, size, label});
+    return label;
+}
+
+std::vector<std::string> ConstantPool::emit() const {
+    std::vector<std::string> lines;
+    if (_entries.empty()) {
+        return lines;
+    }
+    lines.emplace_back(section(".rodata", "\"a\"", "@progbits"));
+    // 大きい項目から並べると揃えるための詰め物が要らない
+    auto entries = _entries;
+    std::ranges::stable_sort(entries, std::ranges::greater{}, &Entry::size);
+    for (const auto& entry : entries) {
+        lines.emplace_back(align(entry.size));
+        lines.emplace_back(labels::label(entry.label).def());
+        if (entry.size == 4) {
+            lines.emplace_back(long_(static_cast<uint32_t>(entry.bits)));
+        } else {
+            lines.emplace_back(quad(entry.bits));
+        }
+        if (entry.size == 16) {
+            lines.emplace_back(quad(0));
+        }
+    }
+    lines.emplace_back(sections::text);
+    return lines;
+}
+
+} // namespace yoctocc
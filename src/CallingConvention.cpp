@@ -0,0 +1,72 @@
+#include "CallingConvention.hpp"
+
+#include "Node/Node.hpp"
+#include "Type.hpp"
+#include "Utility.hpp"
+#include <algorithm>
+
+namespace yoctocc::abi {
+
+bool isFloatOnly(const Type* type, int begin, int end, int offset) {
+    if (type->kind == TypeKind::STRUCT || type->kind == TypeKind::UNION) {
+        for (const Member* member = type->members.get(); member; member = member->next.get()) {
+            if (!isFloatOnly(member->type.get(), begin, end, offset + member->offset)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (type->kind == TypeKind::ARRAY) {
+        for (int i = 0; i < type->arraySize; i++) {
+            if (!isFloatOnly(type->base.get(), begin, end, offset + type->base->size * i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return offset < begin || end <= offset || type::isFloat(type);
+}
+
+int eightbyteSize(const Type* type, int index) {
+    return std::min(8, type->size - index * 8);
+}
+
+ArgumentLayout layoutArguments(std::span<const Type* const> types) {
+    ArgumentLayout layout;
+    int stackSize = 0;
+    for (const Type* type : types) {
+        ArgumentLocation location;
+        const bool isAggregate = type->kind == TypeKind::STRUCT || type->kind == TypeKind::UNION;
+        if (!isAggregate || type->size <= 16) {
+            location.eightbytes = isAggregate ? (type->size + 7) / 8 : 1;
+            int integers = 0;
+            int floats = 0;
+            for (int i = 0; i < location.eightbytes; i++) {
+                const bool isFloat = isAggregate ? isFloatOnly(type, i * 8, i * 8 + 8) : type::isFloat(type);
+                location.classes[i] = isFloat ? ArgumentClass::SSE : ArgumentClass::INTEGER;
+                (isFloat ? floats : integers)++;
+            }
+            if (layout.integerRegisters + integers <= INTEGER_ARGUMENT_REGISTERS &&
+                layout.floatRegisters + floats <= FLOAT_ARGUMENT_REGISTERS) {
+                for (int i = 0; i < location.eightbytes; i++) {
+                    location.registers[i] = location.classes[i] == ArgumentClass::SSE ? layout.floatRegisters++
+                                                                                      : layout.integerRegisters++;
+                }
+                layout.arguments.emplace_back(location);
+                continue;
+            }
+        }
+
+        // 引数は 8 バイトごとに並べる
+        location = ArgumentLocation{.onStack = true};
+        stackSize = static_cast<int>(alignTo(stackSize, std::max(type->alignment, 8)));
+        location.stackOffset = stackSize;
+        stackSize += static_cast<int>(alignTo(type->size, 8));
+        layout.arguments.emplace_back(location);
+    }
+    layout.stackUsed = stackSize;
+    layout.stackSize = static_cast<int>(alignTo(stackSize, 16));
+    return layout;
+}
+
+} // namespace yoctocc::abi
@@ -0,0 +1,52 @@
+#include "FrameLayout.hpp"
+
+#include "Utility.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace yoctocc::frame {
+
+namespace {
+
+bool interferes(const FrameObject& a, const FrameObject& b) {
+    return a.lifetimeBegin <= b.lifetimeEnd && b.lifetimeBegin <= a.lifetimeEnd;
+}
+
+} // namespace
+
+FrameLayout layoutObjects(std::span<const FrameObject> objects) {
+    std::vector<size_t> order(objects.size());
+    std::iota(order.begin(), order.end(), 0);
+    // 境界の大きいものを先に置くと、間に詰め物が入りにくい
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return objects[a].alignment > objects[b].alignment;
+    });
+
+    FrameLayout layout;
+    layout.offsets.assign(objects.size(), 0);
+    // 置いた領域の番号と、上端からの深さ [depth - size, depth)
+    std::vector<std::pair<size_t, int>> placed;
+    for (auto index : order) {
+        const auto& object = objects[index];
+        int alignment = std::max(object.alignment, 1);
+        int depth = static_cast<int>(alignTo(object.size, alignment));
+        // ぶつかる領域があればその下へずらし、ぶつからなくなるまで繰り返す
+        for (bool moved = true; moved;) {
+            moved = false;
+            for (auto [other, otherDepth] : placed) {
+                int otherTop = otherDepth - objects[other].size;
+                if (!interferes(object, objects[other]) || depth - object.size >= otherDepth || otherTop >= depth) {
+                    continue;
+                }
+                depth = static_cast<int>(alignTo(otherDepth + object.size, alignment));
+                moved = true;
+            }
+        }
+        placed.emplace_back(index, depth);
+        layout.offsets[index] = -depth;
+        layout.size = std::max(layout.size, depth);
+    }
+    return layout;
+}
+
+} // namespace yoctocc::frame
@@ -1,8 +1,13 @@
 #include "Generator.hpp"
 
 #include "Assembly/Assembly.hpp"
+#include "IR/IR.hpp"
+#include "IR/InstructionSelector.hpp"
 #include "Logger.hpp"
 #include "Node/Node.hpp"
+#include "Optimizer/PassManager.hpp"
+#include "Profiler/AllocationTracker.hpp"
+#include "Profiler/TimeReport.hpp"
 #include "Token.hpp"
 #include "Type.hpp"
 #include "Utility.hpp"
@@ -12,12 +17,54 @@ namespace {
 using namespace yoctocc;
 
 constexpr size_t STACK_ALIGNMENT = 16;
+// ループの先頭を揃える境界 (命令フェッチの 16 バイト単位)
+constexpr int LOOP_ALIGNMENT = 16;
 
 int depth = 0;
 
-std::string push_rax() {
+// 出力した命令文字列が確保しているメモリを -fmem-report に計上する
+void countInstructionMemory(const std::vector<std::string>& lines) {
+    auto& tracker = profiler::AllocationTracker::instance();
+    if (!tracker.enabled()) {
+        return;
+    }
+    const size_t inlineCapacity = std::string{}.capacity();
+    tracker.allocated(profiler::AllocationCategory::INSTRUCTION, lines.capacity() * sizeof(std::string));
+    for (const auto& line : lines) {
+        if (line.capacity() > inlineCapacity) {
+            tracker.allocated(profiler::AllocationCategory::INSTRUCTION, line.capacity() + 1);
+        }
+    }
+}
+
+// 文の式を含む式は、複製して 2 回生成するとラベルが重複する
+bool containsStatementExpression(const Node* node) {
+    if (!node) {
+        return false;
+    }
+    if (node->nodeType == NodeType::STATEMENT_EXPRESSION) {
+        return true;
+    }
+    if (containsStatementExpression(node->left.get()) || containsStatementExpression(node->right.get()) ||
+        containsStatementExpression(node->condition.get()) || containsStatementExpression(node->then.get()) ||
+        containsStatementExpression(node->els.get())) {
+        return true;
+    }
+    for (const Node* argument = node->arguments.get(); argument; argument = argument->next.get()) {
+        if (containsStatementExpression(argument)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string push_reg(Register reg) {
     depth++;
-    return push(RAX);
+    return push(reg);
+}
+
+std::string push_rax() {
+    return push_reg(RAX);
 }
 
 std::string pop_reg(Register reg) {
@@ -162,6 +209,47 @@ std::vector<std::string> compareZero(const Type* type) {
         return {cmp(RAX, 0)};
     }
 }
+bool isAggregate(const Type* type) {
+    return type->kind == TypeKind::STRUCT || type->kind == TypeKind::UNION;
+}
+
+// メンバアクセスをたどった先が変数か
+bool isVariableAccess(const Node* node) {
+    while (node->nodeType == NodeType::MEMBER) {
+        node = node->left.get();
+    }
+    return node->nodeType == NodeType::VARIABLE;
+}
+
+// 命令を生成しない型変換 (同じ型どうし、幅の変わらない整数どうし、ポインタどうしなど) を取り除く
+const Node* skipNoOpCasts(const Node* node) {
+    while (node->nodeType == NodeType::CAST && !type::is(node->type.get(), TypeKind::BOOL) &&
+           castTable[getTypeID(node->left->type.get())][getTypeID(node->type.get())].empty()) {
+        node = node->left.get();
+    }
+    return node;
+}
+
+// 引数レジスタを壊さずに (RAX だけを作業に使って) 評価できる引数か。
+// 定数、変数・メンバの値とアドレス、それらの整数どうしの型変換が当てはまる
+bool isDirectArgument(const Node* node) {
+    node = skipNoOpCasts(node);
+    switch (node->nodeType) {
+        case NodeType::NUMBER:
+            return true;
+        case NodeType::VARIABLE:
+        case NodeType::MEMBER:
+            return isVariableAccess(node);
+        case NodeType::ADDRESS:
+            return isVariableAccess(node->left.get());
+        case NodeType::CAST:
+            return type::isInteger(node->type.get()) && type::isInteger(node->left->type.get()) &&
+                   isDirectArgument(node->left.get());
+        default:
+            return false;
+    }
+}
+
 } // namespace
 
 namespace yoctocc {
@@ -176,6 +264,8 @@ std::vector<std::string> Generator::run(Object* obj) {
     assignLocalVariableOffsets(obj);
     emitData(obj);
     emitText(obj);
+    addCode(constantPool.emit());
+    countInstructionMemory(lines);
     return lines;
 }
 
@@ -200,6 +290,19 @@ void Generator::cast(const Node* node) {
     }
 }
 
+// +0.0 は xorps で作り、ほかは .rodata の定数を読む
+void Generator::loadFloatConstant(Register reg, const Node* node) {
+    const bool isFloat = node->type->kind == TypeKind::FLOAT;
+    const uint64_t bits = isFloat ? std::bit_cast<uint32_t>(static_cast<float>(node->floatValue))
+                                  : std::bit_cast<uint64_t>(node->floatValue);
+    if (bits == 0) {
+        addCode(xorps(reg, reg));
+        return;
+    }
+    auto label = constantPool.scalar(bits, node->type->size);
+    addCode(isFloat ? movss(reg, RipRelativeAddress{label}) : movsd(reg, RipRelativeAddress{label}));
+}
+
 void Generator::load(const Type* type) {
     using enum TypeKind;
     assert(type);
@@ -296,7 +399,13 @@ void Generator::storeIntegerArgs(int reg, int offset, int size) {
             addCode(mov(Address{RBP, offset}, ARG_REGISTERS64[reg]));
             break;
         default:
-            Log::unreachable();
+            // 構造体の末尾の 3, 5, 6, 7 バイトは 1 バイトずつ書く
+            for (int i = 0; i < size; i++) {
+                if (i > 0) {
+                    addCode(shr(ARG_REGISTERS64[reg], 8));
+                }
+                addCode(mov(Address{RBP, offset + i}, ARG_REGISTERS8[reg]));
+            }
             break;
     }
 }
@@ -319,7 +428,8 @@ void Generator::assignLocalVariableOffsets(Object* obj) {
     assert(obj);
 
     for (Object* fn = obj; fn; fn = fn->next.get()) {
-        if (!fn->isFunction) {
+        // stack-coloring が配置した関数はそのまま使う
+        if (!fn->isFunction || fn->hasFrameLayout) {
             continue;
         }
         int offset = 0;
@@ -399,10 +509,36 @@ void Generator::generateStatement(const Node* node) {
         auto beginLabel = labels::begin(count);
         auto breakLabel = labels::label(node->breakLabel);
         auto continueLabel = labels::label(node->continueLabel);
+        const bool rotate = passManager && passManager->isEnabled("loop-rotate") &&
+                            !containsStatementExpression(node->condition.get());
 
         if (node->init) {
             generateStatement(node->init.get());
         }
+        if (rotate) {
+            // 入口で 1 回だけ条件を調べ、以降は末尾の条件分岐 1 つで先頭へ戻る
+            if (node->condition) {
+                generateExpression(node->condition.get());
+                addCode(compareZero(node->condition->type.get()));
+                addCode(je(breakLabel.ref()));
+            }
+            addCode(align(LOOP_ALIGNMENT));
+            addCode(beginLabel.def());
+            generateStatement(node->then.get());
+            addCode(continueLabel.def());
+            if (node->inc) {
+                generateExpression(node->inc.get());
+            }
+            if (node->condition) {
+                generateExpression(node->condition.get());
+                addCode(compareZero(node->condition->type.get()));
+                addCode(jne(beginLabel.ref()));
+            } else {
+                addCode(jmp(beginLabel.ref()));
+            }
+            addCode(breakLabel.def());
+            return;
+        }
         addCode(beginLabel.def());
         if (node->condition) {
             generateExpression(node->condition.get());
@@ -425,6 +561,9 @@ void Generator::generateStatement(const Node* node) {
         auto breakLabel = labels::label(node->breakLabel);
         auto continueLabel = labels::label(node->continueLabel);
 
+        if (passManager && passManager->isEnabled("loop-rotate")) {
+            addCode(align(LOOP_ALIGNMENT));
+        }
         addCode(beginLabel.def());
         if (node->then) {
             generateStatement(node->then.get());
@@ -502,16 +641,216 @@ void Generator::generateStatement(const Node* node) {
     Log::error("Invalid statement"sv, node->token);
 }
 
-void Generator::pushArgs(const Node* node) {
-    if (!node) {
+void Generator::generateArguments(const Node* arguments, const abi::ArgumentLayout& layout) {
+    std::vector<const Node*> args;
+    for (const Node* arg = arguments; arg; arg = arg->next.get()) {
+        args.emplace_back(arg);
+    }
+
+    // スタックで渡す引数は右から評価して、確保済みの引数領域 (call の時点の rsp から) に書く
+    for (size_t i = args.size(); i-- > 0;) {
+        const auto& location = layout.arguments[i];
+        if (location.onStack) {
+            generateExpression(args[i]);
+            storeStackArgument(args[i]->type.get(), location.stackOffset);
+        }
+    }
+
+    // 関数呼び出しなどを含む引数は引数レジスタを壊しうるので、先に右から評価して 8 バイトずつスタックに積む。
+    // 最後に評価する最も左のものだけは積まずに渡し先へ移す
+    std::vector<size_t> complex;
+    for (size_t i = 0; i < args.size(); i++) {
+        if (!layout.arguments[i].onStack && !isDirectArgument(args[i])) {
+            complex.emplace_back(i);
+        }
+    }
+    for (size_t k = complex.size(); k-- > 0;) {
+        const Node* arg = args[complex[k]];
+        const auto& location = layout.arguments[complex[k]];
+        const Type* type = arg->type.get();
+        generateExpression(arg);
+        if (isAggregate(type)) {
+            if (k == 0) {
+                loadAggregateArgument(type, location, Address{RAX});
+                continue;
+            }
+            // 戻り値の構造体は呼び出し先のフレームに残っているので、push で上書きする前に読み出す
+            addCode(mov(R11, RAX));
+            loadEightbyte(RAX, Address{R11}, abi::eightbyteSize(type, 0));
+            if (location.eightbytes > 1) {
+                loadEightbyte(RDX, Address{R11, 8}, abi::eightbyteSize(type, 1));
+                addCode(push_reg(RDX));
+            }
+            addCode(push_rax());
+        } else if (k > 0) {
+            addCode(type::isFloat(type) ? pushf() : std::vector{push_rax()});
+        } else if (type::isFloat(type)) {
+            if (ARG_REGISTERS128[location.registers[0]] != XMM0) {
+                addCode(movsd(ARG_REGISTERS128[location.registers[0]], XMM0));
+            }
+        } else {
+            addCode(mov(ARG_REGISTERS64[location.registers[0]], RAX));
+        }
+    }
+    for (size_t k = 1; k < complex.size(); k++) {
+        const auto& location = layout.arguments[complex[k]];
+        for (int i = 0; i < location.eightbytes; i++) {
+            if (location.classes[i] == abi::ArgumentClass::SSE) {
+                addCode(popf(ARG_REGISTERS128[location.registers[i]]));
+            } else {
+                addCode(pop_reg(ARG_REGISTERS64[location.registers[i]]));
+            }
+        }
+    }
+
+    // 残りの引数は RAX だけを作業に使って渡し先のレジスタへ直接読み込む
+    for (size_t i = 0; i < args.size(); i++) {
+        if (!layout.arguments[i].onStack && isDirectArgument(args[i])) {
+            loadArgument(args[i], layout.arguments[i]);
+        }
+    }
+}
+
+void Generator::storeStackArgument(const Type* type, int offset) {
+    if (isAggregate(type)) {
+        copyMemory(Address{RSP, offset}, Address{RAX}, type->size);
+    } else if (type->kind == TypeKind::FLOAT) {
+        addCode(movss(Address{RSP, offset}, XMM0));
+    } else if (type->kind == TypeKind::DOUBLE) {
+        addCode(movsd(Address{RSP, offset}, XMM0));
+    } else {
+        addCode(mov(Address{RSP, offset}, RAX));
+    }
+}
+
+void Generator::loadAggregateArgument(const Type* type, const abi::ArgumentLocation& location,
+                                      Address<Register> address) {
+    for (int i = 0; i < location.eightbytes; i++) {
+        const int size = abi::eightbyteSize(type, i);
+        const Register reg = location.classes[i] == abi::ArgumentClass::SSE
+                                 ? ARG_REGISTERS128[location.registers[i]]
+                                 : ARG_REGISTERS64[location.registers[i]];
+        loadEightbyte(reg, address + i * 8, size);
+    }
+}
+
+void Generator::loadEightbyte(Register reg, Address<Register> address, int size) {
+    if (reg <= XMM7) {
+        if (size == 4) {
+            addCode(movss(reg, std::move(address)));
+        } else {
+            addCode(movsd(reg, std::move(address)));
+        }
         return;
     }
-    pushArgs(node->next.get());
-    generateExpression(node);
-    if (type::isFloat(node->type.get())) {
-        addCode(pushf());
+    switch (size) {
+        case 8:
+            addCode(mov(reg, std::move(address)));
+            return;
+        case 4:
+            addCode(mov(sized(reg, 4), std::move(address)));
+            return;
+        case 2:
+            addCode(movzwl(sized(reg, 4), word_ptr(std::move(address))));
+            return;
+        case 1:
+            addCode(movzbl(sized(reg, 4), byte_ptr(std::move(address))));
+            return;
+        default:
+            // 構造体の末尾の 3, 5, 6, 7 バイトは、範囲外を読まないよう上位から 1 バイトずつ組み立てる
+            addCode(movzbl(sized(reg, 4), byte_ptr(address + (size - 1))));
+            for (int i = size - 2; i >= 0; i--) {
+                addCode(shl(reg, 8));
+                addCode(mov(sized(reg, 1), byte_ptr(address + i)));
+            }
+            return;
+    }
+}
+
+void Generator::copyMemory(Address<Register> to, Address<Register> from, int size) {
+    for (int i = 0; i < size;) {
+        const int chunk = size - i >= 8 ? 8 : size - i >= 4 ? 4 : size - i >= 2 ? 2 : 1;
+        addCode(mov(sized(R11, chunk), from + i));
+        addCode(mov(to + i, sized(R11, chunk)));
+        i += chunk;
+    }
+}
+
+void Generator::loadArgument(const Node* node, const abi::ArgumentLocation& location) {
+    node = skipNoOpCasts(node);
+    const Type* type = node->type.get();
+    const bool isLocal = node->nodeType == NodeType::VARIABLE && node->variable->isLocal;
+    const auto index = static_cast<size_t>(location.registers[0]);
+
+    switch (node->nodeType) {
+        case NodeType::NUMBER:
+            if (type::isFloat(type)) {
+                loadFloatConstant(ARG_REGISTERS128[index], node);
+            } else {
+                addCode(mov(ARG_REGISTERS64[index], node->integerValue));
+            }
+            return;
+        case NodeType::ADDRESS:
+            if (node->left->nodeType == NodeType::VARIABLE) {
+                const auto* variable = node->left->variable;
+                if (variable->isLocal) {
+                    addCode(lea(ARG_REGISTERS64[index], Address{RBP, variable->offset}));
+                } else {
+                    addCode(lea(ARG_REGISTERS64[index], RipRelativeAddress{variable->name}));
+                }
+                return;
+            }
+            generateAddress(node->left.get());
+            addCode(mov(ARG_REGISTERS64[index], RAX));
+            return;
+        case NodeType::VARIABLE:
+        case NodeType::MEMBER:
+            break;
+        default:
+            // 整数どうしの型変換は RAX だけで行う
+            generateExpression(node);
+            addCode(mov(ARG_REGISTERS64[index], RAX));
+            return;
+    }
+
+    // 変数・メンバの値は、ローカル変数ならフレームから、それ以外は RAX に求めたアドレスから読む
+    if (type->kind == TypeKind::ARRAY) {
+        if (isLocal) {
+            addCode(lea(ARG_REGISTERS64[index], Address{RBP, node->variable->offset}));
+        } else {
+            generateAddress(node);
+            addCode(mov(ARG_REGISTERS64[index], RAX));
+        }
+        return;
+    }
+    if (!isLocal) {
+        generateAddress(node);
+    }
+    auto address = [&] { return isLocal ? Address{RBP, node->variable->offset} : Address{RAX}; };
+    if (isAggregate(type)) {
+        loadAggregateArgument(type, location, address());
+        return;
+    }
+    if (type->kind == TypeKind::FLOAT) {
+        addCode(movss(ARG_REGISTERS128[index], address()));
+    } else if (type->kind == TypeKind::DOUBLE) {
+        addCode(movsd(ARG_REGISTERS128[index], address()));
+    } else if (type->size == 1) {
+        if (type->isUnsigned) {
+            addCode(movzbl(ARG_REGISTERS32[index], byte_ptr(address())));
+        } else {
+            addCode(movsbl(ARG_REGISTERS32[index], byte_ptr(address())));
+        }
+    } else if (type->size == 2) {
+        if (type->isUnsigned) {
+            addCode(movzwl(ARG_REGISTERS32[index], word_ptr(address())));
+        } else {
+            addCode(movswl(ARG_REGISTERS32[index], word_ptr(address())));
+        }
+    } else if (type->size == 4) {
+        addCode(movsxd(ARG_REGISTERS64[index], address()));
     } else {
-        addCode(push_rax());
+        addCode(mov(ARG_REGISTERS64[index], address()));
     }
 }
 
@@ -524,18 +863,10 @@ void Generator::generateExpression(const Node* node) {
             return;
         case NodeType::NUMBER:
             switch (node->type->kind) {
-                case TypeKind::FLOAT: {
-                    auto u32 = std::bit_cast<uint32_t>(static_cast<float>(node->floatValue));
-                    addCode(mov(EAX, u32));
-                    addCode(movq(XMM0, RAX));
+                case TypeKind::FLOAT:
+                case TypeKind::DOUBLE:
+                    loadFloatConstant(XMM0, node);
                     return;
-                }
-                case TypeKind::DOUBLE: {
-                    auto u64 = std::bit_cast<uint64_t>(node->floatValue);
-                    addCode(mov(RAX, u64));
-                    addCode(movq(XMM0, RAX));
-                    return;
-                }
                 default:
                     addCode(mov(RAX, node->integerValue));
                     return;
@@ -543,17 +874,9 @@ void Generator::generateExpression(const Node* node) {
         case NodeType::NEGATE:
             generateExpression(node->left.get());
             if (type::isFloat(node->type.get())) {
-                if (node->type->kind== TypeKind::FLOAT) {
-                    addCode(mov(RAX, 1));
-                    addCode(shl(RAX, 31));
-                    addCode(movq(XMM1, RAX));
-                    addCode(xorps(XMM0, XMM1));
-                } else if (node->type->kind == TypeKind::DOUBLE) {
-                    addCode(mov(RAX, 1));
-                    addCode(shl(RAX, 63));
-                    addCode(movq(XMM1, RAX));
-                    addCode(xorpd(XMM0, XMM1));
-                }
+                // 符号ビットのマスクは .rodata の定数と xor する
+                addCode(xorps(XMM0, RipRelativeAddress{constantPool.signMask(node->type->size)}));
+                return;
             }
             addCode(neg(RAX));
             return;
@@ -595,24 +918,26 @@ void Generator::generateExpression(const Node* node) {
             addCode(rep_stosb());
             return;
         case NodeType::FUNCTION_CALL: {
-            pushArgs(node->arguments.get());
-
-            int gp = 0;
-            int fp = 0;
+            std::vector<const Type*> types;
             for (const Node* arg = node->arguments.get(); arg; arg = arg->next.get()) {
-                if (type::isFloat(arg->type.get())) {
-                    addCode(popf(ARG_REGISTERS128[fp++]));
-                } else {
-                    addCode(pop_reg(ARG_REGISTERS64[gp++]));
-                }
+                types.emplace_back(arg->type.get());
             }
+            const auto layout = abi::layoutArguments(types);
 
-            if (depth % 2 == 0) {
-                addCode(call(node->functionName));
-            } else {
-                addCode(sub(RSP, 8));
-                addCode(call(node->functionName));
-                addCode(add(RSP, 8));
+            // スタックで渡す引数の領域を先に確保し、call の時点で rsp が 16 バイト境界に揃うようにする
+            const int reserved = layout.stackSize + (depth % 2 == 0 ? 0 : 8);
+            if (reserved > 0) {
+                addCode(sub(RSP, reserved));
+                depth += reserved / 8;
+            }
+            generateArguments(node->arguments.get(), layout);
+            if (node->functionType && node->functionType->isVariadic) {
+                addCode(mov(EAX, layout.floatRegisters));
+            }
+            addCode(call(node->functionName));
+            if (reserved > 0) {
+                addCode(add(RSP, reserved));
+                depth -= reserved / 8;
             }
 
             switch (node->type->kind) {
@@ -886,6 +1211,16 @@ void Generator::generateFunction(const Object* obj) {
     }
 
     addCode(sections::text);
+
+    // -O1 以上では IR を経由してレジスタを割り当てる
+    if (passManager) {
+        if (auto function = passManager->buildIr(obj)) {
+            addCode(labels::label(obj->name).def());
+            addCode(ir::selectInstructions(*function, passManager->target(), constantPool));
+            return;
+        }
+    }
+
     addCode(labels::label(obj->name).def(),
             // Prologue
             push(RBP),
@@ -895,25 +1230,27 @@ void Generator::generateFunction(const Object* obj) {
         addCode(sub(RSP, obj->stackSize));
     }
 
+    std::vector<const Type*> types;
+    for (const Object* param = obj->parameters; param; param = param->next.get()) {
+        types.emplace_back(param->type.get());
+    }
+    const auto layout = abi::layoutArguments(types);
+
     if (obj->vaArea) {
-        int i = 0;
-        int f = 0;
-        for (auto param = obj->parameters; param; param = param->next.get()) {
-            if (type::isFloat(param->type.get())) {
-                f++;
-            } else {
-                i++;
-            }
-        }
+        const int i = layout.integerRegisters;
+        const int f = layout.floatRegisters;
         int offset = obj->vaArea->offset;
         const int fpOffset = 48;
         addCode(
             // va_elem
             movl(dword_ptr(Address{RBP, offset}), i * 8),
-            movl(dword_ptr(Address{RBP, offset + 4}), f * 8 + fpOffset),
+            movl(dword_ptr(Address{RBP, offset + 4}), f * 16 + fpOffset),
+            // overflow_arg_area: 戻り番地と退避した rbp の上で、名前のある引数の後ろ
+            movq(Address{RBP, offset + 8}, RBP),
+            addq(Address{RBP, offset + 8}, 16 + layout.stackUsed),
             movq(Address{RBP, offset + 16}, RBP),
             addq(Address{RBP, offset + 16}, offset + 24),
-            // __reg_save_area__
+            // __reg_save_area__ (psABI に合わせて xmm は 16 バイトずつ)
             movq(Address{RBP, offset + 24}, RDI),
             movq(Address{RBP, offset + 32}, RSI),
             movq(Address{RBP, offset + 40}, RDX),
@@ -921,23 +1258,32 @@ void Generator::generateFunction(const Object* obj) {
             movq(Address{RBP, offset + 56}, R8),
             movq(Address{RBP, offset + 64}, R9),
             movsd(Address{RBP, offset + 72}, XMM0),
-            movsd(Address{RBP, offset + 80}, XMM1),
-            movsd(Address{RBP, offset + 88}, XMM2),
-            movsd(Address{RBP, offset + 96}, XMM3),
-            movsd(Address{RBP, offset + 104}, XMM4),
-            movsd(Address{RBP, offset + 112}, XMM5),
-            movsd(Address{RBP, offset + 120}, XMM6),
-            movsd(Address{RBP, offset + 128}, XMM7)
+            movsd(Address{RBP, offset + 88}, XMM1),
+            movsd(Address{RBP, offset + 104}, XMM2),
+            movsd(Address{RBP, offset + 120}, XMM3),
+            movsd(Address{RBP, offset + 136}, XMM4),
+            movsd(Address{RBP, offset + 152}, XMM5),
+            movsd(Address{RBP, offset + 168}, XMM6),
+            movsd(Address{RBP, offset + 184}, XMM7)
         );
     }
 
-    int f = 0;
-    int i = 0;
-    for (const Object* param = obj->parameters; param; param = param->next.get()) {
-        if (type::isFloat(param->type.get())) {
-            storeFloatArgs(f++, param->offset, param->type->size);
-        } else {
-            storeIntegerArgs(i++, param->offset, param->type->size);
+    size_t index = 0;
+    for (const Object* param = obj->parameters; param; param = param->next.get(), index++) {
+        const auto& location = layout.arguments[index];
+        if (location.onStack) {
+            // 戻り番地と退避した rbp の上にある呼び出し元の引数領域から写す
+            copyMemory(Address{RBP, param->offset}, Address{RBP, 16 + location.stackOffset}, param->type->size);
+            continue;
+        }
+        for (int e = 0; e < location.eightbytes; e++) {
+            const int offset = param->offset + e * 8;
+            const int size = abi::eightbyteSize(param->type.get(), e);
+            if (location.classes[e] == abi::ArgumentClass::SSE) {
+                storeFloatArgs(location.registers[e], offset, size);
+            } else {
+                storeIntegerArgs(location.registers[e], offset, size);
+            }
         }
     }
 
@@ -950,7 +1296,7 @@ void Generator::emitData(const Object* obj) {
     assert(obj);
 
     for (const Object* var = obj; var; var = var->next.get()) {
-        if (var->isFunction || !var->isDefinition) {
+        if (var->isFunction || !var->isDefinition || !var->isLive) {
             continue;
         }
 
@@ -994,10 +1340,19 @@ void Generator::emitText(const Object* obj) {
     assert(obj);
 
     for (const Object* fn = obj; fn; fn = fn->next.get()) {
-        if (!fn->isFunction || !fn->isDefinition) {
+        if (!fn->isFunction || !fn->isDefinition || !fn->isLive) {
             continue;
         }
+        profiler::TimeReport::Scope scope{fn->name, "function"};
+        size_t start = lines.size();
         generateFunction(fn);
+        if (passManager) {
+            std::vector<std::string> body{std::make_move_iterator(lines.begin() + static_cast<std::ptrdiff_t>(start)),
+                                          std::make_move_iterator(lines.end())};
+            lines.resize(start);
+            passManager->runInstructionPasses(fn->name, body);
+            addCode(std::move(body));
+        }
     }
 }
 
@@ -0,0 +1,326 @@
+#include "IR/Analysis.hpp"
+
+#include <algorithm>
+#include <utility>
+#include "Node/Node.hpp"
+#include "Type.hpp"
+
+namespace yoctocc::ir {
+
+std::vector<BasicBlock*> reversePostOrder(const Function& function) {
+    std::vector<BasicBlock*> order;
+    if (function.blocks.empty()) {
+        return order;
+    }
+    std::vector<bool> visited(function.nextBlockId);
+    // (ブロック, 次に調べる後続の番号) の明示的なスタックで深さ優先探索する。
+    // 後続を逆順に調べると、逆後順で最初の後続 (CONDBR の真の側) が直後に並びやすい
+    std::vector<std::pair<BasicBlock*, size_t>> stack;
+    auto* entry = function.blocks.front().get();
+    visited[entry->id] = true;
+    stack.emplace_back(entry, 0);
+    while (!stack.empty()) {
+        auto& [block, next] = stack.back();
+        if (next < block->successors.size()) {
+            auto* successor = block->successors[block->successors.size() - 1 - next++];
+            if (!visited[successor->id]) {
+                visited[successor->id] = true;
+                stack.emplace_back(successor, 0);
+            }
+            continue;
+        }
+        order.emplace_back(block);
+        stack.pop_back();
+    }
+    std::ranges::reverse(order);
+    return order;
+}
+
+bool observesFrameLayout(const Function& function) {
+    auto isScalarAddress = [&](const Instruction* value) {
+        if (value->opcode != Opcode::FRAME_ADDRESS) {
+            return false;
+        }
+        const auto* variable = function.slots[value->immediate].variable;
+        if (!variable) {
+            return false;
+        }
+        const Type* type = variable->type.get();
+        return !type::is(type, TypeKind::ARRAY) && !type::is(type, TypeKind::STRUCT) &&
+               !type::is(type, TypeKind::UNION);
+    };
+    for (const auto& block : function.blocks) {
+        for (const auto& instruction : block->instructions) {
+            if (instruction->opcode != Opcode::ADD && instruction->opcode != Opcode::SUB &&
+                instruction->opcode != Opcode::CMP) {
+                continue;
+            }
+            if (std::ranges::any_of(instruction->operands, isScalarAddress)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+AliasAnalysis::AliasAnalysis(const Function& function)
+    : _function(function),
+      _frameLayoutObserved(observesFrameLayout(function)),
+      _escaped(function.slots.size(), _frameLayoutObserved),
+      _roots(function.nextValueId),
+      _computed(function.nextValueId) {
+    for (const auto& block : function.blocks) {
+        for (const auto& instruction : block->instructions) {
+            for (size_t i = 0; i < instruction->operands.size(); i++) {
+                switch (instruction->opcode) {
+                    case Opcode::LOAD:
+                    case Opcode::STORE:
+                    case Opcode::CLEAR:
+                        if (i == 0) {
+                            continue;
+                        }
+                        break;
+                    case Opcode::COPY_MEMORY:
+                    case Opcode::ADD:
+                    case Opcode::SUB:
+                        continue;
+                    default:
+                        break;
+                }
+                for (const auto* base : roots(instruction->operands[i]).bases) {
+                    if (base->opcode == Opcode::FRAME_ADDRESS) {
+                        _escaped[static_cast<size_t>(base->immediate)] = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+const AliasAnalysis::Roots& AliasAnalysis::roots(const Instruction* address) const {
+    static const Roots unknown{.unknown = true, .bases = {}};
+    if (address->id >= _roots.size()) {
+        return unknown;
+    }
+    if (_computed[address->id]) {
+        return _roots[address->id];
+    }
+
+    Roots result;
+    switch (address->opcode) {
+        case Opcode::FRAME_ADDRESS:
+        case Opcode::GLOBAL_ADDRESS:
+            result.bases.emplace_back(address);
+            break;
+        case Opcode::CONST:
+        case Opcode::MUL:
+        case Opcode::SHL:
+        case Opcode::SEXT:
+        case Opcode::ZEXT:
+            break;
+        case Opcode::ADD:
+        case Opcode::SUB: {
+            // ポインタ同士は足せないので、片方に由来があればもう片方は添字とみなす
+            const auto& left = roots(address->operands[0]);
+            const auto& right = roots(address->operands[1]);
+            if (!left.bases.empty() || !right.bases.empty()) {
+                result.bases = left.bases;
+                result.bases.insert(result.bases.end(), right.bases.begin(), right.bases.end());
+            } else {
+                result.unknown = left.unknown || right.unknown;
+            }
+            break;
+        }
+        default:
+            result.unknown = true;
+            break;
+    }
+    _computed[address->id] = true;
+    _roots[address->id] = std::move(result);
+    return _roots[address->id];
+}
+
+bool AliasAnalysis::isExposed(const Roots& roots) const {
+    return roots.unknown || std::ranges::any_of(roots.bases, [&](const Instruction* base) {
+               return base->opcode == Opcode::GLOBAL_ADDRESS || escapes(base->immediate);
+           });
+}
+
+bool AliasAnalysis::sameBase(const Instruction* a, const Instruction* b) {
+    if (a->opcode != b->opcode) {
+        return false;
+    }
+    return a->opcode == Opcode::FRAME_ADDRESS ? a->immediate == b->immediate : a->symbol == b->symbol;
+}
+
+std::pair<const Instruction*, int64_t> AliasAnalysis::decompose(const Instruction* address) {
+    int64_t offset = 0;
+    if (address->opcode == Opcode::ADD && address->operands[1]->opcode == Opcode::CONST) {
+        offset = address->operands[1]->immediate;
+        address = address->operands[0];
+    }
+    if (address->opcode == Opcode::FRAME_ADDRESS || address->opcode == Opcode::GLOBAL_ADDRESS) {
+        return {address, offset};
+    }
+    return {nullptr, 0};
+}
+
+bool AliasAnalysis::mayModify(const Instruction* instruction, const Instruction* address, int64_t size) const {
+    switch (instruction->opcode) {
+        case Opcode::CALL:
+            return isExposed(roots(address));
+        case Opcode::STORE:
+        case Opcode::CLEAR:
+        case Opcode::COPY_MEMORY: {
+            const auto& target = roots(instruction->operands[0]);
+            const auto& source = roots(address);
+            if (target.unknown) {
+                return isExposed(source);
+            }
+            if (source.unknown) {
+                return isExposed(target);
+            }
+            auto isFrame = [](const Instruction* base) { return base->opcode == Opcode::FRAME_ADDRESS; };
+            if (_frameLayoutObserved && std::ranges::any_of(target.bases, isFrame) &&
+                std::ranges::any_of(source.bases, isFrame)) {
+                return true;
+            }
+            // 同じ変数の重ならない範囲 (配列の別の要素・構造体の別のメンバ)
+            const auto [targetBase, targetOffset] = decompose(instruction->operands[0]);
+            const auto [sourceBase, sourceOffset] = decompose(address);
+            if (targetBase && sourceBase && sameBase(targetBase, sourceBase)) {
+                return targetOffset < sourceOffset + size && sourceOffset < targetOffset + instruction->immediate;
+            }
+            return std::ranges::any_of(target.bases, [&](const Instruction* a) {
+                return std::ranges::any_of(source.bases, [&](const Instruction* b) { return sameBase(a, b); });
+            });
+        }
+        default:
+            return false;
+    }
+}
+
+bool AliasAnalysis::isDereferenceable(const Instruction* address, int64_t size) const {
+    const auto [base, offset] = decompose(address);
+    if (!base) {
+        return false;
+    }
+    if (base->opcode == Opcode::FRAME_ADDRESS) {
+        return offset >= 0 && offset + size <= _function.slots[static_cast<size_t>(base->immediate)].size;
+    }
+    return offset == 0;
+}
+
+DominatorTree::DominatorTree(const Function& function)
+    : _order(ir::reversePostOrder(function)),
+      _rpoIndex(function.nextBlockId, -1),
+      _idom(function.nextBlockId, nullptr),
+      _children(function.nextBlockId),
+      _enter(function.nextBlockId),
+      _leave(function.nextBlockId) {
+    if (_order.empty()) {
+        return;
+    }
+    for (size_t i = 0; i < _order.size(); i++) {
+        _rpoIndex[_order[i]->id] = static_cast<int>(i);
+    }
+
+    auto* entry = _order.front();
+    _idom[entry->id] = entry;
+    auto intersect = [&](BasicBlock* a, BasicBlock* b) {
+        while (a != b) {
+            while (_rpoIndex[a->id] > _rpoIndex[b->id]) {
+                a = _idom[a->id];
+            }
+            while (_rpoIndex[b->id] > _rpoIndex[a->id]) {
+                b = _idom[b->id];
+            }
+        }
+        return a;
+    };
+
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t i = 1; i < _order.size(); i++) {
+            auto* block = _order[i];
+            BasicBlock* newIdom = nullptr;
+            for (auto* predecessor : block->predecessors) {
+                if (_rpoIndex[predecessor->id] < 0 || !_idom[predecessor->id]) {
+                    continue;
+                }
+                newIdom = newIdom ? intersect(predecessor, newIdom) : predecessor;
+            }
+            if (newIdom && _idom[block->id] != newIdom) {
+                _idom[block->id] = newIdom;
+                changed = true;
+            }
+        }
+    }
+    _idom[entry->id] = nullptr;
+
+    for (size_t i = 1; i < _order.size(); i++) {
+        _children[_idom[_order[i]->id]->id].emplace_back(_order[i]);
+    }
+
+    uint32_t clock = 0;
+    std::vector<std::pair<BasicBlock*, size_t>> stack;
+    _enter[entry->id] = clock++;
+    stack.emplace_back(entry, 0);
+    while (!stack.empty()) {
+        auto& [block, next] = stack.back();
+        if (next < _children[block->id].size()) {
+            auto* child = _children[block->id][next++];
+            _enter[child->id] = clock++;
+            stack.emplace_back(child, 0);
+            continue;
+        }
+        _leave[block->id] = clock++;
+        stack.pop_back();
+    }
+}
+
+bool DominatorTree::dominates(const BasicBlock* a, const BasicBlock* b) const {
+    if (!isReachable(a) || !isReachable(b)) {
+        return false;
+    }
+    return _enter[a->id] <= _enter[b->id] && _leave[b->id] <= _leave[a->id];
+}
+
+bool DominatorTree::dominates(const Instruction* a, const Instruction* b) const {
+    if (a->parent != b->parent) {
+        return dominates(a->parent, b->parent);
+    }
+    for (const auto& instruction : a->parent->instructions) {
+        if (instruction.get() == a) {
+            return true;
+        }
+        if (instruction.get() == b) {
+            return false;
+        }
+    }
+    return false;
+}
+
+std::vector<std::vector<BasicBlock*>> DominatorTree::frontiers() const {
+    std::vector<std::vector<BasicBlock*>> frontiers(_idom.size());
+    for (auto* block : _order) {
+        if (block->predecessors.size() < 2) {
+            continue;
+        }
+        for (auto* runner : block->predecessors) {
+            if (!isReachable(runner)) {
+                continue;
+            }
+            while (runner != _idom[block->id]) {
+                auto& frontier = frontiers[runner->id];
+                if (frontier.empty() || frontier.back() != block) {
+                    frontier.emplace_back(block);
+                }
+                runner = _idom[runner->id];
+            }
+        }
+    }
+    return frontiers;
+}
+
+} // namespace yoctocc::ir
@@ -0,0 +1,420 @@
+#include "IR/IR.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+#include "Logger.hpp"
+
+using namespace std::string_view_literals;
+
+namespace yoctocc::ir {
+
+bool Instruction::hasSideEffects() const noexcept {
+    switch (opcode) {
+        case Opcode::STORE:
+        case Opcode::CLEAR:
+        case Opcode::COPY_MEMORY:
+        case Opcode::CALL:
+        case Opcode::BR:
+        case Opcode::CONDBR:
+        case Opcode::RET:
+            return true;
+        default:
+            return false;
+    }
+}
+
+Instruction* BasicBlock::append(std::unique_ptr<Instruction> instruction) {
+    instruction->parent = this;
+    instructions.emplace_back(std::move(instruction));
+    return instructions.back().get();
+}
+
+Instruction* BasicBlock::insertBefore(const Instruction* position, std::unique_ptr<Instruction> instruction) {
+    if (!position) {
+        position = terminator();
+    }
+    auto it = std::ranges::find(instructions, position, &std::unique_ptr<Instruction>::get);
+    instruction->parent = this;
+    return instructions.insert(it, std::move(instruction))->get();
+}
+
+Instruction* BasicBlock::insertAfterPhis(std::unique_ptr<Instruction> instruction) {
+    auto it = std::ranges::find_if(instructions, [](const auto& i) { return i->opcode != Opcode::PHI; });
+    instruction->parent = this;
+    return instructions.insert(it, std::move(instruction))->get();
+}
+
+std::unique_ptr<Instruction> BasicBlock::remove(const Instruction* instruction) {
+    auto it = std::ranges::find(instructions, instruction, &std::unique_ptr<Instruction>::get);
+    if (it == instructions.end()) {
+        return nullptr;
+    }
+    auto removed = std::move(*it);
+    instructions.erase(it);
+    removed->parent = nullptr;
+    return removed;
+}
+
+BasicBlock* Function::createBlock() {
+    auto block = std::make_unique<BasicBlock>();
+    block->id = nextBlockId++;
+    blocks.emplace_back(std::move(block));
+    return blocks.back().get();
+}
+
+std::unique_ptr<Instruction> Function::create(Opcode opcode, ValueType type,
+                                              std::initializer_list<Instruction*> operands) {
+    auto instruction = std::make_unique<Instruction>();
+    instruction->opcode = opcode;
+    instruction->type = type;
+    instruction->operands = operands;
+    instruction->id = nextValueId++;
+    return instruction;
+}
+
+void Function::recomputeControlFlow() {
+    for (auto& block : blocks) {
+        block->predecessors.clear();
+        block->successors.clear();
+    }
+    for (auto& block : blocks) {
+        auto* terminator = block->terminator();
+        if (!terminator) {
+            continue;
+        }
+        for (auto* successor : terminator->blocks) {
+            if (std::ranges::contains(block->successors, successor)) {
+                continue;
+            }
+            block->successors.emplace_back(successor);
+            successor->predecessors.emplace_back(block.get());
+        }
+    }
+}
+
+size_t Function::removeUnreachableBlocks() {
+    std::unordered_set<const BasicBlock*> reachable;
+    std::vector<BasicBlock*> worklist{blocks.front().get()};
+    reachable.insert(blocks.front().get());
+    while (!worklist.empty()) {
+        auto* block = worklist.back();
+        worklist.pop_back();
+        if (auto* terminator = block->terminator()) {
+            for (auto* successor : terminator->blocks) {
+                if (reachable.insert(successor).second) {
+                    worklist.emplace_back(successor);
+                }
+            }
+        }
+    }
+    if (reachable.size() == blocks.size()) {
+        recomputeControlFlow();
+        return 0;
+    }
+
+    for (auto& block : blocks) {
+        if (!reachable.contains(block.get())) {
+            continue;
+        }
+        for (auto& instruction : block->instructions) {
+            if (instruction->opcode != Opcode::PHI) {
+                break;
+            }
+            for (size_t i = instruction->blocks.size(); i-- > 0;) {
+                if (!reachable.contains(instruction->blocks[i])) {
+                    instruction->blocks.erase(instruction->blocks.begin() + static_cast<std::ptrdiff_t>(i));
+                    instruction->operands.erase(instruction->operands.begin() + static_cast<std::ptrdiff_t>(i));
+                }
+            }
+        }
+    }
+    size_t before = blocks.size();
+    std::erase_if(blocks, [&](const auto& block) { return !reachable.contains(block.get()); });
+    recomputeControlFlow();
+    return before - blocks.size();
+}
+
+void Function::replaceUses(const std::unordered_map<Instruction*, Instruction*>& replacements) {
+    if (replacements.empty()) {
+        return;
+    }
+    auto resolve = [&](Instruction* value) {
+        for (auto it = replacements.find(value); it != replacements.end(); it = replacements.find(value)) {
+            if (it->second == value) {
+                break;
+            }
+            value = it->second;
+        }
+        return value;
+    };
+    for (auto& block : blocks) {
+        for (auto& instruction : block->instructions) {
+            for (auto& operand : instruction->operands) {
+                operand = resolve(operand);
+            }
+        }
+    }
+}
+
+std::unordered_map<const Instruction*, size_t> Function::countUses() const {
+    std::unordered_map<const Instruction*, size_t> uses;
+    for (const auto& block : blocks) {
+        for (const auto& instruction : block->instructions) {
+            for (const auto* operand : instruction->operands) {
+                uses[operand]++;
+            }
+        }
+    }
+    return uses;
+}
+
+size_t Function::instructionCount() const {
+    size_t count = 0;
+    for (const auto& block : blocks) {
+        count += block->instructions.size();
+    }
+    return count;
+}
+
+bool Instruction::isVector() const noexcept {
+    return isVectorType(type);
+}
+
+ValueType elementType(ValueType type) {
+    switch (type) {
+        case ValueType::V4I32:
+            return ValueType::I32;
+        case ValueType::V2I64:
+            return ValueType::I64;
+        case ValueType::V4F32:
+            return ValueType::F32;
+        case ValueType::V2F64:
+            return ValueType::F64;
+        default:
+            return type;
+    }
+}
+
+ValueType vectorType(ValueType element) {
+    switch (element) {
+        case ValueType::I32:
+            return ValueType::V4I32;
+        case ValueType::I64:
+            return ValueType::V2I64;
+        case ValueType::F32:
+            return ValueType::V4F32;
+        case ValueType::F64:
+            return ValueType::V2F64;
+        default:
+            return element;
+    }
+}
+
+std::string_view to_string(ValueType type) {
+    switch (type) {
+        case ValueType::VOID:
+            return "void"sv;
+        case ValueType::I32:
+            return "i32"sv;
+        case ValueType::I64:
+            return "i64"sv;
+        case ValueType::F32:
+            return "f32"sv;
+        case ValueType::F64:
+            return "f64"sv;
+        case ValueType::V4I32:
+            return "v4i32"sv;
+        case ValueType::V2I64:
+            return "v2i64"sv;
+        case ValueType::V4F32:
+            return "v4f32"sv;
+        case ValueType::V2F64:
+            return "v2f64"sv;
+    }
+    return "?"sv;
+}
+
+std::string_view to_string(Opcode opcode) {
+    using enum Opcode;
+    switch (opcode) {
+        case CONST:
+            return "const"sv;
+        case PARAM:
+            return "param"sv;
+        case FRAME_ADDRESS:
+            return "frame_address"sv;
+        case GLOBAL_ADDRESS:
+            return "global_address"sv;
+        case ADD:
+            return "add"sv;
+        case SUB:
+            return "sub"sv;
+        case MUL:
+            return "mul"sv;
+        case SDIV:
+            return "sdiv"sv;
+        case UDIV:
+            return "udiv"sv;
+        case SREM:
+            return "srem"sv;
+        case UREM:
+            return "urem"sv;
+        case AND:
+            return "and"sv;
+        case OR:
+            return "or"sv;
+        case XOR:
+            return "xor"sv;
+        case SHL:
+            return "shl"sv;
+        case SHR:
+            return "shr"sv;
+        case SAR:
+            return "sar"sv;
+        case NEG:
+            return "neg"sv;
+        case NOT:
+            return "not"sv;
+        case POPCOUNT:
+            return "popcount"sv;
+        case CLZ:
+            return "clz"sv;
+        case CTZ:
+            return "ctz"sv;
+        case FADD:
+            return "fadd"sv;
+        case FSUB:
+            return "fsub"sv;
+        case FMUL:
+            return "fmul"sv;
+        case FDIV:
+            return "fdiv"sv;
+        case FNEG:
+            return "fneg"sv;
+        case SPLAT:
+            return "splat"sv;
+        case REDUCE:
+            return "reduce"sv;
+        case CMP:
+            return "cmp"sv;
+        case FCMP:
+            return "fcmp"sv;
+        case SEXT:
+            return "sext"sv;
+        case ZEXT:
+            return "zext"sv;
+        case TRUNC:
+            return "trunc"sv;
+        case EXTEND:
+            return "extend"sv;
+        case SITOFP:
+            return "sitofp"sv;
+        case UITOFP:
+            return "uitofp"sv;
+        case FPTOSI:
+            return "fptosi"sv;
+        case FPEXT:
+            return "fpext"sv;
+        case FPTRUNC:
+            return "fptrunc"sv;
+        case LOAD:
+            return "load"sv;
+        case STORE:
+            return "store"sv;
+        case CLEAR:
+            return "clear"sv;
+        case COPY_MEMORY:
+            return "copy_memory"sv;
+        case CALL:
+            return "call"sv;
+        case PHI:
+            return "phi"sv;
+        case COPY:
+            return "copy"sv;
+        case BR:
+            return "br"sv;
+        case CONDBR:
+            return "condbr"sv;
+        case RET:
+            return "ret"sv;
+    }
+    return "?"sv;
+}
+
+std::string_view to_string(Condition condition) {
+    switch (condition) {
+        case Condition::EQ:
+            return "eq"sv;
+        case Condition::NE:
+            return "ne"sv;
+        case Condition::LT:
+            return "lt"sv;
+        case Condition::LE:
+            return "le"sv;
+        case Condition::GT:
+            return "gt"sv;
+        case Condition::GE:
+            return "ge"sv;
+        case Condition::ULT:
+            return "ult"sv;
+        case Condition::ULE:
+            return "ule"sv;
+        case Condition::UGT:
+            return "ugt"sv;
+        case Condition::UGE:
+            return "uge"sv;
+    }
+    return "?"sv;
+}
+
+Condition swapCondition(Condition condition) {
+    switch (condition) {
+        case Condition::LT:
+            return Condition::GT;
+        case Condition::LE:
+            return Condition::GE;
+        case Condition::GT:
+            return Condition::LT;
+        case Condition::GE:
+            return Condition::LE;
+        case Condition::ULT:
+            return Condition::UGT;
+        case Condition::ULE:
+            return Condition::UGE;
+        case Condition::UGT:
+            return Condition::ULT;
+        case Condition::UGE:
+            return Condition::ULE;
+        default:
+            return condition;
+    }
+}
+
+Condition invertCondition(Condition condition) {
+    switch (condition) {
+        case Condition::EQ:
+            return Condition::NE;
+        case Condition::NE:
+            return Condition::EQ;
+        case Condition::LT:
+            return Condition::GE;
+        case Condition::LE:
+            return Condition::GT;
+        case Condition::GT:
+            return Condition::LE;
+        case Condition::GE:
+            return Condition::LT;
+        case Condition::ULT:
+            return Condition::UGE;
+        case Condition::ULE:
+            return Condition::UGT;
+        case Condition::UGT:
+            return Condition::ULE;
+        case Condition::UGE:
+            return Condition::ULT;
+    }
+    Log::unreachable();
+    return condition;
+}
+
+} // namespace yoctocc::ir
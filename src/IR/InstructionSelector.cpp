@@ -0,0 +1,1505 @@
+#include "IR/InstructionSelector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <utility>
+#include "Assembly/Assembly.hpp"
+#include "Assembly/ConstantPool.hpp"
+#include "CallingConvention.hpp"
+#include "FrameLayout.hpp"
+#include "IR/Analysis.hpp"
+#include "IR/RegisterAllocator.hpp"
+#include "Logger.hpp"
+#include "Node/Node.hpp"
+#include "Utility.hpp"
+
+namespace {
+using namespace yoctocc;
+using enum Register;
+using ir::Allocation;
+using ir::BasicBlock;
+using ir::Condition;
+using ir::Location;
+using ir::Opcode;
+using ir::ValueType;
+
+// ループの先頭を揃える境界 (命令フェッチの 16 バイト単位)
+constexpr int LOOP_ALIGNMENT = 16;
+// System V ABI のレッドゾーン。関数を呼ばない関数は rsp を動かさずに rsp の下 128 バイトを使える
+constexpr int RED_ZONE_SIZE = 128;
+
+bool fitsInt32(int64_t value) {
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+bool isXmm(Register reg) {
+    return std::to_underlying(reg) <= std::to_underlying(XMM7);
+}
+
+int widthOf(ValueType type) {
+    return type == ValueType::I32 || type == ValueType::F32 ? 4 : 8;
+}
+
+// 値の型に合わせたレジスタ名 (xmm はそのまま)
+Register named(Register reg, ValueType type) {
+    return isXmm(reg) ? reg : sized(reg, widthOf(type));
+}
+
+std::string memory(int size, Address<Register> address) {
+    switch (size) {
+        case 1:
+            return byte_ptr(std::move(address));
+        case 2:
+            return word_ptr(std::move(address));
+        case 4:
+            return dword_ptr(std::move(address));
+        case 16:
+            return xmmword_ptr(std::move(address));
+        default:
+            return qword_ptr(std::move(address));
+    }
+}
+
+int64_t truncate(int64_t value, int size) {
+    switch (size) {
+        case 1:
+            return static_cast<uint8_t>(value);
+        case 2:
+            return static_cast<uint16_t>(value);
+        case 4:
+            return static_cast<int32_t>(value);
+        default:
+            return value;
+    }
+}
+
+// ベクトルの読み書きに使う転送命令
+OpCode packedMove(ValueType type) {
+    switch (type) {
+        case ValueType::V4F32:
+            return OpCode::MOVUPS;
+        case ValueType::V2F64:
+            return OpCode::MOVUPD;
+        default:
+            return OpCode::MOVDQU;
+    }
+}
+
+// ベクトルの要素ごとの演算 (SSE2)
+OpCode packedOpcode(Opcode opcode, ValueType type) {
+    const bool isWide = type == ValueType::V2I64 || type == ValueType::V2F64;
+    switch (opcode) {
+        case Opcode::ADD:
+            return isWide ? OpCode::PADDQ : OpCode::PADDD;
+        case Opcode::SUB:
+            return isWide ? OpCode::PSUBQ : OpCode::PSUBD;
+        case Opcode::AND:
+            return OpCode::PAND;
+        case Opcode::OR:
+            return OpCode::POR;
+        case Opcode::XOR:
+            return OpCode::PXOR;
+        case Opcode::FADD:
+            return isWide ? OpCode::ADDPD : OpCode::ADDPS;
+        case Opcode::FSUB:
+            return isWide ? OpCode::SUBPD : OpCode::SUBPS;
+        case Opcode::FMUL:
+            return isWide ? OpCode::MULPD : OpCode::MULPS;
+        case Opcode::FDIV:
+            return isWide ? OpCode::DIVPD : OpCode::DIVPS;
+        default:
+            Log::unreachable();
+            return OpCode::PXOR;
+    }
+}
+
+// 浮動小数点数の四則演算 (スカラーとベクトル)
+OpCode floatOpcode(Opcode opcode, ValueType type) {
+    if (ir::isVectorType(type)) {
+        return packedOpcode(opcode, type);
+    }
+    const bool isSingle = type == ValueType::F32;
+    switch (opcode) {
+        case Opcode::FADD:
+            return isSingle ? OpCode::ADDSS : OpCode::ADDSD;
+        case Opcode::FSUB:
+            return isSingle ? OpCode::SUBSS : OpCode::SUBSD;
+        case Opcode::FMUL:
+            return isSingle ? OpCode::MULSS : OpCode::MULSD;
+        default:
+            return isSingle ? OpCode::DIVSS : OpCode::DIVSD;
+    }
+}
+
+// SSE の 2 オペランド形式の演算を、結果のレジスタを別に指定できる VEX 形式にする
+OpCode vexForm(OpCode opCode) {
+    switch (opCode) {
+        case OpCode::ADDSS:
+            return OpCode::VADDSS;
+        case OpCode::ADDSD:
+            return OpCode::VADDSD;
+        case OpCode::SUBSS:
+            return OpCode::VSUBSS;
+        case OpCode::SUBSD:
+            return OpCode::VSUBSD;
+        case OpCode::MULSS:
+            return OpCode::VMULSS;
+        case OpCode::MULSD:
+            return OpCode::VMULSD;
+        case OpCode::DIVSS:
+            return OpCode::VDIVSS;
+        case OpCode::DIVSD:
+            return OpCode::VDIVSD;
+        case OpCode::ADDPS:
+            return OpCode::VADDPS;
+        case OpCode::ADDPD:
+            return OpCode::VADDPD;
+        case OpCode::SUBPS:
+            return OpCode::VSUBPS;
+        case OpCode::SUBPD:
+            return OpCode::VSUBPD;
+        case OpCode::MULPS:
+            return OpCode::VMULPS;
+        case OpCode::MULPD:
+            return OpCode::VMULPD;
+        case OpCode::DIVPS:
+            return OpCode::VDIVPS;
+        case OpCode::DIVPD:
+            return OpCode::VDIVPD;
+        case OpCode::PADDD:
+            return OpCode::VPADDD;
+        case OpCode::PADDQ:
+            return OpCode::VPADDQ;
+        case OpCode::PSUBD:
+            return OpCode::VPSUBD;
+        case OpCode::PSUBQ:
+            return OpCode::VPSUBQ;
+        case OpCode::PAND:
+            return OpCode::VPAND;
+        case OpCode::POR:
+            return OpCode::VPOR;
+        case OpCode::PXOR:
+            return OpCode::VPXOR;
+        default:
+            Log::unreachable();
+            return opCode;
+    }
+}
+
+// vfmadd231 (c + a * b) / vfmsub231 (a * b - c) / vfnmadd231 (c - a * b) を型ごとに並べたもの
+constexpr std::array<std::array<OpCode, 4>, 3> FUSED_OPCODES = {{
+    {OpCode::VFMADD231SS, OpCode::VFMADD231SD, OpCode::VFMADD231PS, OpCode::VFMADD231PD},
+    {OpCode::VFMSUB231SS, OpCode::VFMSUB231SD, OpCode::VFMSUB231PS, OpCode::VFMSUB231PD},
+    {OpCode::VFNMADD231SS, OpCode::VFNMADD231SD, OpCode::VFNMADD231PS, OpCode::VFNMADD231PD},
+}};
+
+// pshufd で 2 つの 64 ビットの要素を入れ替える / 先頭の要素を並べる
+constexpr int SWAP_QWORDS = 0x4E;
+constexpr int SWAP_DWORDS = 0xB1;
+constexpr int BROADCAST_DWORD = 0x00;
+constexpr int BROADCAST_QWORD = 0x44;
+
+OpCode setOpcode(Condition condition) {
+    switch (condition) {
+        case Condition::EQ:
+            return OpCode::SETE;
+        case Condition::NE:
+            return OpCode::SETNE;
+        case Condition::LT:
+            return OpCode::SETL;
+        case Condition::LE:
+            return OpCode::SETLE;
+        case Condition::GT:
+            return OpCode::SETG;
+        case Condition::GE:
+            return OpCode::SETGE;
+        case Condition::ULT:
+            return OpCode::SETB;
+        case Condition::ULE:
+            return OpCode::SETBE;
+        case Condition::UGT:
+            return OpCode::SETA;
+        case Condition::UGE:
+            return OpCode::SETAE;
+    }
+    return OpCode::SETE;
+}
+
+OpCode jumpOpcode(Condition condition) {
+    switch (condition) {
+        case Condition::EQ:
+            return OpCode::JE;
+        case Condition::NE:
+            return OpCode::JNE;
+        case Condition::LT:
+            return OpCode::JL;
+        case Condition::LE:
+            return OpCode::JLE;
+        case Condition::GT:
+            return OpCode::JG;
+        case Condition::GE:
+            return OpCode::JGE;
+        case Condition::ULT:
+            return OpCode::JB;
+        case Condition::ULE:
+            return OpCode::JBE;
+        case Condition::UGT:
+            return OpCode::JA;
+        case Condition::UGE:
+            return OpCode::JAE;
+    }
+    return OpCode::JE;
+}
+
+// 並列コピーの 1 つ。from が NONE なら value を作り直す
+struct Move {
+    Location to;
+    Location from;
+    const ir::Instruction* value;
+};
+
+Location inRegister(Register reg) {
+    return Location{.kind = Location::Kind::REGISTER, .reg = reg};
+}
+
+class InstructionSelector final {
+public:
+    InstructionSelector(ir::Function& function, const ir::Target& target, ConstantPool& constantPool)
+        : _function(function), _target(target), _constantPool(constantPool) {
+    }
+
+    std::vector<std::string> run() {
+        _allocation = ir::allocateRegisters(_function, _target);
+        layoutFrame();
+
+        // 早く抜ける経路はプロローグより前で調べて、フレームを作らずに戻る (shrink-wrapping)
+        auto order = _allocation.order;
+        const BasicBlock* earlyExit = findEarlyExit();
+        if (earlyExit) {
+            std::erase(order, earlyExit);
+            branchToEarlyExit(earlyExit);
+        }
+
+        if (_target.omitsFramePointer) {
+            for (auto reg : _allocation.calleeSaved) {
+                emit(push(reg));
+            }
+            if (_stackAdjustment > 0) {
+                emit(sub(RSP, _stackAdjustment));
+            }
+        } else {
+            emit(push(RBP));
+            emit(mov(RBP, RSP));
+            if (_frameSize > 0) {
+                emit(sub(RSP, _frameSize));
+            }
+            for (auto reg : _allocation.calleeSaved) {
+                emit(push(reg));
+            }
+            if (_outgoingSize > 0) {
+                emit(sub(RSP, _outgoingSize));
+            }
+        }
+
+        for (size_t i = 0; i < order.size(); i++) {
+            _next = i + 1 < order.size() ? order[i + 1] : nullptr;
+            if (i > 0) {
+                if (_allocation.loopHeads[order[i]->id]) {
+                    emit(directive::align(LOOP_ALIGNMENT));
+                }
+                emit(blockLabel(order[i]).def());
+            } else {
+                receiveParameters(order[i]);
+                if (earlyExit) {
+                    // 入口の条件分岐はプロローグの前で済んでいるので、残りの経路へ進むだけ
+                    const auto* condbr = order[i]->terminator();
+                    jumpFrom(order[i], condbr->blocks[condbr->blocks[0] == earlyExit ? 1 : 0]);
+                    continue;
+                }
+            }
+            for (const auto& instruction : order[i]->instructions) {
+                if (instruction->opcode == Opcode::PHI || instruction->opcode == Opcode::PARAM ||
+                    _allocation.inlined[instruction->id]) {
+                    continue;
+                }
+                if (instruction->line != 0 && instruction->line != _line) {
+                    _line = instruction->line;
+                    emit(directive::loc(1, static_cast<int>(_line)));
+                }
+                select(*instruction);
+            }
+        }
+        if (earlyExit) {
+            returnWithoutFrame(earlyExit);
+        }
+        return std::move(_lines);
+    }
+
+private:
+    void emit(std::string&& line) {
+        _lines.emplace_back(std::move(line));
+    }
+
+    Label blockLabel(const BasicBlock* block) const {
+        return labels::label("bb." + _function.name, static_cast<uint64_t>(block->id));
+    }
+
+    // フレームがなくても引数レジスタから読める値 (定数とレジスタで受け取る整数の引数)
+    static bool isFramelessOperand(const ir::Instruction* value, bool allowFloat) {
+        if (value->opcode == Opcode::CONST) {
+            return true;
+        }
+        return value->opcode == Opcode::PARAM && (allowFloat || !value->isFloat()) &&
+               static_cast<size_t>(value->immediate) < argumentRegisterCount(value);
+    }
+
+    // 入口が引数と定数の比較だけで分岐し、その片方が定数か引数を返すだけのブロックなら、そのブロックを返す。
+    // そのブロックへはプロローグの前に分岐して、フレームを作らずに戻れる
+    const BasicBlock* findEarlyExit() const {
+        const bool hasPrologue =
+            !_target.omitsFramePointer || !_allocation.calleeSaved.empty() || _stackAdjustment > 0;
+        const BasicBlock* entry = _allocation.order.front();
+        const auto* condbr = entry->terminator();
+        if (!_target.shrinkWraps || !hasPrologue || !entry->predecessors.empty() || !condbr || condbr->opcode != Opcode::CONDBR ||
+            condbr->blocks[0] == condbr->blocks[1]) {
+            return nullptr;
+        }
+        const auto* condition = condbr->operands[0];
+        if (condition->opcode != Opcode::CMP || condition->parent != entry || !_allocation.inlined[condition->id] ||
+            !std::ranges::all_of(condition->operands, [](const auto* operand) {
+                return isFramelessOperand(operand, false);
+            })) {
+            return nullptr;
+        }
+        for (const auto& instruction : entry->instructions) {
+            if (instruction->opcode != Opcode::PARAM && instruction.get() != condition && instruction.get() != condbr &&
+                !(instruction->opcode == Opcode::CONST && _allocation.inlined[instruction->id])) {
+                return nullptr;
+            }
+        }
+
+        for (const auto* exit : condbr->blocks) {
+            const auto* ret = exit->terminator();
+            if (exit->predecessors.size() != 1 || !ret || ret->opcode != Opcode::RET ||
+                (!ret->operands.empty() && !isFramelessOperand(ret->operands[0], true))) {
+                continue;
+            }
+            if (std::ranges::all_of(exit->instructions, [&](const auto& instruction) {
+                    return instruction.get() == ret ||
+                           (instruction->opcode == Opcode::CONST && _allocation.inlined[instruction->id]);
+                })) {
+                return exit;
+            }
+        }
+        return nullptr;
+    }
+
+    // 引数の置き場所を、プロローグで割り当て先へ移す前の引数レジスタにする (戻すための元の置き場所を返す)
+    std::vector<std::pair<const ir::Instruction*, Location>> useArgumentRegisters() {
+        std::vector<std::pair<const ir::Instruction*, Location>> saved;
+        for (const auto& instruction : _allocation.order.front()->instructions) {
+            if (instruction->opcode != Opcode::PARAM || !isFramelessOperand(instruction.get(), true)) {
+                continue;
+            }
+            const auto index = static_cast<size_t>(instruction->immediate);
+            auto& location = _allocation.locations[instruction->id];
+            saved.emplace_back(instruction.get(), location);
+            location = inRegister(instruction->isFloat() ? ARG_REGISTERS128[index] : ARG_REGISTERS64[index]);
+        }
+        return saved;
+    }
+
+    void restoreLocations(const std::vector<std::pair<const ir::Instruction*, Location>>& saved) {
+        for (const auto& [value, location] : saved) {
+            _allocation.locations[value->id] = location;
+        }
+    }
+
+    // 入口の比較を引数レジスタのまま行い、早く抜けるブロックへ分岐する (比較は rax / r11 しか壊さない)
+    void branchToEarlyExit(const BasicBlock* exit) {
+        const auto* condbr = _allocation.order.front()->terminator();
+        const auto* condition = condbr->operands[0];
+        const auto saved = useArgumentRegisters();
+        compare(*condition);
+        restoreLocations(saved);
+        const auto jump = condbr->blocks[0] == exit ? jumpOpcode(condition->condition)
+                                                    : jumpOpcode(ir::invertCondition(condition->condition));
+        emit(yoctocc::instruction(jump, blockLabel(exit).ref()));
+    }
+
+    // 早く抜けるブロックは関数の最後に置き、フレームを片付けずに戻る
+    void returnWithoutFrame(const BasicBlock* exit) {
+        emit(blockLabel(exit).def());
+        const auto* terminator = exit->terminator();
+        const auto saved = useArgumentRegisters();
+        if (!terminator->operands.empty()) {
+            const auto* value = terminator->operands[0];
+            materialize(value->isFloat() ? XMM0 : RAX, value);
+        }
+        restoreLocations(saved);
+        emit(ret());
+    }
+
+    // rbp の直下に参照の残っている FrameSlot、その下にスピル領域を置き、callee-saved レジスタはさらに下へ積む。
+    // フレームの配置に依存する関数では、すべての FrameSlot をスタックマシンと同じ位置に置く。
+    // rbp を使わないときは callee-saved レジスタを先に積み、その下に同じ並びのフレームを置いて rsp から参照する
+    void layoutFrame() {
+        const bool observed = observesFrameLayout(_function);
+        std::vector<bool> referenced(_function.slots.size(), observed);
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                if (instruction->opcode == Opcode::FRAME_ADDRESS) {
+                    referenced[static_cast<size_t>(instruction->immediate)] = true;
+                }
+            }
+        }
+
+        int offset = 0;
+        _slotOffsets.assign(_function.slots.size(), 0);
+        if (_target.colorsStackSlots && !observed) {
+            // 変数のない FrameSlot (lowering の一時領域) は関数全体で生きているとみなす
+            std::vector<size_t> indices;
+            std::vector<frame::FrameObject> objects;
+            for (size_t i = 0; i < _function.slots.size(); i++) {
+                if (!referenced[i]) {
+                    continue;
+                }
+                const auto& slot = _function.slots[i];
+                frame::FrameObject object{.size = slot.size, .alignment = slot.alignment};
+                if (slot.variable) {
+                    object.lifetimeBegin = slot.variable->lifetimeBegin;
+                    object.lifetimeEnd = slot.variable->lifetimeEnd;
+                }
+                indices.emplace_back(i);
+                objects.emplace_back(object);
+            }
+            const auto layout = frame::layoutObjects(objects);
+            for (size_t i = 0; i < indices.size(); i++) {
+                _slotOffsets[indices[i]] = layout.offsets[i];
+            }
+            offset = layout.size;
+        } else {
+            for (size_t i = 0; i < _function.slots.size(); i++) {
+                if (!referenced[i]) {
+                    continue;
+                }
+                const auto& slot = _function.slots[i];
+                offset = static_cast<int>(alignTo(offset + slot.size, std::max(slot.alignment, 1)));
+                _slotOffsets[i] = -offset;
+            }
+        }
+        _spillBase = static_cast<int>(alignTo(offset, 8));
+        offset = _spillBase + _allocation.spillSlots * 8;
+        // call の時点で rsp が 16 バイト境界に揃うようにする
+        const int saved = static_cast<int>(_allocation.calleeSaved.size()) * 8;
+        _frameSize = static_cast<int>(alignTo(offset + saved, 16)) - saved;
+
+        // スタックで渡す引数の領域は callee-saved レジスタの下に、どの呼び出しにも足りる大きさで確保しておく
+        bool isLeaf = true;
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                if (instruction->opcode == Opcode::CALL) {
+                    const int outgoing = static_cast<int>(alignTo(stackArgumentCount(*instruction) * 8, 16));
+                    _outgoingSize = std::max(_outgoingSize, outgoing);
+                    isLeaf = false;
+                }
+                // 大きな CLEAR は rdi を push するので、レッドゾーンのフレームを壊す
+                if (instruction->opcode == Opcode::CLEAR && instruction->immediate > 64) {
+                    isLeaf = false;
+                }
+            }
+        }
+
+        if (_target.omitsFramePointer) {
+            // 戻り番地と callee-saved レジスタの下でフレームの上端が 16 バイト境界に揃うよう詰め物を入れる
+            _framePadding = (8 + saved) % 16;
+            const int frame = static_cast<int>(alignTo(offset, 16));
+            const bool fitsRedZone = isLeaf && _framePadding + frame <= RED_ZONE_SIZE;
+            _stackAdjustment = fitsRedZone ? 0 : _framePadding + frame + _outgoingSize;
+        }
+    }
+
+    // フレームの上端 (rbp を使うときは rbp) からの位置。rbp を使わないときは rsp からの位置にする
+    Address<Register> frameAddress(int offset) const {
+        if (!_target.omitsFramePointer) {
+            return Address{RBP, offset};
+        }
+        return Address{RSP, _stackAdjustment - _framePadding + _pushedSize + offset};
+    }
+
+    // 呼び出し元がスタックに置いた slot 番目の引数
+    Address<Register> incomingArgumentAddress(int slot) const {
+        if (!_target.omitsFramePointer) {
+            // 戻り番地と退避した rbp の上
+            return Address{RBP, 16 + slot * 8};
+        }
+        // 戻り番地と callee-saved レジスタの上
+        const int saved = static_cast<int>(_allocation.calleeSaved.size()) * 8;
+        return Address{RSP, _stackAdjustment + _pushedSize + saved + 8 + slot * 8};
+    }
+
+    // レジスタに入りきらずスタックで渡す引数の数
+    static int stackArgumentCount(const ir::Instruction& call) {
+        int integers = 0;
+        int floats = 0;
+        for (const auto* argument : call.operands) {
+            (argument->isFloat() ? floats : integers)++;
+        }
+        return std::max(integers - abi::INTEGER_ARGUMENT_REGISTERS, 0) +
+               std::max(floats - abi::FLOAT_ARGUMENT_REGISTERS, 0);
+    }
+
+    Address<Register> spillAddress(int slot) const {
+        return frameAddress(-(_spillBase + (slot + 1) * 8));
+    }
+
+    const Location& locationOf(const ir::Instruction* value) const {
+        return _allocation.locations[value->id];
+    }
+
+    bool isIn(const ir::Instruction* value, Register reg) const {
+        const auto& location = locationOf(value);
+        return !ir::isRematerializable(value) && location.kind == Location::Kind::REGISTER && location.reg == reg;
+    }
+
+    // 結果を計算するレジスタ (割り当て先がレジスタならそこに直接計算する)
+    Register target(const ir::Instruction* value, Register fallback) const {
+        const auto& location = locationOf(value);
+        return location.kind == Location::Kind::REGISTER ? location.reg : fallback;
+    }
+
+    // value を reg (64 ビットの汎用レジスタか xmm) に入れる
+    void materialize(Register reg, const ir::Instruction* value) {
+        switch (value->opcode) {
+            case Opcode::CONST:
+                if (!isXmm(reg)) {
+                    if (value->immediate == 0) {
+                        emit(xor_(sized(reg, 4), sized(reg, 4)));
+                    } else {
+                        emit(mov(named(reg, value->type), value->immediate));
+                    }
+                } else if (value->immediate == 0) {
+                    emit(xorps(reg, reg));
+                } else {
+                    // xmm へは汎用レジスタを経由せず .rodata の定数から読む
+                    const bool isNarrow = value->type == ValueType::F32 || value->type == ValueType::I32;
+                    auto label = _constantPool.scalar(static_cast<uint64_t>(value->immediate), isNarrow ? 4 : 8);
+                    emit(isNarrow ? movss(reg, RipRelativeAddress{label}) : movsd(reg, RipRelativeAddress{label}));
+                }
+                return;
+            case Opcode::FRAME_ADDRESS:
+                emit(lea(reg, frameAddress(_slotOffsets[static_cast<size_t>(value->immediate)])));
+                return;
+            case Opcode::GLOBAL_ADDRESS:
+                emit(lea(reg, RipRelativeAddress{value->symbol}));
+                return;
+            default:
+                break;
+        }
+        moveLocation(inRegister(reg), locationOf(value));
+    }
+
+    // レジスタにある値ならそのレジスタ、なければ scratch に入れる
+    Register use(const ir::Instruction* value, Register scratch) {
+        const auto& location = locationOf(value);
+        if (!ir::isRematerializable(value) && location.kind == Location::Kind::REGISTER) {
+            return location.reg;
+        }
+        materialize(scratch, value);
+        return scratch;
+    }
+
+    // ALU 命令の 2 番目のオペランド (32 ビットに収まる定数は即値にする)
+    std::string source(const ir::Instruction* value, Register scratch, bool allowImmediate = true) {
+        if (allowImmediate && value->opcode == Opcode::CONST && fitsInt32(value->immediate)) {
+            return std::to_string(value->immediate);
+        }
+        return to_string(named(use(value, scratch), value->type));
+    }
+
+    // reg に計算した結果を割り当て先に書く
+    void define(const ir::Instruction* value, Register reg) {
+        const auto& location = locationOf(value);
+        if (location.kind == Location::Kind::NONE) {
+            return;
+        }
+        moveLocation(location, inRegister(reg));
+    }
+
+    void moveLocation(const Location& to, const Location& from) {
+        using enum Location::Kind;
+        if (to == from) {
+            return;
+        }
+        if (to.isVector || from.isVector) {
+            moveVector(to, from);
+        } else if (to.kind == REGISTER && from.kind == REGISTER) {
+            if (isXmm(to.reg) && isXmm(from.reg)) {
+                emit(movaps(to.reg, from.reg));
+            } else if (isXmm(to.reg) || isXmm(from.reg)) {
+                emit(movq(to.reg, from.reg));
+            } else {
+                emit(mov(to.reg, from.reg));
+            }
+        } else if (to.kind == REGISTER && from.kind == STACK) {
+            if (isXmm(to.reg)) {
+                emit(movsd(to.reg, memory(8, spillAddress(from.spillSlot))));
+            } else {
+                emit(mov(to.reg, memory(8, spillAddress(from.spillSlot))));
+            }
+        } else if (to.kind == STACK && from.kind == REGISTER) {
+            if (isXmm(from.reg)) {
+                emit(movsd(memory(8, spillAddress(to.spillSlot)), from.reg));
+            } else {
+                emit(mov(memory(8, spillAddress(to.spillSlot)), from.reg));
+            }
+        } else if (to.kind == STACK && from.kind == STACK) {
+            emit(mov(R11, memory(8, spillAddress(from.spillSlot))));
+            emit(mov(memory(8, spillAddress(to.spillSlot)), R11));
+        } else {
+            Log::unreachable();
+        }
+    }
+
+    // xmm レジスタ全体 (16 バイト) を転送する
+    void moveVector(const Location& to, const Location& from) {
+        using enum Location::Kind;
+        if (to.kind == REGISTER && from.kind == REGISTER) {
+            emit(movaps(to.reg, from.reg));
+        } else if (to.kind == REGISTER && from.kind == STACK) {
+            emit(movdqu(to.reg, memory(16, spillAddress(from.spillSlot))));
+        } else if (to.kind == STACK && from.kind == REGISTER) {
+            emit(movdqu(memory(16, spillAddress(to.spillSlot)), from.reg));
+        } else if (to.kind == STACK && from.kind == STACK) {
+            emit(movdqu(XMM0, memory(16, spillAddress(from.spillSlot))));
+            emit(movdqu(memory(16, spillAddress(to.spillSlot)), XMM0));
+        } else {
+            Log::unreachable();
+        }
+    }
+
+    // 作り直す値を to に置く
+    void rematerialize(const Location& to, const ir::Instruction* value) {
+        if (to.kind == Location::Kind::REGISTER) {
+            materialize(to.reg, value);
+            return;
+        }
+        if (value->opcode == Opcode::CONST && fitsInt32(value->immediate)) {
+            emit(mov(memory(8, spillAddress(to.spillSlot)), value->immediate));
+            return;
+        }
+        if (value->opcode == Opcode::CONST) {
+            emit(mov(R11, value->immediate));
+        } else {
+            materialize(R11, value);
+        }
+        emit(mov(memory(8, spillAddress(to.spillSlot)), R11));
+    }
+
+    // コピー先が他のコピー元でないものから順に行い、循環は rax (ベクトルは xmm0) に逃がして切る。
+    // 作り直す値は他のコピー元を壊さないよう最後に置く
+    void parallelMove(std::vector<Move> moves) {
+        std::vector<Move> pending;
+        std::vector<Move> rematerialized;
+        for (auto& move : moves) {
+            if (move.from.kind == Location::Kind::NONE) {
+                rematerialized.emplace_back(move);
+            } else if (!(move.to == move.from)) {
+                pending.emplace_back(move);
+            }
+        }
+
+        while (!pending.empty()) {
+            auto ready = std::ranges::find_if(pending, [&](const Move& move) {
+                return std::ranges::none_of(pending, [&](const Move& other) { return other.from == move.to; });
+            });
+            if (ready != pending.end()) {
+                moveLocation(ready->to, ready->from);
+                pending.erase(ready);
+                continue;
+            }
+            const Location blocked = pending.front().to;
+            const Location temporary =
+                blocked.isVector ? Location{.kind = Location::Kind::REGISTER, .reg = XMM0, .isVector = true}
+                                 : inRegister(RAX);
+            moveLocation(temporary, blocked);
+            for (auto& move : pending) {
+                if (move.from == blocked) {
+                    move.from = temporary;
+                }
+            }
+        }
+
+        for (const auto& move : rematerialized) {
+            rematerialize(move.to, move.value);
+        }
+    }
+
+    Move moveOf(Location to, const ir::Instruction* value) const {
+        return Move{to, ir::isRematerializable(value) ? Location{} : locationOf(value), value};
+    }
+
+    void receiveParameters(const BasicBlock* entry) {
+        std::vector<Move> moves;
+        std::vector<const ir::Instruction*> onStack;
+        for (const auto& instruction : entry->instructions) {
+            if (instruction->opcode != Opcode::PARAM) {
+                break;
+            }
+            const auto& location = locationOf(instruction.get());
+            if (location.kind == Location::Kind::NONE) {
+                continue;
+            }
+            const auto index = static_cast<size_t>(instruction->immediate);
+            if (index >= argumentRegisterCount(instruction.get())) {
+                onStack.emplace_back(instruction.get());
+                continue;
+            }
+            Register reg = instruction->isFloat() ? ARG_REGISTERS128[index] : ARG_REGISTERS64[index];
+            moves.emplace_back(Move{location, inRegister(reg), instruction.get()});
+        }
+        parallelMove(std::move(moves));
+
+        // 呼び出し元の引数領域から読む
+        for (const auto* param : onStack) {
+            const auto slot = static_cast<int>(param->immediate - argumentRegisterCount(param));
+            const auto address = incomingArgumentAddress(slot);
+            if (param->isFloat()) {
+                emit(param->type == ValueType::F32 ? movss(XMM0, memory(4, address)) : movsd(XMM0, memory(8, address)));
+                define(param, XMM0);
+            } else {
+                emit(mov(named(R11, param->type), memory(widthOf(param->type), address)));
+                define(param, R11);
+            }
+        }
+    }
+
+    static size_t argumentRegisterCount(const ir::Instruction* value) {
+        return value->isFloat() ? abi::FLOAT_ARGUMENT_REGISTERS : abi::INTEGER_ARGUMENT_REGISTERS;
+    }
+
+    // LOAD / STORE などのアドレス。定数の加算は変位にする
+    Address<Register> address(const ir::Instruction* value, Register scratch) {
+        if (value->opcode == Opcode::FRAME_ADDRESS) {
+            return frameAddress(_slotOffsets[static_cast<size_t>(value->immediate)]);
+        }
+        if (value->opcode == Opcode::ADD && _allocation.inlined[value->id]) {
+            return address(value->operands[0], scratch) + static_cast<int>(value->operands[1]->immediate);
+        }
+        return Address{use(value, scratch)};
+    }
+
+    void select(const ir::Instruction& instruction) {
+        const auto& operands = instruction.operands;
+        if (const auto* product = inlinedOperand(instruction, Opcode::FMUL)) {
+            fusedMultiplyAdd(instruction, product);
+            return;
+        }
+        if (instruction.isVector() && instruction.opcode != Opcode::LOAD && instruction.opcode != Opcode::SPLAT &&
+            instruction.opcode != Opcode::COPY) {
+            floatBinary(instruction, packedOpcode(instruction.opcode, instruction.type));
+            return;
+        }
+        switch (instruction.opcode) {
+            case Opcode::ADD:
+                binary(instruction, OpCode::ADD);
+                return;
+            case Opcode::SUB:
+                binary(instruction, OpCode::SUB);
+                return;
+            case Opcode::MUL:
+                binary(instruction, OpCode::IMUL);
+                return;
+            case Opcode::AND:
+                if (const auto* inverted = inlinedOperand(instruction, Opcode::NOT)) {
+                    andNot(instruction, inverted);
+                    return;
+                }
+                binary(instruction, OpCode::AND);
+                return;
+            case Opcode::OR:
+                binary(instruction, OpCode::OR);
+                return;
+            case Opcode::XOR:
+                binary(instruction, OpCode::XOR);
+                return;
+            case Opcode::SDIV:
+            case Opcode::UDIV:
+            case Opcode::SREM:
+            case Opcode::UREM:
+                divide(instruction);
+                return;
+            case Opcode::SHL:
+                shift(instruction, OpCode::SHL);
+                return;
+            case Opcode::SHR:
+                shift(instruction, OpCode::SHR);
+                return;
+            case Opcode::SAR:
+                shift(instruction, OpCode::SAR);
+                return;
+            case Opcode::NEG:
+            case Opcode::NOT: {
+                Register result = target(&instruction, RAX);
+                materialize(result, operands[0]);
+                const auto reg = named(result, instruction.type);
+                emit(instruction.opcode == Opcode::NEG ? neg(reg) : not_(reg));
+                define(&instruction, result);
+                return;
+            }
+            case Opcode::POPCOUNT:
+            case Opcode::CLZ:
+            case Opcode::CTZ: {
+                Register value = use(operands[0], RAX);
+                Register result = target(&instruction, RAX);
+                const auto opCode = instruction.opcode == Opcode::POPCOUNT ? OpCode::POPCNT
+                                    : instruction.opcode == Opcode::CLZ    ? OpCode::LZCNT
+                                                                           : OpCode::TZCNT;
+                emit(yoctocc::instruction(opCode, named(result, instruction.type), named(value, instruction.type)));
+                define(&instruction, result);
+                return;
+            }
+            case Opcode::FADD:
+            case Opcode::FSUB:
+            case Opcode::FMUL:
+            case Opcode::FDIV:
+                floatBinary(instruction, floatOpcode(instruction.opcode, instruction.type));
+                return;
+            case Opcode::FNEG: {
+                Register result = target(&instruction, XMM0);
+                materialize(result, operands[0]);
+                const int size = instruction.type == ValueType::F32 ? 4 : 8;
+                emit(xorps(result, RipRelativeAddress{_constantPool.signMask(size)}));
+                define(&instruction, result);
+                return;
+            }
+            case Opcode::SPLAT:
+                splat(instruction);
+                return;
+            case Opcode::REDUCE:
+                reduce(instruction);
+                return;
+            case Opcode::CMP:
+            case Opcode::FCMP:
+                compareToValue(instruction);
+                return;
+            case Opcode::SEXT: {
+                Register value = use(operands[0], RAX);
+                Register result = target(&instruction, RAX);
+                emit(movsxd(result, sized(value, 4)));
+                define(&instruction, result);
+                return;
+            }
+            case Opcode::ZEXT:
+            case Opcode::TRUNC: {
+                Register value = use(operands[0], RAX);
+                Register result = target(&instruction, RAX);
+                emit(mov(sized(result, 4), sized(value, 4)));
+                define(&instruction, result);
+                return;
+            }
+            case Opcode::EXTEND: {
+                Register value = use(operands[0], RAX);
+                Register result = target(&instruction, RAX);
+                const int size = static_cast<int>(instruction.immediate / 8);
+                emit(instruction.isSigned ? movsbl(sized(result, 4), sized(value, size))
+                                          : movzbl(sized(result, 4), sized(value, size)));
+                define(&instruction, result);
+                return;
+            }
+            case Opcode::SITOFP: {
+                Register value = use(operands[0], RAX);
+                Register result = target(&instruction, XMM0);
+                const auto source = named(value, operands[0]->type);
+                emit(instruction.type == ValueType::F32 ? cvtsi2ss(result, source) : cvtsi2sd(result, source));
+                define(&instruction, result);
+                return;
+            }
+            case Opcode::UITOFP:
+                unsignedToFloat(instruction);
+                return;
+            case Opcode::FPTOSI: {
+                Register value = use(operands[0], XMM0);
+                Register result = target(&instruction, RAX);
+                const auto destination = named(result, instruction.type);
+                emit(operands[0]->type == ValueType::F32 ? cvttss2si(destination, value)
+                                                         : cvttsd2si(destination, value));
+                define(&instruction, result);
+                return;
+            }
+            case Opcode::FPEXT:
+            case Opcode::FPTRUNC: {
+                Register value = use(operands[0], XMM0);
+                Register result = target(&instruction, XMM0);
+                emit(instruction.opcode == Opcode::FPEXT ? cvtss2sd(result, value) : cvtsd2ss(result, value));
+                define(&instruction, result);
+                return;
+            }
+            case Opcode::LOAD:
+                load(instruction);
+                return;
+            case Opcode::STORE:
+                store(instruction);
+                return;
+            case Opcode::CLEAR:
+                clear(instruction);
+                return;
+            case Opcode::COPY_MEMORY:
+                copyMemory(instruction);
+                return;
+            case Opcode::CALL:
+                callFunction(instruction);
+                return;
+            case Opcode::COPY:
+                parallelMove({moveOf(locationOf(&instruction), operands[0])});
+                return;
+            case Opcode::BR:
+                jumpTo(instruction);
+                return;
+            case Opcode::CONDBR:
+                conditionalBranch(instruction);
+                return;
+            case Opcode::RET:
+                returnFrom(instruction);
+                return;
+            case Opcode::CONST:
+            case Opcode::PARAM:
+            case Opcode::FRAME_ADDRESS:
+            case Opcode::GLOBAL_ADDRESS:
+            case Opcode::PHI:
+                return;
+        }
+    }
+
+    // 結果のレジスタに左辺を入れてから右辺を演算する。
+    // 右辺が結果のレジスタにあるときは、交換できる演算なら入れ替え、できなければ rax で計算する
+    void binary(const ir::Instruction& instruction, OpCode opCode) {
+        const auto* lhs = instruction.operands[0];
+        const auto* rhs = instruction.operands[1];
+        Register result = target(&instruction, RAX);
+        if (lhs != rhs && isIn(rhs, result)) {
+            if (ir::isCommutative(instruction.opcode)) {
+                std::swap(lhs, rhs);
+            } else {
+                result = RAX;
+            }
+        }
+        materialize(result, lhs);
+        // imul は即値を取る形を使わない
+        emit(yoctocc::instruction(opCode, named(result, instruction.type), source(rhs, R11, opCode != OpCode::IMUL)));
+        define(&instruction, result);
+    }
+
+    void floatBinary(const ir::Instruction& instruction, OpCode opCode) {
+        const auto* lhs = instruction.operands[0];
+        const auto* rhs = instruction.operands[1];
+        if (_target.hasAvx) {
+            // VEX 形式は結果を別のレジスタに書けるので、左辺を結果のレジスタへ移さなくてよい
+            Register left = use(lhs, XMM0);
+            Register right = use(rhs, XMM1);
+            Register result = target(&instruction, XMM0);
+            emit(yoctocc::instruction(vexForm(opCode), result, left, right));
+            define(&instruction, result);
+            return;
+        }
+        Register result = target(&instruction, XMM0);
+        if (lhs != rhs && isIn(rhs, result)) {
+            if (ir::isCommutative(instruction.opcode)) {
+                std::swap(lhs, rhs);
+            } else {
+                result = XMM0;
+            }
+        }
+        Register right = use(rhs, XMM1);
+        materialize(result, lhs);
+        emit(yoctocc::instruction(opCode, result, right));
+        define(&instruction, result);
+    }
+
+    // instruction に埋め込んだ opcode のオペランド (andn の ~a と FMA の a * b)
+    const ir::Instruction* inlinedOperand(const ir::Instruction& instruction, Opcode opcode) const {
+        for (const auto* operand : instruction.operands) {
+            if (operand->opcode == opcode && _allocation.inlined[operand->id]) {
+                return operand;
+            }
+        }
+        return nullptr;
+    }
+
+    // ~a & b を andn 1 命令で計算する
+    void andNot(const ir::Instruction& instruction, const ir::Instruction* inverted) {
+        const auto* other = instruction.operands[instruction.operands[0] == inverted ? 1 : 0];
+        const auto type = instruction.type;
+        Register mask = use(inverted->operands[0], R11);
+        Register value = use(other, RAX);
+        Register result = target(&instruction, RAX);
+        emit(andn(named(result, type), named(mask, type), named(value, type)));
+        define(&instruction, result);
+    }
+
+    // a * b + c / a * b - c / c - a * b を FMA 1 命令で計算する。
+    // 231 形式は結果のレジスタに c を入れておき、a をレジスタ、b をレジスタかスピル領域から読む
+    void fusedMultiplyAdd(const ir::Instruction& instruction, const ir::Instruction* product) {
+        const bool productIsLeft = instruction.operands[0] == product;
+        const auto* addend = instruction.operands[productIsLeft ? 1 : 0];
+        const size_t form = instruction.opcode == Opcode::FADD ? 0 : productIsLeft ? 1 : 2;
+        const auto type = instruction.type;
+        const size_t column = type == ValueType::F32     ? 0
+                              : type == ValueType::F64   ? 1
+                              : type == ValueType::V4F32 ? 2
+                                                         : 3;
+        const auto* lhs = product->operands[0];
+        const auto* rhs = product->operands[1];
+        auto isStored = [&](const ir::Instruction* value) {
+            return !ir::isRematerializable(value) && locationOf(value).kind != Location::Kind::NONE;
+        };
+        if (!isStored(rhs)) {
+            std::swap(lhs, rhs);
+        }
+
+        Register result = target(&instruction, XMM0);
+        if ((isIn(lhs, result) || isIn(rhs, result)) && !isIn(addend, result)) {
+            result = XMM0;
+        }
+        if (result == XMM0 && !isStored(rhs)) {
+            // 一時レジスタが足りないときは積を先に計算する (丸めは 2 回になる)
+            materialize(XMM1, lhs);
+            materialize(XMM0, rhs);
+            emit(yoctocc::instruction(vexForm(floatOpcode(Opcode::FMUL, type)), XMM1, XMM1, XMM0));
+            materialize(XMM0, addend);
+            const auto opCode = vexForm(floatOpcode(instruction.opcode, type));
+            emit(productIsLeft ? yoctocc::instruction(opCode, XMM0, XMM1, XMM0)
+                               : yoctocc::instruction(opCode, XMM0, XMM0, XMM1));
+            define(&instruction, XMM0);
+            return;
+        }
+
+        Register left = use(lhs, XMM1);
+        std::string right;
+        if (isStored(rhs) && locationOf(rhs).kind == Location::Kind::STACK) {
+            const int size = instruction.isVector() ? 16 : widthOf(type);
+            right = memory(size, spillAddress(locationOf(rhs).spillSlot));
+        } else {
+            right = to_string(use(rhs, XMM0));
+        }
+        materialize(result, addend);
+        emit(yoctocc::instruction(FUSED_OPCODES[form][column], result, left, right));
+        define(&instruction, result);
+    }
+
+    void splat(const ir::Instruction& instruction) {
+        const auto* value = instruction.operands[0];
+        const int order = widthOf(value->type) == 4 ? BROADCAST_DWORD : BROADCAST_QWORD;
+        Register result = target(&instruction, XMM0);
+        if (value->isFloat()) {
+            emit(pshufd(result, use(value, XMM1), order));
+        } else {
+            Register scalar = use(value, RAX);
+            emit(value->type == ValueType::I32 ? movd(XMM1, sized(scalar, 4)) : movq(XMM1, scalar));
+            emit(pshufd(result, XMM1, order));
+        }
+        define(&instruction, result);
+    }
+
+    // 上下の半分を重ねて演算することを要素が 1 つになるまで繰り返す
+    void reduce(const ir::Instruction& instruction) {
+        const auto* vector = instruction.operands[0];
+        const auto opCode = packedOpcode(static_cast<Opcode>(instruction.immediate), vector->type);
+        Register source = use(vector, XMM1);
+        emit(pshufd(XMM0, source, SWAP_QWORDS));
+        emit(yoctocc::instruction(opCode, XMM0, source));
+        if (vector->type == ValueType::V4I32) {
+            emit(pshufd(XMM1, XMM0, SWAP_DWORDS));
+            emit(yoctocc::instruction(opCode, XMM0, XMM1));
+        }
+        Register result = target(&instruction, RAX);
+        emit(instruction.type == ValueType::I32 ? movd(sized(result, 4), XMM0) : movq(result, XMM0));
+        define(&instruction, result);
+    }
+
+    void divide(const ir::Instruction& instruction) {
+        const bool isSigned = instruction.opcode == Opcode::SDIV || instruction.opcode == Opcode::SREM;
+        const bool isRemainder = instruction.opcode == Opcode::SREM || instruction.opcode == Opcode::UREM;
+        const auto type = instruction.type;
+        Register divisor = use(instruction.operands[1], R11);
+        materialize(RAX, instruction.operands[0]);
+        if (isSigned) {
+            emit(type == ValueType::I64 ? cqo() : cdq());
+            emit(idiv(named(divisor, type)));
+        } else {
+            emit(xor_(EDX, EDX));
+            emit(yoctocc::div(named(divisor, type)));
+        }
+        define(&instruction, isRemainder ? RDX : RAX);
+    }
+
+    void shift(const ir::Instruction& instruction, OpCode opCode) {
+        const auto* count = instruction.operands[1];
+        Register result = target(&instruction, RAX);
+        const auto reg = named(result, instruction.type);
+        if (count->opcode == Opcode::CONST) {
+            materialize(result, instruction.operands[0]);
+            emit(yoctocc::instruction(opCode, reg, count->immediate & (widthOf(instruction.type) * 8 - 1)));
+        } else if (_target.hasBmi) {
+            // shlx / sarx / shrx はシフト量を cl 以外のレジスタからも読める
+            Register value = use(instruction.operands[0], RAX);
+            Register amount = use(count, R11);
+            const auto bmiForm = opCode == OpCode::SHL   ? OpCode::SHLX
+                                 : opCode == OpCode::SAR ? OpCode::SARX
+                                                         : OpCode::SHRX;
+            emit(yoctocc::instruction(bmiForm, reg, named(value, instruction.type), named(amount, instruction.type)));
+        } else {
+            // シフト量は cl に固定なので先に読む
+            materialize(RCX, count);
+            materialize(result, instruction.operands[0]);
+            emit(yoctocc::instruction(opCode, reg, CL));
+        }
+        define(&instruction, result);
+    }
+
+    void unsignedToFloat(const ir::Instruction& instruction) {
+        Register value = use(instruction.operands[0], RAX);
+        if (value != RAX) {
+            emit(mov(RAX, value));
+        }
+        Register result = target(&instruction, XMM0);
+        const bool isFloat = instruction.type == ValueType::F32;
+        // 最上位ビットが立っていれば半分にして変換し 2 倍する (最下位ビットは丸めのために残す)
+        emit(test(RAX, RAX));
+        emit(js(labels::label("1").ref(Label::Direction::FORWARD)));
+        emit(isFloat ? cvtsi2ss(result, RAX) : cvtsi2sd(result, RAX));
+        emit(jmp(labels::label("2").ref(Label::Direction::FORWARD)));
+        emit(labels::label("1").def());
+        emit(mov(R11, RAX));
+        emit(shr(R11, 1));
+        emit(and_(EAX, 1));
+        emit(or_(R11, RAX));
+        emit(isFloat ? cvtsi2ss(result, R11) : cvtsi2sd(result, R11));
+        emit(isFloat ? addss(result, result) : addsd(result, result));
+        emit(labels::label("2").def());
+        define(&instruction, result);
+    }
+
+    // フラグを設定する。浮動小数点数の LT / LE はオペランドを入れ替えて ja / jae にする
+    void compare(const ir::Instruction& comparison) {
+        const auto* lhs = comparison.operands[0];
+        const auto* rhs = comparison.operands[1];
+        if (comparison.opcode == Opcode::CMP) {
+            Register left = use(lhs, RAX);
+            emit(cmp(named(left, lhs->type), source(rhs, R11)));
+            return;
+        }
+        if (comparison.condition == Condition::LT || comparison.condition == Condition::LE) {
+            std::swap(lhs, rhs);
+        }
+        Register left = use(lhs, XMM0);
+        Register right = use(rhs, XMM1);
+        emit(lhs->type == ValueType::F32 ? ucomiss(left, right) : ucomisd(left, right));
+    }
+
+    void compareToValue(const ir::Instruction& instruction) {
+        compare(instruction);
+        if (instruction.opcode == Opcode::CMP) {
+            emit(yoctocc::instruction(setOpcode(instruction.condition), AL));
+        } else {
+            switch (instruction.condition) {
+                case Condition::EQ:
+                    emit(sete(AL));
+                    emit(setnp(CL));
+                    emit(and_(AL, CL));
+                    break;
+                case Condition::NE:
+                    emit(setne(AL));
+                    emit(setp(CL));
+                    emit(or_(AL, CL));
+                    break;
+                case Condition::LT:
+                case Condition::GT:
+                    emit(seta(AL));
+                    break;
+                default:
+                    emit(setae(AL));
+                    break;
+            }
+        }
+        Register result = target(&instruction, RAX);
+        emit(movzx(sized(result, 4), AL));
+        define(&instruction, result);
+    }
+
+    void load(const ir::Instruction& instruction) {
+        auto source = address(instruction.operands[0], R11);
+        const int size = static_cast<int>(instruction.immediate);
+        if (instruction.isVector()) {
+            Register result = target(&instruction, XMM0);
+            emit(yoctocc::instruction(packedMove(instruction.type), result, memory(16, source)));
+            define(&instruction, result);
+            return;
+        }
+        if (instruction.isFloat()) {
+            Register result = target(&instruction, XMM0);
+            emit(instruction.type == ValueType::F32 ? movss(result, memory(4, source))
+                                                    : movsd(result, memory(8, source)));
+            define(&instruction, result);
+            return;
+        }
+        Register result = target(&instruction, RAX);
+        if (size < 4) {
+            emit(instruction.isSigned ? movsbl(sized(result, 4), memory(size, source))
+                                      : movzbl(sized(result, 4), memory(size, source)));
+        } else if (size == 4 && instruction.type == ValueType::I64) {
+            emit(instruction.isSigned ? movsxd(result, memory(4, source)) : mov(sized(result, 4), memory(4, source)));
+        } else {
+            emit(mov(sized(result, size), memory(size, source)));
+        }
+        define(&instruction, result);
+    }
+
+    void store(const ir::Instruction& instruction) {
+        auto destination = address(instruction.operands[0], R11);
+        const auto* value = instruction.operands[1];
+        const int size = static_cast<int>(instruction.immediate);
+        if (value->isVector()) {
+            emit(yoctocc::instruction(packedMove(value->type), memory(16, destination), use(value, XMM0)));
+            return;
+        }
+        if (value->isFloat()) {
+            Register reg = use(value, XMM0);
+            emit(value->type == ValueType::F32 ? movss(memory(4, destination), reg) : movsd(memory(8, destination), reg));
+            return;
+        }
+        if (value->opcode == Opcode::CONST && fitsInt32(value->immediate)) {
+            emit(mov(memory(size, destination), truncate(value->immediate, size)));
+            return;
+        }
+        emit(mov(memory(size, destination), sized(use(value, RAX), size)));
+    }
+
+    void clear(const ir::Instruction& instruction) {
+        const int size = static_cast<int>(instruction.immediate);
+        if (size > 64) {
+            // rdi は割り当てに使うので退避する。rsp から参照するフレームは push した分ずれる
+            emit(push(RDI));
+            _pushedSize += 8;
+            auto destination = address(instruction.operands[0], R11);
+            emit(lea(RDI, Address{destination}));
+            _pushedSize -= 8;
+            emit(mov(ECX, size));
+            emit(xor_(EAX, EAX));
+            emit(rep_stosb());
+            emit(pop(RDI));
+            return;
+        }
+        auto destination = address(instruction.operands[0], R11);
+        for (int offset = 0; offset < size;) {
+            const int chunk = size - offset >= 8 ? 8 : size - offset >= 4 ? 4 : size - offset >= 2 ? 2 : 1;
+            emit(mov(memory(chunk, destination + offset), 0));
+            offset += chunk;
+        }
+    }
+
+    void copyMemory(const ir::Instruction& instruction) {
+        const int size = static_cast<int>(instruction.immediate);
+        auto destination = address(instruction.operands[0], R11);
+        auto source = address(instruction.operands[1], RCX);
+        for (int offset = 0; offset < size;) {
+            const int chunk = size - offset >= 8 ? 8 : size - offset >= 4 ? 4 : size - offset >= 2 ? 2 : 1;
+            emit(mov(sized(RAX, chunk), memory(chunk, source + offset)));
+            emit(mov(memory(chunk, destination + offset), sized(RAX, chunk)));
+            offset += chunk;
+        }
+    }
+
+    void callFunction(const ir::Instruction& instruction) {
+        std::vector<Move> moves;
+        size_t integers = 0;
+        size_t floats = 0;
+        int stackOffset = 0;
+        for (const auto* argument : instruction.operands) {
+            auto& count = argument->isFloat() ? floats : integers;
+            if (count < argumentRegisterCount(argument)) {
+                Register reg = argument->isFloat() ? ARG_REGISTERS128[count] : ARG_REGISTERS64[count];
+                moves.emplace_back(moveOf(inRegister(reg), argument));
+                count++;
+                continue;
+            }
+            // レジスタに入りきらない引数は、引数レジスタを並べる前に引数領域へ書く
+            storeStackArgument(argument, Address{RSP, stackOffset});
+            stackOffset += 8;
+        }
+        parallelMove(std::move(moves));
+        if (instruction.isVariadic) {
+            emit(mov(EAX, static_cast<int>(floats)));
+        }
+        // 末尾呼び出しはフレームを片付けてから飛ぶ。呼び出し先の ret がこの関数の呼び出し元へ戻る
+        if (instruction.isTail) {
+            leaveFrame();
+            emit(jmp(instruction.symbol));
+            return;
+        }
+        emit(call(instruction.symbol));
+        if (instruction.type != ValueType::VOID) {
+            define(&instruction, instruction.isFloat() ? XMM0 : RAX);
+        }
+    }
+
+    void storeStackArgument(const ir::Instruction* argument, Address<Register> address) {
+        if (argument->opcode == Opcode::CONST && !argument->isFloat() && fitsInt32(argument->immediate)) {
+            emit(mov(memory(8, address), argument->immediate));
+        } else if (argument->isFloat()) {
+            Register reg = use(argument, XMM0);
+            emit(argument->type == ValueType::F32 ? movss(memory(4, address), reg) : movsd(memory(8, address), reg));
+        } else {
+            emit(mov(memory(8, address), use(argument, R11)));
+        }
+    }
+
+    void jumpTo(const ir::Instruction& instruction) {
+        jumpFrom(instruction.parent, instruction.blocks[0]);
+    }
+
+    void jumpFrom(const BasicBlock* block, const BasicBlock* successor) {
+        std::vector<Move> moves;
+        for (const auto& phi : successor->instructions) {
+            if (phi->opcode != Opcode::PHI) {
+                break;
+            }
+            if (locationOf(phi.get()).kind == Location::Kind::NONE) {
+                continue;
+            }
+            auto it = std::ranges::find(phi->blocks, block);
+            const auto* incoming = phi->operands[static_cast<size_t>(it - phi->blocks.begin())];
+            moves.emplace_back(moveOf(locationOf(phi.get()), incoming));
+        }
+        parallelMove(std::move(moves));
+        if (successor != _next) {
+            emit(jmp(blockLabel(successor).ref()));
+        }
+    }
+
+    void branch(OpCode jump, OpCode inverse, const BasicBlock* ifTrue, const BasicBlock* ifFalse) {
+        if (ifTrue == _next) {
+            emit(yoctocc::instruction(inverse, blockLabel(ifFalse).ref()));
+            return;
+        }
+        emit(yoctocc::instruction(jump, blockLabel(ifTrue).ref()));
+        if (ifFalse != _next) {
+            emit(jmp(blockLabel(ifFalse).ref()));
+        }
+    }
+
+    void conditionalBranch(const ir::Instruction& instruction) {
+        const auto* condition = instruction.operands[0];
+        const auto* ifTrue = instruction.blocks[0];
+        const auto* ifFalse = instruction.blocks[1];
+        if (!_allocation.inlined[condition->id] || ir::isRematerializable(condition)) {
+            Register reg = named(use(condition, RAX), condition->type);
+            emit(test(reg, reg));
+            branch(OpCode::JNE, OpCode::JE, ifTrue, ifFalse);
+            return;
+        }
+
+        compare(*condition);
+        if (condition->opcode == Opcode::CMP) {
+            branch(jumpOpcode(condition->condition), jumpOpcode(ir::invertCondition(condition->condition)), ifTrue,
+                   ifFalse);
+            return;
+        }
+        // 順序なし (NaN) は PF が立つ
+        const auto trueLabel = blockLabel(ifTrue).ref();
+        const auto falseLabel = blockLabel(ifFalse).ref();
+        switch (condition->condition) {
+            case Condition::EQ:
+                emit(jp(falseLabel));
+                if (ifTrue == _next) {
+                    emit(jne(falseLabel));
+                    return;
+                }
+                emit(je(trueLabel));
+                break;
+            case Condition::NE:
+                emit(jp(trueLabel));
+                if (ifTrue == _next) {
+                    emit(je(falseLabel));
+                    return;
+                }
+                emit(jne(trueLabel));
+                break;
+            case Condition::LT:
+            case Condition::GT:
+                branch(OpCode::JA, OpCode::JBE, ifTrue, ifFalse);
+                return;
+            default:
+                branch(OpCode::JAE, OpCode::JB, ifTrue, ifFalse);
+                return;
+        }
+        if (ifFalse != _next) {
+            emit(jmp(falseLabel));
+        }
+    }
+
+    void returnFrom(const ir::Instruction& instruction) {
+        // 直前の末尾呼び出しで関数を抜けている
+        const auto& instructions = instruction.parent->instructions;
+        if (instructions.size() >= 2 && instructions[instructions.size() - 2]->isTail) {
+            return;
+        }
+        if (!instruction.operands.empty()) {
+            const auto* value = instruction.operands[0];
+            materialize(value->isFloat() ? XMM0 : RAX, value);
+        }
+        leaveFrame();
+        emit(ret());
+    }
+
+    void leaveFrame() {
+        const auto& saved = _allocation.calleeSaved;
+        if (_target.omitsFramePointer) {
+            if (_stackAdjustment > 0) {
+                emit(add(RSP, _stackAdjustment));
+            }
+            for (auto it = saved.rbegin(); it != saved.rend(); ++it) {
+                emit(pop(*it));
+            }
+            return;
+        }
+        if (!saved.empty()) {
+            emit(lea(RSP, Address{RBP, -(_frameSize + static_cast<int>(saved.size()) * 8)}));
+            for (auto it = saved.rbegin(); it != saved.rend(); ++it) {
+                emit(pop(*it));
+            }
+        }
+        if (saved.empty() || _frameSize > 0) {
+            emit(mov(RSP, RBP));
+        }
+        emit(pop(RBP));
+    }
+
+    ir::Function& _function;
+    const ir::Target& _target;
+    ConstantPool& _constantPool;
+    Allocation _allocation;
+    std::vector<std::string> _lines;
+    std::vector<int> _slotOffsets;
+    int _spillBase = 0;
+    int _frameSize = 0;
+    int _outgoingSize = 0;
+    // -fomit-frame-pointer: callee-saved レジスタを積んだ後に rsp から引く大きさ (レッドゾーンに収まれば 0)
+    int _stackAdjustment = 0;
+    int _framePadding = 0;
+    // 命令の途中で一時的に push している大きさ
+    int _pushedSize = 0;
+    const BasicBlock* _next = nullptr;
+    size_t _line = 0;
+};
+} // namespace
+
+namespace yoctocc::ir {
+
+std::vector<std::string> selectInstructions(Function& function, const Target& target, ConstantPool& constantPool) {
+    return InstructionSelector{function, target, constantPool}.run();
+}
+
+} // namespace yoctocc::ir
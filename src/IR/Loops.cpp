@@ -0,0 +1,242 @@
+#include "IR/Loops.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+using namespace yoctocc::ir;
+
+bool isSignedCondition(Condition condition) {
+    return condition == Condition::LT || condition == Condition::LE || condition == Condition::GT ||
+           condition == Condition::GE;
+}
+
+// 符号なしの比較を、64 ビットに広げた値どうしの符号付きの比較にする
+Condition signedCondition(Condition condition) {
+    switch (condition) {
+        case Condition::ULT:
+            return Condition::LT;
+        case Condition::ULE:
+            return Condition::LE;
+        case Condition::UGT:
+            return Condition::GT;
+        case Condition::UGE:
+            return Condition::GE;
+        default:
+            return condition;
+    }
+}
+
+Instruction* incoming(const Instruction* phi, const BasicBlock* block) {
+    auto it = std::ranges::find(phi->blocks, block);
+    return it == phi->blocks.end() ? nullptr : phi->operands[static_cast<size_t>(it - phi->blocks.begin())];
+}
+} // namespace
+
+namespace yoctocc::ir {
+
+std::vector<Loop> findLoops(const Function& function, const DominatorTree& dominators) {
+    std::vector<Loop> loops;
+    std::vector<int> loopOf(function.nextBlockId, -1);
+    for (auto* block : dominators.reversePostOrder()) {
+        for (auto* successor : block->successors) {
+            if (!dominators.dominates(successor, block)) {
+                continue;
+            }
+            // 戻る辺 block -> successor。同じヘッダのループにまとめる
+            int& index = loopOf[successor->id];
+            if (index < 0) {
+                index = static_cast<int>(loops.size());
+                auto& loop = loops.emplace_back();
+                loop.header = successor;
+                loop.members.assign(function.nextBlockId, false);
+                loop.members[successor->id] = true;
+            }
+            auto& loop = loops[static_cast<size_t>(index)];
+            // 戻る辺の元から先行ブロックを逆にたどり、ヘッダで止める
+            std::vector<BasicBlock*> worklist;
+            if (!loop.members[block->id]) {
+                loop.members[block->id] = true;
+                worklist.emplace_back(block);
+            }
+            while (!worklist.empty()) {
+                auto* current = worklist.back();
+                worklist.pop_back();
+                for (auto* predecessor : current->predecessors) {
+                    if (dominators.isReachable(predecessor) && !loop.members[predecessor->id]) {
+                        loop.members[predecessor->id] = true;
+                        worklist.emplace_back(predecessor);
+                    }
+                }
+            }
+        }
+    }
+
+    for (auto& loop : loops) {
+        for (auto* block : dominators.reversePostOrder()) {
+            if (!loop.contains(block)) {
+                continue;
+            }
+            loop.blocks.emplace_back(block);
+            if (std::ranges::any_of(block->successors, [&](const BasicBlock* s) { return !loop.contains(s); })) {
+                loop.exiting.emplace_back(block);
+            }
+        }
+    }
+    std::ranges::stable_sort(loops, {}, [](const Loop& loop) { return loop.blocks.size(); });
+    return loops;
+}
+
+BasicBlock* preheaderOf(const Loop& loop) {
+    BasicBlock* preheader = nullptr;
+    for (auto* predecessor : loop.header->predecessors) {
+        if (loop.contains(predecessor)) {
+            continue;
+        }
+        if (preheader) {
+            return nullptr;
+        }
+        preheader = predecessor;
+    }
+    return preheader && preheader->successors.size() == 1 ? preheader : nullptr;
+}
+
+BasicBlock* insertPreheader(Function& function, const Loop& loop) {
+    if (auto* preheader = preheaderOf(loop)) {
+        return preheader;
+    }
+
+    auto* header = loop.header;
+    // 入口ブロックがヘッダのループ (Lowering は作らない) には前ヘッダを置けない
+    if (header == function.blocks.front().get()) {
+        return nullptr;
+    }
+    auto* preheader = function.createBlock();
+    const size_t line = header->instructions.front()->line;
+    for (auto* predecessor : header->predecessors) {
+        if (loop.contains(predecessor)) {
+            continue;
+        }
+        for (auto*& target : predecessor->terminator()->blocks) {
+            if (target == header) {
+                target = preheader;
+            }
+        }
+    }
+
+    // ループの外から来る PHI の値は前ヘッダで合流させる
+    for (auto& phi : header->instructions) {
+        if (phi->opcode != Opcode::PHI) {
+            break;
+        }
+        std::vector<Instruction*> values;
+        std::vector<BasicBlock*> sources;
+        for (size_t i = 0; i < phi->blocks.size();) {
+            if (loop.contains(phi->blocks[i])) {
+                i++;
+                continue;
+            }
+            values.emplace_back(phi->operands[i]);
+            sources.emplace_back(phi->blocks[i]);
+            phi->operands.erase(phi->operands.begin() + static_cast<std::ptrdiff_t>(i));
+            phi->blocks.erase(phi->blocks.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+        if (values.empty()) {
+            continue;
+        }
+        Instruction* incoming = values.front();
+        if (values.size() > 1) {
+            auto merged = function.create(Opcode::PHI, phi->type);
+            merged->operands = std::move(values);
+            merged->blocks = std::move(sources);
+            merged->line = line;
+            incoming = preheader->append(std::move(merged));
+        }
+        phi->operands.emplace_back(incoming);
+        phi->blocks.emplace_back(preheader);
+    }
+
+    auto branch = function.create(Opcode::BR, ValueType::VOID);
+    branch->blocks = {header};
+    branch->line = line;
+    preheader->append(std::move(branch));
+
+    function.recomputeControlFlow();
+    return preheader;
+}
+
+std::optional<InductionVariable> findInductionVariable(BasicBlock* body, const BasicBlock* exit) {
+    auto* terminator = body->terminator();
+    auto* compare = terminator->operands[0];
+    if (compare->opcode != Opcode::CMP || compare->parent != body || compare->operands[0]->type != ValueType::I32) {
+        return std::nullopt;
+    }
+    InductionVariable induction{};
+    induction.compare = compare;
+    induction.condition = compare->condition;
+    induction.next = compare->operands[0];
+    induction.bound = compare->operands[1];
+    if (induction.bound->parent == body) {
+        std::swap(induction.next, induction.bound);
+        induction.condition = swapCondition(induction.condition);
+    }
+    if (induction.bound->parent == body || induction.next->parent != body) {
+        return std::nullopt;
+    }
+    if (terminator->blocks[0] == exit) {
+        induction.condition = invertCondition(induction.condition);
+    }
+
+    auto* next = induction.next;
+    if ((next->opcode != Opcode::ADD && next->opcode != Opcode::SUB) || next->operands[1]->opcode != Opcode::CONST) {
+        return std::nullopt;
+    }
+    induction.phi = next->operands[0];
+    induction.step = static_cast<int32_t>(next->operands[1]->immediate);
+    if (next->opcode == Opcode::SUB) {
+        induction.step = -induction.step;
+    }
+    if (induction.phi->opcode != Opcode::PHI || induction.phi->parent != body || incoming(induction.phi, body) != next) {
+        return std::nullopt;
+    }
+
+    // 単調に条件へ近づく組み合わせだけ (!= は飛び越えると止まらない)
+    switch (induction.condition) {
+        case Condition::LT:
+        case Condition::LE:
+        case Condition::ULT:
+        case Condition::ULE:
+            return induction.step > 0 ? std::optional{induction} : std::nullopt;
+        case Condition::GT:
+        case Condition::GE:
+        case Condition::UGT:
+        case Condition::UGE:
+            return induction.step < 0 ? std::optional{induction} : std::nullopt;
+        default:
+            return std::nullopt;
+    }
+}
+
+Instruction* widenBound(Function& function, BasicBlock* block, const InductionVariable& induction) {
+    const Opcode extend = isSignedCondition(induction.condition) ? Opcode::SEXT : Opcode::ZEXT;
+    auto* bound = block->insertBefore(nullptr, function.create(extend, ValueType::I64, {induction.bound}));
+    bound->line = induction.compare->line;
+    return bound;
+}
+
+Instruction* appendTripCheck(Function& function, BasicBlock* block, const InductionVariable& induction,
+                             Instruction* bound, Instruction* value, int64_t count) {
+    const Opcode extend = isSignedCondition(induction.condition) ? Opcode::SEXT : Opcode::ZEXT;
+    auto* widened = block->append(function.create(extend, ValueType::I64, {value}));
+    auto* offset = block->append(function.create(Opcode::CONST, ValueType::I64));
+    offset->immediate = (count - 1) * induction.step;
+    auto* limit = block->append(function.create(Opcode::ADD, ValueType::I64, {widened, offset}));
+    auto* check = block->append(function.create(Opcode::CMP, ValueType::I32, {limit, bound}));
+    check->condition = signedCondition(induction.condition);
+    for (auto* instruction : {widened, offset, limit, check}) {
+        instruction->line = induction.compare->line;
+    }
+    return check;
+}
+
+} // namespace yoctocc::ir
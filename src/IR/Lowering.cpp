@@ -0,0 +1,768 @@
+#include "IR/Lowering.hpp"
+
+#include <bit>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CallingConvention.hpp"
+#include "Logger.hpp"
+#include "Node/Node.hpp"
+#include "Token.hpp"
+#include "Type.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+ValueType valueTypeOf(const Type* type) {
+    if (!type) {
+        return ValueType::VOID;
+    }
+    switch (type->kind) {
+        case TypeKind::VOID:
+            return ValueType::VOID;
+        case TypeKind::FLOAT:
+            return ValueType::F32;
+        case TypeKind::DOUBLE:
+            return ValueType::F64;
+        default:
+            // 配列・構造体・関数はアドレスを値とする
+            return type::isInteger(type) && type->size <= 4 ? ValueType::I32 : ValueType::I64;
+    }
+}
+
+bool isAggregate(const Type* type) {
+    return type::is(type, TypeKind::STRUCT) || type::is(type, TypeKind::UNION);
+}
+
+// 構文木を IR に変換する。
+// 評価順・型変換・比較の意味はスタックマシンの Generator に合わせる
+class Lowering final {
+public:
+    explicit Lowering(const Object* object) : _object(object) {
+    }
+
+    std::unique_ptr<Function> run() {
+        if (isAggregate(_object->type->returnType.get())) {
+            return nullptr;
+        }
+
+        _function = std::make_unique<Function>();
+        _function->object = _object;
+        _function->name = _object->name;
+        _function->returnType = valueTypeOf(_object->type->returnType.get());
+
+        for (const Object* local = _object->locals.get(); local; local = local->next.get()) {
+            _slots.emplace(local, static_cast<int64_t>(_function->slots.size()));
+            _function->slots.emplace_back(FrameSlot{
+                .name = local->name,
+                .size = local->type->size,
+                .alignment = std::max(local->alignment, 1),
+                .variable = local,
+            });
+        }
+
+        _block = _function->createBlock();
+        _line = _object->token ? _object->token->line : 0;
+        std::vector<const Type*> types;
+        for (const Object* param = _object->parameters; param; param = param->next.get()) {
+            types.emplace_back(param->type.get());
+        }
+        const auto layout = abi::layoutArguments(types);
+        size_t index = 0;
+        for (const Object* param = _object->parameters; param; param = param->next.get(), index++) {
+            const Type* type = param->type.get();
+            const auto& location = layout.arguments[index];
+            if (!isAggregate(type)) {
+                auto* value = emit(Opcode::PARAM, valueTypeOf(type));
+                value->immediate = location.onStack ? stackParameter(type, location) : location.registers[0];
+                store(type, frameAddress(param), value);
+                continue;
+            }
+            // レジスタで受け取った構造体は 8 バイトずつフレームに書く
+            if (location.onStack || !hasLoadableEightbytes(type, location)) {
+                return nullptr;
+            }
+            auto* base = frameAddress(param);
+            for (int i = 0; i < location.eightbytes; i++) {
+                auto* value = emit(Opcode::PARAM, eightbyteType(type, location, i));
+                value->immediate = location.registers[i];
+                auto* address = i == 0 ? base : emit(Opcode::ADD, ValueType::I64, {base, constant(ValueType::I64, 8)});
+                emit(Opcode::STORE, ValueType::VOID, {address, value})->immediate = abi::eightbyteSize(type, i);
+            }
+        }
+
+        statement(_object->body.get());
+        if (_block) {
+            // 末尾まで到達したら 0 (void なら値なし) を返す
+            ret(nullptr);
+        }
+        if (_unsupported) {
+            return nullptr;
+        }
+        _function->removeUnreachableBlocks();
+        return std::move(_function);
+    }
+
+private:
+    Instruction* emit(Opcode opcode, ValueType type, std::initializer_list<Instruction*> operands = {}) {
+        // return や goto の後ろの到達しないコードは新しいブロックに置き、後で削除する
+        if (!_block) {
+            _block = _function->createBlock();
+        }
+        auto instruction = _function->create(opcode, type, operands);
+        instruction->line = _line;
+        return _block->append(std::move(instruction));
+    }
+
+    Instruction* constant(ValueType type, int64_t value) {
+        auto* instruction = emit(Opcode::CONST, type);
+        instruction->immediate = type == ValueType::I32 ? static_cast<int32_t>(value) : value;
+        return instruction;
+    }
+
+    Instruction* floatConstant(ValueType type, double value) {
+        auto* instruction = emit(Opcode::CONST, type);
+        instruction->immediate = type == ValueType::F32 ? std::bit_cast<uint32_t>(static_cast<float>(value))
+                                                        : std::bit_cast<int64_t>(value);
+        return instruction;
+    }
+
+    BasicBlock* labelBlock(const std::string& label) {
+        auto [it, inserted] = _labels.try_emplace(label, nullptr);
+        if (inserted) {
+            it->second = _function->createBlock();
+        }
+        return it->second;
+    }
+
+    void jump(BasicBlock* target) {
+        if (!_block) {
+            return;
+        }
+        emit(Opcode::BR, ValueType::VOID)->blocks = {target};
+        _block = nullptr;
+    }
+
+    void branch(Instruction* condition, BasicBlock* ifTrue, BasicBlock* ifFalse) {
+        emit(Opcode::CONDBR, ValueType::VOID, {condition})->blocks = {ifTrue, ifFalse};
+        _block = nullptr;
+    }
+
+    // 現在のブロックから block へ fallthrough して、以降の命令を block に置く
+    void enter(BasicBlock* block) {
+        jump(block);
+        _block = block;
+    }
+
+    void ret(Instruction* value) {
+        if (_function->returnType == ValueType::VOID) {
+            emit(Opcode::RET, ValueType::VOID);
+        } else {
+            emit(Opcode::RET, ValueType::VOID, {value ? value : constant(_function->returnType, 0)});
+        }
+        _block = nullptr;
+    }
+
+    // スタックで受け取る引数の PARAM の番号 (引数レジスタの数 + 8 バイト単位の位置)
+    static int64_t stackParameter(const Type* type, const abi::ArgumentLocation& location) {
+        const int registers = type::isFloat(type) ? abi::FLOAT_ARGUMENT_REGISTERS : abi::INTEGER_ARGUMENT_REGISTERS;
+        return registers + location.stackOffset / 8;
+    }
+
+    // 構造体の 8 バイトをそれぞれ 1 回の読み書きで扱えるか (3, 5, 6, 7 バイトの端数がないか)
+    static bool hasLoadableEightbytes(const Type* type, const abi::ArgumentLocation& location) {
+        for (int i = 0; i < location.eightbytes; i++) {
+            const int size = abi::eightbyteSize(type, i);
+            if (size != 1 && size != 2 && size != 4 && size != 8) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static ValueType eightbyteType(const Type* type, const abi::ArgumentLocation& location, int index) {
+        const bool isWide = abi::eightbyteSize(type, index) == 8;
+        if (location.classes[index] == abi::ArgumentClass::SSE) {
+            return isWide ? ValueType::F64 : ValueType::F32;
+        }
+        return isWide ? ValueType::I64 : ValueType::I32;
+    }
+
+    Instruction* frameAddress(const Object* variable) {
+        auto it = _slots.find(variable);
+        if (it == _slots.end()) {
+            _unsupported = true;
+            return constant(ValueType::I64, 0);
+        }
+        auto* address = emit(Opcode::FRAME_ADDRESS, ValueType::I64);
+        address->immediate = it->second;
+        return address;
+    }
+
+    // 型の幅が違う整数を揃える
+    Instruction* coerce(Instruction* value, ValueType type, bool isUnsigned) {
+        if (value->type == type) {
+            return value;
+        }
+        if (value->type == ValueType::I64 && type == ValueType::I32) {
+            return emit(Opcode::TRUNC, type, {value});
+        }
+        if (value->type == ValueType::I32 && type == ValueType::I64) {
+            return emit(isUnsigned ? Opcode::ZEXT : Opcode::SEXT, type, {value});
+        }
+        Log::unreachable();
+        return value;
+    }
+
+    // 0 と比較した真偽値 (I32 の 0 / 1)。NaN は真
+    Instruction* truth(Instruction* value, const Type* type) {
+        if (value->opcode == Opcode::CMP || value->opcode == Opcode::FCMP) {
+            return value;
+        }
+        Instruction* result = nullptr;
+        if (type::isFloat(type)) {
+            result = emit(Opcode::FCMP, ValueType::I32, {value, floatConstant(value->type, 0.0)});
+        } else {
+            result = emit(Opcode::CMP, ValueType::I32, {value, constant(value->type, 0)});
+        }
+        result->condition = Condition::NE;
+        return result;
+    }
+
+    Instruction* condition(const Node* node) {
+        return truth(expression(node), node->type.get());
+    }
+
+    Instruction* load(const Type* type, Instruction* address) {
+        using enum TypeKind;
+        switch (type->kind) {
+            case ARRAY:
+            case STRUCT:
+            case UNION:
+            case FUNCTION:
+                return address;
+            default:
+                break;
+        }
+        auto* value = emit(Opcode::LOAD, valueTypeOf(type), {address});
+        value->immediate = type->size;
+        value->isSigned = type::isInteger(type) && !type->isUnsigned;
+        return value;
+    }
+
+    void store(const Type* type, Instruction* address, Instruction* value) {
+        if (isAggregate(type)) {
+            emit(Opcode::COPY_MEMORY, ValueType::VOID, {address, value})->immediate = type->size;
+            return;
+        }
+        emit(Opcode::STORE, ValueType::VOID, {address, value})->immediate = type->size;
+    }
+
+    Instruction* address(const Node* node) {
+        switch (node->nodeType) {
+            case NodeType::VARIABLE:
+                if (node->variable == _object->vaArea) {
+                    // 可変長引数のレジスタ退避領域はスタックマシンだけが作る
+                    _unsupported = true;
+                }
+                if (node->variable->isLocal) {
+                    return frameAddress(node->variable);
+                } else {
+                    auto* address = emit(Opcode::GLOBAL_ADDRESS, ValueType::I64);
+                    address->symbol = node->variable->name;
+                    return address;
+                }
+            case NodeType::DEREFERENCE:
+                return expression(node->left.get());
+            case NodeType::MEMBER: {
+                auto* base = address(node->left.get());
+                if (node->member->offset == 0) {
+                    return base;
+                }
+                return emit(Opcode::ADD, ValueType::I64, {base, constant(ValueType::I64, node->member->offset)});
+            }
+            case NodeType::COMMA:
+                expression(node->left.get());
+                return address(node->right.get());
+            default:
+                break;
+        }
+        Log::error("Not an lvalue"sv, node->token);
+        return nullptr;
+    }
+
+    // Generator::cast と同じ変換を行う
+    Instruction* cast(Instruction* value, const Type* from, const Type* to) {
+        if (type::is(to, TypeKind::VOID) || !value) {
+            return nullptr;
+        }
+        if (type::is(to, TypeKind::BOOL)) {
+            return truth(value, from);
+        }
+
+        const auto toType = valueTypeOf(to);
+        const bool fromFloat = type::isFloat(from);
+        const bool toFloat = type::isFloat(to);
+        if (fromFloat && toFloat) {
+            if (value->type == toType) {
+                return value;
+            }
+            return emit(toType == ValueType::F64 ? Opcode::FPEXT : Opcode::FPTRUNC, toType, {value});
+        }
+        if (fromFloat) {
+            // unsigned int は 64 ビットで変換して下位 32 ビットを使う
+            Instruction* result = nullptr;
+            if (to->size == 8 || (to->size == 4 && to->isUnsigned)) {
+                result = coerce(emit(Opcode::FPTOSI, ValueType::I64, {value}), toType, false);
+            } else {
+                result = emit(Opcode::FPTOSI, ValueType::I32, {value});
+            }
+            return narrow(result, from, to);
+        }
+        if (toFloat) {
+            if (value->type == ValueType::I64) {
+                return emit(from->isUnsigned ? Opcode::UITOFP : Opcode::SITOFP, toType, {value});
+            }
+            if (from->isUnsigned && from->size == 4) {
+                value = emit(Opcode::ZEXT, ValueType::I64, {value});
+            }
+            return emit(Opcode::SITOFP, toType, {value});
+        }
+
+        if (toType == ValueType::I32) {
+            return narrow(coerce(value, ValueType::I32, false), from, to);
+        }
+        if (value->type == ValueType::I64) {
+            return value;
+        }
+        return emit(from->isUnsigned && from->size == 4 ? Opcode::ZEXT : Opcode::SEXT, ValueType::I64, {value});
+    }
+
+    // char / short への変換。変換元の値がすでに変換先の範囲に収まっていれば何もしない
+    Instruction* narrow(Instruction* value, const Type* from, const Type* to) {
+        if (!type::isInteger(to) || to->size >= 4) {
+            return value;
+        }
+        if (type::isInteger(from) &&
+            (from->kind == TypeKind::BOOL ||
+             (from->size < to->size && (from->isUnsigned || !to->isUnsigned)) ||
+             (from->size == to->size && from->isUnsigned == to->isUnsigned))) {
+            return value;
+        }
+        auto* extended = emit(Opcode::EXTEND, ValueType::I32, {value});
+        extended->immediate = to->size * 8;
+        extended->isSigned = !to->isUnsigned;
+        return extended;
+    }
+
+    Instruction* call(const Node* node) {
+        if (isAggregate(node->type.get())) {
+            _unsupported = true;
+        }
+        std::vector<const Node*> arguments;
+        for (const Node* argument = node->arguments.get(); argument; argument = argument->next.get()) {
+            arguments.emplace_back(argument);
+        }
+
+        std::vector<const Type*> types;
+        for (const auto* argument : arguments) {
+            types.emplace_back(argument->type.get());
+        }
+        const auto layout = abi::layoutArguments(types);
+
+        // Generator と同じく後ろの引数から評価する。
+        // レジスタで渡す構造体は 8 バイトずつ読み出し、それぞれを 1 つの引数にする
+        std::vector<std::vector<Instruction*>> values(arguments.size());
+        for (size_t i = arguments.size(); i-- > 0;) {
+            const Type* type = arguments[i]->type.get();
+            const auto& location = layout.arguments[i];
+            auto* value = expression(arguments[i]);
+            if (!isAggregate(type)) {
+                values[i] = {value};
+                continue;
+            }
+            // メモリで渡す構造体はスタックマシンに任せる
+            if (location.onStack || !hasLoadableEightbytes(type, location)) {
+                _unsupported = true;
+                continue;
+            }
+            for (int k = 0; k < location.eightbytes; k++) {
+                auto* address = k == 0 ? value : emit(Opcode::ADD, ValueType::I64, {value, constant(ValueType::I64, 8)});
+                auto* eightbyte = emit(Opcode::LOAD, eightbyteType(type, location, k), {address});
+                eightbyte->immediate = abi::eightbyteSize(type, k);
+                values[i].emplace_back(eightbyte);
+            }
+        }
+
+        auto* result = emit(Opcode::CALL, valueTypeOf(node->type.get()));
+        for (const auto& value : values) {
+            result->operands.insert(result->operands.end(), value.begin(), value.end());
+        }
+        result->symbol = node->functionName;
+        result->isVariadic = node->functionType && node->functionType->isVariadic;
+
+        // bool / char / short の戻り値は al / ax にしか入っていないので拡張する
+        const Type* type = node->type.get();
+        if (type::isInteger(type) && type->size < 4) {
+            auto* extended = emit(Opcode::EXTEND, ValueType::I32, {result});
+            extended->immediate = type->size * 8;
+            extended->isSigned = type->kind != TypeKind::BOOL && !type->isUnsigned;
+            return extended;
+        }
+        return result;
+    }
+
+    Instruction* floatBinary(const Node* node) {
+        auto* rhs = expression(node->right.get());
+        auto* lhs = expression(node->left.get());
+        const auto type = lhs->type;
+        switch (node->nodeType) {
+            case NodeType::ADD:
+                return emit(Opcode::FADD, type, {lhs, rhs});
+            case NodeType::SUB:
+                return emit(Opcode::FSUB, type, {lhs, rhs});
+            case NodeType::MUL:
+                return emit(Opcode::FMUL, type, {lhs, rhs});
+            case NodeType::DIV:
+                return emit(Opcode::FDIV, type, {lhs, rhs});
+            case NodeType::EQUAL:
+            case NodeType::NOT_EQUAL:
+            case NodeType::LESS:
+            case NodeType::LESS_EQUAL: {
+                auto* result = emit(Opcode::FCMP, ValueType::I32, {lhs, rhs});
+                result->condition = node->nodeType == NodeType::EQUAL       ? Condition::EQ
+                                    : node->nodeType == NodeType::NOT_EQUAL ? Condition::NE
+                                    : node->nodeType == NodeType::LESS      ? Condition::LT
+                                                                            : Condition::LE;
+                return result;
+            }
+            default:
+                break;
+        }
+        Log::error("invalid expression"sv, node->token);
+        return nullptr;
+    }
+
+    Instruction* integerBinary(const Node* node) {
+        const Type* leftType = node->left->type.get();
+        auto* rhs = expression(node->right.get());
+        auto* lhs = expression(node->left.get());
+
+        Opcode opcode{};
+        switch (node->nodeType) {
+            case NodeType::ADD:
+                opcode = Opcode::ADD;
+                break;
+            case NodeType::SUB:
+                opcode = Opcode::SUB;
+                break;
+            case NodeType::MUL:
+                opcode = Opcode::MUL;
+                break;
+            case NodeType::DIV:
+                opcode = node->type->isUnsigned ? Opcode::UDIV : Opcode::SDIV;
+                break;
+            case NodeType::MOD:
+                opcode = node->type->isUnsigned ? Opcode::UREM : Opcode::SREM;
+                break;
+            case NodeType::BIT_AND:
+                opcode = Opcode::AND;
+                break;
+            case NodeType::BIT_OR:
+                opcode = Opcode::OR;
+                break;
+            case NodeType::BIT_XOR:
+                opcode = Opcode::XOR;
+                break;
+            case NodeType::SHL:
+                opcode = Opcode::SHL;
+                break;
+            case NodeType::SHR:
+                opcode = leftType->isUnsigned ? Opcode::SHR : Opcode::SAR;
+                break;
+            case NodeType::EQUAL:
+            case NodeType::NOT_EQUAL:
+            case NodeType::LESS:
+            case NodeType::LESS_EQUAL: {
+                const bool isUnsigned = leftType->isUnsigned;
+                auto* result = emit(Opcode::CMP, ValueType::I32,
+                                    {lhs, coerce(rhs, lhs->type, node->right->type->isUnsigned)});
+                result->condition = node->nodeType == NodeType::EQUAL       ? Condition::EQ
+                                    : node->nodeType == NodeType::NOT_EQUAL ? Condition::NE
+                                    : node->nodeType == NodeType::LESS
+                                        ? (isUnsigned ? Condition::ULT : Condition::LT)
+                                        : (isUnsigned ? Condition::ULE : Condition::LE);
+                return result;
+            }
+            default:
+                Log::error("Invalid expression"sv, node->token);
+                return nullptr;
+        }
+
+        // シフトは左辺の型で計算する (右辺はシフト量なので幅を合わせるだけ)
+        const auto type = opcode == Opcode::SHL || opcode == Opcode::SHR || opcode == Opcode::SAR
+                              ? valueTypeOf(leftType)
+                              : valueTypeOf(node->type.get());
+        lhs = coerce(lhs, type, leftType->isUnsigned);
+        rhs = coerce(rhs, type, node->right->type->isUnsigned);
+        return emit(opcode, type, {lhs, rhs});
+    }
+
+    // && と || は右辺を評価するブロックと合流点の PHI にする
+    Instruction* logical(const Node* node) {
+        const bool isAnd = node->nodeType == NodeType::LOGICAL_AND;
+        auto* right = _function->createBlock();
+        auto* join = _function->createBlock();
+
+        auto* left = condition(node->left.get());
+        auto* leftEnd = _block;
+        if (isAnd) {
+            branch(left, right, join);
+        } else {
+            branch(left, join, right);
+        }
+        // 左辺だけで決まったときの値は分岐元のブロックで作っておく
+        auto shortCircuit = _function->create(Opcode::CONST, ValueType::I32);
+        shortCircuit->immediate = isAnd ? 0 : 1;
+        shortCircuit->line = _line;
+        auto* shortValue = leftEnd->insertBefore(nullptr, std::move(shortCircuit));
+
+        _block = right;
+        auto* rightValue = condition(node->right.get());
+        auto* rightEnd = _block;
+        jump(join);
+
+        _block = join;
+        auto* phi = emit(Opcode::PHI, ValueType::I32);
+        phi->operands = {shortValue, rightValue};
+        phi->blocks = {leftEnd, rightEnd};
+        return phi;
+    }
+
+    Instruction* conditional(const Node* node) {
+        auto* thenBlock = _function->createBlock();
+        auto* elseBlock = _function->createBlock();
+        auto* join = _function->createBlock();
+        branch(condition(node->condition.get()), thenBlock, elseBlock);
+
+        std::vector<Instruction*> values;
+        std::vector<BasicBlock*> ends;
+        for (auto [block, arm] : {std::pair{thenBlock, node->then.get()}, std::pair{elseBlock, node->els.get()}}) {
+            _block = block;
+            auto* value = expression(arm);
+            if (_block) {
+                values.emplace_back(value);
+                ends.emplace_back(_block);
+                jump(join);
+            }
+        }
+
+        _block = join;
+        const auto type = valueTypeOf(node->type.get());
+        if (type == ValueType::VOID) {
+            return nullptr;
+        }
+        auto* phi = emit(Opcode::PHI, type);
+        phi->operands = std::move(values);
+        phi->blocks = std::move(ends);
+        return phi;
+    }
+
+    Instruction* expression(const Node* node) {
+        _line = node->token->line;
+
+        switch (node->nodeType) {
+            case NodeType::NULL_EXPRESSION:
+                return nullptr;
+            case NodeType::NUMBER: {
+                const auto type = valueTypeOf(node->type.get());
+                if (type == ValueType::F32 || type == ValueType::F64) {
+                    return floatConstant(type, node->floatValue);
+                }
+                return constant(type, node->integerValue);
+            }
+            case NodeType::NEGATE: {
+                auto* operand = expression(node->left.get());
+                return emit(operand->isFloat() ? Opcode::FNEG : Opcode::NEG, operand->type, {operand});
+            }
+            case NodeType::VARIABLE:
+            case NodeType::MEMBER:
+                return load(node->type.get(), address(node));
+            case NodeType::ADDRESS:
+                return address(node->left.get());
+            case NodeType::DEREFERENCE:
+                return load(node->type.get(), expression(node->left.get()));
+            case NodeType::ASSIGN: {
+                auto* destination = address(node->left.get());
+                auto* value = expression(node->right.get());
+                store(node->type.get(), destination, value);
+                return value;
+            }
+            case NodeType::STATEMENT_EXPRESSION:
+                for (const Node* stmt = node->body.get(); stmt; stmt = stmt->next.get()) {
+                    if (!stmt->next && stmt->nodeType == NodeType::EXPRESSION_STATEMENT) {
+                        return expression(stmt->left.get());
+                    }
+                    statement(stmt);
+                }
+                return nullptr;
+            case NodeType::COMMA:
+                expression(node->left.get());
+                return expression(node->right.get());
+            case NodeType::CAST:
+                return cast(expression(node->left.get()), node->left->type.get(), node->type.get());
+            case NodeType::MEMORY_CLEAR:
+                emit(Opcode::CLEAR, ValueType::VOID, {frameAddress(node->variable)})->immediate =
+                    node->variable->type->size;
+                return nullptr;
+            case NodeType::FUNCTION_CALL:
+                return call(node);
+            case NodeType::CONDITIONAL:
+                return conditional(node);
+            case NodeType::NOT: {
+                auto* operand = expression(node->left.get());
+                Instruction* result = nullptr;
+                if (operand->isFloat()) {
+                    result = emit(Opcode::FCMP, ValueType::I32, {operand, floatConstant(operand->type, 0.0)});
+                } else {
+                    result = emit(Opcode::CMP, ValueType::I32, {operand, constant(operand->type, 0)});
+                }
+                result->condition = Condition::EQ;
+                return result;
+            }
+            case NodeType::BIT_NOT: {
+                auto* operand = expression(node->left.get());
+                return emit(Opcode::NOT, operand->type, {operand});
+            }
+            case NodeType::LOGICAL_AND:
+            case NodeType::LOGICAL_OR:
+                return logical(node);
+            default:
+                break;
+        }
+
+        if (type::isFloat(node->left->type.get())) {
+            return floatBinary(node);
+        }
+        return integerBinary(node);
+    }
+
+    void statement(const Node* node) {
+        _line = node->token->line;
+
+        switch (node->nodeType) {
+            case NodeType::IF: {
+                auto* thenBlock = _function->createBlock();
+                auto* end = _function->createBlock();
+                auto* elseBlock = node->els ? _function->createBlock() : end;
+                branch(condition(node->condition.get()), thenBlock, elseBlock);
+                _block = thenBlock;
+                statement(node->then.get());
+                jump(end);
+                if (node->els) {
+                    _block = elseBlock;
+                    statement(node->els.get());
+                    jump(end);
+                }
+                _block = end;
+                return;
+            }
+            case NodeType::FOR: {
+                auto* breakBlock = labelBlock(node->breakLabel);
+                auto* continueBlock = labelBlock(node->continueLabel);
+                if (node->init) {
+                    statement(node->init.get());
+                }
+                auto* begin = _function->createBlock();
+                enter(begin);
+                if (node->condition) {
+                    auto* body = _function->createBlock();
+                    branch(condition(node->condition.get()), body, breakBlock);
+                    _block = body;
+                }
+                statement(node->then.get());
+                enter(continueBlock);
+                if (node->inc) {
+                    expression(node->inc.get());
+                }
+                jump(begin);
+                _block = breakBlock;
+                return;
+            }
+            case NodeType::DO: {
+                auto* breakBlock = labelBlock(node->breakLabel);
+                auto* continueBlock = labelBlock(node->continueLabel);
+                auto* begin = _function->createBlock();
+                enter(begin);
+                if (node->then) {
+                    statement(node->then.get());
+                }
+                enter(continueBlock);
+                branch(condition(node->condition.get()), begin, breakBlock);
+                _block = breakBlock;
+                return;
+            }
+            case NodeType::SWITCH: {
+                auto* value = expression(node->condition.get());
+                for (const Node* caseNode = node->cases; caseNode; caseNode = caseNode->cases) {
+                    auto* next = _function->createBlock();
+                    auto* compare = emit(Opcode::CMP, ValueType::I32, {value, constant(value->type, caseNode->integerValue)});
+                    compare->condition = Condition::EQ;
+                    branch(compare, labelBlock(caseNode->label), next);
+                    _block = next;
+                }
+                auto* breakBlock = labelBlock(node->breakLabel);
+                jump(node->defaultCase ? labelBlock(node->defaultCase->label) : breakBlock);
+                statement(node->then.get());
+                enter(breakBlock);
+                return;
+            }
+            case NodeType::CASE:
+                enter(labelBlock(node->label));
+                statement(node->left.get());
+                return;
+            case NodeType::BLOCK:
+                for (const Node* stmt = node->body.get(); stmt; stmt = stmt->next.get()) {
+                    statement(stmt);
+                }
+                return;
+            case NodeType::GOTO:
+                jump(labelBlock(node->uniqueLabel));
+                return;
+            case NodeType::LABEL:
+                enter(labelBlock(node->uniqueLabel));
+                statement(node->left.get());
+                return;
+            case NodeType::RETURN:
+                ret(node->left ? expression(node->left.get()) : nullptr);
+                return;
+            case NodeType::EXPRESSION_STATEMENT:
+                expression(node->left.get());
+                return;
+            default:
+                break;
+        }
+        Log::error("Invalid statement"sv, node->token);
+    }
+
+    const Object* _object;
+    std::unique_ptr<Function> _function;
+    // 命令を追加するブロック (終端命令の直後は nullptr)
+    BasicBlock* _block = nullptr;
+    std::unordered_map<const Object*, int64_t> _slots;
+    std::unordered_map<std::string, BasicBlock*> _labels;
+    size_t _line = 0;
+    bool _unsupported = false;
+};
+} // namespace
+
+namespace yoctocc::ir {
+
+std::unique_ptr<Function> lower(const Object* function) {
+    return Lowering{function}.run();
+}
+
+} // namespace yoctocc::ir
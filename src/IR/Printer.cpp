@@ -0,0 +1,140 @@
+#include "IR/Printer.hpp"
+
+#include <bit>
+#include <format>
+#include <print>
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+std::string valueName(const Instruction* value) {
+    return value ? std::format("%{}", value->id) : std::string{"<null>"};
+}
+
+std::string blockName(const BasicBlock* block) {
+    return std::format("bb{}", block->id);
+}
+
+std::string constantText(const Instruction& instruction) {
+    switch (instruction.type) {
+        case ValueType::F32:
+            return std::format("{}", std::bit_cast<float>(static_cast<uint32_t>(instruction.immediate)));
+        case ValueType::F64:
+            return std::format("{}", std::bit_cast<double>(instruction.immediate));
+        default:
+            return std::format("{}", instruction.immediate);
+    }
+}
+
+std::string operandList(const Instruction& instruction) {
+    std::string text;
+    for (const auto* operand : instruction.operands) {
+        if (!text.empty()) {
+            text += ", ";
+        }
+        text += valueName(operand);
+    }
+    return text;
+}
+} // namespace
+
+namespace yoctocc::ir {
+
+std::string to_string(const Instruction& instruction) {
+    std::string text;
+    if (instruction.type != ValueType::VOID) {
+        text = std::format("{} = ", valueName(&instruction));
+    }
+    text += ir::to_string(instruction.opcode);
+
+    switch (instruction.opcode) {
+        case Opcode::CONST:
+            text += std::format(" {} {}", ir::to_string(instruction.type), constantText(instruction));
+            break;
+        case Opcode::PARAM:
+            text += std::format(" {} {}", ir::to_string(instruction.type), instruction.immediate);
+            break;
+        case Opcode::FRAME_ADDRESS:
+            text += std::format(" slot{}", instruction.immediate);
+            break;
+        case Opcode::GLOBAL_ADDRESS:
+            text += std::format(" @{}", instruction.symbol);
+            break;
+        case Opcode::CMP:
+        case Opcode::FCMP:
+            text += std::format(" {} {} {}", ir::to_string(instruction.condition),
+                                ir::to_string(instruction.operands[0]->type), operandList(instruction));
+            break;
+        case Opcode::EXTEND:
+            text += std::format(" {} {}, {} {}", ir::to_string(instruction.type), operandList(instruction),
+                                instruction.immediate, instruction.isSigned ? "signed" : "unsigned");
+            break;
+        case Opcode::REDUCE:
+            text += std::format(" {} {} {}", ir::to_string(instruction.type),
+                                ir::to_string(static_cast<Opcode>(instruction.immediate)), operandList(instruction));
+            break;
+        case Opcode::LOAD:
+            text += std::format(" {} {}, {}{}", ir::to_string(instruction.type), operandList(instruction),
+                                instruction.immediate, instruction.isSigned ? " signed" : "");
+            break;
+        case Opcode::STORE:
+        case Opcode::CLEAR:
+        case Opcode::COPY_MEMORY:
+            text += std::format(" {}, {}", operandList(instruction), instruction.immediate);
+            break;
+        case Opcode::CALL:
+            text += std::format(" {} @{}({}){}{}", ir::to_string(instruction.type), instruction.symbol,
+                                operandList(instruction), instruction.isVariadic ? " variadic" : "",
+                                instruction.isTail ? " tail" : "");
+            break;
+        case Opcode::PHI:
+            text += std::format(" {}", ir::to_string(instruction.type));
+            for (size_t i = 0; i < instruction.operands.size(); i++) {
+                text += std::format("{} [{}, {}]", i == 0 ? "" : ",", valueName(instruction.operands[i]),
+                                    blockName(instruction.blocks[i]));
+            }
+            break;
+        case Opcode::BR:
+            text += std::format(" {}", blockName(instruction.blocks[0]));
+            break;
+        case Opcode::CONDBR:
+            text += std::format(" {}, {}, {}", operandList(instruction), blockName(instruction.blocks[0]),
+                                blockName(instruction.blocks[1]));
+            break;
+        case Opcode::RET:
+            if (!instruction.operands.empty()) {
+                text += std::format(" {}", operandList(instruction));
+            }
+            break;
+        default:
+            text += std::format(" {} {}", ir::to_string(instruction.type), operandList(instruction));
+            break;
+    }
+    return text;
+}
+
+void print(const Function& function, std::FILE* out) {
+    std::println(out, "define {} @{} {{", ir::to_string(function.returnType), function.name);
+    for (size_t i = 0; i < function.slots.size(); i++) {
+        const auto& slot = function.slots[i];
+        std::println(out, "  ; slot{}: {} ({} bytes, align {})", i, slot.name, slot.size, slot.alignment);
+    }
+    for (const auto& block : function.blocks) {
+        std::string predecessors;
+        for (const auto* predecessor : block->predecessors) {
+            predecessors += (predecessors.empty() ? "" : ", ") + blockName(predecessor);
+        }
+        if (predecessors.empty()) {
+            std::println(out, "{}:", blockName(block.get()));
+        } else {
+            std::println(out, "{}:  ; preds = {}", blockName(block.get()), predecessors);
+        }
+        for (const auto& instruction : block->instructions) {
+            std::println(out, "  {}", to_string(*instruction));
+        }
+    }
+    std::println(out, "}}");
+}
+
+} // namespace yoctocc::ir
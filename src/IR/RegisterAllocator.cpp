@@ -0,0 +1,554 @@
+#include "IR/RegisterAllocator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <unordered_map>
+#include "IR/Analysis.hpp"
+#include "IR/Target.hpp"
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+using enum Register;
+
+// 呼び出しで壊れてよいレジスタから先に使う
+constexpr std::array CALLER_SAVED_REGISTERS = {RSI, RDI, R8, R9, R10};
+constexpr std::array CALLEE_SAVED_REGISTERS = {RBX, R12, R13, R14, R15};
+// -fomit-frame-pointer ではフレームポインタに使わない rbp も割り当てる
+constexpr std::array CALLEE_SAVED_REGISTERS_WITH_RBP = {RBX, R12, R13, R14, R15, RBP};
+constexpr std::array FLOAT_REGISTERS = {XMM2, XMM3, XMM4, XMM5, XMM6, XMM7};
+
+bool fitsInt32(int64_t value) {
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+bool isPhi(const Instruction* instruction) {
+    return instruction->opcode == Opcode::PHI;
+}
+
+class BitSet final {
+public:
+    explicit BitSet(size_t size = 0) : _words((size + 63) / 64) {
+    }
+
+    void set(size_t i) {
+        _words[i / 64] |= uint64_t{1} << (i % 64);
+    }
+    void reset(size_t i) {
+        _words[i / 64] &= ~(uint64_t{1} << (i % 64));
+    }
+    [[nodiscard]] bool test(size_t i) const {
+        return (_words[i / 64] >> (i % 64)) & 1;
+    }
+    // this |= other。変化したら true
+    bool unite(const BitSet& other) {
+        bool changed = false;
+        for (size_t i = 0; i < _words.size(); i++) {
+            uint64_t merged = _words[i] | other._words[i];
+            changed = changed || merged != _words[i];
+            _words[i] = merged;
+        }
+        return changed;
+    }
+    // this = use | (out & ~def)
+    bool assignLiveIn(const BitSet& use, const BitSet& out, const BitSet& def) {
+        bool changed = false;
+        for (size_t i = 0; i < _words.size(); i++) {
+            uint64_t value = use._words[i] | (out._words[i] & ~def._words[i]);
+            changed = changed || value != _words[i];
+            _words[i] = value;
+        }
+        return changed;
+    }
+    template <typename F>
+    void forEach(F&& f) const {
+        for (size_t i = 0; i < _words.size(); i++) {
+            for (uint64_t word = _words[i]; word; word &= word - 1) {
+                f(i * 64 + static_cast<size_t>(std::countr_zero(word)));
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> _words;
+};
+
+// 同じブロックへの CONDBR を BR にし、分岐先が複数あるブロックから PHI を持つブロックへの辺を分割して、
+// PHI のコピーを先行ブロックの末尾 (分岐先が 1 つ) に置けるようにする
+void prepareControlFlow(Function& function) {
+    for (const auto& block : function.blocks) {
+        auto* terminator = block->terminator();
+        if (terminator->opcode == Opcode::CONDBR && terminator->blocks[0] == terminator->blocks[1]) {
+            terminator->opcode = Opcode::BR;
+            terminator->operands.clear();
+            terminator->blocks.resize(1);
+        }
+    }
+    function.recomputeControlFlow();
+
+    for (size_t i = 0, count = function.blocks.size(); i < count; i++) {
+        auto* block = function.blocks[i].get();
+        if (!isPhi(block->instructions.front().get())) {
+            continue;
+        }
+        for (auto* predecessor : std::vector{block->predecessors}) {
+            if (predecessor->successors.size() < 2) {
+                continue;
+            }
+            auto* middle = function.createBlock();
+            auto jump = function.create(Opcode::BR, ValueType::VOID);
+            jump->blocks = {block};
+            jump->line = predecessor->terminator()->line;
+            middle->append(std::move(jump));
+            for (auto*& target : predecessor->terminator()->blocks) {
+                if (target == block) {
+                    target = middle;
+                }
+            }
+            for (const auto& phi : block->instructions) {
+                if (!isPhi(phi.get())) {
+                    break;
+                }
+                std::ranges::replace(phi->blocks, predecessor, middle);
+            }
+        }
+    }
+    function.recomputeControlFlow();
+
+    // 引数はまとめて入口の並列コピーで受け取る
+    auto& entry = function.blocks.front()->instructions;
+    std::ranges::stable_partition(entry, [](const auto& instruction) { return instruction->opcode == Opcode::PARAM; });
+}
+
+// 逆後順を基本に、ループへ戻る辺の PHI のコピーだけを行うブロックをヘッダの直前へ移す。
+// 末尾で条件を調べるループは、条件分岐 1 つでそのブロックへ戻り、そのままヘッダへ落ちる。
+// ループの先頭 (移したブロックかヘッダ) には loopHeads の印を付ける
+std::vector<BasicBlock*> layoutBlocks(const Function& function, std::vector<bool>& loopHeads) {
+    const DominatorTree dominators{function};
+    const auto& order = dominators.reversePostOrder();
+    loopHeads.assign(function.nextBlockId, false);
+    std::vector<BasicBlock*> before(function.nextBlockId, nullptr);
+    std::vector<bool> moved(function.nextBlockId, false);
+    for (auto* block : order) {
+        for (auto* successor : block->successors) {
+            if (!dominators.dominates(successor, block)) {
+                continue;
+            }
+            loopHeads[successor->id] = true;
+            if (block->instructions.size() == 1 && block->successors.size() == 1 && successor != order.front() &&
+                !before[successor->id]) {
+                before[successor->id] = block;
+                moved[block->id] = true;
+            }
+        }
+    }
+
+    // 移すブロックの前にさらに別のブロックを移すことはしない
+    for (auto*& copies : before) {
+        if (copies && before[copies->id]) {
+            moved[copies->id] = false;
+            copies = nullptr;
+        }
+    }
+
+    std::vector<BasicBlock*> layout;
+    for (auto* block : order) {
+        if (moved[block->id]) {
+            continue;
+        }
+        if (auto* copies = before[block->id]) {
+            layout.emplace_back(copies);
+            loopHeads[copies->id] = true;
+            loopHeads[block->id] = false;
+        }
+        layout.emplace_back(block);
+    }
+    return layout;
+}
+
+class RegisterAllocator final {
+public:
+    RegisterAllocator(Function& function, const Target& target) : _function(function), _target(target) {
+    }
+
+    Allocation run() {
+        prepareControlFlow(_function);
+        _allocation.order = layoutBlocks(_function, _allocation.loopHeads);
+        _allocation.locations.resize(_function.nextValueId);
+        _allocation.inlined.resize(_function.nextValueId);
+        _uses.assign(_function.nextValueId, 0);
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                for (const auto* operand : instruction->operands) {
+                    _uses[operand->id]++;
+                }
+            }
+        }
+
+        selectInlined();
+        computeLiveness();
+        buildIntervals();
+        linearScan();
+        return std::move(_allocation);
+    }
+
+private:
+    // 単独の命令にしない値を決める
+    void selectInlined() {
+        auto& inlined = _allocation.inlined;
+        std::vector<bool> addressOnly(_function.nextValueId);
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                if (isRematerializable(instruction.get())) {
+                    inlined[instruction->id] = true;
+                }
+                // 定数の加算はアドレスとしてだけ使われるなら変位にする
+                if (instruction->opcode == Opcode::ADD && instruction->type == ValueType::I64 &&
+                    instruction->operands[1]->opcode == Opcode::CONST &&
+                    fitsInt32(instruction->operands[1]->immediate) && _uses[instruction->id] > 0) {
+                    addressOnly[instruction->id] = true;
+                }
+            }
+        }
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                for (size_t i = 0; i < instruction->operands.size(); i++) {
+                    const auto opcode = instruction->opcode;
+                    bool isAddress = (i == 0 && (opcode == Opcode::LOAD || opcode == Opcode::STORE ||
+                                                 opcode == Opcode::CLEAR)) ||
+                                     opcode == Opcode::COPY_MEMORY;
+                    if (!isAddress) {
+                        addressOnly[instruction->operands[i]->id] = false;
+                    }
+                }
+            }
+        }
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                if (addressOnly[instruction->id]) {
+                    inlined[instruction->id] = true;
+                }
+            }
+            // andn の ~a と FMA の a * b は使う命令の中で計算する
+            for (const auto& instruction : block->instructions) {
+                if (auto* operand = fusedOperand(instruction.get())) {
+                    inlined[operand->id] = true;
+                }
+            }
+            // 分岐の直前で比較してフラグを直接使う
+            auto* terminator = block->terminator();
+            if (terminator->opcode == Opcode::CONDBR) {
+                auto* condition = terminator->operands[0];
+                if ((condition->opcode == Opcode::CMP || condition->opcode == Opcode::FCMP) &&
+                    condition->parent == block.get() && _uses[condition->id] == 1) {
+                    inlined[condition->id] = true;
+                }
+            }
+        }
+    }
+
+    // instruction が 1 命令にまとめて計算するオペランド (同じブロックにあり、ほかに使われないもの)
+    [[nodiscard]] const Instruction* fusedOperand(const Instruction* instruction) const {
+        Opcode fused;
+        if (_target.hasBmi && instruction->opcode == Opcode::AND && !instruction->isVector()) {
+            fused = Opcode::NOT;
+        } else if (_target.contractsFloat &&
+                   (instruction->opcode == Opcode::FADD || instruction->opcode == Opcode::FSUB)) {
+            fused = Opcode::FMUL;
+        } else {
+            return nullptr;
+        }
+        for (const auto* operand : instruction->operands) {
+            if (operand->opcode == fused && operand->parent == instruction->parent && _uses[operand->id] == 1) {
+                return operand;
+            }
+        }
+        return nullptr;
+    }
+
+    // レジスタに置く値を使う命令なら、その値ごとに f を呼ぶ (埋め込んだ値はそのオペランドをたどる)
+    template <typename F>
+    void forEachUse(const Instruction* instruction, F&& f) const {
+        for (auto* operand : instruction->operands) {
+            if (isRematerializable(operand)) {
+                continue;
+            }
+            if (_allocation.inlined[operand->id]) {
+                forEachUse(operand, f);
+            } else {
+                f(operand);
+            }
+        }
+    }
+
+    [[nodiscard]] bool defines(const Instruction* instruction) const {
+        return instruction->type != ValueType::VOID && !_allocation.inlined[instruction->id] &&
+               _uses[instruction->id] > 0;
+    }
+
+    // successor の PHI のうち、block の末尾でコピーするもの
+    template <typename F>
+    void forEachPhiMove(const BasicBlock* block, F&& f) const {
+        for (const auto* successor : block->successors) {
+            for (const auto& phi : successor->instructions) {
+                if (!isPhi(phi.get())) {
+                    break;
+                }
+                if (_uses[phi->id] == 0) {
+                    continue;
+                }
+                auto it = std::ranges::find(phi->blocks, block);
+                f(phi.get(), phi->operands[static_cast<size_t>(it - phi->blocks.begin())]);
+            }
+        }
+    }
+
+    void computeLiveness() {
+        const size_t values = _function.nextValueId;
+        const size_t blocks = _function.nextBlockId;
+        std::vector<BitSet> use(blocks, BitSet{values});
+        std::vector<BitSet> def(blocks, BitSet{values});
+        _liveIn.assign(blocks, BitSet{values});
+        _liveOut.assign(blocks, BitSet{values});
+
+        for (const auto* block : _allocation.order) {
+            auto& blockUse = use[block->id];
+            auto& blockDef = def[block->id];
+            for (const auto& instruction : block->instructions) {
+                if (isPhi(instruction.get())) {
+                    continue;
+                }
+                forEachUse(instruction.get(), [&](const Instruction* operand) {
+                    if (!blockDef.test(operand->id)) {
+                        blockUse.set(operand->id);
+                    }
+                });
+                if (defines(instruction.get())) {
+                    blockDef.set(instruction->id);
+                }
+            }
+            // PHI のコピーは全部読んでから全部書く
+            std::vector<const Instruction*> phis;
+            forEachPhiMove(block, [&](const Instruction* phi, const Instruction* incoming) {
+                if (!isRematerializable(incoming) && !blockDef.test(incoming->id)) {
+                    blockUse.set(incoming->id);
+                }
+                phis.emplace_back(phi);
+            });
+            for (const auto* phi : phis) {
+                blockDef.set(phi->id);
+            }
+        }
+
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (auto it = _allocation.order.rbegin(); it != _allocation.order.rend(); ++it) {
+                const auto* block = *it;
+                auto& out = _liveOut[block->id];
+                for (const auto* successor : block->successors) {
+                    out.unite(_liveIn[successor->id]);
+                }
+                changed = _liveIn[block->id].assignLiveIn(use[block->id], out, def[block->id]) || changed;
+            }
+        }
+    }
+
+    void extend(const Instruction* value, int position) {
+        auto& [start, end] = _ranges[value->id];
+        start = std::min(start, position);
+        end = std::max(end, position);
+    }
+
+    // 命令に番号 k を振り、オペランドの使用を 2k、結果の定義を 2k+1 とする。
+    // 生存区間は穴を持たない [最初, 最後] で近似する
+    void buildIntervals() {
+        _ranges.assign(_function.nextValueId, {INT_MAX, -1});
+        int index = 0;
+        int firstParam = -1;
+        for (const auto* block : _allocation.order) {
+            const int first = index;
+            for (const auto& instruction : block->instructions) {
+                if (isPhi(instruction.get())) {
+                    continue;
+                }
+                const int position = 2 * index++;
+                forEachUse(instruction.get(), [&](const Instruction* operand) { extend(operand, position); });
+                if (defines(instruction.get())) {
+                    extend(instruction.get(), position + 1);
+                }
+                if (instruction->opcode == Opcode::CALL) {
+                    _calls.emplace_back(position);
+                }
+                if (instruction->opcode == Opcode::PARAM && firstParam < 0) {
+                    firstParam = position + 1;
+                }
+            }
+            const int last = index - 1;
+            forEachPhiMove(block, [&](const Instruction* phi, const Instruction* incoming) {
+                if (!isRematerializable(incoming)) {
+                    extend(incoming, 2 * last);
+                }
+                extend(phi, 2 * last + 1);
+            });
+            _liveIn[block->id].forEach([&](size_t id) { extendId(id, 2 * first); });
+            _liveOut[block->id].forEach([&](size_t id) { extendId(id, 2 * last + 1); });
+        }
+
+        // 引数は入口で同時に受け取るので、すべて同じ位置から生きているとみなす
+        for (const auto& instruction : _function.blocks.front()->instructions) {
+            if (instruction->opcode == Opcode::PARAM && defines(instruction.get())) {
+                extend(instruction.get(), firstParam);
+            }
+        }
+    }
+
+    void extendId(size_t id, int position) {
+        auto& [start, end] = _ranges[id];
+        start = std::min(start, position);
+        end = std::max(end, position);
+    }
+
+    struct Interval {
+        const Instruction* value;
+        int start;
+        int end;
+        // xmm レジスタに置く値 (浮動小数点数とベクトル)
+        bool isFloat;
+        bool crossesCall;
+    };
+
+    [[nodiscard]] bool crossesCall(int start, int end) const {
+        auto it = std::ranges::lower_bound(_calls, start);
+        return it != _calls.end() && *it < end;
+    }
+
+    void linearScan() {
+        std::vector<Interval> intervals;
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                const auto [start, end] = _ranges[instruction->id];
+                if (end < 0 || (!defines(instruction.get()) && !isPhi(instruction.get()))) {
+                    continue;
+                }
+                if (isPhi(instruction.get()) && _uses[instruction->id] == 0) {
+                    continue;
+                }
+                intervals.push_back({instruction.get(), start, end, instruction->isFloat() || instruction->isVector(),
+                                     crossesCall(start, end)});
+            }
+        }
+        std::ranges::sort(intervals, [](const Interval& a, const Interval& b) {
+            return a.start != b.start ? a.start < b.start : a.value->id < b.value->id;
+        });
+
+        std::vector<Interval*> active;
+        std::unordered_map<Register, bool> busy;
+        auto isFree = [&](Register reg) { return !busy[reg]; };
+
+        for (auto& interval : intervals) {
+            std::erase_if(active, [&](const Interval* other) {
+                if (other->end < interval.start) {
+                    busy[location(other).reg] = false;
+                    return true;
+                }
+                return false;
+            });
+
+            std::optional<Register> chosen;
+            if (interval.isFloat) {
+                if (!interval.crossesCall) {
+                    chosen = findFree(FLOAT_REGISTERS, isFree);
+                }
+            } else {
+                if (!interval.crossesCall) {
+                    chosen = findFree(CALLER_SAVED_REGISTERS, isFree);
+                }
+                if (!chosen) {
+                    chosen = _target.omitsFramePointer ? findFree(CALLEE_SAVED_REGISTERS_WITH_RBP, isFree)
+                                                       : findFree(CALLEE_SAVED_REGISTERS, isFree);
+                }
+            }
+
+            if (!chosen && !(interval.isFloat && interval.crossesCall)) {
+                // 最も遠くまで生きている値を追い出す
+                Interval* victim = nullptr;
+                for (auto* other : active) {
+                    if (other->isFloat != interval.isFloat) {
+                        continue;
+                    }
+                    if (interval.crossesCall && !isCalleeSaved(location(other).reg)) {
+                        continue;
+                    }
+                    if (!victim || other->end > victim->end) {
+                        victim = other;
+                    }
+                }
+                if (victim && victim->end > interval.end) {
+                    chosen = location(victim).reg;
+                    spill(victim);
+                    std::erase(active, victim);
+                }
+            }
+
+            if (!chosen) {
+                spill(&interval);
+                continue;
+            }
+            busy[*chosen] = true;
+            location(&interval) =
+                Location{.kind = Location::Kind::REGISTER, .reg = *chosen, .isVector = interval.value->isVector()};
+            active.emplace_back(&interval);
+            if (isCalleeSaved(*chosen) &&
+                !std::ranges::contains(_allocation.calleeSaved, *chosen)) {
+                _allocation.calleeSaved.emplace_back(*chosen);
+            }
+        }
+        std::ranges::sort(_allocation.calleeSaved);
+    }
+
+    [[nodiscard]] static bool isCalleeSaved(Register reg) {
+        return std::ranges::contains(CALLEE_SAVED_REGISTERS_WITH_RBP, reg);
+    }
+
+    template <size_t N, typename F>
+    static std::optional<Register> findFree(const std::array<Register, N>& registers, F&& isFree) {
+        for (auto reg : registers) {
+            if (isFree(reg)) {
+                return reg;
+            }
+        }
+        return std::nullopt;
+    }
+
+    Location& location(const Interval* interval) {
+        return _allocation.locations[interval->value->id];
+    }
+
+    void spill(const Interval* interval) {
+        const bool isVector = interval->value->isVector();
+        // ベクトルは 2 つ分のうち下のスロットから 16 バイトを使う
+        _allocation.spillSlots += isVector ? 2 : 1;
+        location(interval) =
+            Location{.kind = Location::Kind::STACK, .spillSlot = _allocation.spillSlots - 1, .isVector = isVector};
+    }
+
+    Function& _function;
+    const Target& _target;
+    Allocation _allocation;
+    std::vector<size_t> _uses;
+    std::vector<BitSet> _liveIn;
+    std::vector<BitSet> _liveOut;
+    std::vector<std::pair<int, int>> _ranges;
+    std::vector<int> _calls;
+};
+} // namespace
+
+namespace yoctocc::ir {
+
+Allocation allocateRegisters(Function& function, const Target& target) {
+    return RegisterAllocator{function, target}.run();
+}
+
+} // namespace yoctocc::ir
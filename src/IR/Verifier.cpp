@@ -0,0 +1,383 @@
+#include "IR/Verifier.hpp"
+
+#include <algorithm>
+#include <format>
+#include <unordered_set>
+#include "IR/Analysis.hpp"
+#include "IR/Printer.hpp"
+#include "Logger.hpp"
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+bool isInteger(ValueType type) {
+    return type == ValueType::I32 || type == ValueType::I64;
+}
+
+bool isFloat(ValueType type) {
+    return type == ValueType::F32 || type == ValueType::F64;
+}
+
+// ベクトルで要素ごとに計算できる演算
+bool isLaneOperation(Opcode opcode) {
+    using enum Opcode;
+    return opcode == ADD || opcode == SUB || opcode == AND || opcode == OR || opcode == XOR || opcode == FADD ||
+           opcode == FSUB || opcode == FMUL || opcode == FDIV;
+}
+
+class Verifier final {
+public:
+    Verifier(const Function& function, std::string_view after) : _function(function), _after(after) {
+    }
+
+    void run() {
+        if (_function.blocks.empty()) {
+            fail("function has no blocks");
+        }
+        for (const auto& block : _function.blocks) {
+            _blocks.insert(block.get());
+            for (const auto& instruction : block->instructions) {
+                _values.insert(instruction.get());
+            }
+        }
+        for (const auto& block : _function.blocks) {
+            verifyStructure(*block);
+        }
+        verifyControlFlow();
+
+        DominatorTree dominators{_function};
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                verifyOperands(*instruction, dominators);
+                verifyTypes(*instruction);
+            }
+        }
+    }
+
+private:
+    [[noreturn]] void fail(std::string_view message, const Instruction* instruction = nullptr) {
+        std::string detail = instruction ? std::format(" ({} in bb{})", to_string(*instruction),
+                                                       instruction->parent ? instruction->parent->id : 0)
+                                         : std::string{};
+        Log::error(std::format("IR verification failed after {} in {}: {}{}", _after, _function.name, message, detail));
+        std::exit(1);
+    }
+
+    void verifyStructure(const BasicBlock& block) {
+        if (block.instructions.empty()) {
+            fail(std::format("bb{} is empty", block.id));
+        }
+        if (!block.terminator()) {
+            fail(std::format("bb{} does not end with a terminator", block.id));
+        }
+        bool phis = true;
+        for (const auto& instruction : block.instructions) {
+            if (instruction->parent != &block) {
+                fail("instruction has a wrong parent", instruction.get());
+            }
+            if (instruction->isTerminator() && instruction.get() != block.terminator()) {
+                fail("terminator in the middle of a block", instruction.get());
+            }
+            if (instruction->opcode == Opcode::PHI && !phis) {
+                fail("phi after a non-phi instruction", instruction.get());
+            }
+            phis = phis && instruction->opcode == Opcode::PHI;
+            for (const auto* target : instruction->blocks) {
+                if (!_blocks.contains(target)) {
+                    fail("reference to a block outside the function", instruction.get());
+                }
+            }
+        }
+        const auto* terminator = block.terminator();
+        size_t expected = terminator->opcode == Opcode::BR ? 1 : terminator->opcode == Opcode::CONDBR ? 2 : 0;
+        if (terminator->blocks.size() != expected) {
+            fail("wrong number of successors", terminator);
+        }
+    }
+
+    void verifyControlFlow() {
+        std::vector<std::vector<const BasicBlock*>> predecessors(_function.nextBlockId);
+        for (const auto& block : _function.blocks) {
+            for (const auto* target : block->terminator()->blocks) {
+                auto& list = predecessors[target->id];
+                if (list.empty() || list.back() != block.get()) {
+                    list.emplace_back(block.get());
+                }
+            }
+        }
+        for (const auto& block : _function.blocks) {
+            const auto& expected = predecessors[block->id];
+            if (expected.size() != block->predecessors.size() ||
+                !std::ranges::all_of(expected, [&](const BasicBlock* b) {
+                    return std::ranges::contains(block->predecessors, b);
+                })) {
+                fail(std::format("stale predecessor list of bb{}", block->id));
+            }
+            for (const auto& instruction : block->instructions) {
+                if (instruction->opcode != Opcode::PHI) {
+                    break;
+                }
+                if (instruction->operands.size() != instruction->blocks.size() ||
+                    instruction->blocks.size() != block->predecessors.size()) {
+                    fail("phi does not have one incoming value per predecessor", instruction.get());
+                }
+                for (const auto* incoming : instruction->blocks) {
+                    if (!std::ranges::contains(block->predecessors, incoming) ||
+                        std::ranges::count(instruction->blocks, incoming) != 1) {
+                        fail("phi incoming block is not a unique predecessor", instruction.get());
+                    }
+                }
+            }
+        }
+    }
+
+    void verifyOperands(const Instruction& instruction, const DominatorTree& dominators) {
+        for (size_t i = 0; i < instruction.operands.size(); i++) {
+            const auto* operand = instruction.operands[i];
+            if (!operand || !_values.contains(operand)) {
+                fail("operand is not defined in the function", &instruction);
+            }
+            if (operand->type == ValueType::VOID) {
+                fail("operand has no value", &instruction);
+            }
+            if (instruction.opcode == Opcode::PHI) {
+                const auto* incoming = instruction.blocks[i];
+                if (dominators.isReachable(incoming) && !dominators.dominates(operand->parent, incoming)) {
+                    fail(std::format("%{} does not dominate the end of bb{}", operand->id, incoming->id), &instruction);
+                }
+                continue;
+            }
+            if (operand == &instruction || !dominators.dominates(operand, &instruction)) {
+                if (dominators.isReachable(instruction.parent)) {
+                    fail(std::format("%{} does not dominate its use", operand->id), &instruction);
+                }
+            }
+        }
+    }
+
+    void expectOperands(const Instruction& instruction, size_t count) {
+        if (instruction.operands.size() != count) {
+            fail("wrong number of operands", &instruction);
+        }
+    }
+
+    void expectType(const Instruction& instruction, const Instruction* operand, ValueType type) {
+        if (operand->type != type) {
+            fail(std::format("%{} should be {}", operand->id, to_string(type)), &instruction);
+        }
+    }
+
+    // 同じブロックで直後の RET がこの値を返す (値を返さない関数なら値を返さない)
+    bool returnsRightAfter(const Instruction& call) const {
+        const auto& instructions = call.parent->instructions;
+        const auto* terminator = call.parent->terminator();
+        if (!terminator || terminator->opcode != Opcode::RET || instructions.size() < 2 ||
+            instructions[instructions.size() - 2].get() != &call) {
+            return false;
+        }
+        return terminator->operands.empty() ? _function.returnType == ValueType::VOID
+                                            : terminator->operands[0] == &call;
+    }
+
+    void verifyTypes(const Instruction& instruction) {
+        using enum Opcode;
+        const auto& operands = instruction.operands;
+        switch (instruction.opcode) {
+            case CONST:
+            case PARAM:
+                expectOperands(instruction, 0);
+                return;
+            case FRAME_ADDRESS:
+                expectOperands(instruction, 0);
+                if (instruction.immediate < 0 || static_cast<size_t>(instruction.immediate) >= _function.slots.size()) {
+                    fail("invalid frame slot", &instruction);
+                }
+                [[fallthrough]];
+            case GLOBAL_ADDRESS:
+                if (instruction.type != ValueType::I64) {
+                    fail("address must be i64", &instruction);
+                }
+                return;
+            case ADD:
+            case SUB:
+            case MUL:
+            case SDIV:
+            case UDIV:
+            case SREM:
+            case UREM:
+            case AND:
+            case OR:
+            case XOR:
+            case SHL:
+            case SHR:
+            case SAR:
+                expectOperands(instruction, 2);
+                if (!isInteger(elementType(instruction.type))) {
+                    fail("integer operation must have an integer type", &instruction);
+                }
+                if (isVectorType(instruction.type) && !isLaneOperation(instruction.opcode)) {
+                    fail("operation cannot be applied to a vector", &instruction);
+                }
+                expectType(instruction, operands[0], instruction.type);
+                expectType(instruction, operands[1], instruction.type);
+                return;
+            case NEG:
+            case NOT:
+            case POPCOUNT:
+            case CLZ:
+            case CTZ:
+                expectOperands(instruction, 1);
+                if (!isInteger(instruction.type)) {
+                    fail("integer operation must have an integer type", &instruction);
+                }
+                expectType(instruction, operands[0], instruction.type);
+                return;
+            case FADD:
+            case FSUB:
+            case FMUL:
+            case FDIV:
+                expectOperands(instruction, 2);
+                if (!isFloat(elementType(instruction.type))) {
+                    fail("floating point operation must have a floating point type", &instruction);
+                }
+                expectType(instruction, operands[0], instruction.type);
+                expectType(instruction, operands[1], instruction.type);
+                return;
+            case FNEG:
+                expectOperands(instruction, 1);
+                expectType(instruction, operands[0], instruction.type);
+                return;
+            case SPLAT:
+                expectOperands(instruction, 1);
+                if (!isVectorType(instruction.type)) {
+                    fail("splat must have a vector type", &instruction);
+                }
+                expectType(instruction, operands[0], elementType(instruction.type));
+                return;
+            case REDUCE:
+                expectOperands(instruction, 1);
+                expectType(instruction, operands[0], vectorType(instruction.type));
+                if (!isInteger(instruction.type)) {
+                    fail("reduce must have an integer type", &instruction);
+                }
+                return;
+            case CMP:
+            case FCMP:
+                expectOperands(instruction, 2);
+                expectType(instruction, &instruction, ValueType::I32);
+                if (instruction.opcode == CMP ? !isInteger(operands[0]->type) : !isFloat(operands[0]->type)) {
+                    fail("comparison of a wrong type", &instruction);
+                }
+                expectType(instruction, operands[1], operands[0]->type);
+                return;
+            case SEXT:
+            case ZEXT:
+                expectOperands(instruction, 1);
+                expectType(instruction, operands[0], ValueType::I32);
+                expectType(instruction, &instruction, ValueType::I64);
+                return;
+            case TRUNC:
+                expectOperands(instruction, 1);
+                expectType(instruction, operands[0], ValueType::I64);
+                expectType(instruction, &instruction, ValueType::I32);
+                return;
+            case EXTEND:
+                expectOperands(instruction, 1);
+                expectType(instruction, operands[0], ValueType::I32);
+                expectType(instruction, &instruction, ValueType::I32);
+                if (instruction.immediate != 8 && instruction.immediate != 16) {
+                    fail("extend must be from 8 or 16 bits", &instruction);
+                }
+                return;
+            case SITOFP:
+            case UITOFP:
+                expectOperands(instruction, 1);
+                if (!isInteger(operands[0]->type) || !isFloat(instruction.type)) {
+                    fail("wrong conversion types", &instruction);
+                }
+                return;
+            case FPTOSI:
+                expectOperands(instruction, 1);
+                if (!isFloat(operands[0]->type) || !isInteger(instruction.type)) {
+                    fail("wrong conversion types", &instruction);
+                }
+                return;
+            case FPEXT:
+                expectOperands(instruction, 1);
+                expectType(instruction, operands[0], ValueType::F32);
+                expectType(instruction, &instruction, ValueType::F64);
+                return;
+            case FPTRUNC:
+                expectOperands(instruction, 1);
+                expectType(instruction, operands[0], ValueType::F64);
+                expectType(instruction, &instruction, ValueType::F32);
+                return;
+            case LOAD:
+                expectOperands(instruction, 1);
+                expectType(instruction, operands[0], ValueType::I64);
+                if (isVectorType(instruction.type) && instruction.immediate != 16) {
+                    fail("vector load must be 16 bytes", &instruction);
+                }
+                return;
+            case STORE:
+                expectOperands(instruction, 2);
+                expectType(instruction, operands[0], ValueType::I64);
+                if (isVectorType(operands[1]->type) && instruction.immediate != 16) {
+                    fail("vector store must be 16 bytes", &instruction);
+                }
+                return;
+            case CLEAR:
+                expectOperands(instruction, 1);
+                expectType(instruction, operands[0], ValueType::I64);
+                return;
+            case COPY_MEMORY:
+                expectOperands(instruction, 2);
+                expectType(instruction, operands[0], ValueType::I64);
+                expectType(instruction, operands[1], ValueType::I64);
+                return;
+            case CALL:
+                if (instruction.isTail && !returnsRightAfter(instruction)) {
+                    fail("tail call must be followed by a return of its value", &instruction);
+                }
+                return;
+            case PHI:
+            case COPY:
+                for (const auto* operand : operands) {
+                    expectType(instruction, operand, instruction.type);
+                }
+                return;
+            case BR:
+                expectOperands(instruction, 0);
+                return;
+            case CONDBR:
+                expectOperands(instruction, 1);
+                if (!isInteger(operands[0]->type)) {
+                    fail("branch condition must be an integer", &instruction);
+                }
+                return;
+            case RET:
+                if (_function.returnType == ValueType::VOID) {
+                    expectOperands(instruction, 0);
+                } else {
+                    expectOperands(instruction, 1);
+                    expectType(instruction, operands[0], _function.returnType);
+                }
+                return;
+        }
+    }
+
+    const Function& _function;
+    std::string_view _after;
+    std::unordered_set<const BasicBlock*> _blocks;
+    std::unordered_set<const Instruction*> _values;
+};
+} // namespace
+
+namespace yoctocc::ir {
+
+void verify(const Function& function, std::string_view after) {
+    Verifier{function, after}.run();
+}
+
+} // namespace yoctocc::ir
@@ -0,0 +1,591 @@
+#include "Interpreter/BytecodeCompiler.hpp"
+
+#include <bit>
+#include <cassert>
+#include <format>
+#include "Logger.hpp"
+#include "Node/Node.hpp"
+#include "Token.hpp"
+#include "Type.hpp"
+#include "Utility.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::interpreter;
+
+constexpr size_t STACK_ALIGNMENT = 16;
+
+// Generator と同じく、long かポインタ演算なら 64 ビット、それ以外は 32 ビットで演算する
+ValueType integerOperationType(const Node* node, bool isUnsigned) {
+    bool is64 = node->type->kind == TypeKind::LONG || node->left->type->base;
+    if (is64) {
+        return isUnsigned ? ValueType::U64 : ValueType::I64;
+    }
+    return isUnsigned ? ValueType::U32 : ValueType::I32;
+}
+
+} // namespace
+
+namespace yoctocc::interpreter {
+
+ValueType valueTypeOf(const Type* type) {
+    using enum TypeKind;
+    switch (type->kind) {
+        case CHAR:
+            return type->isUnsigned ? ValueType::U8 : ValueType::I8;
+        case SHORT:
+            return type->isUnsigned ? ValueType::U16 : ValueType::I16;
+        case INT:
+            return type->isUnsigned ? ValueType::U32 : ValueType::I32;
+        case LONG:
+            return type->isUnsigned ? ValueType::U64 : ValueType::I64;
+        case FLOAT:
+            return ValueType::F32;
+        case DOUBLE:
+            return ValueType::F64;
+        default:
+            return ValueType::U64;
+    }
+}
+
+BytecodeCompiler::BytecodeCompiler(std::function<void*(const Object*)> globalAddress,
+                                   std::function<void*(const std::string&)> externalFunction)
+    : _globalAddress(std::move(globalAddress)), _externalFunction(std::move(externalFunction)) {
+}
+
+Program BytecodeCompiler::compile(Object* program) {
+    assert(program);
+    _program = {};
+
+    // 相互再帰に備えて先に番号を振る
+    for (Object* fn = program; fn; fn = fn->next.get()) {
+        if (fn->isFunction && fn->isDefinition) {
+            registerFunction(fn);
+        }
+    }
+    compilePending();
+    return std::move(_program);
+}
+
+Program BytecodeCompiler::compileReachable(const Object* fn) {
+    assert(fn && fn->body);
+    _program = {};
+    registerFunction(fn);
+    compilePending();
+    return std::move(_program);
+}
+
+int BytecodeCompiler::registerFunction(const Object* fn) {
+    auto [it, inserted] = _program.functionIndices.try_emplace(fn->name, static_cast<int>(_program.functions.size()));
+    if (inserted) {
+        auto& function = _program.functions.emplace_back();
+        function.object = fn;
+        _pending.emplace_back(it->second);
+    }
+    return it->second;
+}
+
+void BytecodeCompiler::compilePending() {
+    while (!_pending.empty()) {
+        int index = _pending.back();
+        _pending.pop_back();
+        // 変換中に関数が追加されると vector が再確保されるので、別の Function に組み立ててから戻す
+        Function function = _program.functions[index];
+        auto* fn = const_cast<Object*>(function.object);
+        assignLocalVariableOffsets(fn, function);
+        compileFunction(fn, function);
+        _program.functions[index] = std::move(function);
+    }
+}
+
+void BytecodeCompiler::assignLocalVariableOffsets(Object* fn, Function& function) {
+    int offset = 0;
+    for (Object* local = fn->locals.get(); local; local = local->next.get()) {
+        offset += local->type->size;
+        offset = alignTo(offset, local->alignment);
+        local->offset = -offset;
+    }
+    _frameOffset = offset;
+    function.frameSize = alignTo(offset, STACK_ALIGNMENT);
+}
+
+int BytecodeCompiler::allocateTemporary(int size, int alignment) {
+    _frameOffset = alignTo(_frameOffset + size, alignment);
+    _function->frameSize = alignTo(_frameOffset, STACK_ALIGNMENT);
+    return -_frameOffset;
+}
+
+void BytecodeCompiler::compileFunction(const Object* fn, Function& function) {
+    _function = &function;
+    _labels.clear();
+    _patches.clear();
+
+    compileStatement(fn->body.get());
+    // return のない関数は 0 を返す
+    emit(Op::PUSH);
+    emit(Op::RETURN);
+
+    for (const auto& [label, index] : _patches) {
+        auto it = _labels.find(label);
+        if (it == _labels.end()) {
+            Log::error(std::format("interpreter: undefined label: {}", label));
+            continue;
+        }
+        auto& instruction = function.code[index];
+        if (instruction.op == Op::JUMP_IF_EQUAL) {
+            instruction.imm2 = static_cast<int64_t>(it->second);
+        } else {
+            instruction.imm = static_cast<int64_t>(it->second);
+        }
+    }
+    _function = nullptr;
+}
+
+void BytecodeCompiler::emit(Op op, ValueType type, ValueType type2, int64_t imm, int64_t imm2) {
+    _function->code.emplace_back(Instruction{op, type, type2, imm, imm2});
+}
+
+void BytecodeCompiler::emitJump(Op op, ValueType type, const std::string& label) {
+    _patches.emplace_back(label, _function->code.size());
+    emit(op, type);
+}
+
+void BytecodeCompiler::defineLabel(const std::string& label) {
+    _labels[label] = _function->code.size();
+}
+
+std::string BytecodeCompiler::newLabel() {
+    return std::format(".I.{}", _labelCount++);
+}
+
+void BytecodeCompiler::compileCondition(const Node* node, bool jumpIfZero, const std::string& label) {
+    compileExpression(node);
+    emitJump(jumpIfZero ? Op::JUMP_IF_ZERO : Op::JUMP_IF_NOT_ZERO, valueTypeOf(node->type.get()), label);
+}
+
+void BytecodeCompiler::compileLoad(const Type* type) {
+    using enum TypeKind;
+    switch (type->kind) {
+        case ARRAY:
+        case STRUCT:
+        case UNION:
+            // アドレスがそのまま値になる
+            return;
+        case FLOAT:
+            emit(Op::LOAD, ValueType::F32);
+            return;
+        case DOUBLE:
+            emit(Op::LOAD, ValueType::F64);
+            return;
+        default:
+            break;
+    }
+
+    switch (type->size) {
+        case 1:
+            emit(Op::LOAD, type->isUnsigned ? ValueType::U8 : ValueType::I8);
+            return;
+        case 2:
+            emit(Op::LOAD, type->isUnsigned ? ValueType::U16 : ValueType::I16);
+            return;
+        case 4:
+            emit(Op::LOAD, type->isUnsigned ? ValueType::U32 : ValueType::I32);
+            return;
+        default:
+            emit(Op::LOAD, ValueType::U64);
+            return;
+    }
+}
+
+void BytecodeCompiler::compileStore(const Type* type) {
+    using enum TypeKind;
+    switch (type->kind) {
+        case STRUCT:
+        case UNION:
+            emit(Op::STORE_BLOCK, ValueType::U64, ValueType::U64, type->size);
+            return;
+        case FLOAT:
+            emit(Op::STORE, ValueType::F32);
+            return;
+        case DOUBLE:
+            emit(Op::STORE, ValueType::F64);
+            return;
+        default:
+            break;
+    }
+
+    switch (type->size) {
+        case 1:
+            emit(Op::STORE, ValueType::U8);
+            return;
+        case 2:
+            emit(Op::STORE, ValueType::U16);
+            return;
+        case 4:
+            emit(Op::STORE, ValueType::U32);
+            return;
+        default:
+            emit(Op::STORE, ValueType::U64);
+            return;
+    }
+}
+
+void BytecodeCompiler::compileAddress(const Node* node) {
+    assert(node);
+
+    switch (node->nodeType) {
+        case NodeType::VARIABLE:
+            if (node->variable->isLocal) {
+                emit(Op::LOCAL_ADDRESS, ValueType::U64, ValueType::U64, node->variable->offset);
+            } else {
+                auto address = reinterpret_cast<intptr_t>(_globalAddress(node->variable));
+                emit(Op::PUSH, ValueType::U64, ValueType::U64, address);
+            }
+            return;
+        case NodeType::DEREFERENCE:
+            compileExpression(node->left.get());
+            return;
+        case NodeType::MEMBER:
+            compileAddress(node->left.get());
+            emit(Op::PUSH, ValueType::U64, ValueType::U64, node->member->offset);
+            emit(Op::ADD, ValueType::U64);
+            return;
+        case NodeType::COMMA:
+            compileExpression(node->left.get());
+            emit(Op::POP);
+            compileAddress(node->right.get());
+            return;
+        default:
+            break;
+    }
+
+    Log::error("Not an lvalue"sv, node->token);
+}
+
+void BytecodeCompiler::compileStatement(const Node* node) {
+    assert(node);
+
+    switch (node->nodeType) {
+        case NodeType::IF: {
+            auto elseLabel = newLabel();
+            auto endLabel = newLabel();
+            compileCondition(node->condition.get(), true, elseLabel);
+            compileStatement(node->then.get());
+            emitJump(Op::JUMP, ValueType::U64, endLabel);
+            defineLabel(elseLabel);
+            if (node->els) {
+                compileStatement(node->els.get());
+            }
+            defineLabel(endLabel);
+            return;
+        }
+        case NodeType::FOR: {
+            auto beginLabel = newLabel();
+            if (node->init) {
+                compileStatement(node->init.get());
+            }
+            defineLabel(beginLabel);
+            if (node->condition) {
+                compileCondition(node->condition.get(), true, node->breakLabel);
+            }
+            compileStatement(node->then.get());
+            defineLabel(node->continueLabel);
+            if (node->inc) {
+                compileExpression(node->inc.get());
+                emit(Op::POP);
+            }
+            emitJump(Op::JUMP, ValueType::U64, beginLabel);
+            defineLabel(node->breakLabel);
+            return;
+        }
+        case NodeType::DO: {
+            auto beginLabel = newLabel();
+            defineLabel(beginLabel);
+            if (node->then) {
+                compileStatement(node->then.get());
+            }
+            defineLabel(node->continueLabel);
+            compileCondition(node->condition.get(), false, beginLabel);
+            defineLabel(node->breakLabel);
+            return;
+        }
+        case NodeType::SWITCH: {
+            compileExpression(node->condition.get());
+            auto type = node->condition->type->size == 8 ? ValueType::I64 : ValueType::I32;
+            for (const Node* caseNode = node->cases; caseNode; caseNode = caseNode->cases) {
+                _patches.emplace_back(caseNode->label, _function->code.size());
+                emit(Op::JUMP_IF_EQUAL, type, ValueType::U64, caseNode->integerValue);
+            }
+            emit(Op::POP);
+            if (node->defaultCase) {
+                emitJump(Op::JUMP, ValueType::U64, node->defaultCase->label);
+            }
+            emitJump(Op::JUMP, ValueType::U64, node->breakLabel);
+            compileStatement(node->then.get());
+            defineLabel(node->breakLabel);
+            return;
+        }
+        case NodeType::CASE:
+            defineLabel(node->label);
+            compileStatement(node->left.get());
+            return;
+        case NodeType::BLOCK:
+            for (const Node* statement = node->body.get(); statement; statement = statement->next.get()) {
+                compileStatement(statement);
+            }
+            return;
+        case NodeType::GOTO:
+            emitJump(Op::JUMP, ValueType::U64, node->uniqueLabel);
+            return;
+        case NodeType::LABEL:
+            defineLabel(node->uniqueLabel);
+            compileStatement(node->left.get());
+            return;
+        case NodeType::RETURN:
+            if (node->left) {
+                compileExpression(node->left.get());
+            } else {
+                emit(Op::PUSH);
+            }
+            emit(Op::RETURN);
+            return;
+        case NodeType::EXPRESSION_STATEMENT:
+            compileExpression(node->left.get());
+            emit(Op::POP);
+            return;
+        default:
+            break;
+    }
+
+    Log::error("Invalid statement"sv, node->token);
+}
+
+void BytecodeCompiler::compileCall(const Node* node) {
+    CallSite callSite{};
+    callSite.name = node->functionName;
+
+    // Generator と同じく後ろの引数から評価する
+    std::vector<const Node*> arguments;
+    for (const Node* arg = node->arguments.get(); arg; arg = arg->next.get()) {
+        arguments.emplace_back(arg);
+        callSite.arguments.emplace_back(valueTypeOf(arg->type.get()));
+        callSite.argumentTypes.emplace_back(arg->type.get());
+    }
+    for (auto it = arguments.rbegin(); it != arguments.rend(); ++it) {
+        compileExpression(*it);
+    }
+
+    if (!type::is(node->type, TypeKind::VOID)) {
+        callSite.returnType = node->type.get();
+    }
+
+    if (auto it = _program.functionIndices.find(node->functionName); it != _program.functionIndices.end()) {
+        callSite.function = it->second;
+    } else if (node->variable && node->variable->body) {
+        // 解析途中の定数式から呼ばれた関数
+        callSite.function = registerFunction(node->variable);
+    } else {
+        callSite.host = _externalFunction(node->functionName);
+    }
+
+    // 構造体の戻り値は呼ばれた側のフレームを指すので、解放される前に呼び出し元の領域へ写してもらう
+    if (callSite.function >= 0 && (type::is(node->type, TypeKind::STRUCT) || type::is(node->type, TypeKind::UNION))) {
+        callSite.returnSlot = allocateTemporary(node->type->size, node->type->alignment);
+    }
+
+    emit(Op::CALL, ValueType::U64, ValueType::U64, static_cast<int64_t>(_program.callSites.size()));
+    _program.callSites.emplace_back(std::move(callSite));
+}
+
+void BytecodeCompiler::compileExpression(const Node* node) {
+    assert(node);
+
+    switch (node->nodeType) {
+        case NodeType::NULL_EXPRESSION:
+            emit(Op::PUSH);
+            return;
+        case NodeType::NUMBER:
+            switch (node->type->kind) {
+                case TypeKind::FLOAT:
+                    emit(Op::PUSH, ValueType::F32, ValueType::F32,
+                         std::bit_cast<uint32_t>(static_cast<float>(node->floatValue)));
+                    return;
+                case TypeKind::DOUBLE:
+                    emit(Op::PUSH, ValueType::F64, ValueType::F64, std::bit_cast<int64_t>(node->floatValue));
+                    return;
+                default:
+                    emit(Op::PUSH, ValueType::I64, ValueType::I64, node->integerValue);
+                    return;
+            }
+        case NodeType::NEGATE:
+            compileExpression(node->left.get());
+            emit(Op::NEGATE, valueTypeOf(node->type.get()));
+            return;
+        case NodeType::VARIABLE:
+        case NodeType::MEMBER:
+            compileAddress(node);
+            compileLoad(node->type.get());
+            return;
+        case NodeType::ADDRESS:
+            compileAddress(node->left.get());
+            return;
+        case NodeType::DEREFERENCE:
+            compileExpression(node->left.get());
+            compileLoad(node->type.get());
+            return;
+        case NodeType::ASSIGN:
+            compileAddress(node->left.get());
+            compileExpression(node->right.get());
+            compileStore(node->type.get());
+            return;
+        case NodeType::STATEMENT_EXPRESSION: {
+            const Node* statement = node->body.get();
+            if (!statement) {
+                emit(Op::PUSH);
+                return;
+            }
+            for (; statement->next; statement = statement->next.get()) {
+                compileStatement(statement);
+            }
+            // 最後の式文の値が全体の値になる
+            if (statement->nodeType == NodeType::EXPRESSION_STATEMENT) {
+                compileExpression(statement->left.get());
+            } else {
+                compileStatement(statement);
+                emit(Op::PUSH);
+            }
+            return;
+        }
+        case NodeType::COMMA:
+            compileExpression(node->left.get());
+            emit(Op::POP);
+            compileExpression(node->right.get());
+            return;
+        case NodeType::CAST:
+            compileExpression(node->left.get());
+            if (type::is(node->type, TypeKind::VOID)) {
+                return;
+            }
+            if (type::is(node->type, TypeKind::BOOL)) {
+                emit(Op::TO_BOOL, valueTypeOf(node->left->type.get()));
+                return;
+            }
+            emit(Op::CAST, valueTypeOf(node->left->type.get()), valueTypeOf(node->type.get()));
+            return;
+        case NodeType::MEMORY_CLEAR:
+            emit(Op::MEMORY_CLEAR, ValueType::U64, ValueType::U64, node->variable->offset, node->variable->type->size);
+            emit(Op::PUSH);
+            return;
+        case NodeType::FUNCTION_CALL:
+            compileCall(node);
+            return;
+        case NodeType::CONDITIONAL: {
+            auto elseLabel = newLabel();
+            auto endLabel = newLabel();
+            compileCondition(node->condition.get(), true, elseLabel);
+            compileExpression(node->then.get());
+            emitJump(Op::JUMP, ValueType::U64, endLabel);
+            defineLabel(elseLabel);
+            compileExpression(node->els.get());
+            defineLabel(endLabel);
+            return;
+        }
+        case NodeType::NOT:
+            compileExpression(node->left.get());
+            emit(Op::NOT, valueTypeOf(node->left->type.get()));
+            return;
+        case NodeType::BIT_NOT:
+            compileExpression(node->left.get());
+            emit(Op::BIT_NOT, valueTypeOf(node->type.get()));
+            return;
+        case NodeType::LOGICAL_AND:
+        case NodeType::LOGICAL_OR: {
+            bool isAnd = node->nodeType == NodeType::LOGICAL_AND;
+            auto shortCircuitLabel = newLabel();
+            auto endLabel = newLabel();
+            compileCondition(node->left.get(), isAnd, shortCircuitLabel);
+            compileCondition(node->right.get(), isAnd, shortCircuitLabel);
+            emit(Op::PUSH, ValueType::I64, ValueType::I64, isAnd ? 1 : 0);
+            emitJump(Op::JUMP, ValueType::U64, endLabel);
+            defineLabel(shortCircuitLabel);
+            emit(Op::PUSH, ValueType::I64, ValueType::I64, isAnd ? 0 : 1);
+            defineLabel(endLabel);
+            return;
+        }
+        default:
+            break;
+    }
+
+    // 二項演算: 右辺、左辺の順に評価し、スタックの先頭が左辺になる
+    compileExpression(node->right.get());
+    compileExpression(node->left.get());
+
+    ValueType type;
+    if (type::isFloat(node->left->type.get())) {
+        type = valueTypeOf(node->left->type.get());
+    } else {
+        switch (node->nodeType) {
+            case NodeType::LESS:
+            case NodeType::LESS_EQUAL:
+            case NodeType::SHR:
+                type = integerOperationType(node, node->left->type->isUnsigned);
+                break;
+            default:
+                type = integerOperationType(node, node->type->isUnsigned);
+                break;
+        }
+    }
+
+    switch (node->nodeType) {
+        case NodeType::ADD:
+            emit(Op::ADD, type);
+            return;
+        case NodeType::SUB:
+            emit(Op::SUB, type);
+            return;
+        case NodeType::MUL:
+            emit(Op::MUL, type);
+            return;
+        case NodeType::DIV:
+            emit(Op::DIV, type);
+            return;
+        case NodeType::MOD:
+            emit(Op::MOD, type);
+            return;
+        case NodeType::BIT_AND:
+            emit(Op::BIT_AND, type);
+            return;
+        case NodeType::BIT_OR:
+            emit(Op::BIT_OR, type);
+            return;
+        case NodeType::BIT_XOR:
+            emit(Op::BIT_XOR, type);
+            return;
+        case NodeType::SHL:
+            emit(Op::SHL, type);
+            return;
+        case NodeType::SHR:
+            emit(Op::SHR, type);
+            return;
+        case NodeType::EQUAL:
+            emit(Op::EQUAL, type);
+            return;
+        case NodeType::NOT_EQUAL:
+            emit(Op::NOT_EQUAL, type);
+            return;
+        case NodeType::LESS:
+            emit(Op::LESS, type);
+            return;
+        case NodeType::LESS_EQUAL:
+            emit(Op::LESS_EQUAL, type);
+            return;
+        default:
+            break;
+    }
+
+    Log::error("Invalid expression"sv, node->token);
+}
+
+} // namespace yoctocc::interpreter
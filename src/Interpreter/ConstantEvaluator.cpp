@@ -0,0 +1,48 @@
+#include "Interpreter/ConstantEvaluator.hpp"
+
+#include <format>
+#include <vector>
+#include "Interpreter/Interpreter.hpp"
+#include "Logger.hpp"
+#include "Node/Node.hpp"
+#include "Type.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+// 無限ループや深すぎる再帰でコンパイルが止まらないようにする
+constexpr uint64_t MAX_STEPS = 10'000'000;
+constexpr int MAX_DEPTH = 1000;
+} // namespace
+
+namespace yoctocc::interpreter {
+
+uint64_t evaluateConstantCall(const Node* node, std::span<const uint64_t> args) {
+    const Object* fn = node->variable;
+    if (!fn || !fn->body) {
+        Log::error(std::format("{} must be defined before use in a constant expression", node->functionName),
+                   node->token);
+    }
+
+    BytecodeCompiler compiler{
+        [node](const Object* variable) -> void* {
+            Log::error(std::format("{} cannot be used in a constant expression", variable->name), node->token);
+            return nullptr;
+        },
+        [node](const std::string& name) -> void* {
+            Log::error(std::format("{} cannot be called in a constant expression", name), node->token);
+            return nullptr;
+        },
+    };
+
+    std::vector<ValueType> types;
+    for (const Node* arg = node->arguments.get(); arg; arg = arg->next.get()) {
+        types.emplace_back(valueTypeOf(arg->type.get()));
+    }
+
+    // 評価はコンパイラ自身のメモリで行うので、関数のフレームの外に触れたら止める
+    Interpreter interpreter{compiler.compileReachable(fn), ExecutionLimits{MAX_STEPS, MAX_DEPTH, true}};
+    return interpreter.call(0, args, types);
+}
+
+} // namespace yoctocc::interpreter
@@ -0,0 +1,727 @@
+#include "Interpreter/Interpreter.hpp"
+
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include "CallingConvention.hpp"
+#include "Logger.hpp"
+#include "Node/Node.hpp"
+#include "Type.hpp"
+#include "Utility.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::interpreter;
+
+constexpr int GP_REGISTER_COUNT = abi::INTEGER_ARGUMENT_REGISTERS;
+constexpr int FP_REGISTER_COUNT = abi::FLOAT_ARGUMENT_REGISTERS;
+// ホスト関数にスタックで渡せる引数の 8 バイト単位の数
+constexpr size_t STACK_ARGUMENT_WORDS = 16;
+
+bool isFloat(ValueType type) {
+    return type == ValueType::F32 || type == ValueType::F64;
+}
+
+bool is64(ValueType type) {
+    return type == ValueType::I64 || type == ValueType::U64;
+}
+
+bool isSigned(ValueType type) {
+    return type == ValueType::I8 || type == ValueType::I16 || type == ValueType::I32 || type == ValueType::I64;
+}
+
+float toFloat(uint64_t value) {
+    return std::bit_cast<float>(static_cast<uint32_t>(value));
+}
+
+double toDouble(uint64_t value) {
+    return std::bit_cast<double>(value);
+}
+
+uint64_t fromFloat(float value) {
+    return std::bit_cast<uint32_t>(value);
+}
+
+uint64_t fromDouble(double value) {
+    return std::bit_cast<uint64_t>(value);
+}
+
+// 型に合わせて符号拡張/ゼロ拡張した値にする
+uint64_t canonical(ValueType type, uint64_t value) {
+    switch (type) {
+        case ValueType::I8:
+            return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int8_t>(value)));
+        case ValueType::U8:
+            return static_cast<uint8_t>(value);
+        case ValueType::I16:
+            return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int16_t>(value)));
+        case ValueType::U16:
+            return static_cast<uint16_t>(value);
+        case ValueType::I32:
+            return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(value)));
+        case ValueType::U32:
+        case ValueType::F32:
+            return static_cast<uint32_t>(value);
+        case ValueType::I64:
+        case ValueType::U64:
+        case ValueType::F64:
+            return value;
+    }
+    std::unreachable();
+}
+
+bool isZero(ValueType type, uint64_t value) {
+    switch (type) {
+        case ValueType::F32:
+            return toFloat(value) == 0.0f;
+        case ValueType::F64:
+            return toDouble(value) == 0.0;
+        default:
+            return value == 0;
+    }
+}
+
+// cvttss2si / cvttsd2si と同じく、範囲外や NaN は最小値になる
+template <typename T>
+int64_t truncate(double value) {
+    if (std::isnan(value) || value < static_cast<double>(std::numeric_limits<T>::min()) ||
+        value >= -static_cast<double>(std::numeric_limits<T>::min())) {
+        return std::numeric_limits<T>::min();
+    }
+    return static_cast<T>(value);
+}
+
+// castTable と同じ変換
+uint64_t cast(ValueType from, ValueType to, uint64_t value) {
+    if (isFloat(from)) {
+        double source = from == ValueType::F32 ? toFloat(value) : toDouble(value);
+        switch (to) {
+            case ValueType::F32:
+                return fromFloat(static_cast<float>(source));
+            case ValueType::F64:
+                return fromDouble(source);
+            case ValueType::I8:
+            case ValueType::U8:
+            case ValueType::I16:
+            case ValueType::U16:
+            case ValueType::I32:
+                return canonical(to, static_cast<uint64_t>(truncate<int32_t>(source)));
+            default:
+                return canonical(to, static_cast<uint64_t>(truncate<int64_t>(source)));
+        }
+    }
+
+    if (to == ValueType::F32) {
+        // u64 → f32 は符号付きとして変換する (cvtsi2ss rax)
+        return fromFloat(static_cast<float>(static_cast<int64_t>(value)));
+    }
+    if (to == ValueType::F64) {
+        if (from == ValueType::U64) {
+            return fromDouble(static_cast<double>(value));
+        }
+        return fromDouble(static_cast<double>(static_cast<int64_t>(value)));
+    }
+    return canonical(to, value);
+}
+
+uint64_t compare(Op op, ValueType type, uint64_t a, uint64_t b) {
+    auto test = [op](auto x, auto y) -> uint64_t {
+        switch (op) {
+            case Op::EQUAL:
+                return x == y;
+            case Op::NOT_EQUAL:
+                return x != y;
+            case Op::LESS:
+                return x < y;
+            case Op::LESS_EQUAL:
+                return x <= y;
+            default:
+                std::unreachable();
+        }
+    };
+    switch (type) {
+        case ValueType::F32:
+            return test(toFloat(a), toFloat(b));
+        case ValueType::F64:
+            return test(toDouble(a), toDouble(b));
+        case ValueType::I32:
+            return test(static_cast<int32_t>(a), static_cast<int32_t>(b));
+        case ValueType::U32:
+            return test(static_cast<uint32_t>(a), static_cast<uint32_t>(b));
+        case ValueType::I64:
+            return test(static_cast<int64_t>(a), static_cast<int64_t>(b));
+        default:
+            return test(a, b);
+    }
+}
+
+uint64_t floatArithmetic(Op op, ValueType type, uint64_t a, uint64_t b) {
+    auto apply = [op](auto x, auto y) {
+        switch (op) {
+            case Op::ADD:
+                return x + y;
+            case Op::SUB:
+                return x - y;
+            case Op::MUL:
+                return x * y;
+            case Op::DIV:
+                return x / y;
+            default:
+                Log::error("interpreter: invalid floating point operation"sv);
+                std::unreachable();
+        }
+    };
+    if (type == ValueType::F32) {
+        return fromFloat(apply(toFloat(a), toFloat(b)));
+    }
+    return fromDouble(apply(toDouble(a), toDouble(b)));
+}
+
+uint64_t integerArithmetic(Op op, ValueType type, uint64_t a, uint64_t b) {
+    const bool wide = is64(type);
+    const int shiftMask = wide ? 63 : 31;
+
+    switch (op) {
+        case Op::ADD:
+            return canonical(type, a + b);
+        case Op::SUB:
+            return canonical(type, a - b);
+        case Op::MUL:
+            return canonical(type, a * b);
+        case Op::BIT_AND:
+            return canonical(type, a & b);
+        case Op::BIT_OR:
+            return canonical(type, a | b);
+        case Op::BIT_XOR:
+            return canonical(type, a ^ b);
+        case Op::SHL:
+            return canonical(type, a << (b & shiftMask));
+        case Op::SHR:
+            if (isSigned(type)) {
+                if (wide) {
+                    return static_cast<uint64_t>(static_cast<int64_t>(a) >> (b & shiftMask));
+                }
+                return canonical(type, static_cast<uint64_t>(static_cast<int32_t>(a) >> (b & shiftMask)));
+            }
+            if (wide) {
+                return a >> (b & shiftMask);
+            }
+            return canonical(type, static_cast<uint32_t>(a) >> (b & shiftMask));
+        case Op::DIV:
+        case Op::MOD: {
+            if (canonical(type, b) == 0) {
+                Log::error("interpreter: division by zero"sv);
+            }
+            const bool isDiv = op == Op::DIV;
+            if (!isSigned(type)) {
+                if (wide) {
+                    return isDiv ? a / b : a % b;
+                }
+                auto x = static_cast<uint32_t>(a);
+                auto y = static_cast<uint32_t>(b);
+                return isDiv ? x / y : x % y;
+            }
+            if (wide) {
+                auto x = static_cast<int64_t>(a);
+                auto y = static_cast<int64_t>(b);
+                if (x == INT64_MIN && y == -1) {
+                    Log::error("interpreter: integer overflow in division"sv);
+                }
+                return static_cast<uint64_t>(isDiv ? x / y : x % y);
+            }
+            auto x = static_cast<int32_t>(a);
+            auto y = static_cast<int32_t>(b);
+            if (x == INT32_MIN && y == -1) {
+                Log::error("interpreter: integer overflow in division"sv);
+            }
+            return canonical(type, static_cast<uint64_t>(static_cast<int64_t>(isDiv ? x / y : x % y)));
+        }
+        default:
+            break;
+    }
+    Log::error("interpreter: invalid integer operation"sv);
+    std::unreachable();
+}
+
+size_t sizeOf(ValueType type) {
+    switch (type) {
+        case ValueType::I8:
+        case ValueType::U8:
+            return 1;
+        case ValueType::I16:
+        case ValueType::U16:
+            return 2;
+        case ValueType::I32:
+        case ValueType::U32:
+        case ValueType::F32:
+            return 4;
+        default:
+            return 8;
+    }
+}
+
+uint64_t load(ValueType type, const std::byte* address) {
+    switch (type) {
+        case ValueType::I8:
+        case ValueType::U8: {
+            uint8_t v;
+            std::memcpy(&v, address, sizeof(v));
+            return canonical(type, v);
+        }
+        case ValueType::I16:
+        case ValueType::U16: {
+            uint16_t v;
+            std::memcpy(&v, address, sizeof(v));
+            return canonical(type, v);
+        }
+        case ValueType::I32:
+        case ValueType::U32:
+        case ValueType::F32: {
+            uint32_t v;
+            std::memcpy(&v, address, sizeof(v));
+            return canonical(type, v);
+        }
+        default: {
+            uint64_t v;
+            std::memcpy(&v, address, sizeof(v));
+            return v;
+        }
+    }
+}
+
+void store(ValueType type, std::byte* address, uint64_t value) {
+    switch (type) {
+        case ValueType::I8:
+        case ValueType::U8: {
+            auto v = static_cast<uint8_t>(value);
+            std::memcpy(address, &v, sizeof(v));
+            return;
+        }
+        case ValueType::I16:
+        case ValueType::U16: {
+            auto v = static_cast<uint16_t>(value);
+            std::memcpy(address, &v, sizeof(v));
+            return;
+        }
+        case ValueType::I32:
+        case ValueType::U32:
+        case ValueType::F32: {
+            auto v = static_cast<uint32_t>(value);
+            std::memcpy(address, &v, sizeof(v));
+            return;
+        }
+        default:
+            std::memcpy(address, &value, sizeof(value));
+            return;
+    }
+}
+
+std::byte* toPointer(uint64_t value) {
+    return reinterpret_cast<std::byte*>(static_cast<uintptr_t>(value));
+}
+
+// 引数の型からストアに使う ValueType を決める
+ValueType storeTypeOf(const Type* type) {
+    if (type::isFloat(type)) {
+        return valueTypeOf(type);
+    }
+    switch (type->size) {
+        case 1:
+            return ValueType::U8;
+        case 2:
+            return ValueType::U16;
+        case 4:
+            return ValueType::U32;
+        default:
+            return ValueType::U64;
+    }
+}
+
+} // namespace
+
+namespace yoctocc::interpreter {
+
+Interpreter::Interpreter(Object* program, const runtime::HostLibrary& host) : _host(&host) {
+    assert(program);
+    allocateGlobals(program);
+
+    BytecodeCompiler compiler{
+        [this](const Object* variable) {
+            return globalAddress(variable);
+        },
+        [this](const std::string& name) {
+            return _host->resolve(name);
+        },
+    };
+    _program = compiler.compile(program);
+}
+
+Interpreter::Interpreter(Program program, ExecutionLimits limits) : _limits(limits), _program(std::move(program)) {
+}
+
+std::byte* Interpreter::allocate(size_t size, size_t alignment) {
+    alignment = std::max<size_t>(alignment, 1);
+    auto& block = _memory.emplace_back(std::make_unique<std::byte[]>(size + alignment));
+    auto address = reinterpret_cast<uintptr_t>(block.get());
+    return reinterpret_cast<std::byte*>(alignTo(address, alignment));
+}
+
+void Interpreter::allocateGlobals(Object* program) {
+    for (Object* var = program; var; var = var->next.get()) {
+        if (var->isFunction || !var->isDefinition) {
+            continue;
+        }
+        auto size = static_cast<size_t>(std::max(var->type->size, 1));
+        std::byte* address = allocate(size, var->alignment);
+        std::memset(address, 0, size);
+        if (!var->initialData.empty()) {
+            std::memcpy(address, var->initialData.data(), var->initialData.size());
+        }
+        _globals[var->name] = address;
+    }
+
+    // 他のグローバル変数を指すポインタの初期値を埋める
+    for (Object* var = program; var; var = var->next.get()) {
+        if (var->isFunction || !var->isDefinition) {
+            continue;
+        }
+        auto* base = static_cast<std::byte*>(_globals.at(var->name));
+        for (auto* relocation = var->relocations.get(); relocation; relocation = relocation->next.get()) {
+            auto it = _globals.find(relocation->label);
+            void* target = it != _globals.end() ? it->second : _host->resolve(relocation->label);
+            uint64_t value = reinterpret_cast<uintptr_t>(target) + relocation->addend;
+            std::memcpy(base + relocation->offset, &value, sizeof(value));
+        }
+    }
+}
+
+void* Interpreter::globalAddress(const Object* variable) {
+    if (auto it = _globals.find(variable->name); it != _globals.end()) {
+        return it->second;
+    }
+    // extern 宣言だけの変数はホストから探す
+    void* address = _host->resolve(variable->name);
+    _globals.emplace(variable->name, address);
+    return address;
+}
+
+void Interpreter::checkAccess(const Object* fn, uint64_t address, size_t size) const {
+    if (!_limits.checksMemory) {
+        return;
+    }
+    for (const auto& [begin, end] : _frames) {
+        if (address >= begin && address <= end && size <= end - address) {
+            return;
+        }
+    }
+    Log::error(std::format("interpreter: {} accesses memory outside its local variables in a constant expression",
+                           fn->name));
+}
+
+uint64_t Interpreter::call(int function, std::span<const uint64_t> args, std::span<const ValueType> types) {
+    return execute(_program.functions.at(function), args, types);
+}
+
+int Interpreter::run(const std::string& programName) {
+    auto it = _program.functionIndices.find("main");
+    if (it == _program.functionIndices.end()) {
+        Log::error("interpreter: main is not defined"sv);
+    }
+    const auto& main = _program.functions[it->second];
+
+    std::string name = programName;
+    char* argv[] = {name.data(), nullptr};
+    const uint64_t args[] = {1, reinterpret_cast<uintptr_t>(argv)};
+    const ValueType types[] = {ValueType::I32, ValueType::U64};
+
+    size_t count = 0;
+    for (auto* param = main.object->parameters; param; param = param->next.get()) {
+        count++;
+    }
+    count = std::min<size_t>(count, std::size(args));
+
+    auto result = static_cast<int>(execute(main, std::span{args, count}, std::span{types, count}));
+    std::fflush(stdout);
+    std::fflush(stderr);
+    return result;
+}
+
+uint64_t Interpreter::callHost(const CallSite& callSite, std::span<const uint64_t> args) {
+    // 引数は System V ABI に従って rdi..r9・xmm0..xmm7 とスタックに分ける。
+    // レジスタの分を埋めた後ろに並べた値は、可変長引数として呼び出すとそのままスタックに積まれる。
+    // al にはベクタレジスタの数が入るので printf なども呼べる。
+    std::array<uint64_t, GP_REGISTER_COUNT> gp{};
+    std::array<double, FP_REGISTER_COUNT> fp{};
+    std::array<uint64_t, STACK_ARGUMENT_WORDS> stack{};
+    const auto layout = abi::layoutArguments(callSite.argumentTypes);
+    if (static_cast<size_t>(layout.stackSize) > sizeof(stack)) {
+        Log::error(std::format("interpreter: too many arguments to {}", callSite.name));
+    }
+    for (size_t i = 0; i < args.size(); i++) {
+        const Type* type = callSite.argumentTypes[i];
+        const auto& location = layout.arguments[i];
+        // 構造体はアドレスから中身を読む
+        const bool isAggregate = type::is(type, TypeKind::STRUCT) || type::is(type, TypeKind::UNION);
+        const void* value = isAggregate ? static_cast<const void*>(toPointer(args[i])) : &args[i];
+        if (location.onStack) {
+            std::memcpy(reinterpret_cast<std::byte*>(stack.data()) + location.stackOffset, value,
+                        isAggregate ? static_cast<size_t>(type->size) : sizeof(uint64_t));
+            continue;
+        }
+        for (int e = 0; e < location.eightbytes; e++) {
+            uint64_t word = 0;
+            std::memcpy(&word, static_cast<const std::byte*>(value) + e * 8,
+                        isAggregate ? static_cast<size_t>(abi::eightbyteSize(type, e)) : sizeof(uint64_t));
+            if (location.classes[e] == abi::ArgumentClass::SSE) {
+                fp[location.registers[e]] = std::bit_cast<double>(word);
+            } else {
+                gp[location.registers[e]] = word;
+            }
+        }
+    }
+
+#define HOST_ARGUMENTS                                                                                         \
+    gp[0], gp[1], gp[2], gp[3], gp[4], gp[5], fp[0], fp[1], fp[2], fp[3], fp[4], fp[5], fp[6], fp[7], stack[0],    \
+        stack[1], stack[2], stack[3], stack[4], stack[5], stack[6], stack[7], stack[8], stack[9], stack[10],       \
+        stack[11], stack[12], stack[13], stack[14], stack[15]
+    const Type* returnType = callSite.returnType;
+    if (returnType && returnType->kind == TypeKind::FLOAT) {
+        auto fn = reinterpret_cast<float (*)(...)>(callSite.host);
+        return fromFloat(fn(HOST_ARGUMENTS));
+    }
+    if (returnType && returnType->kind == TypeKind::DOUBLE) {
+        auto fn = reinterpret_cast<double (*)(...)>(callSite.host);
+        return fromDouble(fn(HOST_ARGUMENTS));
+    }
+    auto fn = reinterpret_cast<uint64_t (*)(...)>(callSite.host);
+    uint64_t result = fn(HOST_ARGUMENTS);
+#undef HOST_ARGUMENTS
+
+    if (!returnType) {
+        return 0;
+    }
+    if (returnType->kind == TypeKind::BOOL) {
+        return static_cast<uint8_t>(result);
+    }
+    if (type::isInteger(returnType)) {
+        return canonical(valueTypeOf(returnType), result);
+    }
+    return result;
+}
+
+uint64_t Interpreter::execute(const Function& function, std::span<const uint64_t> args,
+                              std::span<const ValueType> types, std::byte* returnSlot) {
+    const Object* fn = function.object;
+    if (_limits.maxDepth > 0 && _depth >= _limits.maxDepth) {
+        Log::error(std::format("interpreter: call depth limit ({}) exceeded in {}", _limits.maxDepth, fn->name));
+    }
+    _depth++;
+
+    auto frame = std::make_unique<std::byte[]>(function.frameSize + 16);
+    std::byte* frameEnd =
+        reinterpret_cast<std::byte*>(alignTo(reinterpret_cast<uintptr_t>(frame.get()), 16)) + function.frameSize;
+    if (_limits.checksMemory) {
+        _frames.emplace_back(reinterpret_cast<uintptr_t>(frameEnd) - function.frameSize,
+                             reinterpret_cast<uintptr_t>(frameEnd));
+    }
+
+    // 引数をローカル変数に格納する
+    size_t index = 0;
+    int namedGp = 0;
+    int namedFp = 0;
+    for (const Object* param = fn->parameters; param; param = param->next.get(), index++) {
+        if (type::isFloat(param->type.get())) {
+            namedFp++;
+        } else {
+            namedGp++;
+        }
+        if (index >= args.size()) {
+            continue;
+        }
+        if (type::is(param->type, TypeKind::STRUCT) || type::is(param->type, TypeKind::UNION)) {
+            // 構造体は呼び出し元のアドレスから写す
+            std::memcpy(frameEnd + param->offset, toPointer(args[index]), static_cast<size_t>(param->type->size));
+        } else {
+            store(storeTypeOf(param->type.get()), frameEnd + param->offset, args[index]);
+        }
+    }
+
+    // Generator と同じレイアウトで __va_area__ を作る。
+    // レジスタに入らない名前のない引数は、呼び出し元のスタックの代わりに overflow に 8 バイトずつ並べる
+    std::vector<uint64_t> overflow;
+    if (fn->vaArea) {
+        std::byte* area = frameEnd + fn->vaArea->offset;
+        store(ValueType::U32, area, namedGp * 8);
+        store(ValueType::U32, area + 4, namedFp * 16 + 48);
+        store(ValueType::U64, area + 16, reinterpret_cast<uintptr_t>(area + 24));
+        int gp = 0;
+        int fp = 0;
+        for (size_t i = 0; i < args.size(); i++) {
+            const bool isVariadic = i >= index;
+            if (isFloat(types[i])) {
+                if (fp < FP_REGISTER_COUNT) {
+                    store(ValueType::U64, area + 72 + fp++ * 16, args[i]);
+                } else if (isVariadic) {
+                    overflow.emplace_back(args[i]);
+                }
+            } else if (gp < GP_REGISTER_COUNT) {
+                store(ValueType::U64, area + 24 + gp++ * 8, args[i]);
+            } else if (isVariadic) {
+                overflow.emplace_back(args[i]);
+            }
+        }
+        store(ValueType::U64, area + 8, reinterpret_cast<uintptr_t>(overflow.data()));
+    }
+
+    std::vector<uint64_t> stack;
+    stack.reserve(32);
+    auto pop = [&stack] {
+        uint64_t value = stack.back();
+        stack.pop_back();
+        return value;
+    };
+
+    const auto& code = function.code;
+    size_t pc = 0;
+    while (true) {
+        if (_limits.maxSteps > 0 && ++_steps > _limits.maxSteps) {
+            Log::error(std::format("interpreter: step limit ({}) exceeded in {}", _limits.maxSteps, fn->name));
+        }
+        const Instruction& in = code[pc++];
+        switch (in.op) {
+            case Op::PUSH:
+                stack.push_back(static_cast<uint64_t>(in.imm));
+                break;
+            case Op::LOCAL_ADDRESS:
+                stack.push_back(reinterpret_cast<uintptr_t>(frameEnd + in.imm));
+                break;
+            case Op::LOAD:
+                checkAccess(fn, stack.back(), sizeOf(in.type));
+                stack.back() = load(in.type, toPointer(stack.back()));
+                break;
+            case Op::STORE: {
+                uint64_t value = pop();
+                checkAccess(fn, stack.back(), sizeOf(in.type));
+                store(in.type, toPointer(pop()), value);
+                stack.push_back(value);
+                break;
+            }
+            case Op::STORE_BLOCK: {
+                uint64_t source = pop();
+                checkAccess(fn, source, static_cast<size_t>(in.imm));
+                checkAccess(fn, stack.back(), static_cast<size_t>(in.imm));
+                std::memmove(toPointer(pop()), toPointer(source), static_cast<size_t>(in.imm));
+                stack.push_back(source);
+                break;
+            }
+            case Op::MEMORY_CLEAR:
+                std::memset(frameEnd + in.imm, 0, static_cast<size_t>(in.imm2));
+                break;
+            case Op::POP:
+                stack.pop_back();
+                break;
+            case Op::ADD:
+            case Op::SUB:
+            case Op::MUL:
+            case Op::DIV:
+            case Op::MOD:
+            case Op::BIT_AND:
+            case Op::BIT_OR:
+            case Op::BIT_XOR:
+            case Op::SHL:
+            case Op::SHR: {
+                uint64_t a = pop();
+                uint64_t b = pop();
+                stack.push_back(isFloat(in.type) ? floatArithmetic(in.op, in.type, a, b)
+                                                 : integerArithmetic(in.op, in.type, a, b));
+                break;
+            }
+            case Op::EQUAL:
+            case Op::NOT_EQUAL:
+            case Op::LESS:
+            case Op::LESS_EQUAL: {
+                uint64_t a = pop();
+                uint64_t b = pop();
+                stack.push_back(compare(in.op, in.type, a, b));
+                break;
+            }
+            case Op::NEGATE:
+                if (in.type == ValueType::F32) {
+                    stack.back() = fromFloat(-toFloat(stack.back()));
+                } else if (in.type == ValueType::F64) {
+                    stack.back() = fromDouble(-toDouble(stack.back()));
+                } else {
+                    stack.back() = canonical(in.type, 0 - stack.back());
+                }
+                break;
+            case Op::BIT_NOT:
+                stack.back() = canonical(in.type, ~stack.back());
+                break;
+            case Op::NOT:
+                stack.back() = isZero(in.type, stack.back()) ? 1 : 0;
+                break;
+            case Op::TO_BOOL:
+                stack.back() = isZero(in.type, stack.back()) ? 0 : 1;
+                break;
+            case Op::CAST:
+                stack.back() = cast(in.type, in.type2, stack.back());
+                break;
+            case Op::JUMP:
+                pc = static_cast<size_t>(in.imm);
+                break;
+            case Op::JUMP_IF_ZERO:
+                if (isZero(in.type, pop())) {
+                    pc = static_cast<size_t>(in.imm);
+                }
+                break;
+            case Op::JUMP_IF_NOT_ZERO:
+                if (!isZero(in.type, pop())) {
+                    pc = static_cast<size_t>(in.imm);
+                }
+                break;
+            case Op::JUMP_IF_EQUAL:
+                if (compare(Op::EQUAL, in.type, stack.back(), static_cast<uint64_t>(in.imm))) {
+                    stack.pop_back();
+                    pc = static_cast<size_t>(in.imm2);
+                }
+                break;
+            case Op::CALL: {
+                const CallSite& callSite = _program.callSites[in.imm];
+                const size_t count = callSite.arguments.size();
+                // 第1引数がスタックの先頭にある
+                std::vector<uint64_t> callArgs(stack.rbegin(), stack.rbegin() + count);
+                stack.resize(stack.size() - count);
+                if (callSite.function >= 0) {
+                    std::byte* returnSlot = callSite.returnSlot != 0 ? frameEnd + callSite.returnSlot : nullptr;
+                    stack.push_back(
+                        execute(_program.functions[callSite.function], callArgs, callSite.arguments, returnSlot));
+                } else {
+                    stack.push_back(callHost(callSite, callArgs));
+                }
+                break;
+            }
+            case Op::RETURN: {
+                uint64_t value = pop();
+                // このフレームは戻ると解放されるので、構造体は呼び出し元の領域へ写す
+                // (return のないまま末尾に達したときは写すものがない)
+                if (returnSlot && value != 0) {
+                    checkAccess(fn, value, static_cast<size_t>(fn->type->returnType->size));
+                    std::memcpy(returnSlot, toPointer(value), static_cast<size_t>(fn->type->returnType->size));
+                    value = reinterpret_cast<uintptr_t>(returnSlot);
+                }
+                if (_limits.checksMemory) {
+                    _frames.pop_back();
+                }
+                _depth--;
+                return value;
+            }
+        }
+    }
+}
+
+} // namespace yoctocc::interpreter
@@ -0,0 +1,1011 @@
+#include "Jit/Encoder.hpp"
+
+#include <bit>
+#include <charconv>
+#include <format>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include "Assembly/Assembly.hpp"
+#include "Logger.hpp"
+#include "String/String.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+using namespace yoctocc;
+
+struct RegisterInfo {
+    // ModRM / REX に入れるレジスタ番号 (0-15)
+    int number;
+    int size;
+    bool isXmm;
+    // spl/bpl/sil/dil は REX プレフィックスがないと ah/ch/dh/bh になってしまう
+    bool forceRex;
+};
+
+// Register の宣言順 (rax, rbx, rcx, rdx, rsi, rdi, rbp, rsp, r8...) からハードウェアの番号への変換
+constexpr std::array<int, 16> HARDWARE_NUMBERS = {0, 3, 1, 2, 6, 7, 5, 4, 8, 9, 10, 11, 12, 13, 14, 15};
+
+const std::unordered_map<std::string, RegisterInfo>& registerTable() {
+    static const auto table = [] {
+        std::unordered_map<std::string, RegisterInfo> table;
+        using enum Register;
+        for (int i = 0; i < 8; i++) {
+            table.emplace(to_string(static_cast<Register>(std::to_underlying(XMM0) + i)), RegisterInfo{i, 16, true, false});
+        }
+        const std::array<std::pair<Register, int>, 4> groups = {{{RAX, 8}, {EAX, 4}, {AX, 2}, {AL, 1}}};
+        for (const auto& [first, size] : groups) {
+            for (int i = 0; i < 16; i++) {
+                auto reg = static_cast<Register>(std::to_underlying(first) + i);
+                int number = HARDWARE_NUMBERS[i];
+                bool forceRex = size == 1 && number >= 4 && number < 8;
+                table.emplace(to_string(reg), RegisterInfo{number, size, false, forceRex});
+            }
+        }
+        return table;
+    }();
+    return table;
+}
+
+std::string_view trim(std::string_view sv) {
+    while (!sv.empty() && (sv.front() == ' ' || sv.front() == '\t')) {
+        sv.remove_prefix(1);
+    }
+    while (!sv.empty() && (sv.back() == ' ' || sv.back() == '\t')) {
+        sv.remove_suffix(1);
+    }
+    return sv;
+}
+
+std::optional<int64_t> parseInteger(std::string_view sv) {
+    if (sv.empty()) {
+        return std::nullopt;
+    }
+    if (sv.front() == '-') {
+        int64_t value = 0;
+        auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value);
+        if (ec != std::errc{} || ptr != sv.data() + sv.size()) {
+            return std::nullopt;
+        }
+        return value;
+    }
+    // 符号なし 64 ビットの即値 (mov rax, <double のビット列> など) も受け付ける
+    uint64_t value = 0;
+    auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value);
+    if (ec != std::errc{} || ptr != sv.data() + sv.size()) {
+        return std::nullopt;
+    }
+    return std::bit_cast<int64_t>(value);
+}
+
+bool fitsInt8(int64_t value) {
+    return value >= INT8_MIN && value <= INT8_MAX;
+}
+
+bool fitsInt32(int64_t value) {
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+bool isNumericLabel(std::string_view name) {
+    return isNumberString(name);
+}
+
+// ALU 命令 (/digit と opcode の基準値)
+const std::unordered_map<std::string_view, int> ALU_EXTENSIONS = {
+    {"add"sv, 0},
+    {"addq"sv, 0},
+    {"or"sv, 1},
+    {"and"sv, 4},
+    {"sub"sv, 5},
+    {"xor"sv, 6},
+    {"cmp"sv, 7},
+};
+
+// F7 /digit の単項演算
+const std::unordered_map<std::string_view, int> UNARY_EXTENSIONS = {
+    {"not"sv, 2},
+    {"neg"sv, 3},
+    {"mul"sv, 4},
+    {"div"sv, 6},
+    {"idiv"sv, 7},
+};
+
+const std::unordered_map<std::string_view, int> SHIFT_EXTENSIONS = {
+    {"shl"sv, 4},
+    {"shr"sv, 5},
+    {"sar"sv, 7},
+};
+
+const std::unordered_map<std::string_view, uint8_t> SETCC_OPCODES = {
+    {"seto"sv, 0x90},
+    {"setb"sv, 0x92},
+    {"setae"sv, 0x93},
+    {"sete"sv, 0x94},
+    {"setne"sv, 0x95},
+    {"setbe"sv, 0x96},
+    {"seta"sv, 0x97},
+    {"sets"sv, 0x98},
+    {"setp"sv, 0x9A},
+    {"setnp"sv, 0x9B},
+    {"setl"sv, 0x9C},
+    {"setge"sv, 0x9D},
+    {"setle"sv, 0x9E},
+    {"setg"sv, 0x9F},
+};
+
+const std::unordered_map<std::string_view, uint8_t> JCC_OPCODES = {
+    {"jb"sv, 0x82},
+    {"jae"sv, 0x83},
+    {"je"sv, 0x84},
+    {"jne"sv, 0x85},
+    {"jbe"sv, 0x86},
+    {"ja"sv, 0x87},
+    {"js"sv, 0x88},
+    {"jp"sv, 0x8A},
+    {"jnp"sv, 0x8B},
+    {"jl"sv, 0x8C},
+    {"jge"sv, 0x8D},
+    {"jle"sv, 0x8E},
+    {"jg"sv, 0x8F},
+};
+
+struct SseOpCode {
+    // 0 ならプレフィックスなし
+    uint8_t prefix;
+    uint8_t opcode;
+};
+
+// xmm, xmm/m 形式の SSE 命令 (0F xx /r)
+const std::unordered_map<std::string_view, SseOpCode> SSE_OPCODES = {
+    {"cvtsd2ss"sv, {0xF2, 0x5A}},
+    {"cvtss2sd"sv, {0xF3, 0x5A}},
+    {"cvtsi2sd"sv, {0xF2, 0x2A}},
+    {"cvtsi2ss"sv, {0xF3, 0x2A}},
+    {"cvttsd2si"sv, {0xF2, 0x2C}},
+    {"cvttss2si"sv, {0xF3, 0x2C}},
+    {"pxor"sv, {0x66, 0xEF}},
+    {"ucomiss"sv, {0x00, 0x2E}},
+    {"ucomisd"sv, {0x66, 0x2E}},
+    {"xorps"sv, {0x00, 0x57}},
+    {"xorpd"sv, {0x66, 0x57}},
+    {"addss"sv, {0xF3, 0x58}},
+    {"addsd"sv, {0xF2, 0x58}},
+    {"subss"sv, {0xF3, 0x5C}},
+    {"subsd"sv, {0xF2, 0x5C}},
+    {"mulss"sv, {0xF3, 0x59}},
+    {"mulsd"sv, {0xF2, 0x59}},
+    {"divss"sv, {0xF3, 0x5E}},
+    {"divsd"sv, {0xF2, 0x5E}},
+    {"paddd"sv, {0x66, 0xFE}},
+    {"paddq"sv, {0x66, 0xD4}},
+    {"psubd"sv, {0x66, 0xFA}},
+    {"psubq"sv, {0x66, 0xFB}},
+    {"pand"sv, {0x66, 0xDB}},
+    {"por"sv, {0x66, 0xEB}},
+    {"addps"sv, {0x00, 0x58}},
+    {"addpd"sv, {0x66, 0x58}},
+    {"subps"sv, {0x00, 0x5C}},
+    {"subpd"sv, {0x66, 0x5C}},
+    {"mulps"sv, {0x00, 0x59}},
+    {"mulpd"sv, {0x66, 0x59}},
+    {"divps"sv, {0x00, 0x5E}},
+    {"divpd"sv, {0x66, 0x5E}},
+};
+
+struct PackedMove {
+    uint8_t prefix;
+    // xmm <- xmm/m
+    uint8_t load;
+    // xmm/m <- xmm
+    uint8_t store;
+};
+
+// 16 バイトの転送命令
+const std::unordered_map<std::string_view, PackedMove> PACKED_MOVES = {
+    {"movaps"sv, {0x00, 0x28, 0x29}},
+    {"movups"sv, {0x00, 0x10, 0x11}},
+    {"movupd"sv, {0x66, 0x10, 0x11}},
+    {"movdqu"sv, {0xF3, 0x6F, 0x7F}},
+};
+
+struct VexOpCode {
+    // 暗黙のプレフィックス (0: なし, 1: 66, 2: F3, 3: F2)
+    uint8_t pp;
+    // 1: 0F, 2: 0F 38
+    uint8_t map;
+    bool w;
+    uint8_t opcode;
+};
+
+// xmm, xmm (vvvv), xmm/m 形式の VEX 命令 (AVX の 3 オペランド形式と FMA)
+const std::unordered_map<std::string_view, VexOpCode> VEX_OPCODES = {
+    {"vaddss"sv, {2, 1, false, 0x58}},
+    {"vaddsd"sv, {3, 1, false, 0x58}},
+    {"vaddps"sv, {0, 1, false, 0x58}},
+    {"vaddpd"sv, {1, 1, false, 0x58}},
+    {"vsubss"sv, {2, 1, false, 0x5C}},
+    {"vsubsd"sv, {3, 1, false, 0x5C}},
+    {"vsubps"sv, {0, 1, false, 0x5C}},
+    {"vsubpd"sv, {1, 1, false, 0x5C}},
+    {"vmulss"sv, {2, 1, false, 0x59}},
+    {"vmulsd"sv, {3, 1, false, 0x59}},
+    {"vmulps"sv, {0, 1, false, 0x59}},
+    {"vmulpd"sv, {1, 1, false, 0x59}},
+    {"vdivss"sv, {2, 1, false, 0x5E}},
+    {"vdivsd"sv, {3, 1, false, 0x5E}},
+    {"vdivps"sv, {0, 1, false, 0x5E}},
+    {"vdivpd"sv, {1, 1, false, 0x5E}},
+    {"vpaddd"sv, {1, 1, false, 0xFE}},
+    {"vpaddq"sv, {1, 1, false, 0xD4}},
+    {"vpsubd"sv, {1, 1, false, 0xFA}},
+    {"vpsubq"sv, {1, 1, false, 0xFB}},
+    {"vpand"sv, {1, 1, false, 0xDB}},
+    {"vpor"sv, {1, 1, false, 0xEB}},
+    {"vpxor"sv, {1, 1, false, 0xEF}},
+    {"vfmadd231ss"sv, {1, 2, false, 0xB9}},
+    {"vfmadd231sd"sv, {1, 2, true, 0xB9}},
+    {"vfmadd231ps"sv, {1, 2, false, 0xB8}},
+    {"vfmadd231pd"sv, {1, 2, true, 0xB8}},
+    {"vfmsub231ss"sv, {1, 2, false, 0xBB}},
+    {"vfmsub231sd"sv, {1, 2, true, 0xBB}},
+    {"vfmsub231ps"sv, {1, 2, false, 0xBA}},
+    {"vfmsub231pd"sv, {1, 2, true, 0xBA}},
+    {"vfnmadd231ss"sv, {1, 2, false, 0xBD}},
+    {"vfnmadd231sd"sv, {1, 2, true, 0xBD}},
+    {"vfnmadd231ps"sv, {1, 2, false, 0xBC}},
+    {"vfnmadd231pd"sv, {1, 2, true, 0xBC}},
+};
+
+// r, r/m, r (vvvv) 形式の BMI2 のシフト (VEX.0F38 F7)。値は pp
+const std::unordered_map<std::string_view, uint8_t> BMI_SHIFTS = {
+    {"shlx"sv, 1},
+    {"sarx"sv, 2},
+    {"shrx"sv, 3},
+};
+
+// r, r/m 形式のビット数を数える命令 (F3 0F xx)
+const std::unordered_map<std::string_view, uint8_t> BIT_COUNTS = {
+    {"popcnt"sv, 0xB8},
+    {"lzcnt"sv, 0xBD},
+    {"tzcnt"sv, 0xBC},
+};
+
+} // namespace
+
+namespace yoctocc::jit {
+
+struct Encoder::Operand {
+    enum class Kind {
+        REGISTER,
+        MEMORY,
+        IMMEDIATE,
+        LABEL,
+    };
+    Kind kind = Kind::IMMEDIATE;
+    // REGISTER: レジスタ番号, MEMORY: ベースレジスタ番号
+    int reg = 0;
+    // オペランドサイズ。PTR 指定のないメモリオペランドは 0
+    int size = 0;
+    bool isXmm = false;
+    bool forceRex = false;
+    bool isRipRelative = false;
+    // IMMEDIATE: 即値, MEMORY: 変位
+    int64_t value = 0;
+    // LABEL / RIP 相対アドレスのシンボル
+    std::string symbol;
+
+    [[nodiscard]] bool is(Kind k) const {
+        return kind == k;
+    }
+    [[nodiscard]] bool isGeneralRegister() const {
+        return kind == Kind::REGISTER && !isXmm;
+    }
+    [[nodiscard]] bool isXmmRegister() const {
+        return kind == Kind::REGISTER && isXmm;
+    }
+    [[nodiscard]] bool isRegisterOrMemory() const {
+        return kind == Kind::REGISTER || kind == Kind::MEMORY;
+    }
+};
+
+void Encoder::encode(const std::vector<std::string>& lines) {
+    for (const auto& line : lines) {
+        _currentLine = line;
+        encodeLine(trim(line));
+    }
+}
+
+void Encoder::encodeLine(std::string_view line) {
+    if (line.empty() || line.front() == '#') {
+        return;
+    }
+
+    if (line.back() == ':') {
+        defineLabel(line.substr(0, line.size() - 1));
+        return;
+    }
+
+    if (line.front() == '.') {
+        encodeDirective(line);
+        return;
+    }
+
+    auto space = line.find(' ');
+    std::string_view mnemonic = line.substr(0, space);
+    std::string_view rest = space == std::string_view::npos ? ""sv : line.substr(space + 1);
+
+    if (mnemonic == "rep"sv) {
+        auto next = rest.find(' ');
+        mnemonic = line.substr(0, space + 1 + rest.substr(0, next).size());
+        rest = next == std::string_view::npos ? ""sv : rest.substr(next + 1);
+    }
+
+    std::vector<Operand> operands;
+    while (!trim(rest).empty()) {
+        auto comma = rest.find(',');
+        operands.emplace_back(parseOperand(trim(rest.substr(0, comma))));
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        rest = rest.substr(comma + 1);
+    }
+
+    encodeInstruction(mnemonic, operands);
+}
+
+void Encoder::encodeDirective(std::string_view line) {
+    auto space = line.find(' ');
+    std::string_view name = line.substr(0, space);
+    std::string_view argument = space == std::string_view::npos ? ""sv : trim(line.substr(space + 1));
+
+    using enum GasDirective;
+    if (name == to_string(TEXT)) {
+        _section = SectionKind::TEXT;
+        return;
+    }
+    if (name == to_string(DATA)) {
+        _section = SectionKind::DATA;
+        return;
+    }
+    if (name == to_string(BSS)) {
+        _section = SectionKind::BSS;
+        return;
+    }
+    if (name == to_string(SECTION)) {
+        auto sectionName = argument.substr(0, argument.find(','));
+        if (sectionName.starts_with(".rodata"sv) || sectionName.starts_with(".data"sv)) {
+            _section = SectionKind::DATA;
+        } else if (sectionName.starts_with(".text"sv)) {
+            _section = SectionKind::TEXT;
+        } else if (sectionName.starts_with(".bss"sv)) {
+            _section = SectionKind::BSS;
+        }
+        // .note.GNU-stack などは無視
+        return;
+    }
+    if (name == to_string(GLOBAL) || name == to_string(LOCAL) || name == to_string(EXTERN) || name == to_string(LOC) ||
+        name == to_string(FILE) || name == to_string(INTEL_SYNTAX)) {
+        return;
+    }
+    if (name == to_string(ALIGN)) {
+        auto alignment = parseInteger(argument).value_or(1);
+        if (alignment <= 1) {
+            return;
+        }
+        if (_section == SectionKind::BSS) {
+            _bssSize = (_bssSize + alignment - 1) / alignment * alignment;
+            return;
+        }
+        auto& buffer = current();
+        // テキストは nop で埋める
+        uint8_t fill = _section == SectionKind::TEXT ? 0x90 : 0x00;
+        while (buffer.size() % alignment != 0) {
+            buffer.push_back(fill);
+        }
+        return;
+    }
+    if (name == to_string(ZERO)) {
+        auto size = parseInteger(argument).value_or(0);
+        if (_section == SectionKind::BSS) {
+            _bssSize += size;
+        } else {
+            current().insert(current().end(), size, 0);
+        }
+        return;
+    }
+
+    int size = 0;
+    if (name == to_string(BYTE)) {
+        size = 1;
+    } else if (name == to_string(WORD)) {
+        size = 2;
+    } else if (name == to_string(LONG)) {
+        size = 4;
+    } else if (name == to_string(QUAD)) {
+        size = 8;
+    }
+
+    if (size == 0) {
+        Log::error(std::format("jit: unsupported directive: {}", _currentLine));
+        return;
+    }
+
+    if (auto value = parseInteger(argument)) {
+        emitImmediate(*value, size);
+        return;
+    }
+
+    // .quad symbol+addend
+    auto sign = argument.find_last_of("+-");
+    if (size != 8 || sign == std::string_view::npos || sign == 0) {
+        Log::error(std::format("jit: unsupported data relocation: {}", _currentLine));
+        return;
+    }
+    auto addend = parseInteger(argument.substr(sign + 1)).value_or(0);
+    if (argument[sign] == '-') {
+        addend = -addend;
+    }
+    _fixups.emplace_back(Fixup{
+        .kind = FixupKind::ABSOLUTE64,
+        .section = _section,
+        .offset = currentOffset(),
+        .instructionEnd = 0,
+        .opcodeOffset = 0,
+        .symbol = std::string(argument.substr(0, sign)),
+        .addend = addend,
+    });
+    emitImmediate(0, 8);
+}
+
+void Encoder::defineLabel(std::string_view name) {
+    std::string symbolName{name};
+    bool isFunction = _section == SectionKind::TEXT && !name.starts_with('.') && !isNumericLabel(name);
+
+    // 数値ラベル (1: / 1f / 1b) は何度でも定義できるので通し番号を付けて区別する
+    if (isNumericLabel(name)) {
+        int& count = _numericLabelCounts[symbolName];
+        symbolName = std::format("{}@{}", name, count++);
+    }
+
+    if (_symbols.contains(symbolName)) {
+        Log::error(std::format("jit: duplicate symbol: {}", name));
+        return;
+    }
+    _symbols.emplace(symbolName, Symbol{_section, currentOffset(), isFunction});
+}
+
+std::string Encoder::resolveLabelReference(std::string_view name) {
+    if (name.size() >= 2 && isNumericLabel(name.substr(0, name.size() - 1))) {
+        auto base = std::string(name.substr(0, name.size() - 1));
+        int count = _numericLabelCounts[base];
+        if (name.back() == 'f') {
+            return std::format("{}@{}", base, count);
+        }
+        if (name.back() == 'b') {
+            return std::format("{}@{}", base, count - 1);
+        }
+    }
+    return std::string(name);
+}
+
+Encoder::Operand Encoder::parseOperand(std::string_view text) {
+    Operand operand{};
+
+    constexpr std::array<std::pair<std::string_view, int>, 5> sizePrefixes = {{
+        {"BYTE PTR "sv, 1},
+        {"WORD PTR "sv, 2},
+        {"DWORD PTR "sv, 4},
+        {"QWORD PTR "sv, 8},
+        {"XMMWORD PTR "sv, 16},
+    }};
+    for (const auto& [prefix, size] : sizePrefixes) {
+        if (text.starts_with(prefix)) {
+            operand.size = size;
+            text.remove_prefix(prefix.size());
+            break;
+        }
+    }
+
+    if (text.starts_with('[')) {
+        operand.kind = Operand::Kind::MEMORY;
+        auto inner = trim(text.substr(1, text.find(']') - 1));
+        auto op = inner.find_first_of("+-");
+        auto base = trim(inner.substr(0, op));
+        std::string_view displacement = op == std::string_view::npos ? ""sv : trim(inner.substr(op + 1));
+
+        if (base == "rip"sv) {
+            operand.isRipRelative = true;
+            operand.symbol = std::string(displacement);
+            return operand;
+        }
+
+        auto it = registerTable().find(std::string(base));
+        if (it == registerTable().end()) {
+            Log::error(std::format("jit: invalid memory operand: {}", _currentLine));
+            return operand;
+        }
+        operand.reg = it->second.number;
+        if (!displacement.empty()) {
+            operand.value = parseInteger(displacement).value_or(0);
+            if (inner[op] == '-') {
+                operand.value = -operand.value;
+            }
+        }
+        return operand;
+    }
+
+    if (auto it = registerTable().find(std::string(text)); it != registerTable().end()) {
+        operand.kind = Operand::Kind::REGISTER;
+        operand.reg = it->second.number;
+        operand.size = it->second.size;
+        operand.isXmm = it->second.isXmm;
+        operand.forceRex = it->second.forceRex;
+        return operand;
+    }
+
+    if (auto value = parseInteger(text)) {
+        operand.kind = Operand::Kind::IMMEDIATE;
+        operand.value = *value;
+        return operand;
+    }
+
+    operand.kind = Operand::Kind::LABEL;
+    operand.symbol = resolveLabelReference(text);
+    return operand;
+}
+
+std::vector<uint8_t>& Encoder::current() {
+    switch (_section) {
+        case SectionKind::TEXT:
+            return _text;
+        case SectionKind::DATA:
+            return _data;
+        case SectionKind::BSS:
+            break;
+    }
+    Log::error(std::format("jit: cannot emit bytes into .bss: {}", _currentLine));
+    return _data;
+}
+
+size_t Encoder::currentOffset() {
+    return _section == SectionKind::BSS ? _bssSize : current().size();
+}
+
+void Encoder::emitByte(uint8_t value) {
+    current().push_back(value);
+}
+
+void Encoder::emitImmediate(int64_t value, int size) {
+    auto bits = std::bit_cast<uint64_t>(value);
+    for (int i = 0; i < size; i++) {
+        emitByte(static_cast<uint8_t>(bits >> (i * 8)));
+    }
+}
+
+void Encoder::emitRex(bool w, int reg, const Operand& rm, bool forceRex) {
+    uint8_t rex = 0x40;
+    if (w) {
+        rex |= 0x08;
+    }
+    if (reg >= 8) {
+        rex |= 0x04;
+    }
+    if (!rm.isRipRelative && rm.reg >= 8) {
+        rex |= 0x01;
+    }
+    if (rex != 0x40 || forceRex || rm.forceRex) {
+        emitByte(rex);
+    }
+}
+
+void Encoder::emitModRM(int reg, const Operand& rm, int immediateSize) {
+    if (rm.is(Operand::Kind::REGISTER)) {
+        emitByte(static_cast<uint8_t>(0xC0 | ((reg & 7) << 3) | (rm.reg & 7)));
+        return;
+    }
+
+    if (rm.isRipRelative) {
+        emitByte(static_cast<uint8_t>(((reg & 7) << 3) | 5));
+        size_t offset = currentOffset();
+        _fixups.emplace_back(Fixup{
+            .kind = FixupKind::RIP32,
+            .section = _section,
+            .offset = offset,
+            .instructionEnd = offset + 4 + immediateSize,
+            .opcodeOffset = _opcodeOffset,
+            .symbol = rm.symbol,
+            .addend = 0,
+        });
+        emitImmediate(0, 4);
+        return;
+    }
+
+    int base = rm.reg & 7;
+    int mod = 2;
+    if (rm.value == 0 && base != 5) {
+        // rbp / r13 は disp8 = 0 が必要
+        mod = 0;
+    } else if (fitsInt8(rm.value)) {
+        mod = 1;
+    }
+    emitByte(static_cast<uint8_t>((mod << 6) | ((reg & 7) << 3) | base));
+    if (base == 4) {
+        // rsp / r12 は SIB バイトが必要
+        emitByte(0x24);
+    }
+    if (mod == 1) {
+        emitImmediate(rm.value, 1);
+    } else if (mod == 2) {
+        emitImmediate(rm.value, 4);
+    }
+}
+
+void Encoder::emitOp(uint8_t prefix, bool w, std::initializer_list<uint8_t> opcode, int reg, bool regIsByte,
+                     const Operand& rm, int immediateSize) {
+    if (prefix) {
+        emitByte(prefix);
+    }
+    emitRex(w, reg, rm, regIsByte);
+    _opcodeOffset = currentOffset();
+    for (auto byte : opcode) {
+        emitByte(byte);
+    }
+    emitModRM(reg, rm, immediateSize);
+}
+
+void Encoder::emitVex(uint8_t pp, uint8_t map, bool w, uint8_t opcode, int reg, int vvvv, const Operand& rm) {
+    const bool r = reg >= 8;
+    const bool b = !rm.isRipRelative && rm.reg >= 8;
+    const auto inverted = static_cast<uint8_t>((~vvvv & 15) << 3);
+    if (map == 1 && !w && !b) {
+        // 2 バイトの VEX (C5) で表せる
+        emitByte(0xC5);
+        emitByte(static_cast<uint8_t>((r ? 0 : 0x80) | inverted | pp));
+    } else {
+        emitByte(0xC4);
+        emitByte(static_cast<uint8_t>((r ? 0 : 0x80) | 0x40 | (b ? 0 : 0x20) | map));
+        emitByte(static_cast<uint8_t>((w ? 0x80 : 0) | inverted | pp));
+    }
+    _opcodeOffset = currentOffset();
+    emitByte(opcode);
+    emitModRM(reg, rm, 0);
+}
+
+void Encoder::emitBranch(std::initializer_list<uint8_t> opcode, const Operand& target) {
+    if (!target.is(Operand::Kind::LABEL)) {
+        Log::error(std::format("jit: unsupported branch target: {}", _currentLine));
+        return;
+    }
+    for (auto byte : opcode) {
+        emitByte(byte);
+    }
+    size_t offset = currentOffset();
+    _fixups.emplace_back(Fixup{
+        .kind = FixupKind::BRANCH32,
+        .section = _section,
+        .offset = offset,
+        .instructionEnd = offset + 4,
+        .opcodeOffset = 0,
+        .symbol = target.symbol,
+        .addend = 0,
+    });
+    emitImmediate(0, 4);
+}
+
+void Encoder::encodeInstruction(std::string_view mnemonic, std::vector<Operand>& operands) {
+    using Kind = Operand::Kind;
+    auto unsupported = [this] {
+        Log::error(std::format("jit: unsupported instruction: {}", _currentLine));
+    };
+
+    const size_t count = operands.size();
+    Operand none{};
+    Operand& dst = count > 0 ? operands[0] : none;
+    Operand& src = count > 1 ? operands[1] : none;
+
+    // PTR 指定のないメモリオペランドはもう一方のレジスタのサイズに合わせる
+    if (dst.is(Kind::MEMORY) && dst.size == 0 && src.is(Kind::REGISTER)) {
+        dst.size = src.size;
+    }
+    if (src.is(Kind::MEMORY) && src.size == 0 && dst.is(Kind::REGISTER)) {
+        src.size = dst.size;
+    }
+
+    auto sizePrefix = [](int size) -> uint8_t {
+        return size == 2 ? 0x66 : 0x00;
+    };
+
+    if (count == 0) {
+        if (mnemonic == "ret"sv) {
+            emitByte(0xC3);
+        } else if (mnemonic == "cqo"sv) {
+            emitByte(0x48);
+            emitByte(0x99);
+        } else if (mnemonic == "cdq"sv) {
+            emitByte(0x99);
+        } else if (mnemonic == "syscall"sv) {
+            emitByte(0x0F);
+            emitByte(0x05);
+        } else if (mnemonic == "rep stosb"sv) {
+            emitByte(0xF3);
+            emitByte(0xAA);
+        } else if (mnemonic == "nop"sv) {
+            emitByte(0x90);
+        } else {
+            unsupported();
+        }
+        return;
+    }
+
+    if (mnemonic == "call"sv) {
+        emitBranch({0xE8}, dst);
+        return;
+    }
+    if (mnemonic == "jmp"sv) {
+        emitBranch({0xE9}, dst);
+        return;
+    }
+    if (auto it = JCC_OPCODES.find(mnemonic); it != JCC_OPCODES.end()) {
+        emitBranch({0x0F, it->second}, dst);
+        return;
+    }
+
+    if (mnemonic == "push"sv || mnemonic == "pop"sv) {
+        if (!dst.isGeneralRegister()) {
+            unsupported();
+            return;
+        }
+        if (dst.reg >= 8) {
+            emitByte(0x41);
+        }
+        emitByte(static_cast<uint8_t>((mnemonic == "push"sv ? 0x50 : 0x58) + (dst.reg & 7)));
+        return;
+    }
+
+    if (auto it = SETCC_OPCODES.find(mnemonic); it != SETCC_OPCODES.end()) {
+        emitOp(0, false, {0x0F, it->second}, 0, false, dst);
+        return;
+    }
+
+    if (auto it = UNARY_EXTENSIONS.find(mnemonic); it != UNARY_EXTENSIONS.end() && count == 1) {
+        emitOp(sizePrefix(dst.size), dst.size == 8, {static_cast<uint8_t>(dst.size == 1 ? 0xF6 : 0xF7)}, it->second,
+               false, dst);
+        return;
+    }
+
+    if (mnemonic == "inc"sv || mnemonic == "dec"sv) {
+        emitOp(sizePrefix(dst.size), dst.size == 8, {static_cast<uint8_t>(dst.size == 1 ? 0xFE : 0xFF)},
+               mnemonic == "inc"sv ? 0 : 1, false, dst);
+        return;
+    }
+
+    if (auto it = SHIFT_EXTENSIONS.find(mnemonic); it != SHIFT_EXTENSIONS.end()) {
+        bool isByte = dst.size == 1;
+        if (count == 1 || (src.is(Kind::IMMEDIATE) && src.value == 1)) {
+            emitOp(sizePrefix(dst.size), dst.size == 8, {static_cast<uint8_t>(isByte ? 0xD0 : 0xD1)}, it->second, false,
+                   dst);
+        } else if (src.isGeneralRegister() && src.size == 1) {
+            // シフト量は cl 固定
+            emitOp(sizePrefix(dst.size), dst.size == 8, {static_cast<uint8_t>(isByte ? 0xD2 : 0xD3)}, it->second, false,
+                   dst);
+        } else if (src.is(Kind::IMMEDIATE)) {
+            emitOp(sizePrefix(dst.size), dst.size == 8, {static_cast<uint8_t>(isByte ? 0xC0 : 0xC1)}, it->second, false,
+                   dst, 1);
+            emitImmediate(src.value, 1);
+        } else {
+            unsupported();
+        }
+        return;
+    }
+
+    if (auto it = ALU_EXTENSIONS.find(mnemonic); it != ALU_EXTENSIONS.end()) {
+        const int ext = it->second;
+        const auto base = static_cast<uint8_t>(ext * 8);
+        if (mnemonic == "addq"sv) {
+            dst.size = 8;
+        }
+
+        if (dst.isRegisterOrMemory() && src.isGeneralRegister()) {
+            emitOp(sizePrefix(src.size), src.size == 8, {static_cast<uint8_t>(base + (src.size == 1 ? 0 : 1))}, src.reg,
+                   src.forceRex, dst);
+            return;
+        }
+        if (dst.isGeneralRegister() && src.is(Kind::MEMORY)) {
+            emitOp(sizePrefix(dst.size), dst.size == 8, {static_cast<uint8_t>(base + (dst.size == 1 ? 2 : 3))}, dst.reg,
+                   dst.forceRex, src);
+            return;
+        }
+        if (dst.isRegisterOrMemory() && src.is(Kind::IMMEDIATE)) {
+            if (dst.size == 1) {
+                emitOp(0, false, {0x80}, ext, false, dst, 1);
+                emitImmediate(src.value, 1);
+            } else if (fitsInt8(src.value)) {
+                emitOp(sizePrefix(dst.size), dst.size == 8, {0x83}, ext, false, dst, 1);
+                emitImmediate(src.value, 1);
+            } else if (fitsInt32(src.value) || (dst.size == 4 && static_cast<uint64_t>(src.value) <= UINT32_MAX)) {
+                int immediateSize = dst.size == 2 ? 2 : 4;
+                emitOp(sizePrefix(dst.size), dst.size == 8, {0x81}, ext, false, dst, immediateSize);
+                emitImmediate(src.value, immediateSize);
+            } else {
+                unsupported();
+            }
+            return;
+        }
+        unsupported();
+        return;
+    }
+
+    if (mnemonic == "test"sv) {
+        if (dst.isRegisterOrMemory() && src.isGeneralRegister()) {
+            emitOp(sizePrefix(src.size), src.size == 8, {static_cast<uint8_t>(src.size == 1 ? 0x84 : 0x85)}, src.reg,
+                   src.forceRex, dst);
+            return;
+        }
+        unsupported();
+        return;
+    }
+
+    if (mnemonic == "imul"sv && count == 2 && dst.isGeneralRegister() && src.isRegisterOrMemory()) {
+        emitOp(sizePrefix(dst.size), dst.size == 8, {0x0F, 0xAF}, dst.reg, false, src);
+        return;
+    }
+
+    if (mnemonic == "lea"sv) {
+        emitOp(0, dst.size == 8, {0x8D}, dst.reg, false, src);
+        return;
+    }
+
+    if (mnemonic == "movzx"sv || mnemonic == "movsx"sv || mnemonic == "movsbq"sv || mnemonic == "movswq"sv) {
+        bool isSigned = mnemonic != "movzx"sv;
+        int sourceSize = src.size;
+        if (mnemonic == "movsbq"sv) {
+            sourceSize = 1;
+        } else if (mnemonic == "movswq"sv) {
+            sourceSize = 2;
+        }
+        uint8_t opcode = isSigned ? (sourceSize == 1 ? 0xBE : 0xBF) : (sourceSize == 1 ? 0xB6 : 0xB7);
+        emitOp(sizePrefix(dst.size), dst.size == 8, {0x0F, opcode}, dst.reg, false, src);
+        return;
+    }
+
+    if (mnemonic == "movsxd"sv) {
+        emitOp(0, true, {0x63}, dst.reg, false, src);
+        return;
+    }
+
+    if (mnemonic == "movss"sv || mnemonic == "movsd"sv) {
+        uint8_t prefix = mnemonic == "movss"sv ? 0xF3 : 0xF2;
+        if (dst.isXmmRegister()) {
+            emitOp(prefix, false, {0x0F, 0x10}, dst.reg, false, src);
+        } else {
+            emitOp(prefix, false, {0x0F, 0x11}, src.reg, false, dst);
+        }
+        return;
+    }
+
+    if (mnemonic == "movq"sv) {
+        if (dst.isXmmRegister() && src.isGeneralRegister()) {
+            emitOp(0x66, true, {0x0F, 0x6E}, dst.reg, false, src);
+        } else if (dst.isGeneralRegister() && src.isXmmRegister()) {
+            emitOp(0x66, true, {0x0F, 0x7E}, src.reg, false, dst);
+        } else if (dst.isXmmRegister()) {
+            emitOp(0xF3, false, {0x0F, 0x7E}, dst.reg, false, src);
+        } else if (src.isXmmRegister()) {
+            emitOp(0x66, false, {0x0F, 0xD6}, src.reg, false, dst);
+        } else if (dst.is(Kind::MEMORY) && src.isGeneralRegister()) {
+            emitOp(0, true, {0x89}, src.reg, false, dst);
+        } else if (dst.isGeneralRegister() && src.is(Kind::MEMORY)) {
+            emitOp(0, true, {0x8B}, dst.reg, false, src);
+        } else {
+            unsupported();
+        }
+        return;
+    }
+
+    if (mnemonic == "movd"sv) {
+        if (dst.isXmmRegister()) {
+            emitOp(0x66, false, {0x0F, 0x6E}, dst.reg, false, src);
+        } else {
+            emitOp(0x66, false, {0x0F, 0x7E}, src.reg, false, dst);
+        }
+        return;
+    }
+
+    if (auto it = PACKED_MOVES.find(mnemonic); it != PACKED_MOVES.end()) {
+        const auto [prefix, load, store] = it->second;
+        if (dst.isXmmRegister()) {
+            emitOp(prefix, false, {0x0F, load}, dst.reg, false, src);
+        } else {
+            emitOp(prefix, false, {0x0F, store}, src.reg, false, dst);
+        }
+        return;
+    }
+
+    if (mnemonic == "pshufd"sv && count == 3 && operands[2].is(Kind::IMMEDIATE)) {
+        emitOp(0x66, false, {0x0F, 0x70}, dst.reg, false, src, 1);
+        emitImmediate(operands[2].value, 1);
+        return;
+    }
+
+    if (auto it = VEX_OPCODES.find(mnemonic); it != VEX_OPCODES.end() && count == 3) {
+        const auto [pp, map, w, opcode] = it->second;
+        emitVex(pp, map, w, opcode, dst.reg, src.reg, operands[2]);
+        return;
+    }
+
+    if (auto it = BMI_SHIFTS.find(mnemonic); it != BMI_SHIFTS.end() && count == 3) {
+        emitVex(it->second, 2, dst.size == 8, 0xF7, dst.reg, operands[2].reg, src);
+        return;
+    }
+
+    if (mnemonic == "andn"sv && count == 3) {
+        emitVex(0, 2, dst.size == 8, 0xF2, dst.reg, src.reg, operands[2]);
+        return;
+    }
+
+    if (auto it = BIT_COUNTS.find(mnemonic); it != BIT_COUNTS.end()) {
+        emitOp(0xF3, dst.size == 8, {0x0F, it->second}, dst.reg, false, src);
+        return;
+    }
+
+    if (auto it = SSE_OPCODES.find(mnemonic); it != SSE_OPCODES.end()) {
+        // cvtsi2sx は転送元, cvttsx2si は転送先が 64 ビットなら REX.W
+        bool w = (src.isGeneralRegister() && src.size == 8) || (dst.isGeneralRegister() && dst.size == 8);
+        emitOp(it->second.prefix, w, {0x0F, it->second.opcode}, dst.reg, false, src);
+        return;
+    }
+
+    if (mnemonic == "mov"sv) {
+        if (dst.isGeneralRegister() && src.isRegisterOrMemory()) {
+            emitOp(sizePrefix(dst.size), dst.size == 8, {static_cast<uint8_t>(dst.size == 1 ? 0x8A : 0x8B)}, dst.reg,
+                   dst.forceRex, src);
+            return;
+        }
+        if (dst.is(Kind::MEMORY) && src.isGeneralRegister()) {
+            emitOp(sizePrefix(src.size), src.size == 8, {static_cast<uint8_t>(src.size == 1 ? 0x88 : 0x89)}, src.reg,
+                   src.forceRex, dst);
+            return;
+        }
+        if (dst.isGeneralRegister() && src.is(Kind::IMMEDIATE)) {
+            if (dst.size == 8 && fitsInt32(src.value)) {
+                emitOp(0, true, {0xC7}, 0, false, dst, 4);
+                emitImmediate(src.value, 4);
+                return;
+            }
+            int immediateSize = dst.size;
+            bool w = dst.size == 8;
+            if (dst.size == 8 && static_cast<uint64_t>(src.value) <= UINT32_MAX) {
+                // 32 ビットレジスタへの mov は上位をゼロ拡張する
+                immediateSize = 4;
+                w = false;
+            }
+            if (dst.size == 2) {
+                emitByte(0x66);
+            }
+            Operand noMemory{};
+            noMemory.reg = dst.reg;
+            noMemory.kind = Kind::REGISTER;
+            noMemory.forceRex = dst.forceRex;
+            emitRex(w, 0, noMemory, false);
+            emitByte(static_cast<uint8_t>((dst.size == 1 ? 0xB0 : 0xB8) + (dst.reg & 7)));
+            emitImmediate(src.value, immediateSize);
+            return;
+        }
+        if (dst.is(Kind::MEMORY) && src.is(Kind::IMMEDIATE)) {
+            if (dst.size == 1) {
+                emitOp(0, false, {0xC6}, 0, false, dst, 1);
+                emitImmediate(src.value, 1);
+            } else {
+                int immediateSize = dst.size == 2 ? 2 : 4;
+                emitOp(sizePrefix(dst.size), dst.size == 8, {0xC7}, 0, false, dst, immediateSize);
+                emitImmediate(src.value, immediateSize);
+            }
+            return;
+        }
+    }
+
+    unsupported();
+}
+
+} // namespace yoctocc::jit
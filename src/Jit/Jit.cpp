@@ -0,0 +1,188 @@
+#include "Jit/Jit.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <map>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "Logger.hpp"
+#include "Utility.hpp"
+
+namespace {
+
+constexpr size_t PAGE_SIZE = 4096;
+// jmp [rip + 0] + 8 バイトの絶対アドレス
+constexpr size_t STUB_SIZE = 16;
+
+void write32(uint8_t* p, int64_t value) {
+    if (value < INT32_MIN || value > INT32_MAX) {
+        yoctocc::Log::error("jit: relocation out of range");
+    }
+    auto v = static_cast<int32_t>(value);
+    std::memcpy(p, &v, sizeof(v));
+}
+
+void write64(uint8_t* p, uint64_t value) {
+    std::memcpy(p, &value, sizeof(value));
+}
+
+} // namespace
+
+namespace yoctocc::jit {
+
+Jit::Jit(const Encoder& encoder, const runtime::HostLibrary& host, bool perfMap) : _encoder(encoder), _host(host) {
+    load();
+    if (perfMap) {
+        writePerfMap();
+    }
+}
+
+Jit::~Jit() {
+    if (_memory) {
+        munmap(_memory, _memorySize);
+    }
+}
+
+uint8_t* Jit::addressOf(const std::string& name) {
+    const auto& symbols = _encoder.symbols();
+    auto it = symbols.find(name);
+    if (it == symbols.end()) {
+        return nullptr;
+    }
+    switch (it->second.section) {
+        case SectionKind::TEXT:
+            return _memory + it->second.offset;
+        case SectionKind::DATA:
+            return _memory + _dataOffset + it->second.offset;
+        case SectionKind::BSS:
+            return _memory + _bssOffset + it->second.offset;
+    }
+    return nullptr;
+}
+
+void Jit::load() {
+    const auto& fixups = _encoder.fixups();
+    const auto& symbols = _encoder.symbols();
+
+    // 外部関数への分岐はスタブ経由、外部データへの参照は GOT 経由にする
+    std::map<std::string, size_t> stubs;
+    std::map<std::string, size_t> gotSlots;
+    for (const auto& fixup : fixups) {
+        if (symbols.contains(fixup.symbol)) {
+            continue;
+        }
+        if (fixup.kind == FixupKind::BRANCH32) {
+            stubs.try_emplace(fixup.symbol, stubs.size());
+        } else if (fixup.kind == FixupKind::RIP32) {
+            gotSlots.try_emplace(fixup.symbol, gotSlots.size());
+        }
+    }
+
+    const size_t stubOffset = alignTo(_encoder.text().size(), STUB_SIZE);
+    _textSize = alignTo(stubOffset + stubs.size() * STUB_SIZE, PAGE_SIZE);
+    const size_t gotOffset = _textSize;
+    _dataOffset = alignTo(gotOffset + gotSlots.size() * 8, 16);
+    _bssOffset = alignTo(_dataOffset + _encoder.data().size(), 16);
+    _memorySize = alignTo(std::max<size_t>(_bssOffset + _encoder.bssSize(), _textSize + 1), PAGE_SIZE);
+
+    void* memory = mmap(nullptr, _memorySize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        Log::error("jit: mmap failed");
+    }
+    _memory = static_cast<uint8_t*>(memory);
+    std::ranges::copy(_encoder.text(), _memory);
+    std::ranges::copy(_encoder.data(), _memory + _dataOffset);
+
+    for (const auto& [name, index] : stubs) {
+        uint8_t* stub = _memory + stubOffset + index * STUB_SIZE;
+        // jmp QWORD PTR [rip + 0]
+        const uint8_t jump[] = {0xFF, 0x25, 0x00, 0x00, 0x00, 0x00};
+        std::memcpy(stub, jump, sizeof(jump));
+        write64(stub + sizeof(jump), reinterpret_cast<uint64_t>(_host.resolve(name)));
+    }
+    for (const auto& [name, index] : gotSlots) {
+        write64(_memory + gotOffset + index * 8, reinterpret_cast<uint64_t>(_host.resolve(name)));
+    }
+
+    for (const auto& fixup : fixups) {
+        size_t base = fixup.section == SectionKind::TEXT ? 0 : _dataOffset;
+        uint8_t* patch = _memory + base + fixup.offset;
+        uint8_t* target = addressOf(fixup.symbol);
+
+        switch (fixup.kind) {
+            case FixupKind::BRANCH32: {
+                if (!target) {
+                    target = _memory + stubOffset + stubs.at(fixup.symbol) * STUB_SIZE;
+                }
+                write32(patch, target - (_memory + base + fixup.instructionEnd));
+                break;
+            }
+            case FixupKind::RIP32: {
+                if (!target) {
+                    // lea reg, [rip + sym] を mov reg, [rip + GOT] に書き換える
+                    uint8_t* opcode = _memory + base + fixup.opcodeOffset;
+                    if (*opcode != 0x8D) {
+                        Log::error(std::format("jit: unsupported reference to external data: {}", fixup.symbol));
+                    }
+                    *opcode = 0x8B;
+                    target = _memory + gotOffset + gotSlots.at(fixup.symbol) * 8;
+                }
+                write32(patch, target - (_memory + base + fixup.instructionEnd));
+                break;
+            }
+            case FixupKind::ABSOLUTE64: {
+                auto address = target ? reinterpret_cast<uint64_t>(target)
+                                      : reinterpret_cast<uint64_t>(_host.resolve(fixup.symbol));
+                write64(patch, address + fixup.addend);
+                break;
+            }
+        }
+    }
+
+    if (mprotect(_memory, _textSize, PROT_READ | PROT_EXEC) != 0) {
+        Log::error("jit: mprotect failed");
+    }
+}
+
+// perf が JIT コードのシンボルを解決できるように /tmp/perf-<pid>.map を書き出す
+void Jit::writePerfMap() {
+    std::vector<std::pair<size_t, std::string>> functions;
+    for (const auto& [name, symbol] : _encoder.symbols()) {
+        if (symbol.isFunction) {
+            functions.emplace_back(symbol.offset, name);
+        }
+    }
+    std::ranges::sort(functions);
+
+    auto path = std::format("/tmp/perf-{}.map", getpid());
+    FILE* fp = std::fopen(path.c_str(), "w");
+    if (!fp) {
+        return;
+    }
+    for (size_t i = 0; i < functions.size(); i++) {
+        size_t end = i + 1 < functions.size() ? functions[i + 1].first : _encoder.text().size();
+        std::fprintf(fp, "%lx %lx %s\n", reinterpret_cast<uintptr_t>(_memory + functions[i].first),
+                     end - functions[i].first, functions[i].second.c_str());
+    }
+    std::fclose(fp);
+}
+
+int Jit::run(const std::string& programName) {
+    using MainFunction = int (*)(int, char**);
+    auto* entry = addressOf("main");
+    if (!entry) {
+        Log::error("jit: main is not defined");
+    }
+
+    std::string name = programName;
+    char* argv[] = {name.data(), nullptr};
+    auto mainFunction = reinterpret_cast<MainFunction>(entry);
+    int result = mainFunction(1, argv);
+    std::fflush(stdout);
+    std::fflush(stderr);
+    return result;
+}
+
+} // namespace yoctocc::jit
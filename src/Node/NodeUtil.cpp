@@ -1,6 +1,9 @@
 #include "Node/NodeUtil.hpp"
 
+#include <bit>
 #include <utility>
+#include <vector>
+#include "Interpreter/ConstantEvaluator.hpp"
 #include "Logger.hpp"
 #include "Node/NodeTypes.hpp"
 #include "Parser/Common.hpp"
@@ -26,6 +29,32 @@ std::unique_ptr<Member> findStructMember(const std::shared_ptr<Type>& structType
     Log::error("No such member"sv, memberName);
     return nullptr;
 }
+
+// 定数式の中の関数呼び出しを評価し、戻り値をビット列のまま返す
+uint64_t evalFunctionCall(Node* node) {
+    std::vector<uint64_t> args;
+    for (Node* arg = node->arguments.get(); arg; arg = arg->next.get()) {
+        type::addType(arg);
+        switch (arg->type->kind) {
+            case TypeKind::FLOAT:
+                args.emplace_back(std::bit_cast<uint32_t>(static_cast<float>(evalDouble(arg))));
+                break;
+            case TypeKind::DOUBLE:
+                args.emplace_back(std::bit_cast<uint64_t>(evalDouble(arg)));
+                break;
+            case TypeKind::BOOL:
+                args.emplace_back(eval(arg) != 0);
+                break;
+            default:
+                if (!type::isInteger(arg->type.get())) {
+                    Log::error("Only arithmetic arguments are supported in a constant expression"sv, arg->token);
+                }
+                args.emplace_back(static_cast<uint64_t>(eval(arg)));
+                break;
+        }
+    }
+    return interpreter::evaluateConstantCall(node, args);
+}
 } // namespace
 
 namespace yoctocc {
@@ -332,6 +361,11 @@ int64_t eval2(Node* node, std::string& label) {
         return 0;
     case NUMBER:
         return node->integerValue;
+    case FUNCTION_CALL:
+        if (!type::isInteger(node->type.get())) {
+            Log::error("Function call in a constant expression must return an arithmetic type"sv, node->token);
+        }
+        return static_cast<int64_t>(evalFunctionCall(node));
     default:
         // TODO: 列挙体の文字列表現
         Log::error(std::format("token::eval: unsupported node type: {}", std::to_underlying(node->nodeType)));
@@ -384,6 +418,13 @@ double evalDouble(Node* node) {
             return type::isFloat(node->left->type.get()) ? evalDouble(node->left.get()) : eval(node->left.get());
         case NodeType::NUMBER:
             return node->floatValue;
+        case NodeType::FUNCTION_CALL: {
+            uint64_t bits = evalFunctionCall(node);
+            if (node->type->kind == TypeKind::FLOAT) {
+                return std::bit_cast<float>(static_cast<uint32_t>(bits));
+            }
+            return std::bit_cast<double>(bits);
+        }
         default:
             Log::error(std::format("eval_double: unsupported node type: {}", std::to_underlying(node->nodeType)));
             return 0;
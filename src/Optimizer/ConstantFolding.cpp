@@ -0,0 +1,183 @@
+#include "Optimizer/Passes.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include "Node/Node.hpp"
+#include "Type.hpp"
+
+namespace {
+using namespace yoctocc;
+
+bool isIntegerConstant(const Node* node) {
+    return node && node->nodeType == NodeType::NUMBER && type::isInteger(node->type.get());
+}
+
+// 型の幅に切り詰めて、符号付きなら符号拡張、符号なしならゼロ拡張した値にする
+int64_t normalize(uint64_t value, const Type* type) {
+    if (type->kind == TypeKind::BOOL) {
+        return value != 0;
+    }
+    switch (type->size) {
+        case 1:
+            return type->isUnsigned ? static_cast<int64_t>(static_cast<uint8_t>(value)) : static_cast<int8_t>(value);
+        case 2:
+            return type->isUnsigned ? static_cast<int64_t>(static_cast<uint16_t>(value)) : static_cast<int16_t>(value);
+        case 4:
+            return type->isUnsigned ? static_cast<int64_t>(static_cast<uint32_t>(value)) : static_cast<int32_t>(value);
+        default:
+            return static_cast<int64_t>(value);
+    }
+}
+
+// 畳み込めない (ゼロ除算・オーバーフローで例外になる除算・範囲外のシフト) なら nullopt
+std::optional<int64_t> foldBinary(const Node* node) {
+    const Type* operandType = node->left->type.get();
+    const int bits = operandType->size * 8;
+    const bool isUnsigned = operandType->isUnsigned;
+    const int64_t lhs = normalize(node->left->integerValue, operandType);
+    const int64_t rhs = normalize(node->right->integerValue, node->right->type.get());
+    const auto a = static_cast<uint64_t>(lhs);
+    const auto b = static_cast<uint64_t>(rhs);
+
+    switch (node->nodeType) {
+        case NodeType::ADD:
+            return a + b;
+        case NodeType::SUB:
+            return a - b;
+        case NodeType::MUL:
+            return a * b;
+        case NodeType::DIV:
+        case NodeType::MOD: {
+            if (rhs == 0) {
+                return std::nullopt;
+            }
+            if (isUnsigned) {
+                return node->nodeType == NodeType::DIV ? a / b : a % b;
+            }
+            const int64_t minimum = bits == 64 ? INT64_MIN : -(int64_t{1} << (bits - 1));
+            if (lhs == minimum && rhs == -1) {
+                return std::nullopt;
+            }
+            return node->nodeType == NodeType::DIV ? lhs / rhs : lhs % rhs;
+        }
+        case NodeType::BIT_AND:
+            return a & b;
+        case NodeType::BIT_OR:
+            return a | b;
+        case NodeType::BIT_XOR:
+            return a ^ b;
+        case NodeType::SHL:
+            if (rhs < 0 || rhs >= bits) {
+                return std::nullopt;
+            }
+            return a << rhs;
+        case NodeType::SHR:
+            if (rhs < 0 || rhs >= bits) {
+                return std::nullopt;
+            }
+            return isUnsigned ? static_cast<int64_t>(a >> rhs) : lhs >> rhs;
+        case NodeType::EQUAL:
+            return lhs == rhs;
+        case NodeType::NOT_EQUAL:
+            return lhs != rhs;
+        case NodeType::LESS:
+            return isUnsigned ? a < b : lhs < rhs;
+        case NodeType::LESS_EQUAL:
+            return isUnsigned ? a <= b : lhs <= rhs;
+        case NodeType::LOGICAL_AND:
+            return lhs != 0 && rhs != 0;
+        case NodeType::LOGICAL_OR:
+            return lhs != 0 || rhs != 0;
+        default:
+            return std::nullopt;
+    }
+}
+
+std::optional<int64_t> foldUnary(const Node* node) {
+    const int64_t operand = normalize(node->left->integerValue, node->left->type.get());
+    switch (node->nodeType) {
+        case NodeType::NEGATE:
+            return -static_cast<uint64_t>(operand);
+        case NodeType::BIT_NOT:
+            return ~operand;
+        case NodeType::NOT:
+            return operand == 0;
+        case NodeType::CAST:
+            return operand;
+        default:
+            return std::nullopt;
+    }
+}
+
+class ConstantFolder final {
+public:
+    size_t changes = 0;
+
+    // body / arguments の next でつながったリストは再帰せずにたどる
+    void visitList(std::unique_ptr<Node>& head) {
+        for (auto* link = &head; *link; link = &(*link)->next) {
+            visit(*link);
+        }
+    }
+
+    void visit(std::unique_ptr<Node>& slot) {
+        Node* node = slot.get();
+        if (!node) {
+            return;
+        }
+        visit(node->left);
+        visit(node->right);
+        visit(node->condition);
+        visit(node->then);
+        visit(node->els);
+        visit(node->init);
+        visit(node->inc);
+        visitList(node->body);
+        visitList(node->arguments);
+        fold(slot);
+    }
+
+private:
+    void fold(std::unique_ptr<Node>& slot) {
+        Node* node = slot.get();
+        // ポインタ演算や浮動小数点数は対象外
+        if (!type::isInteger(node->type.get())) {
+            return;
+        }
+
+        std::optional<int64_t> value;
+        if (node->left && node->right) {
+            if (isIntegerConstant(node->left.get()) && isIntegerConstant(node->right.get())) {
+                value = foldBinary(node);
+            }
+        } else if (node->left && !node->right && isIntegerConstant(node->left.get())) {
+            value = foldUnary(node);
+        }
+        if (!value) {
+            return;
+        }
+
+        auto folded = std::make_unique<Node>(NodeType::NUMBER, node->token);
+        folded->type = node->type;
+        folded->integerValue = normalize(static_cast<uint64_t>(*value), node->type.get());
+        folded->next = std::move(node->next);
+        slot = std::move(folded);
+        changes++;
+    }
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t foldConstants(Object* program) {
+    ConstantFolder folder;
+    for (Object* fn = program; fn; fn = fn->next.get()) {
+        if (fn->isFunction && fn->body) {
+            folder.visit(fn->body);
+        }
+    }
+    return folder.changes;
+}
+
+} // namespace yoctocc::optimizer
@@ -0,0 +1,376 @@
+#include "Optimizer/Passes.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "IR/Analysis.hpp"
+#include "IR/IR.hpp"
+#include "Node/Node.hpp"
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+// 定数どうしの整数の比較なら結果
+std::optional<bool> evaluateCondition(const Instruction* condition) {
+    if (condition->opcode == Opcode::CONST) {
+        return condition->immediate != 0;
+    }
+    if (condition->opcode != Opcode::CMP || condition->operands[0]->opcode != Opcode::CONST ||
+        condition->operands[1]->opcode != Opcode::CONST) {
+        return std::nullopt;
+    }
+    int64_t left = condition->operands[0]->immediate;
+    int64_t right = condition->operands[1]->immediate;
+    if (condition->operands[0]->type == ValueType::I32) {
+        left = static_cast<int32_t>(left);
+        right = static_cast<int32_t>(right);
+    }
+    const bool isWide = condition->operands[0]->type == ValueType::I64;
+    auto unsignedOf = [&](int64_t value) {
+        return isWide ? static_cast<uint64_t>(value) : static_cast<uint64_t>(static_cast<uint32_t>(value));
+    };
+    switch (condition->condition) {
+        case Condition::EQ:
+            return left == right;
+        case Condition::NE:
+            return left != right;
+        case Condition::LT:
+            return left < right;
+        case Condition::LE:
+            return left <= right;
+        case Condition::GT:
+            return left > right;
+        case Condition::GE:
+            return left >= right;
+        case Condition::ULT:
+            return unsignedOf(left) < unsignedOf(right);
+        case Condition::ULE:
+            return unsignedOf(left) <= unsignedOf(right);
+        case Condition::UGT:
+            return unsignedOf(left) > unsignedOf(right);
+        case Condition::UGE:
+            return unsignedOf(left) >= unsignedOf(right);
+    }
+    return std::nullopt;
+}
+
+void removePhiSource(BasicBlock* block, const BasicBlock* source) {
+    for (auto& phi : block->instructions) {
+        if (phi->opcode != Opcode::PHI) {
+            break;
+        }
+        for (size_t i = 0; i < phi->blocks.size(); i++) {
+            if (phi->blocks[i] == source) {
+                phi->blocks.erase(phi->blocks.begin() + static_cast<std::ptrdiff_t>(i));
+                phi->operands.erase(phi->operands.begin() + static_cast<std::ptrdiff_t>(i));
+                break;
+            }
+        }
+    }
+}
+
+class DeadCodeElimination final {
+public:
+    explicit DeadCodeElimination(Function& function) : _function(function) {
+    }
+
+    size_t run() {
+        size_t removed = foldBranches();
+        removed += _function.removeUnreachableBlocks();
+        removed += mergeBlocks();
+        removed += removeDeadStores();
+        removed += removeDeadInstructions();
+        return removed;
+    }
+
+private:
+    // 条件が定数の CONDBR と、両方の分岐先が同じ CONDBR を BR にする
+    size_t foldBranches() {
+        size_t folded = 0;
+        for (const auto& block : _function.blocks) {
+            auto* terminator = block->terminator();
+            if (!terminator || terminator->opcode != Opcode::CONDBR) {
+                continue;
+            }
+            auto* taken = terminator->blocks[0];
+            auto* other = terminator->blocks[1];
+            if (taken != other) {
+                const auto value = evaluateCondition(terminator->operands[0]);
+                if (!value) {
+                    continue;
+                }
+                if (!*value) {
+                    std::swap(taken, other);
+                }
+                removePhiSource(other, block.get());
+            }
+            terminator->opcode = Opcode::BR;
+            terminator->operands.clear();
+            terminator->blocks = {taken};
+            folded++;
+        }
+        return folded;
+    }
+
+    // 唯一の先行ブロックから BR で入るブロックを先行ブロックの末尾につなげる
+    size_t mergeBlocks() {
+        std::unordered_map<Instruction*, Instruction*> replacements;
+        size_t merged = 0;
+        for (const auto& owner : _function.blocks) {
+            auto* block = owner.get();
+            while (auto* terminator = block->terminator()) {
+                auto* successor = terminator->blocks.empty() ? nullptr : terminator->blocks[0];
+                if (terminator->opcode != Opcode::BR || successor == block || successor->predecessors.size() != 1) {
+                    break;
+                }
+                block->instructions.pop_back();
+                for (auto& instruction : successor->instructions) {
+                    if (instruction->opcode == Opcode::PHI) {
+                        replacements.emplace(instruction.get(), instruction->operands[0]);
+                        continue;
+                    }
+                    instruction->parent = block;
+                    block->instructions.emplace_back(std::move(instruction));
+                }
+                successor->instructions.clear();
+                for (auto* next : successor->successors) {
+                    std::ranges::replace(next->predecessors, successor, block);
+                    for (auto& phi : next->instructions) {
+                        if (phi->opcode != Opcode::PHI) {
+                            break;
+                        }
+                        std::ranges::replace(phi->blocks, successor, block);
+                    }
+                }
+                block->successors = std::move(successor->successors);
+                successor->successors.clear();
+                successor->predecessors.clear();
+                merged++;
+            }
+        }
+        std::erase_if(_function.blocks, [](const auto& block) { return block->instructions.empty(); });
+        _function.replaceUses(replacements);
+        _function.recomputeControlFlow();
+        return merged;
+    }
+
+    // 後で読まれない書き込みを取り除く
+    size_t removeDeadStores() {
+        _function.recomputeControlFlow();
+        AliasAnalysis aliases{_function};
+        std::vector<std::pair<const Instruction*, int64_t>> readers;
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                if (instruction->opcode == Opcode::LOAD) {
+                    readers.emplace_back(instruction->operands[0], instruction->immediate);
+                } else if (instruction->opcode == Opcode::COPY_MEMORY) {
+                    readers.emplace_back(instruction->operands[1], instruction->immediate);
+                }
+            }
+        }
+
+        std::unordered_set<const Instruction*> dead;
+        for (const auto& block : _function.blocks) {
+            // 同じブロックで、読まれないまま上書きされる書き込み
+            std::vector<const Instruction*> pending;
+            for (const auto& instruction : block->instructions) {
+                switch (instruction->opcode) {
+                    case Opcode::LOAD:
+                    case Opcode::COPY_MEMORY: {
+                        const auto* address = instruction->operands[instruction->opcode == Opcode::LOAD ? 0 : 1];
+                        std::erase_if(pending, [&](const Instruction* store) {
+                            return aliases.mayModify(store, address, instruction->immediate);
+                        });
+                        break;
+                    }
+                    case Opcode::CALL:
+                        std::erase_if(pending, [&](const Instruction* store) {
+                            return aliases.mayModify(instruction.get(), store->operands[0], store->immediate);
+                        });
+                        break;
+                    default:
+                        break;
+                }
+                if (!isWrite(instruction.get())) {
+                    continue;
+                }
+                std::erase_if(pending, [&](const Instruction* store) {
+                    if (overwrites(instruction.get(), store)) {
+                        dead.insert(store);
+                        return true;
+                    }
+                    return false;
+                });
+                if (instruction->opcode != Opcode::COPY_MEMORY) {
+                    pending.emplace_back(instruction.get());
+                }
+            }
+        }
+
+        // 外へ出ない変数への書き込みで、どの読み出しとも重ならないもの
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                if (!isWrite(instruction.get()) || dead.contains(instruction.get()) ||
+                    !isPrivateSlot(aliases, instruction->operands[0])) {
+                    continue;
+                }
+                if (std::ranges::none_of(readers, [&](const auto& reader) {
+                        return aliases.mayModify(instruction.get(), reader.first, reader.second);
+                    })) {
+                    dead.insert(instruction.get());
+                }
+            }
+        }
+
+        for (const auto& block : _function.blocks) {
+            std::erase_if(block->instructions, [&](const auto& instruction) { return dead.contains(instruction.get()); });
+        }
+        return dead.size();
+    }
+
+    static bool isWrite(const Instruction* instruction) {
+        return instruction->opcode == Opcode::STORE || instruction->opcode == Opcode::CLEAR ||
+               instruction->opcode == Opcode::COPY_MEMORY;
+    }
+
+    // writer が earlier の書き込んだ範囲をすべて書き換えるか
+    static bool overwrites(const Instruction* writer, const Instruction* earlier) {
+        return writer->operands[0] == earlier->operands[0] && writer->immediate >= earlier->immediate;
+    }
+
+    static bool isPrivateSlot(const AliasAnalysis& aliases, const Instruction* address) {
+        while (address->opcode == Opcode::ADD) {
+            address = address->operands[0];
+        }
+        return address->opcode == Opcode::FRAME_ADDRESS && !aliases.escapes(address->immediate);
+    }
+
+    // 副作用のある命令から使われている命令をたどり、それ以外を取り除く (PHI 同士の循環も消える)
+    size_t removeDeadInstructions() {
+        std::unordered_set<const Instruction*> live;
+        std::vector<const Instruction*> worklist;
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                if (instruction->hasSideEffects() || instruction->opcode == Opcode::PARAM) {
+                    live.insert(instruction.get());
+                    worklist.emplace_back(instruction.get());
+                }
+            }
+        }
+        while (!worklist.empty()) {
+            const auto* instruction = worklist.back();
+            worklist.pop_back();
+            for (const auto* operand : instruction->operands) {
+                if (live.insert(operand).second) {
+                    worklist.emplace_back(operand);
+                }
+            }
+        }
+
+        size_t removed = 0;
+        for (const auto& block : _function.blocks) {
+            removed += std::erase_if(block->instructions, [&](const auto& instruction) {
+                return !live.contains(instruction.get());
+            });
+        }
+        return removed;
+    }
+
+    Function& _function;
+};
+
+// 関数本体から参照しているグローバル変数と関数の名前を集める
+class ReferenceCollector final {
+public:
+    explicit ReferenceCollector(std::vector<std::string>& names) : _names(names) {
+    }
+
+    void visitList(const Node* head) {
+        for (const Node* node = head; node; node = node->next.get()) {
+            visit(node);
+        }
+    }
+
+    void visit(const Node* node) {
+        if (!node) {
+            return;
+        }
+        if (node->variable && !node->variable->isLocal) {
+            _names.emplace_back(node->variable->name);
+        }
+        if (node->nodeType == NodeType::FUNCTION_CALL) {
+            _names.emplace_back(node->functionName);
+        }
+        visit(node->left.get());
+        visit(node->right.get());
+        visit(node->condition.get());
+        visit(node->then.get());
+        visit(node->els.get());
+        visit(node->init.get());
+        visit(node->inc.get());
+        visitList(node->body.get());
+        visitList(node->arguments.get());
+    }
+
+private:
+    std::vector<std::string>& _names;
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t eliminateDeadCode(ir::Function& function) {
+    return DeadCodeElimination{function}.run();
+}
+
+size_t removeUnusedStatics(Object* program) {
+    std::unordered_map<std::string_view, std::vector<Object*>> definitions;
+    std::vector<std::string> worklist;
+    for (Object* object = program; object; object = object->next.get()) {
+        if (!object->isDefinition) {
+            continue;
+        }
+        definitions[object->name].emplace_back(object);
+        if (!object->isStatic) {
+            worklist.emplace_back(object->name);
+        }
+    }
+
+    // static でない定義から参照をたどる
+    std::unordered_set<std::string> reached;
+    while (!worklist.empty()) {
+        std::string name = std::move(worklist.back());
+        worklist.pop_back();
+        if (!reached.insert(name).second) {
+            continue;
+        }
+        auto it = definitions.find(name);
+        if (it == definitions.end()) {
+            continue;
+        }
+        for (const Object* object : it->second) {
+            if (object->isFunction) {
+                ReferenceCollector{worklist}.visit(object->body.get());
+            }
+            for (const Relocation* relocation = object->relocations.get(); relocation;
+                 relocation = relocation->next.get()) {
+                worklist.emplace_back(relocation->label);
+            }
+        }
+    }
+
+    size_t removed = 0;
+    for (Object* object = program; object; object = object->next.get()) {
+        if (object->isDefinition && object->isStatic && object->isLive && !reached.contains(object->name)) {
+            object->isLive = false;
+            removed++;
+        }
+    }
+    return removed;
+}
+
+} // namespace yoctocc::optimizer
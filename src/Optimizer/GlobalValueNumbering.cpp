@@ -0,0 +1,257 @@
+#include "Optimizer/Passes.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "IR/Analysis.hpp"
+#include "IR/IR.hpp"
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+// 同じ値を計算する命令の見分け方 (オペランドは値番号を振り直した後の命令の id)
+struct ExpressionKey {
+    Opcode opcode;
+    ValueType type;
+    int64_t immediate;
+    Condition condition;
+    bool isSigned;
+    std::string symbol;
+    std::vector<uint32_t> operands;
+
+    bool operator==(const ExpressionKey&) const = default;
+};
+
+struct ExpressionKeyHash {
+    size_t operator()(const ExpressionKey& key) const noexcept {
+        size_t hash = std::hash<int64_t>{}(key.immediate);
+        auto combine = [&](size_t value) { hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+        combine(static_cast<size_t>(key.opcode));
+        combine(static_cast<size_t>(key.type));
+        combine(static_cast<size_t>(key.condition));
+        combine(key.isSigned);
+        combine(std::hash<std::string>{}(key.symbol));
+        for (const uint32_t operand : key.operands) {
+            combine(operand);
+        }
+        return hash;
+    }
+};
+
+// 読み出せる値がわかっているメモリ (LOAD の結果か、直前に STORE した値)
+struct AvailableMemory {
+    const Instruction* address;
+    int64_t size;
+    ValueType type;
+    bool isSigned;
+    Instruction* value;
+};
+
+// 定数とアドレスは使う場所で作り直すので、まとめても命令は減らない
+bool isFree(const Instruction* instruction) {
+    return instruction->opcode == Opcode::CONST || instruction->opcode == Opcode::FRAME_ADDRESS ||
+           instruction->opcode == Opcode::GLOBAL_ADDRESS;
+}
+
+bool isPure(const Instruction* instruction) {
+    switch (instruction->opcode) {
+        case Opcode::PARAM:
+        case Opcode::LOAD:
+        case Opcode::CALL:
+        case Opcode::PHI:
+        case Opcode::COPY:
+            return false;
+        default:
+            return !instruction->hasSideEffects();
+    }
+}
+
+int64_t widthOf(ValueType type) {
+    return type == ValueType::I32 || type == ValueType::F32 ? 4 : 8;
+}
+
+// 支配木を深さ優先でたどり、支配する位置で計算済みの式と読み出し済みのメモリを使い回す
+class GlobalValueNumbering final {
+public:
+    explicit GlobalValueNumbering(Function& function) : _function(function), _aliases(function) {
+    }
+
+    size_t run() {
+        _function.recomputeControlFlow();
+        DominatorTree dominators{_function};
+
+        struct Frame {
+            BasicBlock* block;
+            size_t child;
+            size_t logSize;
+            std::vector<AvailableMemory> memory;
+        };
+        std::vector<Frame> frames;
+        frames.push_back({_function.blocks[0].get(), 0, 0, {}});
+        visit(frames.back().block, frames.back().memory);
+
+        while (!frames.empty()) {
+            auto& frame = frames.back();
+            const auto& children = dominators.children(frame.block);
+            if (frame.child < children.size()) {
+                auto* child = children[frame.child++];
+                // 先行ブロックが親だけなら、親の末尾のメモリの状態をそのまま引き継げる
+                std::vector<AvailableMemory> memory;
+                if (child->predecessors.size() == 1) {
+                    memory = frame.memory;
+                }
+                frames.push_back({child, 0, _log.size(), std::move(memory)});
+                visit(frames.back().block, frames.back().memory);
+                continue;
+            }
+            while (_log.size() > frame.logSize) {
+                _expressions.erase(_log.back());
+                _log.pop_back();
+            }
+            frames.pop_back();
+        }
+
+        _function.replaceUses(_replacements);
+        size_t eliminated = 0;
+        for (const auto& block : _function.blocks) {
+            std::erase_if(block->instructions, [&](const std::unique_ptr<Instruction>& instruction) {
+                if (!_replacements.contains(instruction.get())) {
+                    return false;
+                }
+                eliminated += isFree(instruction.get()) ? 0 : 1;
+                return true;
+            });
+        }
+        return eliminated;
+    }
+
+private:
+    Instruction* resolve(Instruction* value) const {
+        for (auto it = _replacements.find(value); it != _replacements.end() && it->second != value;
+             it = _replacements.find(value)) {
+            value = it->second;
+        }
+        return value;
+    }
+
+    void replace(Instruction* instruction, Instruction* value) {
+        _replacements.emplace(instruction, value);
+    }
+
+    void visit(BasicBlock* block, std::vector<AvailableMemory>& memory) {
+        for (const auto& owned : block->instructions) {
+            auto* instruction = owned.get();
+            for (auto*& operand : instruction->operands) {
+                operand = resolve(operand);
+            }
+            switch (instruction->opcode) {
+                case Opcode::PHI:
+                    visitPhi(instruction);
+                    break;
+                case Opcode::LOAD:
+                    visitLoad(instruction, memory);
+                    break;
+                case Opcode::STORE:
+                case Opcode::CLEAR:
+                case Opcode::COPY_MEMORY:
+                case Opcode::CALL:
+                    kill(instruction, memory);
+                    if (instruction->opcode == Opcode::STORE) {
+                        auto* value = instruction->operands[1];
+                        if (instruction->immediate == widthOf(value->type)) {
+                            memory.push_back({instruction->operands[0], instruction->immediate, value->type, false, value});
+                        }
+                    }
+                    break;
+                default:
+                    if (isPure(instruction)) {
+                        visitExpression(instruction);
+                    }
+                    break;
+            }
+        }
+    }
+
+    // すべての流入元が同じ値 (か自分自身) の PHI はその値に置き換える
+    void visitPhi(Instruction* phi) {
+        Instruction* same = nullptr;
+        for (auto* operand : phi->operands) {
+            operand = resolve(operand);
+            if (operand == phi || operand == same) {
+                continue;
+            }
+            if (same) {
+                return;
+            }
+            same = operand;
+        }
+        if (same) {
+            replace(phi, same);
+        }
+    }
+
+    void visitExpression(Instruction* instruction) {
+        ExpressionKey key{
+            .opcode = instruction->opcode,
+            .type = instruction->type,
+            .immediate = instruction->immediate,
+            .condition = instruction->condition,
+            .isSigned = instruction->isSigned,
+            .symbol = instruction->symbol,
+            .operands = {},
+        };
+        for (const auto* operand : instruction->operands) {
+            key.operands.emplace_back(operand->id);
+        }
+        if (isCommutative(instruction->opcode)) {
+            std::ranges::sort(key.operands);
+        }
+        auto [it, inserted] = _expressions.try_emplace(std::move(key), instruction);
+        if (inserted) {
+            _log.emplace_back(it->first);
+        } else {
+            replace(instruction, it->second);
+        }
+    }
+
+    void visitLoad(Instruction* load, std::vector<AvailableMemory>& memory) {
+        const auto* address = load->operands[0];
+        for (const auto& available : memory) {
+            if (available.address != address || available.size != load->immediate || available.type != load->type) {
+                continue;
+            }
+            // 型の幅より狭い読み出しは拡張の仕方も一致しなければならない
+            if (load->immediate < widthOf(load->type) && available.isSigned != load->isSigned) {
+                continue;
+            }
+            replace(load, available.value);
+            return;
+        }
+        memory.push_back({address, load->immediate, load->type, load->isSigned, load});
+    }
+
+    void kill(const Instruction* writer, std::vector<AvailableMemory>& memory) const {
+        std::erase_if(memory, [&](const AvailableMemory& available) {
+            return _aliases.mayModify(writer, available.address, available.size);
+        });
+    }
+
+    Function& _function;
+    AliasAnalysis _aliases;
+    std::unordered_map<ExpressionKey, Instruction*, ExpressionKeyHash> _expressions;
+    // 支配木を戻るときに取り消すキー
+    std::vector<ExpressionKey> _log;
+    std::unordered_map<Instruction*, Instruction*> _replacements;
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t numberGlobalValues(ir::Function& function) {
+    return GlobalValueNumbering{function}.run();
+}
+
+} // namespace yoctocc::optimizer
@@ -0,0 +1,370 @@
+#include "Optimizer/Passes.hpp"
+
+#include <format>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Node/Node.hpp"
+#include "Type.hpp"
+
+namespace {
+using namespace yoctocc;
+
+// 展開してよい関数本体のノード数。inline 指定の関数はこの値まで、指定のない関数はその 1/4 まで
+constexpr size_t INLINE_THRESHOLD = 96;
+constexpr size_t DEFAULT_THRESHOLD = INLINE_THRESHOLD / 4;
+
+// 同じ名前の宣言と定義に付いた指定をまとめたもの
+struct InlineHint {
+    bool isInline = false;
+    bool isAlwaysInline = false;
+    bool isNoInline = false;
+};
+
+size_t countNodes(const Node* node) {
+    size_t count = 0;
+    for (; node; node = node->next.get()) {
+        count += 1 + countNodes(node->left.get()) + countNodes(node->right.get()) +
+                 countNodes(node->condition.get()) + countNodes(node->then.get()) + countNodes(node->els.get()) +
+                 countNodes(node->init.get()) + countNodes(node->inc.get()) + countNodes(node->body.get()) +
+                 countNodes(node->arguments.get());
+    }
+    return count;
+}
+
+size_t countReturns(const Node* node) {
+    size_t count = 0;
+    for (; node; node = node->next.get()) {
+        count += (node->nodeType == NodeType::RETURN ? 1 : 0) + countReturns(node->left.get()) +
+                 countReturns(node->right.get()) + countReturns(node->condition.get()) +
+                 countReturns(node->then.get()) + countReturns(node->els.get()) + countReturns(node->init.get()) +
+                 countReturns(node->inc.get()) + countReturns(node->body.get()) + countReturns(node->arguments.get());
+    }
+    return count;
+}
+
+size_t countParameters(const Object* function) {
+    size_t count = 0;
+    for (const Object* param = function->parameters; param; param = param->next.get()) {
+        count++;
+    }
+    return count;
+}
+
+// 呼び出し先の本体を複製する。ローカル変数は呼び出し元に作った変数に、ラベルは展開ごとに新しい名前に置き換え、
+// switch の case の連結も複製したノードにつなぎ直す
+class BodyCloner final {
+public:
+    BodyCloner(const std::unordered_map<const Object*, Object*>& locals, int& labelCount)
+        : _locals(locals), _labelCount(labelCount) {
+    }
+
+    std::unique_ptr<Node> cloneList(const Node* head) {
+        std::unique_ptr<Node> result;
+        auto* tail = &result;
+        for (const Node* node = head; node; node = node->next.get()) {
+            *tail = clone(node);
+            tail = &(*tail)->next;
+        }
+        return result;
+    }
+
+    std::unique_ptr<Node> clone(const Node* node) {
+        auto copy = std::make_unique<Node>(node->nodeType, node->token);
+        copy->integerValue = node->integerValue;
+        copy->floatValue = node->floatValue;
+        copy->type = node->type;
+        copy->left = cloneList(node->left.get());
+        copy->right = cloneList(node->right.get());
+        copy->condition = cloneList(node->condition.get());
+        copy->then = cloneList(node->then.get());
+        copy->els = cloneList(node->els.get());
+        copy->init = cloneList(node->init.get());
+        copy->inc = cloneList(node->inc.get());
+        copy->breakLabel = rename(node->breakLabel);
+        copy->continueLabel = rename(node->continueLabel);
+        copy->body = cloneList(node->body.get());
+        copy->variable = node->variable;
+        if (auto it = _locals.find(node->variable); it != _locals.end()) {
+            copy->variable = it->second;
+        }
+        if (node->member) {
+            copy->member = std::make_unique<Member>();
+            copy->member->name = node->member->name;
+            copy->member->type = node->member->type;
+            copy->member->alignment = node->member->alignment;
+            copy->member->offset = node->member->offset;
+            copy->member->index = node->member->index;
+        }
+        copy->functionName = node->functionName;
+        copy->functionType = node->functionType;
+        copy->arguments = cloneList(node->arguments.get());
+        // case のラベルはパーサーが作った一意な名前、goto / ラベル文の label はソース上の名前
+        copy->label = node->nodeType == NodeType::CASE ? rename(node->label) : node->label;
+        copy->uniqueLabel = rename(node->uniqueLabel);
+        copy->cases = node->cases;
+        copy->defaultCase = node->defaultCase;
+        _clones.emplace(node, copy.get());
+        _cloned.emplace_back(copy.get());
+        return copy;
+    }
+
+    // 複製し終えてから、元のノードを指している case の連結を複製したノードに置き換える
+    void relinkCases() {
+        for (Node* node : _cloned) {
+            node->cases = relinked(node->cases);
+            node->defaultCase = relinked(node->defaultCase);
+        }
+    }
+
+private:
+    std::string rename(const std::string& label) {
+        if (label.empty()) {
+            return label;
+        }
+        auto [it, inserted] = _labels.try_emplace(label);
+        if (inserted) {
+            it->second = std::format(".L..inline.{}", _labelCount++);
+        }
+        return it->second;
+    }
+
+    Node* relinked(Node* node) const {
+        if (!node) {
+            return nullptr;
+        }
+        auto it = _clones.find(node);
+        return it == _clones.end() ? nullptr : it->second;
+    }
+
+    const std::unordered_map<const Object*, Object*>& _locals;
+    int& _labelCount;
+    std::unordered_map<std::string, std::string> _labels;
+    std::unordered_map<const Node*, Node*> _clones;
+    std::vector<Node*> _cloned;
+};
+
+// 呼び出しを、引数を仮引数の複製に代入して本体を実行する文式に置き換える
+//   f(a, b) => ({ p = a; q = b; 本体; 戻り値; })
+// 本体の最後の文が唯一の return ならその式を文式の値にし、それ以外の return は
+// 戻り値の変数に代入して本体の後ろのラベルへ飛ぶ
+class Inliner final {
+public:
+    explicit Inliner(Object* program) : _program(program) {
+    }
+
+    size_t run() {
+        std::vector<Object*> functions;
+        for (Object* object = _program; object; object = object->next.get()) {
+            if (!object->isFunction) {
+                continue;
+            }
+            auto& hint = _hints[object->name];
+            hint.isInline |= object->isInline;
+            hint.isAlwaysInline |= object->isAlwaysInline;
+            hint.isNoInline |= object->isNoInline;
+            if (object->isDefinition && object->body) {
+                _definitions[object->name] = object;
+                functions.emplace_back(object);
+            }
+        }
+
+        // 先に定義された関数から展開し、展開済みの本体を後の呼び出し元に複製する
+        size_t inlined = 0;
+        for (auto it = functions.rbegin(); it != functions.rend(); ++it) {
+            _caller = *it;
+            inlined += visit(_caller->body);
+        }
+        return inlined;
+    }
+
+private:
+    size_t visitList(std::unique_ptr<Node>& head) {
+        size_t inlined = 0;
+        for (auto* slot = &head; *slot; slot = &(*slot)->next) {
+            inlined += visit(*slot);
+        }
+        return inlined;
+    }
+
+    // 展開した本体の中はたどらないので、再帰呼び出しを含む関数でも展開は 1 段で止まる
+    size_t visit(std::unique_ptr<Node>& slot) {
+        if (!slot) {
+            return 0;
+        }
+        Node* node = slot.get();
+        size_t inlined = visit(node->left) + visit(node->right) + visit(node->condition) + visit(node->then) +
+                         visit(node->els) + visit(node->init) + visit(node->inc) + visitList(node->body) +
+                         visitList(node->arguments);
+        if (node->nodeType != NodeType::FUNCTION_CALL) {
+            return inlined;
+        }
+        const Object* callee = inlinableCallee(node);
+        if (!callee) {
+            return inlined;
+        }
+        auto replacement = expand(node, callee);
+        replacement->next = std::move(node->next);
+        slot = std::move(replacement);
+        return inlined + 1;
+    }
+
+    const Object* inlinableCallee(const Node* call) const {
+        auto it = _definitions.find(call->functionName);
+        if (it == _definitions.end() || it->second == _caller) {
+            return nullptr;
+        }
+        const Object* callee = it->second;
+        const auto& hint = _hints.at(callee->name);
+        const auto* returnType = callee->type->returnType.get();
+        if (hint.isNoInline || callee->vaArea || callee->type->isVariadic || returnType->kind == TypeKind::STRUCT ||
+            returnType->kind == TypeKind::UNION) {
+            return nullptr;
+        }
+        size_t arguments = 0;
+        for (const Node* argument = call->arguments.get(); argument; argument = argument->next.get()) {
+            arguments++;
+        }
+        if (arguments != countParameters(callee)) {
+            return nullptr;
+        }
+        if (hint.isAlwaysInline) {
+            return callee;
+        }
+        const size_t threshold = hint.isInline ? INLINE_THRESHOLD : DEFAULT_THRESHOLD;
+        return countNodes(callee->body.get()) <= threshold ? callee : nullptr;
+    }
+
+    std::unique_ptr<Node> expand(Node* call, const Object* callee) {
+        const Token* token = call->token;
+        // 呼び出し先のローカル変数 (仮引数を含む) を呼び出し元に作る
+        std::unordered_map<const Object*, Object*> locals;
+        for (const Object* local = callee->locals.get(); local; local = local->next.get()) {
+            auto copy = makeVariable(local->name, local->type, true);
+            copy->alignment = local->alignment;
+            copy->next = std::move(_caller->locals);
+            locals.emplace(local, copy.get());
+            _caller->locals = std::move(copy);
+        }
+
+        std::unique_ptr<Node> head;
+        auto* tail = &head;
+        auto append = [&](std::unique_ptr<Node> statement) {
+            *tail = std::move(statement);
+            tail = &(*tail)->next;
+        };
+        auto expressionStatement = [&](std::unique_ptr<Node> expression) {
+            type::addType(expression.get());
+            return createUnaryNode(NodeType::EXPRESSION_STATEMENT, token, std::move(expression));
+        };
+
+        auto arguments = std::move(call->arguments);
+        for (const Object* param = callee->parameters; param; param = param->next.get()) {
+            auto rest = std::move(arguments->next);
+            append(expressionStatement(createBinaryNode(NodeType::ASSIGN, token,
+                                                        createVariableNode(token, locals.at(param)),
+                                                        std::move(arguments))));
+            arguments = std::move(rest);
+        }
+
+        BodyCloner cloner{locals, _labelCount};
+        const auto& returnType = callee->type->returnType;
+        const bool returnsValue = returnType->kind != TypeKind::VOID;
+        const Node* body = callee->body->body.get();
+        const Node* last = body;
+        while (last && last->next) {
+            last = last->next.get();
+        }
+
+        const bool endsWithReturn = last && last->nodeType == NodeType::RETURN;
+        if (countReturns(body) == (endsWithReturn ? 1 : 0) && (endsWithReturn || !returnsValue)) {
+            // return が最後の文にしかない
+            for (const Node* statement = body; statement; statement = statement->next.get()) {
+                if (statement != last || statement->nodeType != NodeType::RETURN) {
+                    append(cloner.clone(statement));
+                } else if (statement->left) {
+                    append(expressionStatement(cloner.clone(statement->left.get())));
+                }
+            }
+            cloner.relinkCases();
+        } else {
+            Object* result = nullptr;
+            if (returnsValue) {
+                auto variable = makeVariable("", returnType, true);
+                result = variable.get();
+                variable->next = std::move(_caller->locals);
+                _caller->locals = std::move(variable);
+            }
+            auto end = std::format(".L..inline.{}", _labelCount++);
+            auto statements = cloner.cloneList(body);
+            // return を置き換えると複製したノードが解放されるので、その前に case をつなぎ直す
+            cloner.relinkCases();
+            for (auto* slot = &statements; *slot; slot = &(*slot)->next) {
+                rewriteReturns(*slot, result, end);
+            }
+            append(std::move(statements));
+            while (*tail) {
+                tail = &(*tail)->next;
+            }
+            auto label = std::make_unique<Node>(NodeType::LABEL, token);
+            label->uniqueLabel = end;
+            label->left = createBlockNode(token);
+            append(std::move(label));
+            if (result) {
+                append(expressionStatement(createVariableNode(token, result)));
+            }
+        }
+
+        auto expression = std::make_unique<Node>(NodeType::STATEMENT_EXPRESSION, token);
+        expression->body = std::move(head);
+        expression->type = returnType;
+        return expression;
+    }
+
+    // return e; => { 戻り値 = e; goto end; }
+    static void rewriteReturns(std::unique_ptr<Node>& slot, Object* result, const std::string& end) {
+        Node* node = slot.get();
+        for (auto* child : {&node->left, &node->right, &node->condition, &node->then, &node->els, &node->init,
+                            &node->inc, &node->body, &node->arguments}) {
+            for (auto* element = child; *element; element = &(*element)->next) {
+                rewriteReturns(*element, result, end);
+            }
+        }
+        if (node->nodeType != NodeType::RETURN) {
+            return;
+        }
+        const Token* token = node->token;
+        auto jump = std::make_unique<Node>(NodeType::GOTO, token);
+        jump->uniqueLabel = end;
+        std::unique_ptr<Node> statements;
+        if (node->left) {
+            auto value = std::move(node->left);
+            if (result) {
+                value = createBinaryNode(NodeType::ASSIGN, token, createVariableNode(token, result), std::move(value));
+            }
+            type::addType(value.get());
+            statements = createUnaryNode(NodeType::EXPRESSION_STATEMENT, token, std::move(value));
+            statements->next = std::move(jump);
+        } else {
+            statements = std::move(jump);
+        }
+        auto block = createBlockNode(token, std::move(statements));
+        block->next = std::move(node->next);
+        slot = std::move(block);
+    }
+
+    Object* _program;
+    Object* _caller = nullptr;
+    std::unordered_map<std::string, InlineHint> _hints;
+    std::unordered_map<std::string, Object*> _definitions;
+    int _labelCount = 0;
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t inlineFunctions(Object* program) {
+    return Inliner{program}.run();
+}
+
+} // namespace yoctocc::optimizer
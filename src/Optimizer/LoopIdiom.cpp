@@ -0,0 +1,375 @@
+#include "Optimizer/Passes.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "IR/Analysis.hpp"
+#include "IR/IR.hpp"
+#include "IR/Loops.hpp"
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+// 定数 (定数の符号拡張と、どの辺からも同じ定数が来る PHI を含む) ならその値
+std::optional<int64_t> constantOf(const Instruction* value) {
+    switch (value->opcode) {
+        case Opcode::CONST:
+            return value->type == ValueType::I32 ? static_cast<int32_t>(value->immediate) : value->immediate;
+        case Opcode::SEXT:
+            if (value->operands[0]->opcode == Opcode::CONST) {
+                return static_cast<int32_t>(value->operands[0]->immediate);
+            }
+            return std::nullopt;
+        case Opcode::PHI: {
+            std::optional<int64_t> result;
+            for (const auto* operand : value->operands) {
+                if (operand == value) {
+                    continue;
+                }
+                if (operand->opcode != Opcode::CONST || (result && *result != constantOf(operand))) {
+                    return std::nullopt;
+                }
+                result = constantOf(operand);
+            }
+            return result;
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+bool isConstant(const Instruction* value, int64_t expected) {
+    return constantOf(value) == expected;
+}
+
+// binary の一方が value なら、もう一方
+Instruction* otherOperand(const Instruction* binary, const Instruction* value) {
+    if (binary->operands[0] == value) {
+        return binary->operands[1];
+    }
+    return binary->operands[1] == value ? binary->operands[0] : nullptr;
+}
+
+Instruction* incoming(const Instruction* phi, const BasicBlock* block) {
+    auto it = std::ranges::find(phi->blocks, block);
+    return phi->operands[static_cast<size_t>(it - phi->blocks.begin())];
+}
+
+enum class Idiom {
+    // x &= x - 1 か c += x & 1; x >>= 1 を x が 0 になるまで
+    POPCOUNT,
+    // x >>= 1 を x が 0 になるまで (x のビット幅 - clz)
+    BIT_WIDTH,
+    // x >>= 1 を最下位ビットが 1 になるまで
+    TRAILING_ZEROS,
+};
+
+// ビットを 1 つずつ調べて数える 1 ブロックのループ
+//   guard:     condbr (x0 についての条件), preheader, exit
+//   preheader: br body
+//   body:      x = phi [x0, preheader], [x', body]; c = phi [c0, preheader], [c', body]
+//              x' = x & (x - 1); c' = c + 1; condbr (x' != 0), body, exit
+// を、本体を 1 回だけ通り c' = c + popcount(x) を計算する形にする。ループを続ける条件は入口でも調べてあるので、
+// 本体に入る x0 は条件を満たす (0 でない、最下位ビットが 0 など)。認める組み合わせは
+//   x' = x & (x - 1), c' = c + 1, x' != 0 の間:         c + popcount(x), x' = 0 (x86-64-v2)
+//   x' = x >> 1, c' = c + (x & 1), x' != 0 の間:         c + popcount(x), x' = 0 (x86-64-v2)
+//   x' = x >> 1, c' = c + 1, x' != 0 の間:               c + (ビット幅 - clz(x)), x' = 0 (x86-64-v3)
+//   x' = x >> 1 (算術シフトも可), c' = c + 1, (x' & 1) == 0 の間: c + ctz(x), x' = x >> ctz(x) (x86-64-v3)
+// x が 0 だと ctz のループは終わらないが、副作用のないループは終わると仮定してよい (C11 6.8.5p6)
+class LoopIdiomRecognition final {
+public:
+    LoopIdiomRecognition(Function& function, int isaLevel) : _function(function), _isaLevel(isaLevel) {
+    }
+
+    size_t run() {
+        if (_isaLevel < 2) {
+            return 0;
+        }
+        _function.recomputeControlFlow();
+        std::vector<BasicBlock*> headers;
+        {
+            DominatorTree dominators{_function};
+            for (const auto& loop : findLoops(_function, dominators)) {
+                if (loop.blocks.size() == 1) {
+                    headers.emplace_back(loop.header);
+                }
+            }
+        }
+
+        size_t replaced = 0;
+        for (auto* header : headers) {
+            if (replace(header)) {
+                replaced++;
+            }
+        }
+        return replaced;
+    }
+
+private:
+    bool replace(BasicBlock* body) {
+        auto* terminator = body->terminator();
+        if (terminator->opcode != Opcode::CONDBR || body->predecessors.size() != 2) {
+            return false;
+        }
+        const bool loopIsTrue = terminator->blocks[0] == body;
+        auto* exit = terminator->blocks[loopIsTrue ? 1 : 0];
+        if (terminator->blocks[loopIsTrue ? 0 : 1] != body || exit == body) {
+            return false;
+        }
+        auto* preheader = body->predecessors[0] == body ? body->predecessors[1] : body->predecessors[0];
+        if (preheader->successors.size() != 1 || preheader->predecessors.size() != 1) {
+            return false;
+        }
+
+        // ループを続ける条件: x' != 0 か (x' & 1) == 0
+        auto* compare = terminator->operands[0];
+        if (compare->opcode != Opcode::CMP || compare->parent != body) {
+            return false;
+        }
+        const auto condition = loopIsTrue ? compare->condition : invertCondition(compare->condition);
+        Instruction* tested = nullptr;
+        if (isConstant(compare->operands[1], 0)) {
+            tested = compare->operands[0];
+        } else if (isConstant(compare->operands[0], 0)) {
+            tested = compare->operands[1];
+        } else {
+            return false;
+        }
+        Instruction* next = tested;
+        const bool testsLowestBit = condition == Condition::EQ;
+        if (testsLowestBit) {
+            if (tested->opcode != Opcode::AND || tested->parent != body) {
+                return false;
+            }
+            next = isConstant(tested->operands[1], 1) ? tested->operands[0]
+                   : isConstant(tested->operands[0], 1) ? tested->operands[1]
+                                                        : nullptr;
+        } else if (condition != Condition::NE) {
+            return false;
+        }
+        if (!next || next->parent != body || (next->type != ValueType::I32 && next->type != ValueType::I64)) {
+            return false;
+        }
+
+        // x と c の PHI (ほかの PHI は定数だけ)
+        Instruction* x = nullptr;
+        Instruction* counter = nullptr;
+        for (const auto& instruction : body->instructions) {
+            if (instruction->opcode != Opcode::PHI) {
+                break;
+            }
+            if (incoming(instruction.get(), body) == next) {
+                x = instruction.get();
+            } else if (!constantOf(instruction.get())) {
+                if (counter) {
+                    return false;
+                }
+                counter = instruction.get();
+            }
+        }
+        if (!x || !counter || (counter->type != ValueType::I32 && counter->type != ValueType::I64)) {
+            return false;
+        }
+
+        // x' の計算
+        std::vector<const Instruction*> pattern = {compare, next};
+        bool clearsLowest = false;
+        if (next->opcode == Opcode::AND) {
+            auto* decremented = otherOperand(next, x);
+            if (testsLowestBit || !decremented || decremented->parent != body ||
+                !((decremented->opcode == Opcode::ADD && decremented->operands[0] == x &&
+                   isConstant(decremented->operands[1], -1)) ||
+                  (decremented->opcode == Opcode::SUB && decremented->operands[0] == x &&
+                   isConstant(decremented->operands[1], 1)))) {
+                return false;
+            }
+            pattern.emplace_back(decremented);
+            clearsLowest = true;
+        } else if ((next->opcode == Opcode::SHR || (testsLowestBit && next->opcode == Opcode::SAR)) &&
+                   next->operands[0] == x && isConstant(next->operands[1], 1)) {
+            // x >> 1
+        } else {
+            return false;
+        }
+        if (testsLowestBit) {
+            pattern.emplace_back(tested);
+        }
+
+        // c' の計算 (c + 1 か c + (x & 1)。c を広げて足し、戻すものも認める)
+        auto* counterNext = incoming(counter, body);
+        auto* sum = counterNext;
+        const bool isWidened = sum->opcode == Opcode::TRUNC;
+        if (isWidened) {
+            pattern.emplace_back(sum);
+            sum = sum->operands[0];
+        }
+        if (sum->opcode != Opcode::ADD || sum->parent != body) {
+            return false;
+        }
+        pattern.emplace_back(sum);
+        Instruction* step = nullptr;
+        for (size_t i = 0; i < 2; i++) {
+            const auto* operand = sum->operands[i];
+            if (isWidened && operand->opcode == Opcode::SEXT && operand->operands[0] == counter &&
+                operand->parent == body) {
+                pattern.emplace_back(operand);
+                step = sum->operands[1 - i];
+                break;
+            }
+            if (!isWidened && operand == counter) {
+                step = sum->operands[1 - i];
+                break;
+            }
+        }
+        if (!step) {
+            return false;
+        }
+        Idiom idiom;
+        if (isConstant(step, 1)) {
+            idiom = clearsLowest ? Idiom::POPCOUNT : testsLowestBit ? Idiom::TRAILING_ZEROS : Idiom::BIT_WIDTH;
+        } else if (!clearsLowest && !testsLowestBit && step->opcode == Opcode::AND && step->parent == body &&
+                   otherOperand(step, x) && isConstant(otherOperand(step, x), 1)) {
+            pattern.emplace_back(step);
+            idiom = Idiom::POPCOUNT;
+        } else {
+            return false;
+        }
+        if (idiom != Idiom::POPCOUNT && _isaLevel < 3) {
+            return false;
+        }
+
+        // 本体にはパターンの命令だけがあり、ループの外では x' と c' だけを使う
+        const std::unordered_set<const Instruction*> members(pattern.begin(), pattern.end());
+        for (const auto& instruction : body->instructions) {
+            if (instruction->opcode != Opcode::PHI && !instruction->isTerminator() &&
+                instruction->opcode != Opcode::CONST && !members.contains(instruction.get())) {
+                return false;
+            }
+        }
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                for (const auto* operand : instruction->operands) {
+                    if (operand->parent != body || operand->opcode == Opcode::CONST || constantOf(operand)) {
+                        continue;
+                    }
+                    const bool inBody = block.get() == body && instruction->opcode != Opcode::PHI;
+                    if (!inBody && operand != next && operand != counterNext) {
+                        return false;
+                    }
+                }
+            }
+        }
+        if (!guards(preheader, compare, loopIsTrue, next, incoming(x, preheader))) {
+            return false;
+        }
+
+        rewrite(body, exit, idiom, x, counter, next, counterNext, members);
+        return true;
+    }
+
+    // preheader の唯一の先行ブロックが、x0 について本体の末尾と同じ条件を調べて preheader へ来るか
+    static bool guards(const BasicBlock* preheader, const Instruction* compare, bool loopIsTrue,
+                       const Instruction* next, const Instruction* initial) {
+        const auto* guard = preheader->predecessors[0]->terminator();
+        if (guard->opcode != Opcode::CONDBR || guard->blocks[0] == guard->blocks[1]) {
+            return false;
+        }
+        const bool enterIsTrue = guard->blocks[0] == preheader;
+        return enterIsTrue == loopIsTrue && matches(guard->operands[0], compare, next, initial);
+    }
+
+    // guard が、test の next を initial に置き換えた計算と同じか
+    static bool matches(const Instruction* guard, const Instruction* test, const Instruction* next,
+                        const Instruction* initial) {
+        if (test == next) {
+            return guard == initial;
+        }
+        if (guard == test) {
+            return true;
+        }
+        if (test->opcode == Opcode::CONST || constantOf(test)) {
+            return constantOf(guard) == constantOf(test) && guard->type == test->type;
+        }
+        if (guard->opcode != test->opcode || guard->type != test->type || guard->condition != test->condition ||
+            guard->operands.size() != test->operands.size() || test->opcode == Opcode::PHI) {
+            return false;
+        }
+        for (size_t i = 0; i < test->operands.size(); i++) {
+            if (!matches(guard->operands[i], test->operands[i], next, initial)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void rewrite(BasicBlock* body, BasicBlock* exit, Idiom idiom, Instruction* x, Instruction* counter,
+                 Instruction* next, Instruction* counterNext, const std::unordered_set<const Instruction*>& pattern) {
+        const size_t line = counterNext->line;
+        auto emit = [&](Opcode opcode, ValueType type, std::initializer_list<Instruction*> operands) {
+            auto instruction = _function.create(opcode, type, operands);
+            instruction->line = line;
+            return body->insertBefore(nullptr, std::move(instruction));
+        };
+        auto constant = [&](ValueType type, int64_t value) {
+            auto instruction = _function.create(Opcode::CONST, type);
+            instruction->immediate = value;
+            return body->insertBefore(nullptr, std::move(instruction));
+        };
+
+        const auto type = x->type;
+        Instruction* count = nullptr;
+        Instruction* last = nullptr;
+        switch (idiom) {
+            case Idiom::POPCOUNT:
+                count = emit(Opcode::POPCOUNT, type, {x});
+                last = constant(type, 0);
+                break;
+            case Idiom::BIT_WIDTH:
+                count = emit(Opcode::SUB, type,
+                             {constant(type, type == ValueType::I32 ? 32 : 64), emit(Opcode::CLZ, type, {x})});
+                last = constant(type, 0);
+                break;
+            case Idiom::TRAILING_ZEROS:
+                count = emit(Opcode::CTZ, type, {x});
+                last = emit(next->opcode, type, {x, count});
+                break;
+        }
+        if (counter->type != type) {
+            count = emit(counter->type == ValueType::I32 ? Opcode::TRUNC : Opcode::ZEXT, counter->type, {count});
+        }
+        auto* total = emit(Opcode::ADD, counter->type, {counter, count});
+
+        // 本体は 1 回だけ通るので、PHI は preheader から来る値になる
+        std::unordered_map<Instruction*, Instruction*> replacements{{counterNext, total}, {next, last}};
+        auto* terminator = body->terminator();
+        terminator->opcode = Opcode::BR;
+        terminator->operands.clear();
+        terminator->blocks = {exit};
+        for (const auto& phi : body->instructions) {
+            if (phi->opcode != Opcode::PHI) {
+                break;
+            }
+            replacements.emplace(phi.get(), phi->operands[phi->blocks[0] == body ? 1 : 0]);
+        }
+        _function.replaceUses(replacements);
+        std::erase_if(body->instructions, [&](const auto& instruction) {
+            return instruction->opcode == Opcode::PHI || pattern.contains(instruction.get());
+        });
+        _function.recomputeControlFlow();
+    }
+
+    Function& _function;
+    const int _isaLevel;
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t recognizeLoopIdioms(ir::Function& function, int isaLevel) {
+    return LoopIdiomRecognition{function, isaLevel}.run();
+}
+
+} // namespace yoctocc::optimizer
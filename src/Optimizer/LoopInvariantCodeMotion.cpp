@@ -0,0 +1,147 @@
+#include "Optimizer/Passes.hpp"
+
+#include <algorithm>
+#include <vector>
+#include "IR/Analysis.hpp"
+#include "IR/IR.hpp"
+#include "IR/Loops.hpp"
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+// 定数とアドレスは使う場所で作り直すので、動かしても命令は減らない
+bool isFree(const Instruction* instruction) {
+    return instruction->opcode == Opcode::CONST || instruction->opcode == Opcode::FRAME_ADDRESS ||
+           instruction->opcode == Opcode::GLOBAL_ADDRESS;
+}
+
+bool mayTrap(const Instruction* instruction) {
+    switch (instruction->opcode) {
+        case Opcode::SDIV:
+        case Opcode::SREM: {
+            // 0 除算と INT_MIN / -1
+            const auto* divisor = instruction->operands[1];
+            return divisor->opcode != Opcode::CONST || divisor->immediate == 0 || divisor->immediate == -1;
+        }
+        case Opcode::UDIV:
+        case Opcode::UREM: {
+            const auto* divisor = instruction->operands[1];
+            return divisor->opcode != Opcode::CONST || divisor->immediate == 0;
+        }
+        default:
+            return false;
+    }
+}
+
+class LoopInvariantCodeMotion final {
+public:
+    explicit LoopInvariantCodeMotion(Function& function) : _function(function) {
+    }
+
+    size_t run() {
+        _function.recomputeControlFlow();
+        {
+            DominatorTree dominators{_function};
+            for (const auto& loop : findLoops(_function, dominators)) {
+                insertPreheader(_function, loop);
+            }
+        }
+
+        DominatorTree dominators{_function};
+        AliasAnalysis aliases{_function};
+        size_t hoisted = 0;
+        // 内側のループから順に処理するので、内側の前ヘッダへ出した命令は外側のループでさらに外へ出せる
+        for (const auto& loop : findLoops(_function, dominators)) {
+            hoisted += hoist(loop, dominators, aliases);
+        }
+        return hoisted;
+    }
+
+private:
+    size_t hoist(const Loop& loop, const DominatorTree& dominators, const AliasAnalysis& aliases) {
+        auto* preheader = preheaderOf(loop);
+        if (!preheader) {
+            return 0;
+        }
+
+        // ループの中でメモリに書き込む命令
+        std::vector<const Instruction*> writers;
+        bool hasCall = false;
+        for (auto* block : loop.blocks) {
+            for (const auto& instruction : block->instructions) {
+                switch (instruction->opcode) {
+                    case Opcode::CALL:
+                        hasCall = true;
+                        [[fallthrough]];
+                    case Opcode::STORE:
+                    case Opcode::CLEAR:
+                    case Opcode::COPY_MEMORY:
+                        writers.emplace_back(instruction.get());
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        // 呼び出しがなく、すべての出口より前に実行されるブロックの命令は、ループに入れば必ず 1 回は実行される
+        auto alwaysExecuted = [&](const BasicBlock* block) {
+            return !hasCall && !loop.exiting.empty() &&
+                   std::ranges::all_of(loop.exiting,
+                                       [&](const BasicBlock* exiting) { return dominators.dominates(block, exiting); });
+        };
+        auto isInvariant = [&](const Instruction* instruction) {
+            if (instruction->opcode == Opcode::PHI || instruction->hasSideEffects()) {
+                return false;
+            }
+            return std::ranges::none_of(instruction->operands,
+                                        [&](const Instruction* operand) { return loop.contains(operand->parent); });
+        };
+        auto canHoist = [&](const Instruction* instruction) {
+            if (!isInvariant(instruction)) {
+                return false;
+            }
+            if (mayTrap(instruction)) {
+                return alwaysExecuted(instruction->parent);
+            }
+            if (instruction->opcode != Opcode::LOAD) {
+                return true;
+            }
+            // 読み出しはループの中で書き換えられず、ループを 1 回も回らなくても読んでよいアドレスだけ
+            const auto* address = instruction->operands[0];
+            if (std::ranges::any_of(writers, [&](const Instruction* writer) {
+                    return aliases.mayModify(writer, address, instruction->immediate);
+                })) {
+                return false;
+            }
+            return aliases.isDereferenceable(address, instruction->immediate) ||
+                   alwaysExecuted(instruction->parent);
+        };
+
+        size_t hoisted = 0;
+        for (auto* block : loop.blocks) {
+            for (size_t i = 0; i < block->instructions.size();) {
+                auto* instruction = block->instructions[i].get();
+                if (!canHoist(instruction)) {
+                    i++;
+                    continue;
+                }
+                hoisted += isFree(instruction) ? 0 : 1;
+                preheader->insertBefore(nullptr, block->remove(instruction));
+            }
+        }
+        return hoisted;
+    }
+
+    Function& _function;
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t hoistLoopInvariants(ir::Function& function) {
+    return LoopInvariantCodeMotion{function}.run();
+}
+
+} // namespace yoctocc::optimizer
@@ -0,0 +1,307 @@
+#include "Optimizer/Passes.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include "IR/Analysis.hpp"
+#include "IR/IR.hpp"
+#include "IR/Loops.hpp"
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+// ヘッダから複製してよい命令の数 (定数とアドレスを除く)
+constexpr size_t MAX_DUPLICATED_INSTRUCTIONS = 8;
+
+bool isFree(const Instruction* instruction) {
+    return instruction->opcode == Opcode::CONST || instruction->opcode == Opcode::FRAME_ADDRESS ||
+           instruction->opcode == Opcode::GLOBAL_ADDRESS;
+}
+
+// 先頭で条件を調べるループ
+//   preheader: br header
+//   header:    phi ...; 条件の計算; condbr body, exit
+//   latch:     br header
+// を、入口で 1 回だけ条件を調べ、末尾の条件分岐で本体の先頭へ戻る形にする
+//   preheader: 条件の計算 (PHI は入口の値); condbr body, exit
+//   body:      phi (preheader の値, latch の値) ...
+//   latch:     条件の計算 (PHI は戻る値); condbr body, exit
+// ヘッダで定義した値は、ループの中では body の PHI、ループの後では exit の PHI に置き換える
+class LoopRotation final {
+public:
+    explicit LoopRotation(Function& function) : _function(function) {
+    }
+
+    size_t run() {
+        _function.recomputeControlFlow();
+        std::vector<BasicBlock*> headers;
+        {
+            DominatorTree dominators{_function};
+            for (const auto& loop : findLoops(_function, dominators)) {
+                headers.emplace_back(loop.header);
+            }
+        }
+
+        size_t rotated = 0;
+        for (auto* header : headers) {
+            // 回転するたびに CFG が変わるので、ループを探し直す
+            DominatorTree dominators{_function};
+            auto loops = findLoops(_function, dominators);
+            auto it = std::ranges::find(loops, header, &Loop::header);
+            if (it == loops.end()) {
+                continue;
+            }
+            if (!insertPreheader(_function, *it)) {
+                continue;
+            }
+            DominatorTree updated{_function};
+            loops = findLoops(_function, updated);
+            it = std::ranges::find(loops, header, &Loop::header);
+            if (it != loops.end() && rotate(*it, updated)) {
+                rotated++;
+            }
+        }
+        return rotated;
+    }
+
+private:
+    bool rotate(const Loop& loop, const DominatorTree& dominators) {
+        auto* header = loop.header;
+        auto* preheader = preheaderOf(loop);
+        auto* terminator = header->terminator();
+        if (!preheader || terminator->opcode != Opcode::CONDBR) {
+            return false;
+        }
+        const bool bodyIsTrue = loop.contains(terminator->blocks[0]);
+        auto* body = terminator->blocks[bodyIsTrue ? 0 : 1];
+        auto* exit = terminator->blocks[bodyIsTrue ? 1 : 0];
+        if (!loop.contains(body) || loop.contains(exit) || body == header || body->predecessors.size() != 1 ||
+            body->instructions.front()->opcode == Opcode::PHI) {
+            return false;
+        }
+
+        // 戻る辺はひとつで、無条件にヘッダへ戻る
+        BasicBlock* latch = nullptr;
+        for (auto* predecessor : header->predecessors) {
+            if (!loop.contains(predecessor)) {
+                continue;
+            }
+            if (latch) {
+                return false;
+            }
+            latch = predecessor;
+        }
+        if (!latch || latch == header || latch->terminator()->opcode != Opcode::BR) {
+            return false;
+        }
+
+        // 出口はひとつで、ループの中からしか入らない。ヘッダ以外は本体の先頭が支配する
+        for (auto* block : loop.blocks) {
+            for (auto* successor : block->successors) {
+                if (!loop.contains(successor) && successor != exit) {
+                    return false;
+                }
+            }
+            if (block != header && !dominators.dominates(body, block)) {
+                return false;
+            }
+        }
+        if (!std::ranges::all_of(exit->predecessors, [&](const BasicBlock* b) { return loop.contains(b); })) {
+            return false;
+        }
+
+        // ヘッダは副作用のない短い計算だけ
+        size_t cost = 0;
+        for (const auto& instruction : header->instructions) {
+            if (instruction->opcode == Opcode::PHI || instruction->isTerminator()) {
+                continue;
+            }
+            if (instruction->hasSideEffects() || instruction->opcode == Opcode::CALL) {
+                return false;
+            }
+            cost += isFree(instruction.get()) ? 0 : 1;
+        }
+        if (cost > MAX_DUPLICATED_INSTRUCTIONS) {
+            return false;
+        }
+
+        _header = header;
+        _body = body;
+        _exit = exit;
+        _preheader = preheader;
+        _latch = latch;
+        _fromPreheader.clear();
+        _fromLatch.clear();
+        _inBody.clear();
+        _inExit.clear();
+        _pending.clear();
+
+        // ヘッダの命令を前ヘッダと latch に複製する
+        for (const auto& instruction : header->instructions) {
+            if (instruction->opcode != Opcode::PHI) {
+                break;
+            }
+            for (size_t i = 0; i < instruction->blocks.size(); i++) {
+                auto& map = instruction->blocks[i] == preheader ? _fromPreheader : _fromLatch;
+                map[instruction.get()] = instruction->operands[i];
+            }
+        }
+        for (const auto& instruction : header->instructions) {
+            if (instruction->opcode == Opcode::PHI || instruction->isTerminator()) {
+                continue;
+            }
+            _fromPreheader[instruction.get()] =
+                duplicate(*instruction, preheader, [&](Instruction* value) { return preheaderValue(value); });
+            _fromLatch[instruction.get()] =
+                duplicate(*instruction, latch, [&](Instruction* value) { return latchValue(value); });
+        }
+        retarget(preheader, *terminator, preheaderValue(terminator->operands[0]));
+        retarget(latch, *terminator, latchValue(terminator->operands[0]));
+
+        // exit の PHI のヘッダから来る値は、前ヘッダと latch から来る値に分ける
+        for (auto& phi : exit->instructions) {
+            if (phi->opcode != Opcode::PHI) {
+                break;
+            }
+            auto it = std::ranges::find(phi->blocks, header);
+            if (it == phi->blocks.end()) {
+                continue;
+            }
+            const auto index = static_cast<size_t>(it - phi->blocks.begin());
+            auto* value = phi->operands[index];
+            phi->blocks[index] = preheader;
+            phi->operands[index] = preheaderValue(value);
+            phi->blocks.emplace_back(latch);
+            phi->operands.emplace_back(latchValue(value));
+        }
+
+        // ヘッダの値の残りの使用を、ループの中では body の PHI、ループの後では exit の PHI に置き換える
+        for (const auto& block : _function.blocks) {
+            if (block.get() == header) {
+                continue;
+            }
+            // 置き換え先の PHI を同じブロックに足すことがあるので添字でたどる
+            for (size_t k = 0; k < block->instructions.size(); k++) {
+                auto* instruction = block->instructions[k].get();
+                for (size_t i = 0; i < instruction->operands.size(); i++) {
+                    auto* operand = instruction->operands[i];
+                    if (operand->parent != header) {
+                        continue;
+                    }
+                    const auto* user = instruction->opcode == Opcode::PHI ? instruction->blocks[i] : block.get();
+                    instruction->operands[i] = loop.contains(user) ? inBody(operand) : inExit(operand);
+                }
+            }
+        }
+        // body の PHI は複製がそろってからオペランドを決める (決める途中で増えることもある)
+        for (size_t i = 0; i < _pending.size(); i++) {
+            auto [phi, value] = _pending[i];
+            phi->operands = {preheaderValue(value), latchValue(value)};
+            phi->blocks = {preheader, latch};
+        }
+
+        std::erase_if(_function.blocks, [&](const auto& block) { return block.get() == header; });
+        _function.recomputeControlFlow();
+        return true;
+    }
+
+    // ヘッダの値 value の、前ヘッダの末尾での値
+    Instruction* preheaderValue(Instruction* value) const {
+        return value->parent == _header ? _fromPreheader.at(value) : value;
+    }
+
+    // ヘッダの値 value の、latch の末尾での値 (次の周回でヘッダが計算するはずだった値)
+    Instruction* latchValue(Instruction* value) {
+        if (value->parent != _header) {
+            return value;
+        }
+        auto* result = _fromLatch.at(value);
+        // 戻る値がヘッダで定義した値なら、今の周回でのその値 (body の PHI) になる
+        if (value->opcode == Opcode::PHI && result->parent == _header) {
+            return inBody(result);
+        }
+        return result;
+    }
+
+    template <typename Map>
+    Instruction* duplicate(const Instruction& instruction, BasicBlock* block, Map&& map) {
+        auto copy = _function.create(instruction.opcode, instruction.type);
+        for (auto* operand : instruction.operands) {
+            copy->operands.emplace_back(map(operand));
+        }
+        copy->immediate = instruction.immediate;
+        copy->condition = instruction.condition;
+        copy->isSigned = instruction.isSigned;
+        copy->isVariadic = instruction.isVariadic;
+        copy->symbol = instruction.symbol;
+        copy->line = instruction.line;
+        return block->insertBefore(nullptr, std::move(copy));
+    }
+
+    static void retarget(BasicBlock* block, const Instruction& branch, Instruction* condition) {
+        auto* terminator = block->terminator();
+        terminator->opcode = Opcode::CONDBR;
+        terminator->operands = {condition};
+        terminator->blocks = branch.blocks;
+        terminator->line = branch.line;
+    }
+
+    // ヘッダの値 value の、本体の先頭での値
+    Instruction* inBody(Instruction* value) {
+        auto [it, inserted] = _inBody.try_emplace(value, nullptr);
+        if (inserted) {
+            auto phi = _function.create(Opcode::PHI, value->type);
+            phi->line = value->line;
+            it->second = _body->insertAfterPhis(std::move(phi));
+            _pending.emplace_back(it->second, value);
+        }
+        return it->second;
+    }
+
+    // ヘッダの値 value の、ループを出た後での値
+    Instruction* inExit(Instruction* value) {
+        auto [it, inserted] = _inExit.try_emplace(value, nullptr);
+        if (!inserted) {
+            return it->second;
+        }
+        auto phi = _function.create(Opcode::PHI, value->type);
+        phi->line = value->line;
+        for (auto* predecessor : _exit->predecessors) {
+            if (predecessor == _header) {
+                continue;
+            }
+            phi->blocks.emplace_back(predecessor);
+            phi->operands.emplace_back(inBody(value));
+        }
+        phi->blocks.emplace_back(_preheader);
+        phi->operands.emplace_back(preheaderValue(value));
+        phi->blocks.emplace_back(_latch);
+        phi->operands.emplace_back(latchValue(value));
+        it->second = _exit->insertAfterPhis(std::move(phi));
+        return it->second;
+    }
+
+    Function& _function;
+    BasicBlock* _header = nullptr;
+    BasicBlock* _body = nullptr;
+    BasicBlock* _exit = nullptr;
+    BasicBlock* _preheader = nullptr;
+    BasicBlock* _latch = nullptr;
+    // ヘッダの値ごとに、前ヘッダ / latch に複製した値 (PHI は各辺から来る値)
+    std::unordered_map<const Instruction*, Instruction*> _fromPreheader;
+    std::unordered_map<const Instruction*, Instruction*> _fromLatch;
+    std::unordered_map<const Instruction*, Instruction*> _inBody;
+    std::unordered_map<const Instruction*, Instruction*> _inExit;
+    // オペランドを決めていない body の PHI と、それが表すヘッダの値
+    std::vector<std::pair<Instruction*, Instruction*>> _pending;
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t rotateLoops(ir::Function& function) {
+    return LoopRotation{function}.run();
+}
+
+} // namespace yoctocc::optimizer
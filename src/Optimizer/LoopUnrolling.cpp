@@ -0,0 +1,257 @@
+#include "Optimizer/Passes.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "IR/Analysis.hpp"
+#include "IR/IR.hpp"
+#include "IR/Loops.hpp"
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+// 展開後の本体の命令数の上限 (定数とアドレスを除く)
+constexpr size_t MAX_UNROLLED_INSTRUCTIONS = 128;
+
+bool isFree(const Instruction* instruction) {
+    return instruction->opcode == Opcode::CONST || instruction->opcode == Opcode::FRAME_ADDRESS ||
+           instruction->opcode == Opcode::GLOBAL_ADDRESS;
+}
+
+// 1 ブロックの計数ループ
+//   preheader: br body
+//   body:      phi ...; 本体; next = i + step; condbr (next < n), body, exit
+// を、残りが factor 回以上あるかを調べて本体を factor 個並べたループと、残りを回す元のループにする
+//   preheader: condbr (i + (factor - 1) * step < n), unrolled, body
+//   unrolled:  phi ...; 本体 x factor; condbr (next + (factor - 1) * step < n), unrolled, remainder
+//   remainder: condbr (next < n), body, exit
+//   body:      元のループ (preheader / remainder から入る)
+// 比較は 64 ビットに広げて行うので、途中の i + (factor - 1) * step が桁あふれすることはない
+class LoopUnrolling final {
+public:
+    LoopUnrolling(Function& function, int factor) : _function(function), _factor(factor) {
+    }
+
+    size_t run() {
+        if (_factor < 2) {
+            return 0;
+        }
+        _function.recomputeControlFlow();
+        std::vector<BasicBlock*> headers;
+        {
+            DominatorTree dominators{_function};
+            for (const auto& loop : findLoops(_function, dominators)) {
+                if (loop.blocks.size() == 1) {
+                    headers.emplace_back(loop.header);
+                }
+            }
+        }
+
+        size_t unrolled = 0;
+        for (auto* header : headers) {
+            DominatorTree dominators{_function};
+            auto loops = findLoops(_function, dominators);
+            auto it = std::ranges::find(loops, header, &Loop::header);
+            if (it == loops.end() || hasSeveralEntries(*it) || !insertPreheader(_function, *it)) {
+                continue;
+            }
+            if (unroll(header)) {
+                unrolled++;
+            }
+        }
+        return unrolled;
+    }
+
+private:
+    // ループの外から複数の場所で入るループ (ベクトル化したループの残りを回すループなど) は、
+    // 回る回数が少ないことが多いので展開しない
+    static bool hasSeveralEntries(const Loop& loop) {
+        return std::ranges::count_if(loop.header->predecessors,
+                                     [&](const BasicBlock* block) { return !loop.contains(block); }) > 1;
+    }
+
+    bool unroll(BasicBlock* body) {
+        auto* terminator = body->terminator();
+        if (terminator->opcode != Opcode::CONDBR) {
+            return false;
+        }
+        const bool loopIsTrue = terminator->blocks[0] == body;
+        auto* exit = terminator->blocks[loopIsTrue ? 1 : 0];
+        if (terminator->blocks[loopIsTrue ? 0 : 1] != body || exit == body) {
+            return false;
+        }
+        BasicBlock* preheader = nullptr;
+        for (auto* predecessor : body->predecessors) {
+            if (predecessor != body) {
+                preheader = predecessor;
+            }
+        }
+        if (!preheader || body->predecessors.size() != 2 || preheader->successors.size() != 1) {
+            return false;
+        }
+        const auto induction = findInductionVariable(body, exit);
+        if (!induction) {
+            return false;
+        }
+
+        // 末尾の比較は分岐だけが使う
+        const auto uses = _function.countUses();
+        if (uses.at(terminator->operands[0]) != 1) {
+            return false;
+        }
+        size_t cost = 0;
+        for (const auto& instruction : body->instructions) {
+            if (instruction->opcode == Opcode::CALL) {
+                return false;
+            }
+            cost += isFree(instruction.get()) || instruction->opcode == Opcode::PHI ? 0 : 1;
+        }
+        if (cost * static_cast<size_t>(_factor) > MAX_UNROLLED_INSTRUCTIONS) {
+            return false;
+        }
+
+        _body = body;
+        const auto* compare = terminator->operands[0];
+        const size_t line = terminator->line;
+        auto* unrolled = _function.createBlock();
+        auto* remainder = _function.createBlock();
+
+        // 本体を factor 個並べる。copies[k] は k 番目の複製での本体の値
+        std::vector<std::unordered_map<const Instruction*, Instruction*>> copies(static_cast<size_t>(_factor));
+        std::vector<std::pair<Instruction*, Instruction*>> phis;
+        for (const auto& instruction : body->instructions) {
+            if (instruction->opcode != Opcode::PHI) {
+                break;
+            }
+            auto phi = _function.create(Opcode::PHI, instruction->type);
+            phi->line = instruction->line;
+            auto* result = unrolled->append(std::move(phi));
+            copies[0][instruction.get()] = result;
+            phis.emplace_back(instruction.get(), result);
+        }
+        for (size_t k = 0; k < copies.size(); k++) {
+            auto& copy = copies[k];
+            if (k > 0) {
+                for (const auto& [phi, _] : phis) {
+                    copy[phi] = valueIn(copies[k - 1], incoming(phi, body));
+                }
+            }
+            for (const auto& instruction : body->instructions) {
+                // 末尾の比較は展開したループでは使わない (remainder で作り直す)
+                if (instruction->opcode == Opcode::PHI || instruction->isTerminator() ||
+                    instruction.get() == compare) {
+                    continue;
+                }
+                auto clone = _function.create(instruction->opcode, instruction->type);
+                for (auto* operand : instruction->operands) {
+                    clone->operands.emplace_back(valueIn(copy, operand));
+                }
+                clone->immediate = instruction->immediate;
+                clone->condition = instruction->condition;
+                clone->isSigned = instruction->isSigned;
+                clone->isVariadic = instruction->isVariadic;
+                clone->symbol = instruction->symbol;
+                clone->line = instruction->line;
+                copy[instruction.get()] = unrolled->append(std::move(clone));
+            }
+        }
+        const auto& last = copies.back();
+        for (const auto& [phi, copy] : phis) {
+            copy->operands = {incoming(phi, preheader), valueIn(last, incoming(phi, body))};
+            copy->blocks = {preheader, unrolled};
+        }
+
+        // 残りが factor 回以上あるか
+        auto* bound = widenBound(_function, preheader, *induction);
+        auto enoughLeft = [&](BasicBlock* block, Instruction* value) {
+            return appendTripCheck(_function, block, *induction, bound, value, _factor);
+        };
+        auto branch = [&](BasicBlock* block, Instruction* condition, BasicBlock* ifTrue, BasicBlock* ifFalse) {
+            auto instruction = _function.create(Opcode::CONDBR, ValueType::VOID, {condition});
+            instruction->blocks = {ifTrue, ifFalse};
+            instruction->line = line;
+            block->append(std::move(instruction));
+        };
+
+        preheader->instructions.pop_back();
+        branch(preheader, enoughLeft(preheader, incoming(induction->phi, preheader)), unrolled, body);
+        branch(unrolled, enoughLeft(unrolled, last.at(induction->next)), unrolled, remainder);
+        // 展開したループを抜けた後は、元のループの末尾と同じ比較で残りを回すか決める
+        auto* recheck = remainder->append(_function.create(Opcode::CMP, ValueType::I32));
+        for (auto* operand : compare->operands) {
+            recheck->operands.emplace_back(valueIn(last, operand));
+        }
+        recheck->condition = compare->condition;
+        recheck->line = line;
+        branch(remainder, recheck, loopIsTrue ? body : exit, loopIsTrue ? exit : body);
+
+        // 元のループへは remainder からも入る
+        for (const auto& [phi, _] : phis) {
+            phi->operands.emplace_back(valueIn(last, incoming(phi, body)));
+            phi->blocks.emplace_back(remainder);
+        }
+        for (auto& phi : exit->instructions) {
+            if (phi->opcode != Opcode::PHI) {
+                break;
+            }
+            if (auto it = std::ranges::find(phi->blocks, body); it != phi->blocks.end()) {
+                phi->operands.emplace_back(valueIn(last, phi->operands[static_cast<size_t>(it - phi->blocks.begin())]));
+                phi->blocks.emplace_back(remainder);
+            }
+        }
+
+        // ループの後で本体の値を直接使っていれば (exit の先行ブロックが本体だけのとき)、exit で合流させる
+        std::unordered_map<const Instruction*, Instruction*> merged;
+        for (const auto& block : _function.blocks) {
+            if (block.get() == body || block.get() == unrolled || block.get() == remainder) {
+                continue;
+            }
+            for (size_t k = 0; k < block->instructions.size(); k++) {
+                auto* instruction = block->instructions[k].get();
+                if (instruction->opcode == Opcode::PHI && block.get() == exit) {
+                    continue;
+                }
+                for (auto*& operand : instruction->operands) {
+                    if (operand->parent != body) {
+                        continue;
+                    }
+                    auto [it, inserted] = merged.try_emplace(operand, nullptr);
+                    if (inserted) {
+                        auto phi = _function.create(Opcode::PHI, operand->type, {operand, last.at(operand)});
+                        phi->blocks = {body, remainder};
+                        phi->line = operand->line;
+                        it->second = exit->insertAfterPhis(std::move(phi));
+                    }
+                    operand = it->second;
+                }
+            }
+        }
+
+        _function.recomputeControlFlow();
+        return true;
+    }
+
+    static Instruction* incoming(const Instruction* phi, const BasicBlock* block) {
+        auto it = std::ranges::find(phi->blocks, block);
+        return phi->operands[static_cast<size_t>(it - phi->blocks.begin())];
+    }
+
+    Instruction* valueIn(const std::unordered_map<const Instruction*, Instruction*>& copy, Instruction* value) const {
+        return value->parent == _body ? copy.at(value) : value;
+    }
+
+    Function& _function;
+    const int _factor;
+    BasicBlock* _body = nullptr;
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t unrollLoops(ir::Function& function, int factor) {
+    return LoopUnrolling{function, factor}.run();
+}
+
+} // namespace yoctocc::optimizer
@@ -0,0 +1,670 @@
+#include "Optimizer/Passes.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "IR/Analysis.hpp"
+#include "IR/IR.hpp"
+#include "IR/Loops.hpp"
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+// ベクトルの大きさ (xmm レジスタ 1 本)
+constexpr int64_t VECTOR_BYTES = 16;
+// 実行時に重なりを調べる基底アドレスの組の上限
+constexpr size_t MAX_RUNTIME_CHECKS = 4;
+
+int64_t widthOf(ValueType type) {
+    return type == ValueType::I32 || type == ValueType::F32 ? 4 : 8;
+}
+
+bool isLaneOperation(Opcode opcode, ValueType type) {
+    switch (opcode) {
+        case Opcode::ADD:
+        case Opcode::SUB:
+        case Opcode::AND:
+        case Opcode::OR:
+        case Opcode::XOR:
+            return type == ValueType::I32 || type == ValueType::I64;
+        case Opcode::FADD:
+        case Opcode::FSUB:
+        case Opcode::FMUL:
+        case Opcode::FDIV:
+            return type == ValueType::F32 || type == ValueType::F64;
+        default:
+            return false;
+    }
+}
+
+Instruction* incoming(const Instruction* phi, const BasicBlock* block) {
+    auto it = std::ranges::find(phi->blocks, block);
+    return phi->operands[static_cast<size_t>(it - phi->blocks.begin())];
+}
+
+// 整数の畳み込み acc = acc op x (浮動小数点数は足す順序を変えると丸めが変わるので扱わない)
+struct Reduction {
+    Instruction* phi;
+    // acc op x
+    Instruction* update;
+    // ベクトルの要素どうしと、ループに入る前の値をまとめる演算 (acc - x は要素ごとに引いた結果を足す)
+    Opcode combine;
+};
+
+// 連続した要素を読み書きするアドレス (ループ不変な base + 帰納変数 * 要素の大きさ)
+struct Access {
+    Instruction* instruction;
+    Instruction* base;
+};
+
+// 1 ブロックの計数ループ
+//   preheader: br body
+//   body:      i = phi ...; a[i] などの要素ごとの計算; next = i + 1; condbr (next < n), body, exit
+// を、16 バイトずつ SSE2 のベクトルで計算するループと、残りを回す元のループにする
+//   preheader: condbr (i + (lanes - 1) < n && 書き込みが他の読み書きと 16 バイト以内で重ならない), vector, body
+//   vector:    vi = phi ...; ベクトルの計算; vnext = vi + lanes; condbr (vnext + (lanes - 1) < n), vector, middle
+//   middle:    畳み込みの要素をまとめる; condbr (vnext < n), body, exit
+//   body:      元のループ (preheader / middle から入る)
+// 扱う計算は要素ごとの加減算・論理演算・浮動小数点数の四則演算、整数の畳み込み、
+// 不変な値の書き込み (memset) と同じ大きさの読み出しをそのまま書く写し (memcpy)
+class LoopVectorization final {
+public:
+    explicit LoopVectorization(Function& function) : _function(function) {
+    }
+
+    size_t run() {
+        _function.recomputeControlFlow();
+        std::vector<BasicBlock*> headers;
+        {
+            DominatorTree dominators{_function};
+            for (const auto& loop : findLoops(_function, dominators)) {
+                if (loop.blocks.size() == 1) {
+                    headers.emplace_back(loop.header);
+                }
+            }
+        }
+
+        size_t vectorized = 0;
+        for (auto* header : headers) {
+            DominatorTree dominators{_function};
+            auto loops = findLoops(_function, dominators);
+            auto it = std::ranges::find(loops, header, &Loop::header);
+            if (it == loops.end() || !insertPreheader(_function, *it)) {
+                continue;
+            }
+            if (vectorize(header)) {
+                vectorized++;
+            }
+        }
+        return vectorized;
+    }
+
+private:
+    bool vectorize(BasicBlock* body) {
+        auto* terminator = body->terminator();
+        if (terminator->opcode != Opcode::CONDBR) {
+            return false;
+        }
+        const bool loopIsTrue = terminator->blocks[0] == body;
+        auto* exit = terminator->blocks[loopIsTrue ? 1 : 0];
+        if (terminator->blocks[loopIsTrue ? 0 : 1] != body || exit == body) {
+            return false;
+        }
+        BasicBlock* preheader = nullptr;
+        for (auto* predecessor : body->predecessors) {
+            if (predecessor != body) {
+                preheader = predecessor;
+            }
+        }
+        if (!preheader || body->predecessors.size() != 2 || preheader->successors.size() != 1) {
+            return false;
+        }
+        const auto induction = findInductionVariable(body, exit);
+        if (!induction || induction->step != 1) {
+            return false;
+        }
+
+        _body = body;
+        _induction = *induction;
+        _scales.clear();
+        _addresses.clear();
+        _lanes.clear();
+        _rawLoads.clear();
+        _accesses.clear();
+        _reductions.clear();
+        _elementSize = 0;
+        _extend = std::nullopt;
+        if (!analyze() || !checkUses()) {
+            return false;
+        }
+        const auto checks = collectRuntimeChecks();
+        if (!checks) {
+            return false;
+        }
+        transform(preheader, exit, loopIsTrue, *checks);
+        return true;
+    }
+
+    bool isInvariant(const Instruction* value) const {
+        return value->parent != _body;
+    }
+
+    // 本体の命令を順に調べ、帰納変数から作るアドレスと要素ごとに計算できる値に分ける
+    bool analyze() {
+        for (const auto& owned : _body->instructions) {
+            auto* instruction = owned.get();
+            const auto& operands = instruction->operands;
+            if (instruction == _induction.next || instruction == _induction.compare || instruction->isTerminator()) {
+                continue;
+            }
+            if (instruction->opcode == Opcode::PHI) {
+                if (instruction != _induction.phi && !addReduction(instruction)) {
+                    return false;
+                }
+                continue;
+            }
+            if (auto* reduction = reductionOf(instruction)) {
+                // 畳み込む値はベクトルの要素ごとの値
+                auto* value = operands[0] == reduction->phi ? operands[1] : operands[0];
+                const auto lane = laneOf(value);
+                if (!lane || *lane != vectorType(instruction->type)) {
+                    return false;
+                }
+                _lanes[instruction] = *lane;
+                continue;
+            }
+            switch (instruction->opcode) {
+                case Opcode::SEXT:
+                case Opcode::ZEXT:
+                    if (operands[0] != _induction.phi || (_extend && *_extend != instruction->opcode)) {
+                        return false;
+                    }
+                    _extend = instruction->opcode;
+                    _scales[instruction] = 1;
+                    continue;
+                case Opcode::MUL:
+                case Opcode::SHL: {
+                    auto* index = operands[0];
+                    auto* factor = operands[1];
+                    if (instruction->opcode == Opcode::MUL && index->opcode == Opcode::CONST) {
+                        std::swap(index, factor);
+                    }
+                    auto it = _scales.find(index);
+                    if (it == _scales.end() || it->second != 1 || factor->opcode != Opcode::CONST ||
+                        factor->immediate <= 0 || factor->immediate > 8) {
+                        return false;
+                    }
+                    _scales[instruction] =
+                        instruction->opcode == Opcode::MUL ? factor->immediate : int64_t{1} << factor->immediate;
+                    continue;
+                }
+                case Opcode::ADD: {
+                    auto* base = operands[0];
+                    auto* index = operands[1];
+                    if (!_scales.contains(index)) {
+                        std::swap(base, index);
+                    }
+                    auto it = _scales.find(index);
+                    if (it == _scales.end()) {
+                        break;
+                    }
+                    if (!isInvariant(base)) {
+                        return false;
+                    }
+                    _addresses[instruction] = {it->second, base};
+                    continue;
+                }
+                case Opcode::LOAD:
+                    if (!addLoad(instruction)) {
+                        return false;
+                    }
+                    continue;
+                case Opcode::STORE:
+                    if (!addStore(instruction)) {
+                        return false;
+                    }
+                    continue;
+                default:
+                    break;
+            }
+            if (!isLaneOperation(instruction->opcode, instruction->type)) {
+                return false;
+            }
+            const auto type = vectorType(instruction->type);
+            for (const auto* operand : operands) {
+                if (!isInvariant(operand) && laneOf(operand) != type) {
+                    return false;
+                }
+            }
+            _lanes[instruction] = type;
+        }
+        // 要素の大きさはすべての読み書きで同じ。計算する値の要素もその大きさ
+        if (_accesses.empty()) {
+            return false;
+        }
+        return std::ranges::all_of(_lanes, [&](const auto& entry) {
+            return _rawLoads.contains(entry.first) || widthOf(elementType(entry.second)) == _elementSize;
+        });
+    }
+
+    bool addReduction(Instruction* phi) {
+        if (phi->type != ValueType::I32 && phi->type != ValueType::I64) {
+            return false;
+        }
+        auto* update = incoming(phi, _body);
+        if (update->parent != _body || update->type != phi->type) {
+            return false;
+        }
+        const auto& operands = update->operands;
+        if ((operands[0] == phi) == (operands[1] == phi)) {
+            return false;
+        }
+        switch (update->opcode) {
+            case Opcode::ADD:
+            case Opcode::AND:
+            case Opcode::OR:
+            case Opcode::XOR:
+                _reductions.push_back({phi, update, update->opcode});
+                return true;
+            case Opcode::SUB:
+                if (operands[0] != phi) {
+                    return false;
+                }
+                _reductions.push_back({phi, update, Opcode::ADD});
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    Reduction* reductionOf(const Instruction* update) {
+        auto it = std::ranges::find(_reductions, update, &Reduction::update);
+        return it == _reductions.end() ? nullptr : &*it;
+    }
+
+    std::optional<ValueType> laneOf(const Instruction* value) const {
+        auto it = _lanes.find(value);
+        return it == _lanes.end() || _rawLoads.contains(value) ? std::nullopt : std::optional{it->second};
+    }
+
+    // 連続した要素へのアクセスとして記録する (要素の大きさはループ全体で揃える)
+    bool addAccess(Instruction* instruction) {
+        auto it = _addresses.find(instruction->operands[0]);
+        const int64_t size = instruction->immediate;
+        if (it == _addresses.end() || it->second.first != size || (_elementSize != 0 && _elementSize != size)) {
+            return false;
+        }
+        _elementSize = size;
+        _accesses.push_back({instruction, it->second.second});
+        return true;
+    }
+
+    bool addLoad(Instruction* load) {
+        if (!addAccess(load)) {
+            return false;
+        }
+        if (load->immediate == widthOf(load->type)) {
+            _lanes[load] = vectorType(load->type);
+            return true;
+        }
+        // char / short はそのまま書き写すときだけ (ビット列として 16 バイトずつ読む)
+        if (load->type != ValueType::I32 || load->immediate > 2) {
+            return false;
+        }
+        _lanes[load] = ValueType::V4I32;
+        _rawLoads.insert(load);
+        return true;
+    }
+
+    bool addStore(Instruction* store) {
+        if (!addAccess(store)) {
+            return false;
+        }
+        const auto* value = store->operands[1];
+        if (isInvariant(value)) {
+            return value->type == ValueType::I32 || store->immediate == widthOf(value->type);
+        }
+        if (_rawLoads.contains(value)) {
+            return true;
+        }
+        return laneOf(value) && store->immediate == widthOf(value->type);
+    }
+
+    // ループの中の値はそれぞれ決まった使われ方だけをする
+    bool checkUses() const {
+        std::unordered_map<const Instruction*, std::vector<const Instruction*>> users;
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                for (const auto* operand : instruction->operands) {
+                    if (operand->parent == _body) {
+                        users[operand].emplace_back(instruction.get());
+                    }
+                }
+            }
+        }
+        auto usedOnlyBy = [&](const Instruction* value, auto&& allowed) {
+            auto it = users.find(value);
+            return it == users.end() || std::ranges::all_of(it->second, allowed);
+        };
+        auto inBody = [&](const Instruction* user) { return user->parent == _body; };
+
+        if (!usedOnlyBy(_induction.phi, [&](const Instruction* user) {
+                return user == _induction.next || (inBody(user) && _scales.contains(user));
+            })) {
+            return false;
+        }
+        if (!usedOnlyBy(_induction.compare, [&](const Instruction* user) { return user == _body->terminator(); }) ||
+            !usedOnlyBy(_induction.next, [&](const Instruction* user) {
+                return !inBody(user) || user == _induction.phi || user == _induction.compare;
+            })) {
+            return false;
+        }
+        for (const auto& [index, _] : _scales) {
+            if (!usedOnlyBy(index, [&](const Instruction* user) {
+                    return inBody(user) && (_scales.contains(user) || _addresses.contains(user));
+                })) {
+                return false;
+            }
+        }
+        for (const auto& [address, _] : _addresses) {
+            if (!usedOnlyBy(address, [&](const Instruction* user) {
+                    return inBody(user) && (user->opcode == Opcode::LOAD || user->opcode == Opcode::STORE) &&
+                           user->operands[0] == address && (user->opcode == Opcode::LOAD || user->operands[1] != address);
+                })) {
+                return false;
+            }
+        }
+        for (const auto& reduction : _reductions) {
+            if (!usedOnlyBy(reduction.phi, [&](const Instruction* user) { return user == reduction.update; }) ||
+                !usedOnlyBy(reduction.update, [&](const Instruction* user) {
+                    return !inBody(user) || user == reduction.phi;
+                })) {
+                return false;
+            }
+        }
+        for (const auto& [lane, _] : _lanes) {
+            if (std::ranges::find(_reductions, lane, &Reduction::update) != _reductions.end()) {
+                continue;
+            }
+            if (_rawLoads.contains(lane)) {
+                // 読んだまま同じ大きさで書くだけ
+                if (!usedOnlyBy(lane, [&](const Instruction* user) {
+                        return user->opcode == Opcode::STORE && user->operands[1] == lane &&
+                               user->immediate == lane->immediate;
+                    })) {
+                    return false;
+                }
+                continue;
+            }
+            if (!usedOnlyBy(lane, [&](const Instruction* user) {
+                    return inBody(user) && (_lanes.contains(user) || user->opcode == Opcode::STORE);
+                })) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 書き込みと、別名かもしれない別の基底からの読み書きの組。実行時に 16 バイト以上離れているか調べる
+    std::optional<std::vector<std::pair<Instruction*, Instruction*>>> collectRuntimeChecks() const {
+        AliasAnalysis aliases{_function};
+        std::vector<std::pair<Instruction*, Instruction*>> checks;
+        for (const auto& store : _accesses) {
+            if (store.instruction->opcode != Opcode::STORE) {
+                continue;
+            }
+            for (const auto& other : _accesses) {
+                // 同じ基底なら同じ周回で同じ要素を読み書きするので、順序は変わらない
+                if (other.base == store.base ||
+                    !aliases.mayModify(store.instruction, other.instruction->operands[0], _elementSize)) {
+                    continue;
+                }
+                const std::pair pair{std::min(store.base, other.base, std::less{}),
+                                     std::max(store.base, other.base, std::less{})};
+                if (!std::ranges::contains(checks, pair)) {
+                    checks.emplace_back(pair);
+                }
+            }
+        }
+        if (checks.size() > MAX_RUNTIME_CHECKS) {
+            return std::nullopt;
+        }
+        return checks;
+    }
+
+    void transform(BasicBlock* preheader, BasicBlock* exit, bool loopIsTrue,
+                   const std::vector<std::pair<Instruction*, Instruction*>>& checks) {
+        const int64_t lanes = VECTOR_BYTES / _elementSize;
+        const size_t line = _induction.compare->line;
+        auto* vector = _function.createBlock();
+        auto* middle = _function.createBlock();
+        _preheader = preheader;
+        _splats.clear();
+        _copies.clear();
+
+        auto branch = [&](BasicBlock* block, Instruction* condition, BasicBlock* ifTrue, BasicBlock* ifFalse) {
+            auto instruction = _function.create(Opcode::CONDBR, ValueType::VOID, {condition});
+            instruction->blocks = {ifTrue, ifFalse};
+            instruction->line = line;
+            block->append(std::move(instruction));
+        };
+        auto append = [&](BasicBlock* block, Opcode opcode, ValueType type, std::initializer_list<Instruction*> operands) {
+            auto* instruction = block->append(_function.create(opcode, type, operands));
+            instruction->line = line;
+            return instruction;
+        };
+        auto constant = [&](BasicBlock* block, ValueType type, int64_t value) {
+            auto* instruction = append(block, Opcode::CONST, type, {});
+            instruction->immediate = value;
+            return instruction;
+        };
+
+        // 入口: 残りが lanes 回以上あり、書き込みが他の読み書きと重ならなければベクトルのループへ。
+        // 分岐はループ不変な値を並べ終えてから付け直す
+        preheader->instructions.pop_back();
+        auto* bound = widenBound(_function, preheader, _induction);
+        auto* enter = appendTripCheck(_function, preheader, _induction, bound, incoming(_induction.phi, preheader), lanes);
+        for (const auto& [first, second] : checks) {
+            // |first - second| >= 16 (符号なしで first - second + 15 > 30)
+            auto* distance = append(preheader, Opcode::SUB, ValueType::I64, {first, second});
+            auto* shifted =
+                append(preheader, Opcode::ADD, ValueType::I64, {distance, constant(preheader, ValueType::I64, VECTOR_BYTES - 1)});
+            auto* apart = append(preheader, Opcode::CMP, ValueType::I32,
+                                 {shifted, constant(preheader, ValueType::I64, 2 * VECTOR_BYTES - 2)});
+            apart->condition = Condition::UGT;
+            enter = append(preheader, Opcode::AND, ValueType::I32, {enter, apart});
+        }
+
+        // ベクトルのループ
+        auto* index = append(vector, Opcode::PHI, ValueType::I32, {});
+        _copies[_induction.phi] = index;
+        std::vector<std::pair<const Reduction*, Instruction*>> accumulators;
+        for (const auto& reduction : _reductions) {
+            const auto type = vectorType(reduction.phi->type);
+            const int64_t identity = reduction.combine == Opcode::AND ? -1 : 0;
+            auto* initial = splat(constant(preheader, reduction.phi->type, identity), type);
+            auto* accumulator = append(vector, Opcode::PHI, type, {});
+            accumulator->operands = {initial};
+            accumulator->blocks = {preheader};
+            _copies[reduction.phi] = accumulator;
+            accumulators.emplace_back(&reduction, accumulator);
+        }
+        for (const auto& owned : _body->instructions) {
+            auto* instruction = owned.get();
+            if (instruction->opcode == Opcode::PHI || instruction == _induction.next ||
+                instruction == _induction.compare || instruction->isTerminator()) {
+                continue;
+            }
+            if (instruction->opcode == Opcode::STORE) {
+                auto* store = append(vector, Opcode::STORE, ValueType::VOID,
+                                     {_copies.at(instruction->operands[0]), vectorValue(instruction, instruction->operands[1])});
+                store->immediate = VECTOR_BYTES;
+                store->line = instruction->line;
+                continue;
+            }
+            auto it = _lanes.find(instruction);
+            auto* clone = append(vector, instruction->opcode, it == _lanes.end() ? instruction->type : it->second, {});
+            for (auto* operand : instruction->operands) {
+                clone->operands.emplace_back(it == _lanes.end() ? valueIn(operand) : vectorValue(instruction, operand));
+            }
+            clone->immediate = it != _lanes.end() && instruction->opcode == Opcode::LOAD ? VECTOR_BYTES
+                                                                                           : instruction->immediate;
+            clone->isSigned = instruction->isSigned;
+            clone->line = instruction->line;
+            _copies[instruction] = clone;
+        }
+        auto* next = append(vector, Opcode::ADD, ValueType::I32, {index, constant(vector, ValueType::I32, lanes)});
+        index->operands = {incoming(_induction.phi, preheader), next};
+        index->blocks = {preheader, vector};
+        for (auto& [reduction, accumulator] : accumulators) {
+            accumulator->operands.emplace_back(_copies.at(reduction->update));
+            accumulator->blocks.emplace_back(vector);
+        }
+        branch(vector, appendTripCheck(_function, vector, _induction, bound, next, lanes), vector, middle);
+        branch(preheader, enter, vector, _body);
+
+        // ベクトルのループを抜けたら、畳み込みをまとめ、元のループの末尾と同じ比較で残りを回すか決める
+        std::unordered_map<const Instruction*, Instruction*> results;
+        results[_induction.next] = next;
+        for (auto& [reduction, accumulator] : accumulators) {
+            auto* reduced = append(middle, Opcode::REDUCE, reduction->phi->type, {_copies.at(reduction->update)});
+            reduced->immediate = static_cast<int64_t>(reduction->combine);
+            results[reduction->update] = append(middle, reduction->combine, reduction->phi->type,
+                                                {incoming(reduction->phi, preheader), reduced});
+        }
+        auto* recheck = append(middle, Opcode::CMP, ValueType::I32, {});
+        for (auto* operand : _induction.compare->operands) {
+            recheck->operands.emplace_back(operand == _induction.next ? next : operand);
+        }
+        recheck->condition = _induction.compare->condition;
+        branch(middle, recheck, loopIsTrue ? _body : exit, loopIsTrue ? exit : _body);
+
+        auto resultOf = [&](Instruction* value) { return value->parent == _body ? results.at(value) : value; };
+
+        // 元のループへは middle からも入る
+        for (const auto& owned : _body->instructions) {
+            auto* phi = owned.get();
+            if (phi->opcode != Opcode::PHI) {
+                break;
+            }
+            phi->operands.emplace_back(resultOf(incoming(phi, _body)));
+            phi->blocks.emplace_back(middle);
+        }
+        for (auto& phi : exit->instructions) {
+            if (phi->opcode != Opcode::PHI) {
+                break;
+            }
+            if (auto it = std::ranges::find(phi->blocks, _body); it != phi->blocks.end()) {
+                phi->operands.emplace_back(resultOf(phi->operands[static_cast<size_t>(it - phi->blocks.begin())]));
+                phi->blocks.emplace_back(middle);
+            }
+        }
+
+        // ループの後で本体の値を直接使っていれば (exit の先行ブロックが本体だけのとき)、exit で合流させる
+        std::unordered_map<const Instruction*, Instruction*> merged;
+        for (const auto& block : _function.blocks) {
+            if (block.get() == _body || block.get() == vector || block.get() == middle) {
+                continue;
+            }
+            for (size_t k = 0; k < block->instructions.size(); k++) {
+                auto* instruction = block->instructions[k].get();
+                if (instruction->opcode == Opcode::PHI && block.get() == exit) {
+                    continue;
+                }
+                for (auto*& operand : instruction->operands) {
+                    if (operand->parent != _body) {
+                        continue;
+                    }
+                    auto [it, inserted] = merged.try_emplace(operand, nullptr);
+                    if (inserted) {
+                        auto phi = _function.create(Opcode::PHI, operand->type, {operand, results.at(operand)});
+                        phi->blocks = {_body, middle};
+                        phi->line = operand->line;
+                        it->second = exit->insertAfterPhis(std::move(phi));
+                    }
+                    operand = it->second;
+                }
+            }
+        }
+
+        _function.recomputeControlFlow();
+    }
+
+    // ベクトルのループでの value の値 (アドレスの計算はスカラーのまま複製する)
+    Instruction* valueIn(Instruction* value) const {
+        return value->parent == _body ? _copies.at(value) : value;
+    }
+
+    // user の中で使う value のベクトル。ループ不変な値は前ヘッダで並べる
+    Instruction* vectorValue(const Instruction* user, Instruction* value) {
+        if (!isInvariant(value)) {
+            return _copies.at(value);
+        }
+        if (user->opcode != Opcode::STORE) {
+            return splat(value, vectorType(value->type));
+        }
+        // char / short の書き込みは 4 バイトに並べてから広げる (memset)
+        switch (user->immediate) {
+            case 1:
+            case 2: {
+                const bool isByte = user->immediate == 1;
+                auto mask = _function.create(Opcode::CONST, ValueType::I32);
+                mask->immediate = isByte ? 0xFF : 0xFFFF;
+                auto repeat = _function.create(Opcode::CONST, ValueType::I32);
+                repeat->immediate = isByte ? 0x01010101 : 0x00010001;
+                auto* low = _preheader->insertBefore(nullptr, std::move(mask));
+                auto* masked = _preheader->insertBefore(nullptr, _function.create(Opcode::AND, ValueType::I32, {value, low}));
+                auto* times = _preheader->insertBefore(nullptr, std::move(repeat));
+                auto* pattern =
+                    _preheader->insertBefore(nullptr, _function.create(Opcode::MUL, ValueType::I32, {masked, times}));
+                return splat(pattern, ValueType::V4I32);
+            }
+            default:
+                return splat(value, vectorType(value->type));
+        }
+    }
+
+    Instruction* splat(Instruction* value, ValueType type) {
+        auto [it, inserted] = _splats.try_emplace(value, nullptr);
+        if (inserted) {
+            auto instruction = _function.create(Opcode::SPLAT, type, {value});
+            instruction->line = _induction.compare->line;
+            it->second = _preheader->insertBefore(nullptr, std::move(instruction));
+        }
+        return it->second;
+    }
+
+    Function& _function;
+    BasicBlock* _body = nullptr;
+    BasicBlock* _preheader = nullptr;
+    InductionVariable _induction{};
+    // 帰納変数を 64 ビットに広げて定数を掛けた値と、その倍率 (バイト)
+    std::unordered_map<const Instruction*, int64_t> _scales;
+    // 連続した要素のアドレスと、その倍率とループ不変な基底
+    std::unordered_map<const Instruction*, std::pair<int64_t, Instruction*>> _addresses;
+    // 要素ごとに計算する値と、そのベクトルの型
+    std::unordered_map<const Instruction*, ValueType> _lanes;
+    // そのまま書き写すだけの char / short の読み出し
+    std::unordered_set<const Instruction*> _rawLoads;
+    std::vector<Access> _accesses;
+    std::vector<Reduction> _reductions;
+    int64_t _elementSize = 0;
+    // 帰納変数を広げる命令 (SEXT / ZEXT) はひとつに揃える
+    std::optional<Opcode> _extend;
+    // 本体の値ごとの、ベクトルのループでの値
+    std::unordered_map<const Instruction*, Instruction*> _copies;
+    std::unordered_map<const Instruction*, Instruction*> _splats;
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t vectorizeLoops(ir::Function& function) {
+    return LoopVectorization{function}.run();
+}
+
+} // namespace yoctocc::optimizer
@@ -0,0 +1,368 @@
+#include "Optimizer/Passes.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "IR/Analysis.hpp"
+#include "IR/IR.hpp"
+#include "Node/Node.hpp"
+#include "Type.hpp"
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+// 昇格する FrameSlot の情報
+struct Candidate {
+    bool promotable = true;
+    ValueType type = ValueType::VOID;
+    std::vector<Instruction*> addresses;
+    // 初期化されていない読み出しと CLEAR の値
+    Instruction* zero = nullptr;
+};
+
+bool isScalar(const FrameSlot& slot) {
+    if (!slot.variable) {
+        return false;
+    }
+    const Type* type = slot.variable->type.get();
+    if (!type::isInteger(type) && !type::isFloat(type) && !type::is(type, TypeKind::POINTER)) {
+        return false;
+    }
+    return slot.size == 1 || slot.size == 2 || slot.size == 4 || slot.size == 8;
+}
+
+class Mem2Reg final {
+public:
+    explicit Mem2Reg(Function& function) : _function(function) {
+    }
+
+    size_t run() {
+        if (observesFrameLayout(_function)) {
+            return 0;
+        }
+        collectCandidates();
+        const size_t promoted = _promoted.size();
+        if (promoted == 0) {
+            return 0;
+        }
+
+        DominatorTree dominators{_function};
+        placePhis(dominators);
+        createZeros();
+        rename(dominators);
+        cleanup();
+        return promoted;
+    }
+
+private:
+    // アドレスが LOAD / STORE / CLEAR のアドレスとしてだけ使われるスロットを探す
+    void collectCandidates() {
+        std::unordered_map<const Instruction*, int64_t> addressSlots;
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                if (instruction->opcode != Opcode::FRAME_ADDRESS) {
+                    continue;
+                }
+                auto& candidate = _candidates[instruction->immediate];
+                candidate.promotable = candidate.promotable && isScalar(_function.slots[instruction->immediate]);
+                candidate.addresses.emplace_back(instruction.get());
+                addressSlots.emplace(instruction.get(), instruction->immediate);
+            }
+        }
+
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                for (size_t i = 0; i < instruction->operands.size(); i++) {
+                    auto it = addressSlots.find(instruction->operands[i]);
+                    if (it == addressSlots.end()) {
+                        continue;
+                    }
+                    auto& candidate = _candidates[it->second];
+                    const int size = _function.slots[it->second].size;
+                    if (i != 0 || instruction->immediate != size) {
+                        candidate.promotable = false;
+                        continue;
+                    }
+                    switch (instruction->opcode) {
+                        case Opcode::LOAD:
+                            merge(candidate, instruction->type);
+                            break;
+                        case Opcode::STORE:
+                            merge(candidate, instruction->operands[1]->type);
+                            break;
+                        case Opcode::CLEAR:
+                            break;
+                        default:
+                            candidate.promotable = false;
+                            break;
+                    }
+                }
+            }
+        }
+
+        for (auto& [slot, candidate] : _candidates) {
+            // 読み書きされない (CLEAR だけの) スロットは残す
+            candidate.promotable = candidate.promotable && candidate.type != ValueType::VOID;
+            if (candidate.promotable) {
+                _promoted.emplace_back(slot);
+                for (auto* address : candidate.addresses) {
+                    _promotedAddresses.emplace(address, slot);
+                }
+            }
+        }
+    }
+
+    static void merge(Candidate& candidate, ValueType type) {
+        if (candidate.type == ValueType::VOID) {
+            candidate.type = type;
+        } else if (candidate.type != type) {
+            candidate.promotable = false;
+        }
+    }
+
+    const int64_t* promotedSlot(const Instruction* address) const {
+        auto it = _promotedAddresses.find(address);
+        return it == _promotedAddresses.end() ? nullptr : &it->second;
+    }
+
+    Candidate& candidateOf(int64_t slot) {
+        return _candidates.at(slot);
+    }
+
+    // 値を書き込むブロックの反復支配辺境に PHI を置く
+    void placePhis(const DominatorTree& dominators) {
+        const auto frontiers = dominators.frontiers();
+        for (const int64_t slot : _promoted) {
+            const auto& candidate = candidateOf(slot);
+            std::vector<BasicBlock*> worklist;
+            std::unordered_set<const BasicBlock*> visited;
+            for (const auto& block : _function.blocks) {
+                for (const auto& instruction : block->instructions) {
+                    if (instruction->opcode == Opcode::STORE || instruction->opcode == Opcode::CLEAR) {
+                        const auto* found = promotedSlot(instruction->operands[0]);
+                        if (found && *found == slot && visited.insert(block.get()).second) {
+                            worklist.emplace_back(block.get());
+                        }
+                    }
+                }
+            }
+
+            std::unordered_set<const BasicBlock*> hasPhi;
+            while (!worklist.empty()) {
+                auto* block = worklist.back();
+                worklist.pop_back();
+                for (auto* frontier : frontiers[block->id]) {
+                    if (!hasPhi.insert(frontier).second) {
+                        continue;
+                    }
+                    auto phi = _function.create(Opcode::PHI, candidate.type);
+                    phi->line = frontier->instructions.front()->line;
+                    auto* inserted = frontier->insertBefore(frontier->instructions.front().get(), std::move(phi));
+                    _phiSlots.emplace(inserted, slot);
+                    if (visited.insert(frontier).second) {
+                        worklist.emplace_back(frontier);
+                    }
+                }
+            }
+        }
+    }
+
+    // 名前の付け替え中に入口ブロックの命令の位置がずれないよう、0 は先に作っておく (使われなければ cleanup で消す)
+    void createZeros() {
+        auto* entry = _function.blocks[0].get();
+        for (const int64_t slot : _promoted) {
+            auto zero = _function.create(Opcode::CONST, candidateOf(slot).type);
+            zero->line = entry->instructions.front()->line;
+            candidateOf(slot).zero = entry->insertAfterPhis(std::move(zero));
+        }
+    }
+
+    Instruction* current(int64_t slot) {
+        auto& stack = _stacks[slot];
+        return stack.empty() ? candidateOf(slot).zero : stack.back();
+    }
+
+    // 支配木を深さ優先でたどり、読み出しを直前に書き込んだ値に置き換える
+    void rename(const DominatorTree& dominators) {
+        struct Frame {
+            BasicBlock* block;
+            size_t child;
+            size_t logSize;
+        };
+        std::vector<int64_t> log;
+        std::vector<Frame> frames;
+        frames.push_back({_function.blocks[0].get(), 0, 0});
+        renameBlock(frames.back().block, log);
+
+        while (!frames.empty()) {
+            auto& frame = frames.back();
+            const auto& children = dominators.children(frame.block);
+            if (frame.child < children.size()) {
+                auto* child = children[frame.child++];
+                size_t logSize = log.size();
+                frames.push_back({child, 0, logSize});
+                renameBlock(child, log);
+                continue;
+            }
+            while (log.size() > frame.logSize) {
+                _stacks[log.back()].pop_back();
+                log.pop_back();
+            }
+            frames.pop_back();
+        }
+    }
+
+    void renameBlock(BasicBlock* block, std::vector<int64_t>& log) {
+        auto push = [&](int64_t slot, Instruction* value) {
+            _stacks[slot].emplace_back(value);
+            log.emplace_back(slot);
+        };
+
+        // insertBefore で命令が増えるので添字でたどる
+        for (size_t i = 0; i < block->instructions.size(); i++) {
+            auto* instruction = block->instructions[i].get();
+            if (instruction->opcode == Opcode::PHI) {
+                auto it = _phiSlots.find(instruction);
+                if (it != _phiSlots.end()) {
+                    push(it->second, instruction);
+                }
+                continue;
+            }
+            if (instruction->operands.empty()) {
+                continue;
+            }
+            const auto* slot = promotedSlot(instruction->operands[0]);
+            if (!slot) {
+                continue;
+            }
+            switch (instruction->opcode) {
+                case Opcode::LOAD: {
+                    auto* value = current(*slot);
+                    const int size = _function.slots[*slot].size;
+                    if (size < 4 && !isExtended(value, size, instruction->isSigned)) {
+                        // 狭い変数は書き込んだ値を型の幅で読み直したものになる
+                        auto extended = _function.create(Opcode::EXTEND, ValueType::I32, {value});
+                        extended->immediate = size * 8;
+                        extended->isSigned = instruction->isSigned;
+                        extended->line = instruction->line;
+                        value = block->insertBefore(instruction, std::move(extended));
+                        i++;
+                    }
+                    _replacements.emplace(instruction, value);
+                    _removed.insert(instruction);
+                    break;
+                }
+                case Opcode::STORE:
+                    push(*slot, instruction->operands[1]);
+                    _removed.insert(instruction);
+                    break;
+                case Opcode::CLEAR:
+                    push(*slot, candidateOf(*slot).zero);
+                    _removed.insert(instruction);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        for (auto* successor : block->successors) {
+            for (const auto& instruction : successor->instructions) {
+                if (instruction->opcode != Opcode::PHI) {
+                    break;
+                }
+                auto it = _phiSlots.find(instruction.get());
+                if (it == _phiSlots.end()) {
+                    continue;
+                }
+                instruction->operands.emplace_back(current(it->second));
+                instruction->blocks.emplace_back(block);
+            }
+        }
+    }
+
+    static bool isExtended(const Instruction* value, int size, bool isSigned) {
+        if (value->opcode == Opcode::EXTEND) {
+            return value->immediate == size * 8 && value->isSigned == isSigned;
+        }
+        if (value->opcode == Opcode::CONST) {
+            const int64_t v = value->immediate;
+            if (size == 1) {
+                return isSigned ? v == static_cast<int8_t>(v) : v == static_cast<uint8_t>(v);
+            }
+            return isSigned ? v == static_cast<int16_t>(v) : v == static_cast<uint16_t>(v);
+        }
+        // 比較の結果は 0 / 1
+        return value->opcode == Opcode::CMP || value->opcode == Opcode::FCMP;
+    }
+
+    void cleanup() {
+        _function.replaceUses(_replacements);
+
+        // 使われない PHI を取り除く (PHI 同士の循環だけで使われているものも含む)
+        std::unordered_set<const Instruction*> live;
+        std::vector<Instruction*> worklist;
+        for (const auto& block : _function.blocks) {
+            for (const auto& instruction : block->instructions) {
+                if (instruction->opcode == Opcode::PHI || _removed.contains(instruction.get())) {
+                    continue;
+                }
+                for (auto* operand : instruction->operands) {
+                    if (operand->opcode == Opcode::PHI && live.insert(operand).second) {
+                        worklist.emplace_back(operand);
+                    }
+                }
+            }
+        }
+        while (!worklist.empty()) {
+            auto* phi = worklist.back();
+            worklist.pop_back();
+            for (auto* operand : phi->operands) {
+                if (operand->opcode == Opcode::PHI && live.insert(operand).second) {
+                    worklist.emplace_back(operand);
+                }
+            }
+        }
+
+        for (const auto& block : _function.blocks) {
+            std::erase_if(block->instructions, [&](const std::unique_ptr<Instruction>& instruction) {
+                if (_removed.contains(instruction.get()) || _promotedAddresses.contains(instruction.get())) {
+                    return true;
+                }
+                return instruction->opcode == Opcode::PHI && !live.contains(instruction.get());
+            });
+        }
+
+        const auto uses = _function.countUses();
+        for (const int64_t slot : _promoted) {
+            auto* zero = candidateOf(slot).zero;
+            if (!uses.contains(zero)) {
+                _function.blocks[0]->remove(zero);
+            }
+        }
+    }
+
+    Function& _function;
+    std::unordered_map<int64_t, Candidate> _candidates;
+    std::vector<int64_t> _promoted;
+    std::unordered_map<const Instruction*, int64_t> _promotedAddresses;
+    std::unordered_map<const Instruction*, int64_t> _phiSlots;
+    std::unordered_map<int64_t, std::vector<Instruction*>> _stacks;
+    std::unordered_map<Instruction*, Instruction*> _replacements;
+    std::unordered_set<const Instruction*> _removed;
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t promoteMemoryToRegisters(ir::Function& function) {
+    // アドレスを一時変数に入れてから読み書きするスロットは、先に一時変数を昇格すると昇格できるようになる
+    size_t promoted = 0;
+    while (size_t count = Mem2Reg{function}.run()) {
+        promoted += count;
+    }
+    return promoted;
+}
+
+} // namespace yoctocc::optimizer
@@ -0,0 +1,302 @@
+#include "Optimizer/PassManager.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <format>
+#include <print>
+#include "IR/IR.hpp"
+#include "IR/Lowering.hpp"
+#include "IR/Printer.hpp"
+#include "IR/Verifier.hpp"
+#include "Node/Node.hpp"
+#include "Logger.hpp"
+#include "Optimizer/Passes.hpp"
+#include "Profiler/TimeReport.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::optimizer;
+
+struct PassEntry {
+    PassInfo info;
+    size_t (*runAst)(Object* program);
+    size_t (*runIr)(ir::Function& function, const OptimizationOptions& options);
+    size_t (*runInstructions)(std::vector<std::string>& lines);
+};
+
+// オプションを使わない IR のパス
+template <size_t (*Pass)(ir::Function&)>
+size_t withoutOptions(ir::Function& function, const OptimizationOptions&) {
+    return Pass(function);
+}
+
+size_t unrollLoopsByFactor(ir::Function& function, const OptimizationOptions& options) {
+    return unrollLoops(function, options.unrollFactor);
+}
+
+size_t recognizeLoopIdiomsForTarget(ir::Function& function, const OptimizationOptions& options) {
+    return recognizeLoopIdioms(function, options.isaLevel);
+}
+
+// 実行順に並べる
+const std::array PASSES = {
+    PassEntry{
+        {"constant-fold"sv, PassKind::AST, 1, "fold integer constant expressions"sv},
+        foldConstants,
+        nullptr,
+        nullptr,
+    },
+    PassEntry{
+        {"inline"sv, PassKind::AST, 1, "substitute bodies of small, inline and always_inline functions at call sites"sv},
+        inlineFunctions,
+        nullptr,
+        nullptr,
+    },
+    PassEntry{
+        {"unused-statics"sv, PassKind::AST, 1, "drop static functions and variables that nothing references"sv},
+        removeUnusedStatics,
+        nullptr,
+        nullptr,
+    },
+    PassEntry{
+        {"stack-coloring"sv, PassKind::AST, 1, "share frame slots between locals with disjoint lifetimes, sorted by alignment"sv},
+        colorStackSlots,
+        nullptr,
+        nullptr,
+    },
+    // IR への変換そのもの。-fno-ir なら全関数をスタックマシンで生成する
+    PassEntry{
+        {"ir"sv, PassKind::IR, 1, "lower functions to SSA IR and allocate registers"sv},
+        nullptr,
+        nullptr,
+        nullptr,
+    },
+    PassEntry{
+        {"mem2reg"sv, PassKind::IR, 1, "promote scalar local variables to SSA values"sv},
+        nullptr,
+        withoutOptions<promoteMemoryToRegisters>,
+        nullptr,
+    },
+    PassEntry{
+        {"gvn"sv, PassKind::IR, 1, "reuse values already computed or loaded on every path (GVN / CSE)"sv},
+        nullptr,
+        withoutOptions<numberGlobalValues>,
+        nullptr,
+    },
+    PassEntry{
+        {"tail-call"sv, PassKind::IR, 1, "turn self-recursive tail calls into loops and other tail calls into jumps"sv},
+        nullptr,
+        withoutOptions<eliminateTailCalls>,
+        nullptr,
+    },
+    PassEntry{
+        {"loop-rotate"sv, PassKind::IR, 1, "test loop conditions once before entry and again at the bottom"sv},
+        nullptr,
+        withoutOptions<rotateLoops>,
+        nullptr,
+    },
+    PassEntry{
+        {"licm"sv, PassKind::IR, 1, "hoist loop-invariant computations and loads into loop preheaders"sv},
+        nullptr,
+        withoutOptions<hoistLoopInvariants>,
+        nullptr,
+    },
+    PassEntry{
+        {"dce"sv, PassKind::IR, 1, "remove unreachable blocks, dead stores and unused values"sv},
+        nullptr,
+        withoutOptions<eliminateDeadCode>,
+        nullptr,
+    },
+    PassEntry{
+        {"loop-idiom"sv, PassKind::IR, 1, "replace bit-counting loops with popcnt / lzcnt / tzcnt under -march"sv},
+        nullptr,
+        recognizeLoopIdiomsForTarget,
+        nullptr,
+    },
+    PassEntry{
+        {"loop-vectorize"sv, PassKind::IR, 2, "vectorize element-wise loops with SSE2 and finish with the scalar loop"sv},
+        nullptr,
+        withoutOptions<vectorizeLoops>,
+        nullptr,
+    },
+    PassEntry{
+        {"loop-unroll"sv, PassKind::IR, 2, "unroll single-block counted loops by -funroll-factor with a remainder loop"sv},
+        nullptr,
+        unrollLoopsByFactor,
+        nullptr,
+    },
+    // 命令選択の設定。-fno-omit-frame-pointer なら IR から作る関数でも rbp をフレームポインタにする
+    PassEntry{
+        {"omit-frame-pointer"sv, PassKind::IR, 1, "address frames from rsp, allocate rbp and keep leaf frames in the red zone"sv},
+        nullptr,
+        nullptr,
+        nullptr,
+    },
+    PassEntry{
+        {"shrink-wrap"sv, PassKind::IR, 1, "test early exits on argument registers before the prologue and return frameless"sv},
+        nullptr,
+        nullptr,
+        nullptr,
+    },
+    PassEntry{
+        {"peephole"sv, PassKind::INSTRUCTION, 1, "simplify redundant stack-machine instruction sequences"sv},
+        nullptr,
+        nullptr,
+        optimizePeephole,
+    },
+};
+
+const std::array<PassInfo, PASSES.size()> PASS_INFOS = [] {
+    std::array<PassInfo, PASSES.size()> infos{};
+    for (size_t i = 0; i < PASSES.size(); i++) {
+        infos[i] = PASSES[i].info;
+    }
+    return infos;
+}();
+
+std::string_view to_string(PassKind kind) {
+    switch (kind) {
+        case PassKind::AST:
+            return "ast"sv;
+        case PassKind::IR:
+            return "ir"sv;
+        case PassKind::INSTRUCTION:
+            return "instruction"sv;
+    }
+    return "?"sv;
+}
+} // namespace
+
+namespace yoctocc::optimizer {
+
+std::span<const PassInfo> registeredPasses() {
+    return PASS_INFOS;
+}
+
+const PassInfo* findPass(std::string_view name) {
+    auto it = std::ranges::find(PASS_INFOS, name, &PassInfo::name);
+    return it == PASS_INFOS.end() ? nullptr : &*it;
+}
+
+PassManager::PassManager(OptimizationOptions options) : _options(std::move(options)) {
+    _enabled.resize(PASSES.size());
+    _statistics.resize(PASSES.size());
+    for (size_t i = 0; i < PASSES.size(); i++) {
+        const auto& name = PASSES[i].info.name;
+        bool enabled = _options.level >= PASSES[i].info.level;
+        if (std::ranges::contains(_options.enabledPasses, name)) {
+            enabled = true;
+        }
+        if (std::ranges::contains(_options.disabledPasses, name)) {
+            enabled = false;
+        }
+        _enabled[i] = enabled;
+    }
+}
+
+bool PassManager::isEnabled(std::string_view name) const {
+    for (size_t i = 0; i < PASSES.size(); i++) {
+        if (PASSES[i].info.name == name) {
+            return _enabled[i];
+        }
+    }
+    return false;
+}
+
+bool PassManager::shouldRun(size_t index, std::string_view unit) {
+    if (!_enabled[index]) {
+        return false;
+    }
+    if (_options.bisectLimit < 0) {
+        return true;
+    }
+    // LLVM の -opt-bisect-limit と同じく、実行ごとに通し番号を振って表示する
+    int execution = ++_executions;
+    bool run = execution <= _options.bisectLimit;
+    std::println(stderr, "BISECT: {} pass ({}) {} on {}", run ? "running" : "NOT running", execution,
+                 PASSES[index].info.name, unit);
+    return run;
+}
+
+template <typename Body>
+void PassManager::runPass(size_t index, std::string_view unit, Body&& body) {
+    if (!shouldRun(index, unit)) {
+        return;
+    }
+    profiler::TimeReport::Scope scope{PASSES[index].info.name, "pass"};
+    auto start = std::chrono::steady_clock::now();
+    size_t changes = body();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto& statistics = _statistics[index];
+    statistics.runs++;
+    statistics.changes += changes;
+    statistics.microseconds += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+void PassManager::runAstPasses(Object* program) {
+    for (size_t i = 0; i < PASSES.size(); i++) {
+        if (PASSES[i].info.kind == PassKind::AST) {
+            runPass(i, "<program>"sv, [&] { return PASSES[i].runAst(program); });
+        }
+    }
+}
+
+std::unique_ptr<ir::Function> PassManager::buildIr(const Object* function) {
+    const size_t gate = static_cast<size_t>(std::ranges::find(PASSES, "ir"sv, [](const PassEntry& entry) {
+                                                return entry.info.name;
+                                            }) - PASSES.begin());
+    std::unique_ptr<ir::Function> result;
+    runPass(gate, function->name, [&] {
+        result = ir::lower(function);
+        return result ? size_t{1} : size_t{0};
+    });
+    if (!result) {
+        return nullptr;
+    }
+
+    if (_options.verifyIr) {
+        ir::verify(*result, "lowering"sv);
+    }
+    for (size_t i = 0; i < PASSES.size(); i++) {
+        if (PASSES[i].info.kind == PassKind::IR && PASSES[i].runIr) {
+            runPass(i, function->name, [&] { return PASSES[i].runIr(*result, _options); });
+            if (_options.verifyIr) {
+                ir::verify(*result, PASSES[i].info.name);
+            }
+        }
+    }
+    if (_options.dumpIr) {
+        ir::print(*result, stderr);
+    }
+    return result;
+}
+
+void PassManager::runInstructionPasses(std::string_view function, std::vector<std::string>& lines) {
+    for (size_t i = 0; i < PASSES.size(); i++) {
+        if (PASSES[i].info.kind == PassKind::INSTRUCTION) {
+            runPass(i, function, [&] { return PASSES[i].runInstructions(lines); });
+        }
+    }
+}
+
+void PassManager::printStatistics(std::FILE* out) const {
+    std::println(out, "");
+    std::println(out, "===== Pass statistics (-O{}) =====", _options.level);
+    std::println(out, "{:<24} {:<12} {:>8} {:>10} {:>12}", "pass", "kind", "runs", "changes", "wall (ms)");
+    for (size_t i = 0; i < PASSES.size(); i++) {
+        const auto& info = PASSES[i].info;
+        if (!_enabled[i]) {
+            std::println(out, "{:<24} {:<12} {:>8}", info.name, to_string(info.kind), "disabled");
+            continue;
+        }
+        const auto& statistics = _statistics[i];
+        std::println(out, "{:<24} {:<12} {:>8} {:>10} {:>12.3f}", info.name, to_string(info.kind), statistics.runs,
+                     statistics.changes, statistics.microseconds / 1000.0);
+    }
+}
+
+} // namespace yoctocc::optimizer
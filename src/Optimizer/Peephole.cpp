@@ -0,0 +1,123 @@
+#include "Optimizer/Passes.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Assembly/Assembly.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+using namespace yoctocc;
+
+bool isLabel(std::string_view line) {
+    return !line.empty() && line.back() == ':';
+}
+
+bool isLocation(std::string_view line) {
+    return line.starts_with(".loc "sv);
+}
+
+std::string_view mnemonicOf(std::string_view line) {
+    return line.substr(0, line.find(' '));
+}
+
+std::string_view operandsOf(std::string_view line) {
+    auto space = line.find(' ');
+    return space == std::string_view::npos ? ""sv : line.substr(space + 1);
+}
+
+// 出力済みの命令列の末尾と次の命令を組み合わせて置き換える。
+// 置き換えた結果がさらに前の命令と組になることもあるので、末尾に対して繰り返し適用される。
+class PeepholeOptimizer final {
+public:
+    size_t changes = 0;
+    std::vector<std::string> output;
+
+    void append(std::string&& line) {
+        if (combinePushPop(line) || foldAddressIntoLoad(line)) {
+            changes++;
+            return;
+        }
+        if (isLabel(line)) {
+            removeJumpTo(std::string_view{line}.substr(0, line.size() - 1));
+        }
+        output.emplace_back(std::move(line));
+    }
+
+private:
+    // "push rax" + "pop rdi" -> "mov rdi, rax"
+    // "push rax" + "pop rax" -> (削除)
+    bool combinePushPop(std::string_view line) {
+        if (output.empty() || mnemonicOf(line) != "pop"sv || mnemonicOf(output.back()) != "push"sv) {
+            return false;
+        }
+        std::string source{operandsOf(output.back())};
+        std::string destination{operandsOf(line)};
+        output.pop_back();
+        if (source != destination) {
+            append(mov(destination, source));
+        }
+        return true;
+    }
+
+    // "lea rax, [rbp - 8]" + "movsxd rax, [rax]" -> "movsxd rax, [rbp - 8]"
+    // 読み込み先が rax / eax のときだけ lea の結果が不要になる
+    bool foldAddressIntoLoad(std::string_view line) {
+        if (output.empty() || !output.back().starts_with("lea rax, [rbp"sv)) {
+            return false;
+        }
+        auto mnemonic = mnemonicOf(line);
+        if (mnemonic != "mov"sv && mnemonic != "movsxd"sv && mnemonic != "movsx"sv && mnemonic != "movzx"sv) {
+            return false;
+        }
+        auto operands = operandsOf(line);
+        if (!operands.starts_with("rax, "sv) && !operands.starts_with("eax, "sv)) {
+            return false;
+        }
+        auto memory = operands.find("[rax]"sv);
+        if (memory == std::string_view::npos) {
+            return false;
+        }
+        std::string address{operandsOf(output.back()).substr("rax, "sv.size())};
+        std::string folded{line};
+        folded.replace(line.size() - operands.size() + memory, "[rax]"sv.size(), address);
+        output.pop_back();
+        output.emplace_back(std::move(folded));
+        return true;
+    }
+
+    // 直前 (.loc を挟んでもよい) の jmp がこのラベルへのものなら削除する
+    void removeJumpTo(std::string_view label) {
+        for (size_t i = output.size(); i-- > 0;) {
+            if (isLocation(output[i])) {
+                continue;
+            }
+            if (mnemonicOf(output[i]) != "jmp"sv) {
+                return;
+            }
+            auto target = operandsOf(output[i]);
+            // 数値ラベルの前方参照 "1f" は定義 "1:" と対応させる
+            if (target == label || (target.ends_with('f') && target.substr(0, target.size() - 1) == label)) {
+                output.erase(output.begin() + static_cast<std::ptrdiff_t>(i));
+                changes++;
+            }
+            return;
+        }
+    }
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t optimizePeephole(std::vector<std::string>& lines) {
+    PeepholeOptimizer optimizer;
+    optimizer.output.reserve(lines.size());
+    for (auto& line : lines) {
+        optimizer.append(std::move(line));
+    }
+    lines = std::move(optimizer.output);
+    return optimizer.changes;
+}
+
+} // namespace yoctocc::optimizer
@@ -0,0 +1,154 @@
+#include "Optimizer/Passes.hpp"
+
+#include <algorithm>
+#include <vector>
+#include "FrameLayout.hpp"
+#include "Node/Node.hpp"
+#include "Type.hpp"
+#include "Utility.hpp"
+
+namespace {
+using namespace yoctocc;
+
+constexpr int STACK_ALIGNMENT = 16;
+
+const Node* skipCasts(const Node* node) {
+    while (node && node->nodeType == NodeType::CAST) {
+        node = node->left.get();
+    }
+    return node;
+}
+
+// スカラーのローカル変数のアドレス (配列・構造体の要素を指すアドレスは含めない)
+bool isScalarLocalAddress(const Node* node) {
+    node = skipCasts(node);
+    if (!node || node->nodeType != NodeType::ADDRESS) {
+        return false;
+    }
+    const Node* operand = node->left.get();
+    if (operand->nodeType != NodeType::VARIABLE || !operand->variable->isLocal) {
+        return false;
+    }
+    const Type* type = operand->variable->type.get();
+    return !type::is(type, TypeKind::ARRAY) && !type::is(type, TypeKind::STRUCT) && !type::is(type, TypeKind::UNION);
+}
+
+// &y - &x や *(&x + 1) のように、ローカル変数どうしの並びに頼るアドレスの計算があるか。
+// あれば宣言順の配置 (IR の observesFrameLayout と同じ) のままにする。
+// char *p = &x; のようにアドレスを代入した変数も、IR では mem2reg でアドレスそのものになるので同じに扱う
+class LayoutObserver final {
+public:
+    bool observes(const Node* body) {
+        collectAddressHolders(body);
+        return visit(body);
+    }
+
+private:
+    void collectAddressHolders(const Node* node) {
+        for (; node; node = node->next.get()) {
+            if (node->nodeType == NodeType::ASSIGN && node->left->nodeType == NodeType::VARIABLE &&
+                isScalarLocalAddress(node->right.get())) {
+                _addressHolders.emplace_back(node->left->variable);
+            }
+            collectAddressHolders(node->left.get());
+            collectAddressHolders(node->right.get());
+            collectAddressHolders(node->condition.get());
+            collectAddressHolders(node->then.get());
+            collectAddressHolders(node->els.get());
+            collectAddressHolders(node->init.get());
+            collectAddressHolders(node->inc.get());
+            collectAddressHolders(node->body.get());
+            collectAddressHolders(node->arguments.get());
+        }
+    }
+
+    bool holdsAddress(const Node* node) const {
+        node = skipCasts(node);
+        if (isScalarLocalAddress(node)) {
+            return true;
+        }
+        return node && node->nodeType == NodeType::VARIABLE &&
+               std::ranges::find(_addressHolders, node->variable) != _addressHolders.end();
+    }
+
+    bool visitList(const Node* head) {
+        for (const Node* node = head; node; node = node->next.get()) {
+            if (visit(node)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool visit(const Node* node) {
+        if (!node) {
+            return false;
+        }
+        switch (node->nodeType) {
+            case NodeType::ADD:
+            case NodeType::SUB:
+            case NodeType::EQUAL:
+            case NodeType::NOT_EQUAL:
+            case NodeType::LESS:
+            case NodeType::LESS_EQUAL:
+                if (holdsAddress(node->left.get()) || holdsAddress(node->right.get())) {
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+        return visit(node->left.get()) || visit(node->right.get()) || visit(node->condition.get()) ||
+               visit(node->then.get()) || visit(node->els.get()) || visit(node->init.get()) ||
+               visit(node->inc.get()) || visitList(node->body.get()) || visitList(node->arguments.get());
+    }
+
+    std::vector<const Object*> _addressHolders;
+};
+
+// 宣言順に詰めたときのフレームの大きさ (Generator::assignLocalVariableOffsets と同じ配置)
+int sequentialFrameSize(const Object* function) {
+    int offset = 0;
+    for (const Object* local = function->locals.get(); local; local = local->next.get()) {
+        offset = static_cast<int>(alignTo(offset + local->type->size, local->alignment));
+    }
+    return static_cast<int>(alignTo(offset, STACK_ALIGNMENT));
+}
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t colorStackSlots(Object* program) {
+    size_t changed = 0;
+    for (Object* function = program; function; function = function->next.get()) {
+        if (!function->isFunction || !function->isDefinition || LayoutObserver{}.observes(function->body.get())) {
+            continue;
+        }
+
+        std::vector<Object*> locals;
+        std::vector<frame::FrameObject> objects;
+        for (Object* local = function->locals.get(); local; local = local->next.get()) {
+            locals.emplace_back(local);
+            objects.push_back({
+                .size = local->type->size,
+                .alignment = local->alignment,
+                .lifetimeBegin = local->lifetimeBegin,
+                .lifetimeEnd = local->lifetimeEnd,
+            });
+        }
+        const auto layout = frame::layoutObjects(objects);
+        for (size_t i = 0; i < locals.size(); i++) {
+            locals[i]->offset = layout.offsets[i];
+        }
+
+        const int stackSize = static_cast<int>(alignTo(layout.size, STACK_ALIGNMENT));
+        if (stackSize < sequentialFrameSize(function)) {
+            changed++;
+        }
+        function->stackSize = stackSize;
+        function->hasFrameLayout = true;
+    }
+    return changed;
+}
+
+} // namespace yoctocc::optimizer
@@ -0,0 +1,205 @@
+#include "Optimizer/Passes.hpp"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "CallingConvention.hpp"
+#include "IR/Analysis.hpp"
+#include "IR/IR.hpp"
+
+namespace {
+using namespace yoctocc;
+using namespace yoctocc::ir;
+
+// 引数の場所 (浮動小数点数か, PARAM の immediate と同じ番号)
+using ArgumentKey = std::pair<bool, int64_t>;
+
+// RET の直前で呼び、その値をそのまま返す (値を返さない関数なら結果を捨てる) 呼び出し
+//   block: ...; v = call @f(args); ret v
+// のうち、自分自身を呼ぶものは引数を PHI に渡して入口へ戻るループにする
+//   entry:  param ...; br header
+//   header: phi (param, args) ...; 元の入口の命令
+//   block:  ...; br header
+// それ以外で引数がすべてレジスタに収まるものは、フレームを片付けてから jmp で呼ぶ印 (isTail) を付ける。
+// 呼び出し先がこの関数のフレームを参照しうる (FrameSlot のアドレスが外へ出た) 関数ではどちらも行わない
+class TailCall final {
+public:
+    explicit TailCall(Function& function) : _function(function) {
+    }
+
+    size_t run() {
+        const auto uses = _function.countUses();
+        std::vector<Instruction*> calls;
+        for (const auto& block : _function.blocks) {
+            if (auto* call = tailCall(*block, uses)) {
+                calls.emplace_back(call);
+            }
+        }
+        if (calls.empty() || framesEscape()) {
+            return 0;
+        }
+
+        size_t changed = 0;
+        std::vector<Instruction*> recursive;
+        for (auto* call : calls) {
+            if (call->symbol == _function.name) {
+                recursive.emplace_back(call);
+            } else if (fitsInRegisters(*call)) {
+                call->isTail = true;
+                changed++;
+            }
+        }
+        if (!recursive.empty() && loopToEntry(recursive)) {
+            changed += recursive.size();
+        }
+        return changed;
+    }
+
+private:
+    Instruction* tailCall(const BasicBlock& block, const std::unordered_map<const Instruction*, size_t>& uses) const {
+        const auto* terminator = block.terminator();
+        if (!terminator || terminator->opcode != Opcode::RET || block.instructions.size() < 2) {
+            return nullptr;
+        }
+        auto* call = block.instructions[block.instructions.size() - 2].get();
+        if (call->opcode != Opcode::CALL) {
+            return nullptr;
+        }
+        if (terminator->operands.empty()) {
+            return _function.returnType == ValueType::VOID && !uses.contains(call) ? call : nullptr;
+        }
+        return terminator->operands[0] == call && uses.at(call) == 1 ? call : nullptr;
+    }
+
+    bool framesEscape() const {
+        AliasAnalysis alias{_function};
+        for (size_t slot = 0; slot < _function.slots.size(); slot++) {
+            if (alias.escapes(static_cast<int64_t>(slot))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // スタックで渡す引数は呼び出し元の引数領域に書くので、jmp で呼ぶと書く場所がない
+    static bool fitsInRegisters(const Instruction& call) {
+        const auto floats = std::ranges::count_if(call.operands, &Instruction::isFloat);
+        const auto integers = static_cast<std::ptrdiff_t>(call.operands.size()) - floats;
+        return integers <= abi::INTEGER_ARGUMENT_REGISTERS && floats <= abi::FLOAT_ARGUMENT_REGISTERS;
+    }
+
+    // Lowering / InstructionSelector と同じく、レジスタの後は整数と浮動小数点数の区別なく 8 バイトずつ並べる
+    static std::map<ArgumentKey, Instruction*> argumentsOf(const Instruction& call) {
+        std::map<ArgumentKey, Instruction*> arguments;
+        int64_t integers = 0;
+        int64_t floats = 0;
+        int64_t stack = 0;
+        for (auto* argument : call.operands) {
+            const bool isFloat = argument->isFloat();
+            auto& count = isFloat ? floats : integers;
+            const int64_t limit = isFloat ? abi::FLOAT_ARGUMENT_REGISTERS : abi::INTEGER_ARGUMENT_REGISTERS;
+            arguments.emplace(ArgumentKey{isFloat, count < limit ? count++ : limit + stack++}, argument);
+        }
+        return arguments;
+    }
+
+    bool loopToEntry(const std::vector<Instruction*>& calls) {
+        _function.recomputeControlFlow();
+        auto* entry = _function.blocks.front().get();
+        if (!entry->predecessors.empty()) {
+            return false;
+        }
+        std::vector<Instruction*> params;
+        for (const auto& instruction : entry->instructions) {
+            if (instruction->opcode == Opcode::PARAM) {
+                params.emplace_back(instruction.get());
+            }
+        }
+        // 使われない引数は DCE で PARAM ごと消えているので、残っている PARAM の分だけ対応を調べる
+        for (const auto* call : calls) {
+            if (call->isVariadic) {
+                return false;
+            }
+            const auto mapping = argumentsOf(*call);
+            for (const auto* param : params) {
+                auto it = mapping.find(ArgumentKey{param->isFloat(), param->immediate});
+                if (it == mapping.end() || it->second->type != param->type) {
+                    return false;
+                }
+            }
+        }
+
+        // PARAM 以外の入口の命令を header に移す
+        auto* header = _function.createBlock();
+        const size_t line = entry->instructions.front()->line;
+        std::vector<std::unique_ptr<Instruction>> moved;
+        for (auto& instruction : entry->instructions) {
+            if (instruction->opcode == Opcode::PARAM) {
+                continue;
+            }
+            moved.emplace_back(std::move(instruction));
+        }
+        std::erase(entry->instructions, nullptr);
+        for (auto& instruction : moved) {
+            header->append(std::move(instruction));
+        }
+        for (auto* successor : header->terminator()->blocks) {
+            for (auto& phi : successor->instructions) {
+                if (phi->opcode != Opcode::PHI) {
+                    break;
+                }
+                std::ranges::replace(phi->blocks, entry, header);
+            }
+        }
+        auto br = _function.create(Opcode::BR, ValueType::VOID);
+        br->blocks = {header};
+        br->line = line;
+        entry->append(std::move(br));
+
+        // 引数を受け取った値は、入口から来たときの PARAM と戻ってきたときの引数の PHI にする
+        std::unordered_map<Instruction*, Instruction*> replacements;
+        std::vector<Instruction*> phis;
+        for (auto* param : params) {
+            auto phi = _function.create(Opcode::PHI, param->type);
+            phi->line = param->line;
+            replacements.emplace(param, phis.emplace_back(header->insertAfterPhis(std::move(phi))));
+        }
+        _function.replaceUses(replacements);
+        for (size_t i = 0; i < params.size(); i++) {
+            phis[i]->operands = {params[i]};
+            phis[i]->blocks = {entry};
+        }
+
+        // 引数の PARAM も PHI に置き換わっているので、置き換えた後の引数を戻る値にする
+        for (auto* call : calls) {
+            const auto arguments = argumentsOf(*call);
+            auto* block = call->parent;
+            const size_t callLine = call->line;
+            block->instructions.pop_back();
+            block->instructions.pop_back();
+            auto back = _function.create(Opcode::BR, ValueType::VOID);
+            back->blocks = {header};
+            back->line = callLine;
+            block->append(std::move(back));
+            for (size_t i = 0; i < params.size(); i++) {
+                phis[i]->operands.emplace_back(arguments.at(ArgumentKey{params[i]->isFloat(), params[i]->immediate}));
+                phis[i]->blocks.emplace_back(block);
+            }
+        }
+        _function.recomputeControlFlow();
+        return true;
+    }
+
+    Function& _function;
+};
+} // namespace
+
+namespace yoctocc::optimizer {
+
+size_t eliminateTailCalls(ir::Function& function) {
+    return TailCall{function}.run();
+}
+
+} // namespace yoctocc::optimizer
@@ -0,0 +1,162 @@
+#include "Options.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <optional>
+#include <string_view>
+#include "Logger.hpp"
+#include "Optimizer/PassManager.hpp"
+
+using namespace std::string_view_literals;
+
+namespace yoctocc {
+
+namespace {
+// -march に指定できる名前 (添字 + 1 がレベル)
+constexpr std::array ISA_LEVELS = {"x86-64"sv, "x86-64-v2"sv, "x86-64-v3"sv, "x86-64-v4"sv};
+
+// 符号のない 10 進数の整数。数字以外を含むか int に収まらなければ nullopt
+std::optional<int> parseNonNegative(std::string_view text) {
+    int value = 0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || text.front() == '-' || ec != std::errc{} || ptr != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+} // namespace
+
+Options parseOptions(int argc, char* argv[]) {
+    Options options{};
+    std::vector<std::string> positionals;
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+
+        if (arg == "--run"sv) {
+            options.run = true;
+            continue;
+        }
+
+        if (arg == "--interpret"sv) {
+            options.interpret = true;
+            continue;
+        }
+
+        if (arg == "--perf-map"sv) {
+            options.perfMap = true;
+            continue;
+        }
+
+        if (arg == "--load"sv) {
+            if (i + 1 >= argc) {
+                Log::error("--load requires a library path"sv);
+            }
+            options.libraries.emplace_back(argv[++i]);
+            continue;
+        }
+
+        if (arg == "-ftime-report"sv) {
+            options.timeReport = true;
+            continue;
+        }
+
+        if (arg == "-fmem-report"sv) {
+            options.memoryReport = true;
+            continue;
+        }
+
+        if (arg.starts_with("-ftime-trace="sv)) {
+            options.timeTraceFile = arg.substr("-ftime-trace="sv.size());
+            if (options.timeTraceFile.empty()) {
+                Log::error("-ftime-trace requires a file name"sv);
+            }
+            continue;
+        }
+
+        if (arg == "-O"sv || arg == "-O0"sv || arg == "-O1"sv || arg == "-O2"sv) {
+            options.optimization.level = arg.size() == 2 ? 1 : arg[2] - '0';
+            continue;
+        }
+
+        if (arg.starts_with("-fopt-bisect-limit="sv)) {
+            auto limit = parseNonNegative(arg.substr("-fopt-bisect-limit="sv.size()));
+            if (!limit) {
+                Log::error("-fopt-bisect-limit requires a non-negative integer"sv);
+            }
+            options.optimization.bisectLimit = *limit;
+            continue;
+        }
+
+        if (arg.starts_with("-funroll-factor="sv)) {
+            auto factor = parseNonNegative(arg.substr("-funroll-factor="sv.size()));
+            if (!factor || *factor < 1) {
+                Log::error("-funroll-factor requires a positive integer"sv);
+            }
+            options.optimization.unrollFactor = *factor;
+            continue;
+        }
+
+        if (arg.starts_with("-march="sv)) {
+            auto level = std::ranges::find(ISA_LEVELS, arg.substr("-march="sv.size()));
+            if (level == ISA_LEVELS.end()) {
+                Log::error(std::format("Unknown -march: {} (x86-64, x86-64-v2, x86-64-v3, x86-64-v4)",
+                                       arg.substr("-march="sv.size())));
+            }
+            options.optimization.isaLevel = static_cast<int>(level - ISA_LEVELS.begin()) + 1;
+            continue;
+        }
+
+        if (arg == "-ffp-contract=fast"sv || arg == "-ffp-contract=off"sv) {
+            options.optimization.contractFloat = arg.ends_with("fast"sv);
+            continue;
+        }
+
+        if (arg == "-fdump-ir"sv) {
+            options.optimization.dumpIr = true;
+            continue;
+        }
+
+        if (arg == "-fverify-ir"sv) {
+            options.optimization.verifyIr = true;
+            continue;
+        }
+
+        if (arg.starts_with("-fno-"sv) && optimizer::findPass(arg.substr("-fno-"sv.size()))) {
+            options.optimization.disabledPasses.emplace_back(arg.substr("-fno-"sv.size()));
+            continue;
+        }
+
+        if (arg.starts_with("-f"sv) && optimizer::findPass(arg.substr("-f"sv.size()))) {
+            options.optimization.enabledPasses.emplace_back(arg.substr("-f"sv.size()));
+            continue;
+        }
+
+        if (arg.starts_with("-") && arg != "-"sv) {
+            Log::error(std::format("Unknown option: {}", arg));
+        }
+
+        positionals.emplace_back(arg);
+    }
+
+    if (options.run && options.interpret) {
+        Log::error("--run and --interpret cannot be used together"sv);
+    }
+
+    if (positionals.empty() || positionals.size() > 2) {
+        Log::error("Usage: yoctocc [--run | --interpret] [--load <lib>]... [--perf-map] [-O0 | -O1 | -O2] [-f<pass> | -fno-<pass>]... "
+                   "[-fopt-bisect-limit=<n>] [-march=<level>] [-ffp-contract=fast|off] [-fdump-ir] [-fverify-ir] "
+                   "[-ftime-report] [-ftime-trace=<file>] [-fmem-report] "
+                   "<source_file> [output_file]"sv);
+    }
+
+    options.sourceFile = positionals[0];
+    if (positionals.size() == 2) {
+        options.outputFile = positionals[1];
+    }
+    return options;
+}
+
+} // namespace yoctocc
@@ -144,7 +144,7 @@ std::shared_ptr<Type> Parser::enumSpecifier(Token*& token) {
             return tagScope->type;
         }
         Log::error("Unknown enum type"sv, tag);
-        return std::make_shared<Type>(TypeKind::UNKNOWN);
+        return type::makeType(TypeKind::UNKNOWN);
     }
 
     token = token::skipIf(token, "{");
@@ -182,7 +182,8 @@ std::shared_ptr<Type> Parser::enumSpecifier(Token*& token) {
 //             | struct-decl | union-decl | typedef-name
 //             | enum-specifier
 //             | "const" | "volatile" | "auto" | "register" | "restrict"
-//             | "__restrict" | "__restrict__" | "_Noreturn")+
+//             | "__restrict" | "__restrict__" | "_Noreturn" | "inline"
+//             | attribute)+
 std::shared_ptr<Type> Parser::declSpec(Token*& token, VariableAttribute* attr) {
     // clang-format off
     enum {
@@ -223,6 +224,21 @@ std::shared_ptr<Type> Parser::declSpec(Token*& token, VariableAttribute* attr) {
             continue;
         }
 
+        if (token::is(token, Keyword::INLINE)) {
+            if (!attr) {
+                Log::error("inline is not allowed here"sv, token);
+                return nullptr;
+            }
+            attr->isInline = true;
+            token = token->next.get();
+            continue;
+        }
+
+        if (token::is(token, Keyword::ATTRIBUTE)) {
+            attribute(token, attr);
+            continue;
+        }
+
         std::array comsumedIgnreKeywords {
             token::consume(token, Keyword::CONST),
             token::consume(token, Keyword::VOLATILE),
@@ -372,6 +388,44 @@ std::shared_ptr<Type> Parser::declSpec(Token*& token, VariableAttribute* attr) {
     return type;
 }
 
+// attribute = "__attribute__" "(" "(" (ident ("(" balanced-tokens ")")? ("," ident ...)*)? ")" ")"
+void Parser::attribute(Token*& token, VariableAttribute* attr) {
+    token = token::skipIf(token->next.get(), "(");
+    token = token::skipIf(token, "(");
+    while (!token::consume(token, ")")) {
+        if (token->kind == TokenKind::TERMINATOR) {
+            Log::error("unterminated attribute"sv, token);
+            return;
+        }
+        if (token::consume(token, ",")) {
+            continue;
+        }
+        const auto& name = token->originalValue;
+        if (attr && (name == "always_inline" || name == "__always_inline__")) {
+            attr->isAlwaysInline = true;
+        } else if (attr && (name == "noinline" || name == "__noinline__")) {
+            attr->isNoInline = true;
+        }
+        token = token->next.get();
+
+        // 属性の引数は使わないので、対応する ")" まで読み飛ばす
+        int depth = 0;
+        while (token::is(token, "(") || depth > 0) {
+            if (token->kind == TokenKind::TERMINATOR) {
+                Log::error("unterminated attribute"sv, token);
+                return;
+            }
+            if (token::is(token, "(")) {
+                depth++;
+            } else if (token::is(token, ")")) {
+                depth--;
+            }
+            token = token->next.get();
+        }
+    }
+    token = token::skipIf(token, ")");
+}
+
 // abstract-declarator = pointers ("(" abstract-declarator ")")? type-suffix
 std::shared_ptr<Type> Parser::abstractDeclarator(Token*& token, std::shared_ptr<Type>& type) {
     type = pointers(token, type);
@@ -379,7 +433,7 @@ std::shared_ptr<Type> Parser::abstractDeclarator(Token*& token, std::shared_ptr<
     if (token::is(token, "(")) {
         auto start = token;
         auto next = start->next.get();
-        auto dummyType = std::make_shared<Type>(TypeKind::UNKNOWN);
+        auto dummyType = type::makeType(TypeKind::UNKNOWN);
         abstractDeclarator(next, dummyType);
         token = token::skipIf(next, ")");
         type = typeSuffix(token, type);
@@ -423,7 +477,7 @@ std::shared_ptr<Type> Parser::declarator(Token*& token, const std::shared_ptr<Ty
     if (token::is(token, "(")) {
         auto start = token;
         auto next = start->next.get();
-        auto dummyType = std::make_shared<Type>(TypeKind::UNKNOWN);
+        auto dummyType = type::makeType(TypeKind::UNKNOWN);
         declarator(next, dummyType);
         token = token::skipIf(next, ")");
         type = typeSuffix(token, type);
@@ -483,6 +537,9 @@ std::shared_ptr<Type> Parser::functionParameters(Token*& token, std::shared_ptr<
             auto name = paramType->name;
             paramType = type::pointerTo(paramType->base);
             paramType->name = name;
+        } else {
+            // 構造体や typedef の型は他の宣言と共有しているので、next でつなぐ前に複製する
+            paramType = type::makeType(*paramType);
         }
         *current = paramType;
         current = &paramType->next;
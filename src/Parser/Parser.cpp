@@ -9,6 +9,7 @@
 #include "Type.hpp"
 #include "Utility.hpp"
 #include <cassert>
+#include <limits>
 #include <utility>
 
 using namespace std::string_view_literals;
@@ -28,7 +29,7 @@ bool Parser::isFunction(Token* token) {
     if (token::is(token, ";")) {
         return false;
     }
-    auto dummy = std::make_shared<Type>(TypeKind::UNKNOWN);
+    auto dummy = type::makeType(TypeKind::UNKNOWN);
     auto type = declarator(token, dummy);
     return type->kind == TypeKind::FUNCTION;
 }
@@ -62,6 +63,7 @@ Object* Parser::createLocalVariable(const std::string& name, const std::shared_p
     var->next = std::move(_locals);
     _parseScope.pushVariableScope(name)->variable = raw;
     _locals = std::move(var);
+    beginLifetime(raw);
     return raw;
 }
 
@@ -70,9 +72,21 @@ Object* Parser::createTemporaryLocalVariable(const std::shared_ptr<Type>& type)
     Object* raw = var.get();
     var->next = std::move(_locals);
     _locals = std::move(var);
+    beginLifetime(raw);
     return raw;
 }
 
+void Parser::beginLifetime(Object* var) {
+    // 引数と __va_area__ は複合文の外なので関数全体で生きている
+    if (_lifetimeScopes.empty()) {
+        return;
+    }
+    // goto で宣言より前に戻っても場所が変わらないよう、複合文に入った時点から生きているとみなす
+    auto& scope = _lifetimeScopes.back();
+    var->lifetimeBegin = scope.begin;
+    scope.locals.push_back(var);
+}
+
 Object* Parser::createGlobalVariable(const std::string& name, const std::shared_ptr<Type>& type) {
     auto var = makeVariable(name, type, false);
     Object* raw = var.get();
@@ -845,6 +859,7 @@ ParseResult Parser::parseCompoundStatement(Token* token) {
     Node* current = head.get();
 
     _parseScope.enterScope();
+    _lifetimeScopes.push_back({++_lifetimeTick, {}});
 
     while (token->kind != TokenKind::TERMINATOR && !token::is(token, "}")) {
         if (parser::isTypeName(token, _parseScope) && !token::is(token->next.get(), ":")) {
@@ -879,6 +894,11 @@ ParseResult Parser::parseCompoundStatement(Token* token) {
     }
 
     _parseScope.leaveScope();
+    int end = ++_lifetimeTick;
+    for (auto var : _lifetimeScopes.back().locals) {
+        var->lifetimeEnd = end;
+    }
+    _lifetimeScopes.pop_back();
 
     auto node = createBlockNode(head->token, std::move(head->next));
     return {std::move(node), token->next.get()};
@@ -1198,11 +1218,10 @@ ParseResult Parser::parseFunctionCall(Token* token) {
         }
 
         if (parameterType) {
-            if (parameterType->kind == TypeKind::STRUCT || parameterType->kind == TypeKind::UNION) {
-                Log::error("Passing struct/union is not supported yet"sv, token);
-                return {};
+            // 構造体・共用体はそのまま値を渡す
+            if (parameterType->kind != TypeKind::STRUCT && parameterType->kind != TypeKind::UNION) {
+                arg = createCastNode(std::move(arg), parameterType);
             }
-            arg = createCastNode(std::move(arg), parameterType);
             parameterType = parameterType->next;
         } else if (arg->type->kind == TypeKind::FLOAT) {
             arg = createCastNode(std::move(arg), type::doubleType());
@@ -1226,6 +1245,8 @@ ParseResult Parser::parseFunctionCall(Token* token) {
     node->functionType = type;
     node->type = type->returnType;
     node->arguments = std::move(head->next);
+    // 定数式からの呼び出しを評価するときに関数本体を参照する
+    node->variable = varScope->variable;
 
     return {std::move(node), token};
 }
@@ -1260,10 +1281,19 @@ Token* Parser::parseFunction(Token* token, std::shared_ptr<Type>& baseType, cons
         return nullptr;
     }
 
+    // 宣言子の後ろに書いた __attribute__((...)) も関数に付ける
+    auto functionAttr = attr;
+    while (token::is(token, Keyword::ATTRIBUTE)) {
+        attribute(token, &functionAttr);
+    }
+
     auto name = token::getIdentifier(funcType->name);
     auto func = makeFunction(name, funcType);
     func->isDefinition = !token::consume(token, ";");
     func->isStatic = attr.isStatic;
+    func->isInline = functionAttr.isInline;
+    func->isAlwaysInline = functionAttr.isAlwaysInline;
+    func->isNoInline = functionAttr.isNoInline;
 
     _parseScope.pushVariableScope(name)->variable = func.get();
 
@@ -1282,7 +1312,7 @@ Token* Parser::parseFunction(Token* token, std::shared_ptr<Type>& baseType, cons
     _currentFunction->parameters = _locals.get();
 
     if (funcType->isVariadic) {
-        _currentFunction->vaArea = createLocalVariable("__va_area__", type::arrayOf(type::charType(), 136));
+        _currentFunction->vaArea = createLocalVariable("__va_area__", type::arrayOf(type::charType(), 200));
     }
 
     token = token::skipIf(token, "{");
@@ -1347,8 +1377,14 @@ Token* Parser::parseGlobalVariable(Token* token, std::shared_ptr<Type>& baseType
 ParseResult Parser::parsePrimary(Token* token) {
     if (token::is(token, "(") && token::is(token->next.get(), "{")) {
         auto node = std::make_unique<Node>(NodeType::STATEMENT_EXPRESSION, token);
+        Object* outer = _locals.get();
         auto [block, rest] = parseCompoundStatement(token->next->next.get());
         node->body = std::move(block->body);
+        // 文式の値は中の変数を指したまま外で使われることがあるので、外側の複合文まで生かす
+        for (auto var = _locals.get(); var != outer; var = var->next.get()) {
+            var->lifetimeEnd = std::numeric_limits<int>::max();
+            beginLifetime(var);
+        }
         return {std::move(node), token::skipIf(rest, ")")};
     }
 
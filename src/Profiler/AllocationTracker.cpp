@@ -0,0 +1,70 @@
+#include "Profiler/AllocationTracker.hpp"
+
+#include <print>
+
+namespace yoctocc::profiler {
+
+std::string_view to_string_view(AllocationCategory category) {
+    switch (category) {
+        case AllocationCategory::TOKEN:
+            return "Token";
+        case AllocationCategory::NODE:
+            return "Node";
+        case AllocationCategory::TYPE:
+            return "Type";
+        case AllocationCategory::OBJECT:
+            return "Object";
+        case AllocationCategory::INITIALIZER:
+            return "Initializer";
+        case AllocationCategory::INSTRUCTION:
+            return "instruction strings";
+        case AllocationCategory::SCOPE:
+            return "scope entries";
+    }
+    return "unknown";
+}
+
+AllocationTracker& AllocationTracker::instance() {
+    static AllocationTracker tracker;
+    return tracker;
+}
+
+void AllocationTracker::allocated(AllocationCategory category, size_t bytes, uint64_t count) noexcept {
+    if (!_enabled) {
+        return;
+    }
+    auto& counter = _counters[static_cast<size_t>(category)];
+    counter.allocations += count;
+    counter.bytes += bytes;
+    counter.liveBytes += static_cast<int64_t>(bytes);
+    if (counter.liveBytes > counter.peakBytes) {
+        counter.peakBytes = counter.liveBytes;
+    }
+}
+
+void AllocationTracker::deallocated(AllocationCategory category, size_t bytes) noexcept {
+    if (!_enabled) {
+        return;
+    }
+    _counters[static_cast<size_t>(category)].liveBytes -= static_cast<int64_t>(bytes);
+}
+
+void AllocationTracker::print(std::FILE* out) const {
+    std::println(out, "===== Memory report =====");
+    std::println(out, "{:<20} {:>12} {:>14} {:>14} {:>14}", "category", "allocations", "total (KB)", "live (KB)",
+                 "peak (KB)");
+    Counter total{};
+    for (size_t i = 0; i < ALLOCATION_CATEGORY_COUNT; i++) {
+        const auto& counter = _counters[i];
+        std::println(out, "{:<20} {:>12} {:>14.1f} {:>14.1f} {:>14.1f}",
+                     to_string_view(static_cast<AllocationCategory>(i)), counter.allocations, counter.bytes / 1024.0,
+                     counter.liveBytes / 1024.0, counter.peakBytes / 1024.0);
+        total.allocations += counter.allocations;
+        total.bytes += counter.bytes;
+        total.liveBytes += counter.liveBytes;
+    }
+    std::println(out, "{:<20} {:>12} {:>14.1f} {:>14.1f}", "total", total.allocations, total.bytes / 1024.0,
+                 total.liveBytes / 1024.0);
+}
+
+} // namespace yoctocc::profiler
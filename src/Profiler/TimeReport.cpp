@@ -0,0 +1,153 @@
+#include "Profiler/TimeReport.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <format>
+#include <fstream>
+#include <print>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "Logger.hpp"
+
+namespace {
+using namespace yoctocc::profiler;
+
+// codegen の内訳として表示する関数の数
+constexpr size_t MAX_REPORTED_FUNCTIONS = 10;
+
+int64_t cpuMicroseconds() {
+    timespec ts{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1'000'000 + ts.tv_nsec / 1000;
+}
+
+long peakRssKilobytes() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+std::string escapeJson(std::string_view text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += std::format("\\u{:04x}", c);
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+} // namespace
+
+namespace yoctocc::profiler {
+
+TimeReport& TimeReport::instance() {
+    static TimeReport report;
+    return report;
+}
+
+TimeReport::Scope::Scope(std::string_view name, std::string_view category) {
+    auto& report = instance();
+    if (report.enabled()) {
+        _index = report.begin(name, category);
+    }
+}
+
+TimeReport::Scope::~Scope() {
+    if (_index != SIZE_MAX) {
+        instance().end(_index);
+    }
+}
+
+size_t TimeReport::begin(std::string_view name, std::string_view category) {
+    auto now = std::chrono::steady_clock::now();
+    _events.emplace_back(Event{
+        .name = std::string{name},
+        .category = std::string{category},
+        .depth = _depth++,
+        .startMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(now - _origin).count(),
+        .wallMicroseconds = 0,
+        .cpuMicroseconds = cpuMicroseconds(),
+        .peakRssKilobytes = 0,
+    });
+    return _events.size() - 1;
+}
+
+void TimeReport::end(size_t index) {
+    auto now = std::chrono::steady_clock::now();
+    auto& event = _events[index];
+    event.wallMicroseconds =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - _origin).count() - event.startMicroseconds;
+    event.cpuMicroseconds = cpuMicroseconds() - event.cpuMicroseconds;
+    event.peakRssKilobytes = peakRssKilobytes();
+    _depth--;
+}
+
+void TimeReport::print(std::FILE* out) const {
+    int64_t totalWall = 0;
+    int64_t totalCpu = 0;
+    for (const auto& event : _events) {
+        if (event.depth == 0) {
+            totalWall += event.wallMicroseconds;
+            totalCpu += event.cpuMicroseconds;
+        }
+    }
+
+    std::println(out, "===== Time report =====");
+    std::println(out, "{:<24} {:>12} {:>12} {:>7} {:>14}", "phase", "wall (ms)", "cpu (ms)", "wall %", "peak RSS (KB)");
+    for (const auto& event : _events) {
+        if (event.depth != 0) {
+            continue;
+        }
+        double percent = totalWall > 0 ? 100.0 * event.wallMicroseconds / totalWall : 0.0;
+        std::println(out, "{:<24} {:>12.3f} {:>12.3f} {:>6.1f}% {:>14}", event.name, event.wallMicroseconds / 1000.0,
+                     event.cpuMicroseconds / 1000.0, percent, event.peakRssKilobytes);
+    }
+    std::println(out, "{:<24} {:>12.3f} {:>12.3f} {:>7} {:>14}", "total", totalWall / 1000.0, totalCpu / 1000.0, "",
+                 peakRssKilobytes());
+
+    std::vector<const Event*> functions;
+    for (const auto& event : _events) {
+        if (event.category == "function") {
+            functions.emplace_back(&event);
+        }
+    }
+    if (functions.empty()) {
+        return;
+    }
+    std::ranges::stable_sort(functions, std::ranges::greater{}, &Event::wallMicroseconds);
+
+    std::println(out, "");
+    std::println(out, "codegen by function ({} functions, slowest {} shown)", functions.size(),
+                 std::min(functions.size(), MAX_REPORTED_FUNCTIONS));
+    std::println(out, "{:<24} {:>12} {:>12}", "function", "wall (ms)", "cpu (ms)");
+    for (size_t i = 0; i < functions.size() && i < MAX_REPORTED_FUNCTIONS; i++) {
+        std::println(out, "{:<24} {:>12.3f} {:>12.3f}", functions[i]->name, functions[i]->wallMicroseconds / 1000.0,
+                     functions[i]->cpuMicroseconds / 1000.0);
+    }
+}
+
+void TimeReport::writeTrace(const std::string& path) const {
+    std::ofstream ofs(path);
+    if (!ofs) {
+        Log::error(std::format("Failed to open trace file: {}", path));
+    }
+
+    const int pid = static_cast<int>(getpid());
+    ofs << "{\"traceEvents\":[\n";
+    for (size_t i = 0; i < _events.size(); i++) {
+        const auto& event = _events[i];
+        ofs << std::format(
+            "{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{},\"dur\":{},\"pid\":{},\"tid\":0,"
+            "\"args\":{{\"cpu_us\":{},\"peak_rss_kb\":{}}}}}{}\n",
+            escapeJson(event.name), escapeJson(event.category), event.startMicroseconds, event.wallMicroseconds, pid,
+            event.cpuMicroseconds, event.peakRssKilobytes, i + 1 < _events.size() ? "," : "");
+    }
+    ofs << "],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+} // namespace yoctocc::profiler
@@ -0,0 +1,84 @@
+#include "Runtime/HostLibrary.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <format>
+#include <unordered_map>
+#include "Logger.hpp"
+
+namespace {
+
+int assertCount = 0;
+
+// test_helper.c の ASSERT と同じ形式で結果を出力する
+void builtinAssert(int expected, int actual) {
+    assertCount++;
+    std::fprintf(stderr, "ASSERT_RESULT %s #%d expected %d actual %d\n", expected == actual ? "PASS" : "FAIL",
+                 assertCount, expected, actual);
+}
+
+// 組み込みのホスト関数表
+const std::unordered_map<std::string, void*>& hostFunctions() {
+    static const std::unordered_map<std::string, void*> table = {
+        {"ASSERT", reinterpret_cast<void*>(&builtinAssert)},
+        {"printf", reinterpret_cast<void*>(&std::printf)},
+        {"sprintf", reinterpret_cast<void*>(&std::sprintf)},
+        {"vsprintf", reinterpret_cast<void*>(&std::vsprintf)},
+        {"puts", reinterpret_cast<void*>(&std::puts)},
+        {"putchar", reinterpret_cast<void*>(&std::putchar)},
+        {"strcmp", reinterpret_cast<void*>(&std::strcmp)},
+        {"strncmp", reinterpret_cast<void*>(&std::strncmp)},
+        {"strlen", reinterpret_cast<void*>(&std::strlen)},
+        {"memcpy", reinterpret_cast<void*>(&std::memcpy)},
+        {"memset", reinterpret_cast<void*>(&std::memset)},
+        {"malloc", reinterpret_cast<void*>(&std::malloc)},
+        {"calloc", reinterpret_cast<void*>(&std::calloc)},
+        {"free", reinterpret_cast<void*>(&std::free)},
+        {"exit", reinterpret_cast<void*>(&std::exit)},
+    };
+    return table;
+}
+
+} // namespace
+
+namespace yoctocc::runtime {
+
+HostLibrary::HostLibrary(const std::vector<std::string>& libraries) {
+    for (const auto& library : libraries) {
+        void* handle = dlopen(library.c_str(), RTLD_NOW | RTLD_GLOBAL);
+        if (!handle) {
+            Log::error(std::format("failed to load {}: {}", library, dlerror()));
+        }
+        _handles.emplace_back(handle);
+    }
+}
+
+HostLibrary::~HostLibrary() {
+    for (void* handle : _handles) {
+        dlclose(handle);
+    }
+}
+
+void* HostLibrary::find(const std::string& name) const {
+    for (void* handle : _handles) {
+        if (void* address = dlsym(handle, name.c_str())) {
+            return address;
+        }
+    }
+    if (auto it = hostFunctions().find(name); it != hostFunctions().end()) {
+        return it->second;
+    }
+    return dlsym(RTLD_DEFAULT, name.c_str());
+}
+
+void* HostLibrary::resolve(const std::string& name) const {
+    void* address = find(name);
+    if (!address) {
+        Log::error(std::format("undefined symbol: {}", name));
+    }
+    return address;
+}
+
+} // namespace yoctocc::runtime
@@ -450,10 +450,14 @@ std::unique_ptr<Token> parsePunctuator(char ch, ParseContext& context) {
 namespace yoctocc {
 
 std::unique_ptr<Token> tokenize(std::ifstream& ifs) {
+    std::string content{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+    return tokenize(content);
+}
+
+std::unique_ptr<Token> tokenize(const std::string& content) {
     auto head = std::make_unique<Token>();
     Token* current = head.get();
 
-    std::string content{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
     Log::sourceCode = content;
     auto it = content.cbegin();
     auto startLocation = [&it, &content]() { return static_cast<size_t>(std::distance(content.cbegin(), it)); };
@@ -54,20 +54,20 @@ std::tuple<std::unique_ptr<Node>, std::unique_ptr<Node>> convertUsualArithmetic(
 namespace yoctocc::type {
 
 std::shared_ptr<Type> pointerTo(const std::shared_ptr<Type>& base) {
-    auto type = std::make_shared<Type>(TypeKind::POINTER, 8, 8);
+    auto type = makeType(TypeKind::POINTER, 8, 8);
     type->base = base;
     type->isUnsigned = true;
     return type;
 }
 
 std::shared_ptr<Type> functionType(const std::shared_ptr<Type>& returnType) {
-    auto type = std::make_shared<Type>(TypeKind::FUNCTION);
+    auto type = makeType(TypeKind::FUNCTION);
     type->returnType = returnType;
     return type;
 }
 
 std::shared_ptr<Type> arrayOf(const std::shared_ptr<Type>& base, int size) {
-    auto type = std::make_shared<Type>(TypeKind::ARRAY, base->size * size, base->alignment);
+    auto type = makeType(TypeKind::ARRAY, base->size * size, base->alignment);
     type->base = base;
     type->arraySize = size;
     return type;
@@ -224,7 +224,7 @@ void addType(Node* node) {
 }
 
 std::shared_ptr<Type> copyStructType(const std::shared_ptr<Type>& from) {
-    auto to = std::make_shared<Type>(*from);
+    auto to = makeType(*from);
     auto head = std::make_unique<Member>();
     auto current = head.get();
 
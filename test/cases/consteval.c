@@ -0,0 +1,73 @@
+void ASSERT(int expected, int actual);
+
+int square(int x) { return x * x; }
+
+int fib(int n) {
+    if (n < 2)
+        return n;
+    return fib(n - 1) + fib(n - 2);
+}
+
+unsigned crc8(unsigned c) {
+    for (int i = 0; i < 8; i++)
+        c = c & 1 ? (c >> 1) ^ 0xedb88320 : c >> 1;
+    return c;
+}
+
+double half(double x) { return x / 2; }
+
+long sum(int n) {
+    long total = 0;
+    int values[8];
+    for (int i = 0; i < 8; i++)
+        values[i] = i * n;
+    for (int i = 0; i < 8; i++)
+        total += values[i];
+    return total;
+}
+
+char narrow(int x) { return x; }
+
+void fill(int *p, int n) { for (int i = 0; i < n; i++) p[i] = i + 1; }
+int filled(int n) { int buf[8]; fill(buf, n); return buf[0] + buf[n - 1]; }
+
+int array[square(3)];
+unsigned table[4] = {crc8(0), crc8(1), crc8(2), crc8(255)};
+double halves[2] = {half(3), half(0.5)};
+long sums = sum(2) + square(2);
+char narrowed = narrow(300);
+int fills = filled(8);
+
+int classify(int x) {
+    switch (x) {
+    case square(2):
+        return 1;
+    case fib(6):
+        return 2;
+    }
+    return 0;
+}
+
+int main() {
+    ASSERT(36, sizeof(array));
+    ASSERT(55, ({ enum { value = fib(10) }; value; }));
+    ASSERT(16, ({ char x[square(4)]; sizeof(x); }));
+
+    ASSERT(1, table[0] == crc8(0));
+    ASSERT(1, table[1] == crc8(1));
+    ASSERT(1, table[2] == crc8(2));
+    ASSERT(1, table[3] == crc8(255));
+    ASSERT(1, table[1] == 0x77073096);
+
+    ASSERT(1, halves[0] == 1.5);
+    ASSERT(1, halves[1] == 0.25);
+    ASSERT(60, sums);
+    ASSERT(44, narrowed);
+    ASSERT(9, fills);
+
+    ASSERT(1, classify(4));
+    ASSERT(2, classify(8));
+    ASSERT(0, classify(5));
+
+    return 0;
+}
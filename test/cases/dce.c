@@ -0,0 +1,25 @@
+void ASSERT(int expected, int actual);
+
+// 到達できないコードと読まれない書き込みの削除
+static int dce_unused_count;
+static int dce_unused(void) { return dce_unused_count++; }
+static int dce_first(int *a) { return a[0]; }
+int dce_overwrite(void) { int a[2]; a[0] = 1; a[0] = 2; a[1] = a[0]; a[0] = 3; return a[0] * 10 + a[1]; }
+int dce_call(void) { int a[2]; a[0] = 5; int r = dce_first(a); a[0] = 6; return r * 10 + a[0]; }
+int dce_clear(void) { int a[4] = {0}; a[1] = 3; return a[0] + a[1]; }
+int dce_branch(int x) {
+    if (0) return 1;
+    while (1) { if (x > 2) break; x++; }
+    return x;
+    x = 9;
+}
+
+int main() {
+    ASSERT(32, dce_overwrite());
+    ASSERT(56, dce_call());
+    ASSERT(3, dce_clear());
+    ASSERT(3, dce_branch(0));
+    ASSERT(7, dce_branch(7));
+
+    return 0;
+}
@@ -80,5 +80,12 @@ int main() {
     ASSERT(0, 0.0/0.0 > 0);
     ASSERT(0, 0.0/0.0 >= 0);
 
+    ASSERT(1, 1/0.0 > 0);
+    ASSERT(1, 1/-0.0 < 0);
+    ASSERT(1, 1/-0.0f < 0);
+    ASSERT(1, ({ double x = 0.0; 1/-x < 0; }));
+    ASSERT(-5, ({ float x = 2.5f; -x * 2; }));
+    ASSERT(4, ({ double x = 1.5; x * 1.5 + 1.5 - -x / 1.5 - 0.25; }));
+
     return 0;
 }
@@ -0,0 +1,77 @@
+void ASSERT(int expected, int actual);
+
+// 葉関数のフレームポインタの省略とレッドゾーン
+int fpo_leaf(int i) { int a[16]; for (int j = 0; j < 16; j++) a[j] = j * j; return a[i & 15]; }
+int fpo_large_leaf(int i) { int a[64]; for (int j = 0; j < 64; j++) a[j] = j + 1; return a[i & 63]; }
+int fpo_stack_args(int a, int b, int c, int d, int e, int f, int g, int h) { return g * 10 + h; }
+int fpo_clear(int i) { char a[100] = {0}; a[i] = 5; return a[0] + a[50] + a[99]; }
+int fpo_pressure(int a, int b) {
+    int c = a + 1, d = b + 2, e = a * b, f = a - b, g = a ^ 5, h = b | 8;
+    int x = fpo_stack_args(a, b, c, d, e, f, g, h);
+    return a + b + c + d + e + f + g + h + x;
+}
+
+// 早期リターンをプロローグの前で抜けるシュリンクラッピング
+int wrap_deref(int *p) { if (!p) return 0; return fpo_stack_args(*p, 0, 0, 0, 0, 0, *p, 1) + *p; }
+long wrap_fib(long n) { if (n < 2) return n; return wrap_fib(n - 1) + wrap_fib(n - 2); }
+double wrap_float(int n, double x) { if (n > 0) return x; return wrap_float(n + 1, x * 2) + 1; }
+int wrap_unsigned(unsigned n, int m) { if (n >= 5u) return m; return wrap_unsigned(n + 1, m + n) * 2; }
+int wrap_stack(int a, int b, int c, int d, int e, int f, int g) { if (g == 0) return a; return wrap_stack(b, c, d, e, f, a, g - 1) + g; }
+void wrap_store(int *p, int n) { if (n <= 0) return; *p = fpo_leaf(n); }
+
+// 寿命が重ならないローカル変数のスタックスロットの共有
+int color_sum(int *a, int n) { int s = 0; for (int i = 0; i < n; i++) s += a[i]; return s; }
+int color_siblings(int n) {
+    int r = 0;
+    { int a[8]; for (int i = 0; i < 8; i++) a[i] = i + n; r += color_sum(a, 8); }
+    { int b[8]; for (int i = 0; i < 8; i++) b[i] = i * n; r += color_sum(b, 8); }
+    return r;
+}
+int color_nested(int n) {
+    int keep[4] = {1, 2, 3, 4};
+    for (int k = 0; k < n; k++) {
+        { char c[12]; for (int i = 0; i < 12; i++) c[i] = i; keep[k & 3] += c[11]; }
+        { long l[3]; l[0] = l[1] = l[2] = k; keep[(k + 1) & 3] += color_sum((int *)l, 6); }
+    }
+    return color_sum(keep, 4);
+}
+struct ColorMixed { char c; long l; short s; };
+int color_check(char *a, long *b, short *c, char *d, struct ColorMixed *m) {
+    return (long)b % 8 + (long)c % 2 + (long)m % 8 + *a + *b + *c + d[0] + d[1] + d[2] + m->c + m->l + m->s;
+}
+int color_align(void) {
+    char a = 1; long b = 2; short c = 3; char d[3] = {4, 5, 6}; struct ColorMixed m = {7, 8, 9};
+    return color_check(&a, &b, &c, d, &m);
+}
+struct ColorPair { long a, b; };
+long color_stmt_expr(int n) {
+    struct ColorPair p = ({ struct ColorPair q = {n, n * 2}; q; });
+    return ({ long t[2] = {p.a, p.b}; { long u[2] = {3, 4}; t[0] += u[1]; } t[0] + t[1]; });
+}
+
+int main() {
+    ASSERT(49, fpo_leaf(7));
+    ASSERT(64, fpo_large_leaf(63));
+    ASSERT(78, fpo_stack_args(1, 2, 3, 4, 5, 6, 7, 8));
+    ASSERT(5, fpo_clear(50));
+    ASSERT(118, fpo_pressure(3, 4));
+
+    ASSERT(0, wrap_deref(0));
+    ASSERT(34, ({ int x = 3; wrap_deref(&x); }));
+    ASSERT(55, wrap_fib(10));
+    ASSERT(4, wrap_float(3, 4.0));
+    ASSERT(19, wrap_float(-2, 2.0));
+    ASSERT(9, wrap_unsigned(7, 9));
+    ASSERT(256, wrap_unsigned(1, 6));
+    ASSERT(1, wrap_stack(1, 2, 3, 4, 5, 6, 0));
+    ASSERT(10, wrap_stack(1, 2, 3, 4, 5, 6, 3));
+    ASSERT(7, ({ int x = 7; wrap_store(&x, 0); x; }));
+    ASSERT(16, ({ int x = 7; wrap_store(&x, 4); x; }));
+
+    ASSERT(100, color_siblings(2));
+    ASSERT(52, color_nested(3));
+    ASSERT(45, color_align());
+    ASSERT(19, color_stmt_expr(5));
+
+    return 0;
+}
@@ -98,6 +98,12 @@ char *fmt(char *buf, char *fmt, ...) {
     vsprintf(buf, fmt, ap);
 }
 
+char *fmt_after(long a, long b, long c, long d, long e, long f, long g, char *buf, char *fmt, ...) {
+    va_list ap;
+    *ap = *(__va_elem *)__va_area__;
+    vsprintf(buf, fmt, ap);
+}
+
 double add_double(double x, double y);
 float add_float(float x, float y);
 
@@ -109,6 +115,39 @@ double add_double3(double x, double y, double z) {
   return x + y + z;
 }
 
+int arg_calls = 0;
+int count_arg(int x) { arg_calls++; return x; }
+double mix_args(double a, int b, float c, long d, double e, char f) { return a + b * 2 + c * 4 + d * 8 + e * 16 + f * 32; }
+
+int many_ints(int a, int b, int c, int d, int e, int f, int g, char h, long i, int j) {
+    return ((((((((a * 10 + b) * 10 + c) * 10 + d) * 10 + e) * 10 + f) * 10 + g) * 10 + h) * 10 + i) * 10 + j;
+}
+double many_doubles(double a, double b, double c, double d, double e, double f, double g, double h, float i, int j, double k) {
+    return (((((((((a * 10 + b) * 10 + c) * 10 + d) * 10 + e) * 10 + f) * 10 + g) * 10 + h) * 10 + i) * 10 + k) - j;
+}
+
+typedef struct { char *ptr; long len; } Slice;
+typedef struct { float x, y; } Vec2;
+typedef struct { double x; int n; } Tagged;
+typedef struct { char c[3]; } Char3;
+typedef struct { char c[7]; short s; } Odd9;
+typedef struct { long a, b, c; } Large;
+long slice_len(Slice s) { return s.len; }
+char slice_at(Slice s, long i) { return s.ptr[i]; }
+float vec2_dot(Vec2 a, Vec2 b) { return a.x * b.x + a.y * b.y; }
+double tagged(Tagged t) { return t.x * t.n; }
+int char3(Char3 c) { return c.c[0] * 100 + c.c[1] * 10 + c.c[2]; }
+int odd9(Odd9 o) { return o.c[0] + o.c[6] + o.s; }
+long large(Large l) { return l.a * 100 + l.b * 10 + l.c; }
+long large_set(Large l) { l.a = 9; return l.a + l.b; }
+long struct_after_regs(int a, int b, int c, int d, int e, Slice s, Large l, Vec2 v) {
+    return a + b + c + d + e + s.len + l.c + v.y;
+}
+
+typedef struct { char a; int b; short c; long d; } Mixed;
+Mixed mixed_make(int n) { Mixed m = {n, n * 2, n * 3, n * 4}; return m; }
+long mixed_sum(int n) { Mixed x = mixed_make(n); Mixed y = mixed_make(n + 1); return x.a + x.b + x.c + x.d + y.d * 100; }
+
 int main() {
     ASSERT(3, ret3());
     ASSERT(8, add2(3, 5));
@@ -174,10 +213,38 @@ int main() {
 
     ASSERT(7, add_float3(2.5, 2.5, 2.5));
     ASSERT(7, add_double3(2.5, 2.5, 2.5));
+    ASSERT(63, ({ int i = 1; float f = 1; mix_args(1.0, i, f, count_arg(1), 1.0, i); }));
+    ASSERT(63, ({ double d = 1; char c = 1; mix_args(count_arg(1), count_arg(1), d, c, count_arg(1), count_arg(1)); }));
+    ASSERT(95, ({ int a[2] = {1, 2}; mix_args(*a, a[1] - 1, a[0], count_arg(a[0]), 1.0, count_arg(2)); }));
+    ASSERT(7, arg_calls);
+
+    ASSERT(1234567890, many_ints(1,2,3,4,5,6,7,8,9,0));
+    ASSERT(1234567880, many_doubles(1,2,3,4,5,6,7,8,9,10,0));
+    ASSERT(0, ({ char buf[100]; sprintf(buf, "%d%d%d%d%d%d%.1f", 1, 2, 3, 4, 5, 6, 7.5); strcmp(buf, "1234567.5"); }));
+
+    ASSERT(3, ({ Slice s = {"abc", 3}; slice_len(s); }));
+    ASSERT('c', ({ Slice s = {"abc", 3}; slice_at(s, 2); }));
+    ASSERT(11, ({ Vec2 a = {1, 2}, b = {3, 4}; vec2_dot(a, b); }));
+    ASSERT(-15, ({ Tagged t = {2.5, -6}; tagged(t); }));
+    ASSERT(123, ({ Char3 c = {{1, 2, 3}}; char3(c); }));
+    ASSERT(310, ({ Odd9 o = {{1, 0, 0, 0, 0, 0, 9}, 300}; odd9(o); }));
+    ASSERT(123, ({ Large l = {1, 2, 3}; large(l); }));
+    ASSERT(11, ({ Large l = {1, 2, 3}; large_set(l); }));
+    ASSERT(1, ({ Large l = {1, 2, 3}; large_set(l); l.a; }));
+    ASSERT(27, ({ Slice s = {"", 7}; Large l = {0, 0, 3}; Vec2 v = {0, 2}; struct_after_regs(1, 2, 3, 4, 5, s, l, v); }));
+    ASSERT(5, ({ Mixed m = mixed_make(5); m.a; }));
+    ASSERT(10, ({ Mixed m = mixed_make(5); m.b; }));
+    ASSERT(15, ({ Mixed m = mixed_make(5); m.c; }));
+    ASSERT(20, ({ Mixed m = mixed_make(5); m.d; }));
+    ASSERT(1630, mixed_sum(3));
 
     ASSERT(0, ({ char buf[100]; sprintf(buf, "%.1f", (float)3.5); strcmp(buf, "3.5"); }));
 
     ASSERT(0, ({ char buf[100]; fmt(buf, "%.1f", (float)3.5); strcmp(buf, "3.5"); }));
+    ASSERT(0, ({ char buf[100]; fmt(buf, "%d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9); strcmp(buf, "1 2 3 4 5 6 7 8 9"); }));
+    ASSERT(0, ({ char buf[100]; fmt(buf, "%.1f %.1f %.1f %.1f %.1f %.1f %.1f %.1f %.1f %.1f", 0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5); strcmp(buf, "0.5 1.5 2.5 3.5 4.5 5.5 6.5 7.5 8.5 9.5"); }));
+    ASSERT(0, ({ char buf[100]; fmt(buf, "%d %.1f %d %.1f %d %d %d %d %d", 1, 2.5, 3, 4.5, 5, 6, 7, 8, 9); strcmp(buf, "1 2.5 3 4.5 5 6 7 8 9"); }));
+    ASSERT(0, ({ char buf[100]; fmt_after(1, 2, 3, 4, 5, 6, 7, buf, "%d %d %s", 8, 9, "foo"); strcmp(buf, "8 9 foo"); }));
 
     return 0;
 }
@@ -0,0 +1,22 @@
+void ASSERT(int expected, int actual);
+
+// 共通部分式の削除 (間に別名になりうる書き込みがあれば読み直す)
+struct GvnPoint { int x, y; };
+int gvn_g;
+void gvn_bump() { gvn_g++; }
+int gvn_len2(struct GvnPoint *p) { return p->x * p->x + p->y * p->y; }
+int gvn_alias(int *a, int *b) { int t = *a; *b = 10; return t + *a; }
+int gvn_call(void) { int t = gvn_g; gvn_bump(); return gvn_g - t; }
+int gvn_forward(struct GvnPoint *p) { p->x = 6; p->y = 7; return p->x * p->y; }
+char gvn_narrow(char *c) { *c = 300; return *c; }
+
+int main() {
+    ASSERT(25, ({ struct GvnPoint p = {3, 4}; gvn_len2(&p); }));
+    ASSERT(11, ({ int a = 1; gvn_alias(&a, &a); }));
+    ASSERT(210, ({ int a = 1, b = 2; int r = gvn_alias(&a, &b); r * 100 + b; }));
+    ASSERT(1, gvn_call());
+    ASSERT(42, ({ struct GvnPoint p; gvn_forward(&p); }));
+    ASSERT(44, ({ char c; gvn_narrow(&c); }));
+
+    return 0;
+}
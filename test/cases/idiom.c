@@ -0,0 +1,22 @@
+void ASSERT(int expected, int actual);
+
+// ビット数え上げなどのループを命令に置き換えても結果が変わらないこと
+int idiom_pop(unsigned x) { int c = 0; while (x) { x &= x - 1; c++; } return c; }
+int idiom_pop_shift(unsigned long x) { int c = 0; for (; x; x >>= 1) c += x & 1; return c; }
+int idiom_width(unsigned x) { int n = 0; while (x) { x >>= 1; n++; } return n; }
+int idiom_ctz(unsigned x) { int n = 0; while (!(x & 1)) { x >>= 1; n++; } return n * 100 + x; }
+int idiom_do(unsigned x) { int c = 0; do { x &= x - 1; c++; } while (x); return c; }
+
+int main() {
+    ASSERT(0, idiom_pop(0));
+    ASSERT(32, idiom_pop(4294967295));
+    ASSERT(3, idiom_pop_shift(4294967296 + 5));
+    ASSERT(0, idiom_width(0));
+    ASSERT(10, idiom_width(1000));
+    ASSERT(301, idiom_ctz(8));
+    ASSERT(305, idiom_ctz(40));
+    ASSERT(1, idiom_do(0));
+    ASSERT(2, idiom_do(6));
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+void ASSERT(int expected, int actual);
+
+// インライン展開 (ローカル変数の名前の衝突、switch、再帰、属性)
+struct InlinePoint { int x, y; };
+static inline int inline_get_x(struct InlinePoint *p) { return p->x; }
+inline void inline_set_y(struct InlinePoint *p, int y) { p->y = y; }
+int inline_sum(struct InlinePoint *p) { inline_set_y(p, 5); return inline_get_x(p) + p->y; }
+int inline_sign(int x) { if (x < 0) return -1; if (x > 0) return 1; return 0; }
+int inline_signs(int a, int b) { return inline_sign(a) * 10 + inline_sign(b); }
+static inline int inline_local(int x) { int t = x * 2; { int t = 3; x += t; } return t + x; }
+int inline_shadow(int t) { return inline_local(t) + t; }
+int inline_switch(int x) { switch (x) { case 1: return 10; case 2: x += 5; default: break; } return x; }
+int inline_switches(void) { return inline_switch(1) * 100 + inline_switch(2) * 10 + inline_switch(3); }
+static int inline_loop(int n) { int s = 0; for (int i = 0; i < n; i++) { if (i == 3) continue; s += i; } return s; }
+int inline_loops(void) { return inline_loop(5) + inline_loop(2); }
+int inline_fact(int n) { if (n <= 1) return 1; return n * inline_fact(n - 1); }
+int inline_fact_caller(int n) { return inline_fact(n) + 1; }
+static int __attribute__((noinline)) inline_never(int x) { return x + 1; }
+__attribute__((always_inline)) static inline int inline_always(int x) {
+    int s = 0;
+    for (int i = 0; i < x; i++) { s += i; s ^= i << 1; s -= i & 3; s += x * i; s |= i; s &= 0xffff; }
+    return s;
+}
+int inline_attributes(int x) { return inline_never(x) + inline_always(x); }
+int inline_effects(int *p) { return *p += 1; }
+int inline_args(void) { int a = 1; int r = inline_effects(&a) + inline_effects(&a); return r * 10 + a; }
+void inline_nothing(void) {}
+int inline_void(void) { inline_nothing(); return 9; }
+
+int main() {
+    ASSERT(8, ({ struct InlinePoint p = {3, 0}; inline_sum(&p); }));
+    ASSERT(-9, inline_signs(-4, 1));
+    ASSERT(0, inline_signs(0, 0));
+    ASSERT(27, inline_shadow(6));
+    ASSERT(1000 + 70 + 3, inline_switches());
+    ASSERT(8, inline_loops());
+    ASSERT(121, inline_fact_caller(5));
+    ASSERT(inline_never(7) + inline_always(7), inline_attributes(7));
+    ASSERT(53, inline_args());
+    ASSERT(9, inline_void());
+
+    return 0;
+}
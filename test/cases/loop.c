@@ -0,0 +1,76 @@
+void ASSERT(int expected, int actual);
+
+// ループ不変式の移動 (別名になりうる書き込みと、1 回も回らないループ)
+int licm_g;
+void licm_bump() { licm_g++; }
+int licm_rows(int *img, int w, int h) {
+    int s = 0;
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+            s += img[y * w + x] * (w * h);
+    return s;
+}
+int licm_alias(int n) {
+    int t[2] = {1, 2}; int *p = t; int s = 0;
+    for (int i = 0; i < n; i++) { s += t[1]; p[1] = s; }
+    return s;
+}
+int licm_call(int n) { int s = 0; licm_g = 1; for (int i = 0; i < n; i++) { s += licm_g; licm_bump(); } return s; }
+int licm_div(int n, int d) { int s = 0; for (int i = 0; i < n; i++) s += 100 / d; return s; }
+int licm_null(int n, int *p) { int s = 0; for (int i = 0; i < n; i++) s += *p; return s; }
+
+// ループの回転 (先頭で 1 回だけ条件を調べ、末尾で判定する形にする)
+int rotate_count(int n) { int i = 0; while (i * i < n) i++; return i; }
+int rotate_swap(int n) { int a = 1, b = 2; for (int i = 0; i < n; i++) { int t = a; a = b; b = t; } return a * 10 + b; }
+int rotate_break(int n) { int i; for (i = 0; i < n; i++) { if (i == 7) break; } return i; }
+int rotate_calls;
+int rotate_next(void) { return rotate_calls++; }
+int rotate_side(int n) { int s = 0; while (rotate_next() < n) s++; return s * 10 + rotate_calls; }
+int rotate_nested(int n) {
+    int s = 0;
+    for (int i = 0; i < n; i++)
+        for (int j = i; j < n; j++)
+            s += j;
+    return s;
+}
+
+// ループ展開 (展開しきれない残りのループと、カウンタのあふれ)
+int unroll_sum(int *a, int n) { int s = 0; for (int i = 0; i < n; i++) s += a[i]; return s; }
+int unroll_down(int n) { int s = 0; for (int i = n; i > 0; i -= 2) s = s * 3 + i; return s; }
+unsigned unroll_unsigned(unsigned n) { unsigned s = 0; for (unsigned i = 0; i < n; i++) s += i * i; return s; }
+int unroll_after(int n) { int i; int s = 1; for (i = 0; i <= n; i++) s ^= i << 1; return i * 1000 + s; }
+int unroll_limit(int n) { int c = 0; for (int i = n; i < 2147483647; i++) c++; return c; }
+
+int main() {
+    ASSERT(126, ({ int img[6] = {1, 2, 3, 4, 5, 6}; licm_rows(img, 3, 2); }));
+    ASSERT(16, licm_alias(4));
+    ASSERT(10, licm_call(4));
+    ASSERT(0, licm_div(0, 0));
+    ASSERT(75, licm_div(3, 4));
+    ASSERT(0, licm_null(0, 0));
+    ASSERT(0, rotate_count(0));
+    ASSERT(8, rotate_count(50));
+    ASSERT(12, rotate_swap(0));
+    ASSERT(21, rotate_swap(3));
+    ASSERT(3, rotate_break(3));
+    ASSERT(7, rotate_break(100));
+    ASSERT(0, rotate_break(-1));
+    ASSERT(45, rotate_side(4));
+    ASSERT(0, rotate_nested(0));
+    ASSERT(20, rotate_nested(4));
+    ASSERT(0, ({ int a[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9}; unroll_sum(a, 0); }));
+    ASSERT(6, ({ int a[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9}; unroll_sum(a, 3); }));
+    ASSERT(10, ({ int a[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9}; unroll_sum(a, 4); }));
+    ASSERT(45, ({ int a[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9}; unroll_sum(a, 9); }));
+    ASSERT(0, unroll_down(0));
+    ASSERT(1, unroll_down(1));
+    ASSERT(973, unroll_down(9));
+    ASSERT(204, unroll_unsigned(9));
+    ASSERT(1, unroll_unsigned(2));
+    ASSERT(1001, unroll_after(0));
+    ASSERT(8001, unroll_after(7));
+    ASSERT(10003, unroll_after(9));
+    ASSERT(5, unroll_limit(2147483642));
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+void ASSERT(int expected, int actual);
+
+// -O1 / -O2 で書き換えられやすいコードの結果が -O0 と一致することを確かめる
+// (make test YOCTOCC_FLAGS=-O2 で最適化後のコードをテストする)
+
+int fold_wrap() { return 2147483647 + 1 == -2147483647 - 1; }
+int fold_unsigned() { return (unsigned)-1 > 1u; }
+int fold_shift() { return (1 << 31) >> 31; }
+long fold_long() { return (1L << 40) / 1024; }
+
+// SSA IR とレジスタ割り当て
+int add3(int a, int b, int c) { return a + b + c; }
+int ir_loop(int n) { int s = 0; for (int i = 0; i < n; i++) s += i; return s; }
+int ir_live_across_calls(int a, int b) {
+    int c = a * 3, d = b - 1, e = a ^ b, f = a + 7, g = b * b;
+    int x = add3(c, d, e);
+    int y = add3(f, g, x);
+    return a + b + c + d + e + f + g + x + y;
+}
+int ir_swap(int n) { int a = 1, b = 2; while (n--) { int t = a; a = b; b = t; } return a * 10 + b; }
+int ir_switch(int x) {
+    switch (x) {
+        case 1: return 10;
+        case 2: x += 5;
+        case 3: return x * 2;
+        default: return -1;
+    }
+}
+int ir_goto(int n) { int s = 0; again: s += n; if (--n > 0) goto again; return s; }
+int ir_char(int x) { char c = x; unsigned char u = x; c += 1; return c * 1000 + u; }
+double ir_float(double x, float y, int n) { double s = 0; for (int i = 0; i < n; i++) s = s * x + y; return s; }
+double ir_u2f(unsigned long x) { return x; }
+long ir_long(long a, long b) { a *= b; a /= 3; a %= 1000; a <<= 2; return a >> 1; }
+
+int main() {
+    ASSERT(1, fold_wrap());
+    ASSERT(1, fold_unsigned());
+    ASSERT(-1, fold_shift());
+    ASSERT(1, fold_long() == 1073741824L);
+    ASSERT(-7, -7 / 2 * 2 + -7 % 2);
+    ASSERT(255, (unsigned char)-1);
+    ASSERT(-1, (signed char)255);
+    ASSERT(1, !(3 - 3));
+    ASSERT(0, 5 < 3 || 0);
+    ASSERT(7, ({ int x = 3; x + 2 * 2; }));
+    ASSERT(45, ir_loop(10));
+    ASSERT(0, ir_loop(-1));
+    ASSERT(132, ir_live_across_calls(4, 5));
+    ASSERT(21, ir_swap(3));
+    ASSERT(12, ir_swap(4));
+    ASSERT(10, ir_switch(1));
+    ASSERT(14, ir_switch(2));
+    ASSERT(6, ir_switch(3));
+    ASSERT(-1, ir_switch(9));
+    ASSERT(15, ir_goto(5));
+    ASSERT(-127873, ir_char(383));
+    ASSERT(1, ir_float(2.0, 1.5f, 3) == 10.5);
+    ASSERT(1, ir_u2f(18446744073709551615UL) > 1.8e19);
+    ASSERT(1, ir_u2f(3) == 3.0);
+    ASSERT(1, ir_long(1000000007L, 3L) == 14L);
+
+    return 0;
+}
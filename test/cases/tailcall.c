@@ -0,0 +1,27 @@
+void ASSERT(int expected, int actual);
+
+// 末尾再帰のループ化と兄弟呼び出し (深い再帰でもスタックがあふれないこと)
+long tail_sum(long n, long acc) { if (n == 0) return acc; return tail_sum(n - 1, acc + n); }
+int tail_gcd(int a, int b) { if (b == 0) return a; return tail_gcd(b, a % b); }
+double tail_half(int n, double acc) { if (n == 0) return acc; return tail_half(n - 1, acc + 0.5); }
+int tail_rotate(int a, int b, int c, int d, int e, int f, int g, int h) {
+    if (a == 0) return b * 1000000 + c * 100000 + d * 10000 + e * 1000 + f * 100 + g * 10 + h;
+    return tail_rotate(a - 1, h, b, c, d, e, f, g);
+}
+int tail_even(int n);
+int tail_odd(int n) { if (n == 0) return 0; return tail_even(n - 1); }
+int tail_even(int n) { if (n == 0) return 1; return tail_odd(n - 1); }
+int tail_deref(int *p) { return *p; }
+int tail_escape(int x) { int y = x + 1; return tail_deref(&y); }
+
+int main() {
+    ASSERT(50005000, tail_sum(10000, 0));
+    ASSERT(21, tail_gcd(1071, 462));
+    ASSERT(5000, tail_half(10000, 0));
+    ASSERT(5671234, tail_rotate(3, 1, 2, 3, 4, 5, 6, 7));
+    ASSERT(1, tail_even(10000));
+    ASSERT(0, tail_odd(10000));
+    ASSERT(8, tail_escape(7));
+
+    return 0;
+}
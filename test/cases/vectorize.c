@@ -0,0 +1,21 @@
+void ASSERT(int expected, int actual);
+
+// 要素ごとのループのベクトル化 (端数と、読み書きが重なる配列)
+int vec_sub(int *a, int n) { int s = 100; for (int i = 0; i < n; i++) s -= a[i]; return s; }
+void vec_addf(float *d, float *a, float *b, int n) { for (int i = 0; i < n; i++) d[i] = a[i] + b[i]; }
+void vec_fill(char *p, char c, int n) { for (int i = 0; i < n; i++) p[i] = c; }
+void vec_copy(char *d, char *s, int n) { for (int i = 0; i < n; i++) d[i] = s[i]; }
+void vec_long(long *a, long *b, int n) { for (int i = 0; i < n; i++) a[i] = a[i] + b[i]; }
+
+int main() {
+    ASSERT(94, ({ int a[19]; for (int i = 0; i < 19; i++) a[i] = i + 1; vec_sub(a, 3); }));
+    ASSERT(-90, ({ int a[19]; for (int i = 0; i < 19; i++) a[i] = i + 1; vec_sub(a, 19); }));
+    ASSERT(18, ({ float x[10], y[10]; for (int i = 0; i < 10; i++) x[i] = i + 1; vec_addf(y, x, x, 9); y[8]; }));
+    ASSERT(512, ({ float x[10]; for (int i = 0; i < 10; i++) x[i] = i + 1; vec_addf(x + 1, x, x, 9); x[9]; }));
+    ASSERT(141, ({ char p[21]; p[20] = 1; vec_fill(p, 7, 20); int s = 0; for (int i = 0; i < 21; i++) s += p[i]; s; }));
+    ASSERT(20, ({ char p[20]; for (int i = 0; i < 20; i++) p[i] = i + 1; vec_copy(p + 1, p, 19); int s = 0; for (int i = 0; i < 20; i++) s += p[i]; s; }));
+    ASSERT(229, ({ char p[20]; for (int i = 0; i < 20; i++) p[i] = i + 1; vec_copy(p, p + 1, 19); int s = 0; for (int i = 0; i < 20; i++) s += p[i]; s; }));
+    ASSERT(10, ({ long a[5] = {1, 2, 3, 4, 5}; vec_long(a, a, 5); a[4]; }));
+
+    return 0;
+}
@@ -10,6 +10,10 @@ Usage:
 Environment:
     FORMAT=md       Output in Markdown format (default: simple, matches the
                      original bash script's terminal output 1:1)
+    JIT=1           Run each case in-process with `yoctocc --run` instead of
+                     assembling and linking (x86-64 hosts only)
+    INTERPRET=1     Run each case with the bytecode interpreter (`yoctocc --interpret`)
+    YOCTOCC_FLAGS   Extra compiler flags, e.g. YOCTOCC_FLAGS="-O2 -fno-peephole"
 """
 
 import os
@@ -32,6 +36,9 @@ TEST_TIMEOUT = int(os.environ.get("TEST_TIMEOUT", "10"))
 PARALLEL_JOBS = int(os.environ.get("PARALLEL_JOBS", os.cpu_count() or 4))
 OUTPUT_MD = os.environ.get("FORMAT", "simple") == "md"
 FILTERS = sys.argv[1:]
+JIT = os.environ.get("JIT", "0") == "1"
+INTERPRET = os.environ.get("INTERPRET", "0") == "1"
+YOCTOCC_FLAGS = os.environ.get("YOCTOCC_FLAGS", "").split()
 
 
 class C:
@@ -50,6 +57,7 @@ PROJECT_ROOT = SCRIPT_DIR.parent
 CASES_DIR = SCRIPT_DIR / "cases"
 COMPILER = PROJECT_ROOT / "build" / "yoctocc"
 TEST_HELPER_O = PROJECT_ROOT / "build" / "test_helper.o"
+TEST_HELPER_SO = PROJECT_ROOT / "build" / "test_helper.so"
 
 # --- Architecture detection: arm64 needs an x86-64 cross compiler + QEMU ---
 
@@ -121,8 +129,20 @@ def run_single_test(tc: TestCase, work_dir: Path) -> TestResult:
     asm, obj, binf = d / "a.s", d / "a.o", d / "a"
     r = TestResult(name=tc.name, file=tc.file, expected_exit=tc.expected_exit)
 
+    if JIT or INTERPRET:
+        mode = "--run" if JIT else "--interpret"
+        run_cmd = [str(COMPILER), mode, *YOCTOCC_FLAGS, "--load", str(TEST_HELPER_SO), str(tc.file)]
+        _, out, rc = run_step(run_cmd)
+        if rc is None:
+            r.status, r.reason = "FAIL", "timeout"
+            return r
+        r.actual_exit, r.stderr_log = rc, out
+        if rc != tc.expected_exit:
+            r.status, r.reason = "FAIL", "result"
+        return r
+
     build_steps = [
-        ("compile", [str(COMPILER), str(tc.file), str(asm)]),
+        ("compile", [str(COMPILER), *YOCTOCC_FLAGS, str(tc.file), str(asm)]),
         ("assemble", [X86_64_CC, "-c", "-o", str(obj), str(asm)]),
         ("link", [X86_64_CC, "-no-pie", "-o", str(binf), str(obj), str(TEST_HELPER_O)]),
     ]
@@ -239,6 +259,8 @@ def header_lines() -> List[str]:
         ]
         if FILTERS:
             lines.append(f"- **フィルタ**: {' '.join(FILTERS)}")
+        if YOCTOCC_FLAGS:
+            lines.append(f"- **コンパイラオプション**: {' '.join(YOCTOCC_FLAGS)}")
         return lines + [""]
 
     bar = color("=" * 40, C.BLUE)
@@ -246,6 +268,8 @@ def header_lines() -> List[str]:
              f"アーキテクチャ: {UNAME_M}", f"並列数: {PARALLEL_JOBS}", f"タイムアウト: {TEST_TIMEOUT}s"]
     if FILTERS:
         lines.append(f"フィルタ: {' '.join(FILTERS)}")
+    if YOCTOCC_FLAGS:
+        lines.append(f"コンパイラオプション: {' '.join(YOCTOCC_FLAGS)}")
     return lines + [""]
 
 
@@ -383,7 +407,8 @@ def main():
     print(color("コンパイラ本体のビルドが完了しました", C.GREEN))
 
     print(color("テストヘルパーをビルド中...", C.YELLOW))
-    if not make("build/test_helper.o", MAKE_X86_FLAG):
+    helper = "build/test_helper.so" if JIT or INTERPRET else "build/test_helper.o"
+    if not make(helper, MAKE_X86_FLAG):
         print(color("テストヘルパーのビルドに失敗しました", C.RED))
         sys.exit(1)
     print(color("テストヘルパーのビルドが完了しました", C.GREEN))